@@ -0,0 +1,171 @@
+/*
+ 
+ xTalk Engine UTF-8 Case Folding Table Generator
+ xte_mkfold.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Generates xte_utf8_fold.c from the Unicode case folding data in xte_utf8_tables.c.
+ Run from the CinsImp source directory whenever the case folding data is updated:
+ 
+    cc -o /tmp/xte_mkfold Tools/xte_mkfold.c && /tmp/xte_mkfold > xte_utf8_fold.c
+ 
+ *************************************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define XTALK_TESTS 1
+#include "../xte_utf8_tables.c"
+
+
+/* these must match xtalk_utf8_equal.c */
+#define MAX_CODE_POINTS_MAPPING 3
+#define FOLD_EXPANDS 0x80000000U
+
+#define CODE_POINT_LIMIT 0x110000
+#define BLOCK_SIZE 256
+#define BLOCK_COUNT (CODE_POINT_LIMIT / BLOCK_SIZE)
+
+
+static unsigned int g_folds[CODE_POINT_LIMIT][MAX_CODE_POINTS_MAPPING];
+static int g_fold_points[CODE_POINT_LIMIT];
+
+
+/*
+ *  load_folds
+ *  ---------------------------------------------------------------------------------------------
+ *  Reads the common (C) and full (F) case folding rules; together these give the full case
+ *  folding of Unicode.  The simple (S) rules are superseded by the full rules and the Turkic (T)
+ *  rules are language specific, so both are ignored.
+ *
+ *  ASCII lower case letters in the folded forms are replaced with upper case, so that folded
+ *  strings order the same way as they always have (see xte_cstring_fold()).
+ */
+static void load_folds(void)
+{
+    char const *data = _XTE_UTF8_CASE_DATA;
+    while (*data)
+    {
+        char *next;
+        unsigned long code = strtoul(data, &next, 16);
+        char status = next[2];
+        data = next + 4;
+        
+        if ((status == 'C') || (status == 'F'))
+        {
+            int points = 0;
+            while (*data != ';')
+            {
+                unsigned long point = strtoul(data, &next, 16);
+                if ((point >= 'a') && (point <= 'z')) point -= 0x20;
+                g_folds[code][points++] = (unsigned int)point;
+                data = next;
+                while (*data == ' ') data++;
+            }
+            g_fold_points[code] = points;
+        }
+        
+        data = strchr(data, '\n') + 1;
+    }
+    
+    /* having replaced the folded forms, ASCII letters must also be folded to upper case */
+    for (int code = 'a'; code <= 'z'; code++)
+    {
+        g_folds[code][0] = code - 0x20;
+        g_fold_points[code] = 1;
+        g_fold_points[code - 0x20] = 0;
+    }
+}
+
+
+int main(void)
+{
+    load_folds();
+    
+    printf("/*\n"
+           " \n"
+           " xTalk Engine UTF-8 Case Folding Tables\n"
+           " xte_utf8_fold.c\n"
+           " \n"
+           " CinsImp\n"
+           " Copyright (c) 2010-2013 Joshua Hawcroft\n"
+           " <www.joshhawcroft.com/CinsImp/>\n"
+           " \n"
+           " Generated by Tools/xte_mkfold.c from the Unicode case folding data in xte_utf8_tables.c;\n"
+           " do not edit.\n"
+           " \n"
+           " The folded form of a code point is looked up by its high bits in _XTE_UTF8_FOLD_BLOCK_INDEX\n"
+           " and then by its low 8-bits in _XTE_UTF8_FOLD_BLOCKS.  Zero means the code point folds to\n"
+           " itself.  Values with the high bit set index a multiple code point form in\n"
+           " _XTE_UTF8_FOLD_EXPANSIONS.\n"
+           " \n"
+           " *************************************************************************************************\n"
+           " */\n\n\n");
+    
+    /* multiple code point forms */
+    static unsigned int values[CODE_POINT_LIMIT];
+    int expansion_count = 0;
+    printf("unsigned int const _XTE_UTF8_FOLD_EXPANSIONS[][%d] = {\n", MAX_CODE_POINTS_MAPPING);
+    for (int code = 0; code < CODE_POINT_LIMIT; code++)
+    {
+        if (g_fold_points[code] == 1)
+            values[code] = g_folds[code][0];
+        else if (g_fold_points[code] > 1)
+        {
+            printf("    { 0x%04X, 0x%04X, 0x%04X }, /* %04X */\n",
+                   g_folds[code][0], g_folds[code][1], g_folds[code][2], code);
+            values[code] = FOLD_EXPANDS | expansion_count++;
+        }
+    }
+    printf("};\n\n\n");
+    
+    /* blocks of 256 code points; block zero is shared by code points that don't fold */
+    static unsigned char block_index[BLOCK_COUNT];
+    int block_count = 1;
+    printf("unsigned int const _XTE_UTF8_FOLD_BLOCKS[][%d] = {\n", BLOCK_SIZE);
+    printf("    { 0 },\n");
+    for (int block = 0; block < BLOCK_COUNT; block++)
+    {
+        unsigned int const *block_values = values + block * BLOCK_SIZE;
+        int is_empty = 1;
+        for (int i = 0; i < BLOCK_SIZE; i++)
+            if (block_values[i]) is_empty = 0;
+        if (is_empty) continue;
+        
+        block_index[block] = block_count++;
+        printf("    { /* %04X */\n", block * BLOCK_SIZE);
+        for (int i = 0; i < BLOCK_SIZE; i++)
+        {
+            if (i % 8 == 0) printf("       ");
+            if (block_values[i]) printf(" 0x%08X,", block_values[i]);
+            else printf(" %10s,", "0");
+            if (i % 8 == 7) printf("\n");
+        }
+        printf("    },\n");
+    }
+    printf("};\n\n\n");
+    
+    if (block_count > 256)
+    {
+        fprintf(stderr, "xte_mkfold: too many blocks\n");
+        return EXIT_FAILURE;
+    }
+    
+    printf("unsigned char const _XTE_UTF8_FOLD_BLOCK_INDEX[%#X] = {\n", BLOCK_COUNT);
+    for (int block = 0; block < BLOCK_COUNT; block++)
+    {
+        if (block % 32 == 0) printf("   ");
+        printf(" %d,", block_index[block]);
+        if (block % 32 == 31) printf("\n");
+    }
+    printf("};\n\n\n");
+    
+    return EXIT_SUCCESS;
+}
+
+
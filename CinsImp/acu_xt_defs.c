@@ -12,6 +12,8 @@
 int _retr_script(XTE *in_engine, StackMgrStack *in_register_entry, XTEVariant *in_object,
                         char const **out_script, int const *out_checkpoints[], int *out_checkpoint_count);
 int _next_responder(XTE *in_engine, StackMgrStack *in_stack, XTEVariant *in_responder, XTEVariant **out_responder);
+int _ident_script(XTE *in_engine, StackMgrStack *in_register_entry, XTEVariant *in_object,
+                  void const **out_domain, long *out_id, long *out_revision);
 
 
 
@@ -213,6 +215,7 @@ struct XTEClassDef _acu_xt_classes[] = {
         (XTEContainerWriter)&_obj_fld_write,
         (XTEScriptRetriever)&_retr_script,
         (XTENextResponder)&_next_responder,
+        (XTEScriptIdentifier)&_ident_script,
     },
     {
         "bgfld", /* background field by ID must have a different accessor, thus the entire class definition is replicated,
@@ -224,6 +227,7 @@ struct XTEClassDef _acu_xt_classes[] = {
         (XTEContainerWriter)&_obj_fld_write,
         (XTEScriptRetriever)&_retr_script,
         (XTENextResponder)&_next_responder,
+        (XTEScriptIdentifier)&_ident_script,
     },
     {
         "cdbtn",
@@ -234,6 +238,7 @@ struct XTEClassDef _acu_xt_classes[] = {
         NULL,
         (XTEScriptRetriever)&_retr_script,
         (XTENextResponder)&_next_responder,
+        (XTEScriptIdentifier)&_ident_script,
     },
     {
         "bgbtn",
@@ -244,6 +249,7 @@ struct XTEClassDef _acu_xt_classes[] = {
         NULL,
         (XTEScriptRetriever)&_retr_script,
         (XTENextResponder)&_next_responder,
+        (XTEScriptIdentifier)&_ident_script,
     },
     {
         "card",
@@ -254,6 +260,7 @@ struct XTEClassDef _acu_xt_classes[] = {
         NULL,
         (XTEScriptRetriever)&_retr_script,
         (XTENextResponder)&_next_responder,
+        (XTEScriptIdentifier)&_ident_script,
     },
     {
         "bkgnd",
@@ -264,6 +271,7 @@ struct XTEClassDef _acu_xt_classes[] = {
         NULL,
         (XTEScriptRetriever)&_retr_script,
         (XTENextResponder)&_next_responder,
+        (XTEScriptIdentifier)&_ident_script,
     },
     {
         "stack",
@@ -274,6 +282,7 @@ struct XTEClassDef _acu_xt_classes[] = {
         NULL,
         (XTEScriptRetriever)&_retr_script,
         (XTENextResponder)&_next_responder,
+        (XTEScriptIdentifier)&_ident_script,
     },
     
     /* palette windows */
@@ -250,6 +250,46 @@ int _retr_script(XTE *in_engine, StackMgrStack *in_register_entry, XTEVariant *i
 }
 
 
+/* identifies the script of an object for the engine's compiled handler cache;
+ the object type is encoded in the low bits of the ID, as card, background and widget IDs
+ are allocated independently */
+int _ident_script(XTE *in_engine, StackMgrStack *in_register_entry, XTEVariant *in_object,
+                  void const **out_domain, long *out_id, long *out_revision)
+{
+    HandleDef *the_handle = xte_variant_ref_ident(in_object);
+    Stack *the_stack;
+    
+    if (_stackmgr_handle_is_stack(the_handle))
+    {
+        the_stack = (Stack*)the_handle;
+        *out_id = STACKMGR_TYPE_STACK;
+    }
+    else
+    {
+        StackMgrStack *register_entry = _stackmgr_stack((StackHandle)the_handle);
+        if (!register_entry) return XTE_FALSE;
+        the_stack = register_entry->stack;
+        switch (the_handle->reference.type)
+        {
+            case STACKMGR_TYPE_BKGND:
+            case STACKMGR_TYPE_CARD:
+                *out_id = (the_handle->reference.layer_id << 3) | the_handle->reference.type;
+                break;
+            case STACKMGR_TYPE_BUTTON:
+            case STACKMGR_TYPE_FIELD:
+                *out_id = (the_handle->reference.widget_id << 3) | the_handle->reference.type;
+                break;
+            default:
+                return XTE_FALSE;
+        }
+    }
+    
+    *out_domain = the_stack;
+    *out_revision = stack_script_revision(the_stack);
+    return XTE_TRUE;
+}
+
+
 int _next_responder(XTE *in_engine, StackMgrStack *in_stack, XTEVariant *in_responder, XTEVariant **out_responder)
 {
     HandleDef *responder = xte_variant_ref_ident(in_responder);
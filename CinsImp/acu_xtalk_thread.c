@@ -532,7 +532,7 @@ void _acu_xt_comms_unlock(StackMgrStack *in_stack)
 /*
  *  _acu_xt_wakeup
  *  ---------------------------------------------------------------------------------------------
- *  Wake up XT if it is sleeping.  Otherwise, does nothing.
+ *  Wake up XT if it is sleeping.  Otherwise, asks the running script to check for signals.
  *
  *  ! Ensure communications channels are not locked, otherwise this will cause a deadlock.
  */
@@ -541,6 +541,10 @@ void _acu_xt_wakeup(StackMgrStack *in_stack)
     _acu_thread_mutex_lock(&(in_stack->xt_mutex_comms));
     _acu_thread_cond_signal(&(in_stack->xt_wakeup));
     _acu_thread_mutex_unlock(&(in_stack->xt_mutex_comms));
+    
+    /* if a script is running, have it check for signals at the next opportunity,
+     rather than when it next polls */
+    if (in_stack->xtalk) xte_attention(in_stack->xtalk);
 }
 
 
@@ -18,6 +18,7 @@
 
 
 #define SORTER_ALLOC_SIZE 4096
+#define SORTER_RUN_SIZE 16
 
 
 struct Sorter
@@ -65,13 +66,26 @@ Sortable sorter_item(Sorter *in_sorter, long in_index)
 }
 
 
+int sorter_reserve(Sorter *in_sorter, long in_count)
+{
+    assert(in_sorter != NULL);
+    assert(in_count >= 0);
+    
+    if (in_count <= in_sorter->item_alloc) return 1;
+    Sortable *new_items = realloc(in_sorter->items, sizeof(Sortable) * in_count);
+    if (!new_items) return 0;
+    in_sorter->items = new_items;
+    in_sorter->item_alloc = in_count;
+    return 1;
+}
+
+
 int sorter_add(Sorter *in_sorter, Sortable in_item)
 {
-    assert(sizeof(Sortable) < SORTER_ALLOC_SIZE);
     assert(in_sorter != NULL);
     
     /* increase the number of allocated slots (if necessary) */
-    if ((in_sorter->item_count + 1) * sizeof(Sortable) > in_sorter->item_alloc)
+    if (in_sorter->item_count + 1 > in_sorter->item_alloc)
     {
         Sortable *new_items = realloc(in_sorter->items, sizeof(Sortable) * (in_sorter->item_alloc + SORTER_ALLOC_SIZE));
         if (!new_items) return 0;
@@ -85,29 +99,86 @@ int sorter_add(Sorter *in_sorter, Sortable in_item)
 }
 
 
+/* stable insertion sort of a range of items;
+ used for short runs, and if there isn't enough memory for a merge */
+static void _sorter_insertion_sort(Sorter *in_sorter, long in_begin, long in_end, int in_direction)
+{
+    Sortable *items = in_sorter->items;
+    for (long item = in_begin + 1; item < in_end; item++)
+    {
+        Sortable temp = items[item];
+        long dest = item;
+        while ((dest > in_begin) && (in_sorter->comp(in_sorter, in_sorter->user, items[dest-1], temp) == in_direction))
+        {
+            items[dest] = items[dest-1];
+            dest--;
+        }
+        items[dest] = temp;
+    }
+}
+
+
+/* merges two adjacent sorted runs; items from the left run are taken first
+ unless the right item belongs strictly before it, which keeps the sort stable */
+static void _sorter_merge(Sorter *in_sorter, Sortable *in_source, Sortable *out_dest,
+                          long in_begin, long in_middle, long in_end, int in_direction)
+{
+    long left = in_begin, right = in_middle, dest = in_begin;
+    while ((left < in_middle) && (right < in_end))
+    {
+        if (in_sorter->comp(in_sorter, in_sorter->user, in_source[left], in_source[right]) == in_direction)
+            out_dest[dest++] = in_source[right++];
+        else
+            out_dest[dest++] = in_source[left++];
+    }
+    while (left < in_middle) out_dest[dest++] = in_source[left++];
+    while (right < in_end) out_dest[dest++] = in_source[right++];
+}
+
+
+/* stable sort; items which compare equal retain their existing order,
+ allowing successive sorts to produce a multi-key ordering */
 void sorter_sort(Sorter *in_sorter, SorterDirection in_direction)
 {
-    /* simple bubble sort */
-    int continue_sort = 1;
-    long item_limit = in_sorter->item_count - 1;
+    assert(in_sorter != NULL);
+    
+    long item_count = in_sorter->item_count;
     int direction = ((in_direction == SORTER_ASCENDING) ? 1 : -1);
-    while (continue_sort)
+    
+    /* sort short runs in place */
+    for (long begin = 0; begin < item_count; begin += SORTER_RUN_SIZE)
+        _sorter_insertion_sort(in_sorter, begin, (begin + SORTER_RUN_SIZE < item_count ? begin + SORTER_RUN_SIZE : item_count),
+                               direction);
+    if (item_count <= SORTER_RUN_SIZE) return;
+    
+    Sortable *buffer = malloc(sizeof(Sortable) * item_count);
+    if (!buffer)
     {
-        continue_sort = 0;
-        for (long item = 0; item < item_limit; item++)
+        /* slow, but we can still sort correctly */
+        _sorter_insertion_sort(in_sorter, 0, item_count, direction);
+        return;
+    }
+    
+    /* merge runs of increasing width, alternating between the item list and the buffer */
+    Sortable *source = in_sorter->items;
+    Sortable *dest = buffer;
+    for (long width = SORTER_RUN_SIZE; width < item_count; width *= 2)
+    {
+        for (long begin = 0; begin < item_count; begin += 2 * width)
         {
-            int diff = in_sorter->comp(in_sorter, in_sorter->user, in_sorter->items[item], in_sorter->items[item+1]);
-            if (diff == direction)
-            {
-                /* swap */
-                Sortable temp = in_sorter->items[item];
-                in_sorter->items[item] = in_sorter->items[item+1];
-                in_sorter->items[item+1] = temp;
-                
-                continue_sort = 1;
-            }
+            long middle = (begin + width < item_count ? begin + width : item_count);
+            long end = (begin + 2 * width < item_count ? begin + 2 * width : item_count);
+            _sorter_merge(in_sorter, source, dest, begin, middle, end, direction);
         }
+        Sortable *temp = source;
+        source = dest;
+        dest = temp;
     }
+    
+    /* make sure the result ends up in the item list */
+    if (source != in_sorter->items)
+        memcpy(in_sorter->items, source, sizeof(Sortable) * item_count);
+    free(buffer);
 }
 
 
@@ -22,6 +22,7 @@ typedef int (*SorterComparator) (Sorter *in_sorter, void *in_user, Sortable in_i
 
 Sorter* sorter_create(SorterComparator in_comparator, void *in_user);
 void sorter_destroy(Sorter *in_sorter);
+int sorter_reserve(Sorter *in_sorter, long in_count);
 int sorter_add(Sorter *in_sorter, Sortable in_item);
 void sorter_sort(Sorter *in_sorter, SorterDirection in_direction);
 long sorter_count(Sorter *in_sorter);
@@ -35,7 +35,66 @@
 #include "stack_int.h"
 
 
-#define _STACK_FILE_FORMAT_VERSION 1
+/* file format versions:
+ 1  original format
+ 2  card & widget sequence tables are stored in binary rather than ASCII form
+ 3  word index of widget content for find (widget_word)
+ 4  indicies for the common lookups of widgets, widget content, cards and resources */
+#define _STACK_FILE_FORMAT_VERSION 4
+
+
+/* the word index table and its indicies; see stack_find.c */
+static char const *_g_stack_word_index_sql[] = {
+    "CREATE TABLE widget_word (word TEXT, widgetid INTEGER, cardid INTEGER, bkgndid INTEGER)",
+    "CREATE UNIQUE INDEX widget_word_owner ON widget_word (widgetid, cardid, bkgndid, word)",
+    "CREATE INDEX widget_word_word ON widget_word (word)",
+    NULL
+};
+
+
+/* indicies for the lookups made by most accessors; without them, reading a single field of a
+ large stack scans the content of every field */
+static char const *_g_stack_lookup_index_sql[] = {
+    "CREATE INDEX IF NOT EXISTS widget_content_owner ON widget_content (widgetid, cardid, bkgndid)",
+    "CREATE INDEX IF NOT EXISTS widget_content_card ON widget_content (cardid, bkgndid)",
+    "CREATE INDEX IF NOT EXISTS widget_options_widget ON widget_options (widgetid, optionid)",
+    "CREATE INDEX IF NOT EXISTS widget_card ON widget (cardid)",
+    "CREATE INDEX IF NOT EXISTS widget_bkgnd ON widget (bkgndid)",
+    "CREATE INDEX IF NOT EXISTS card_bkgnd ON card (bkgndid)",
+    "CREATE INDEX IF NOT EXISTS card_name ON card (name)",
+    "CREATE INDEX IF NOT EXISTS resource_type ON resource (resourcetype, resourceid)",
+    NULL
+};
+
+
+/* the handler for reporting the progress of upgrades to older files, if any */
+static StackUpgradeProgressHandler _g_stack_upgrade_progress = NULL;
+static void *_g_stack_upgrade_progress_context = NULL;
+
+
+static int _stack_exec_all(sqlite3 *in_db, char const *in_sql[])
+{
+    for (int i = 0; in_sql[i]; i++)
+    {
+        int err = sqlite3_exec(in_db, in_sql[i], NULL, NULL, NULL);
+        if (err != SQLITE_OK) return err;
+    }
+    return SQLITE_OK;
+}
+
+
+static int _stack_create_word_index(sqlite3 *in_db)
+{
+    return _stack_exec_all(in_db, _g_stack_word_index_sql);
+}
+
+
+static int _stack_sql_count(char const *in_sql[])
+{
+    int count = 0;
+    while (in_sql[count]) count++;
+    return count;
+}
 
 /*
 static void _handle_sql_error(void *pArg, int iErrCode, const char *zMsg){
@@ -113,6 +172,10 @@ void _stack_cancel(Stack *in_stack)
     int err = sqlite3_exec(in_stack->db, "ROLLBACK", NULL, NULL, NULL);
     assert(err == SQLITE_OK);
     
+    _stack_card_bkgnd_map_invalidate(in_stack); /* may have been loaded mid-transaction */
+    _stack_search_cache_invalidate(in_stack);
+    in_stack->word_index_revision++;
+    
     stack_undo_flush(in_stack); /* necessary since with the nesting of complex serialisaton routines
                                  things could be in a very screwed up state if anything major has
                                  gone wrong while accessing the disk,
@@ -136,6 +199,17 @@ static void _stack_init(Stack *io_stack)
     io_stack->card_widget_table = NULL;
     io_stack->bkgnd_widget_table = NULL;
     io_stack->stack_card_table = NULL;
+    io_stack->card_bkgnd_map = NULL;
+    io_stack->card_bkgnd_count = 0;
+    io_stack->search_cache.bkgnds = NULL;
+    io_stack->search_cache.bkgnd_count = 0;
+    io_stack->search_cache.card_dontsearch = NULL;
+    io_stack->search_cache.card_bytes = 0;
+    io_stack->search_cache.field_searchable = NULL;
+    io_stack->search_cache.field_bytes = 0;
+    io_stack->has_word_index = STACK_NO;
+    io_stack->word_index_revision = 0;
+    _stack_script_changed(io_stack);
     
     /* undo */
     io_stack->undo_stack = NULL;
@@ -148,6 +222,12 @@ static void _stack_init(Stack *io_stack)
     io_stack->find_state_field_content = NULL;
     io_stack->find_state_field_words = NULL;
     io_stack->find_state_field_offsets = NULL;
+    io_stack->find_content_card_id = STACK_NO_OBJECT;
+    io_stack->find_content_field_ids = NULL;
+    io_stack->find_content_text = NULL;
+    io_stack->find_content_count = 0;
+    io_stack->find_candidates = NULL;
+    io_stack->find_candidate_count = 0;
     io_stack->found_text = NULL;
     stack_reset_find(io_stack);
 }
@@ -217,6 +297,156 @@ static int _stack_check_schema_is_ok(sqlite3 *in_db, StackOpenStatus *out_status
 }
 
 
+/* SQL function which converts the ASCII form of an ID table to the binary form */
+static void _sql_idtable_binary(sqlite3_context *in_context, int in_argc, sqlite3_value **in_argv)
+{
+    Stack *stack = sqlite3_user_data(in_context);
+    char const *ascii = (char const*)sqlite3_value_text(in_argv[0]);
+    IDTable *table = idtable_create_with_ascii(stack, (ascii ? ascii : ""));
+    if (!table)
+    {
+        sqlite3_result_error_nomem(in_context);
+        return;
+    }
+    long size;
+    const void *data = idtable_to_binary(table, &size);
+    if (data) sqlite3_result_blob(in_context, data, (int)size, SQLITE_TRANSIENT);
+    else sqlite3_result_error_nomem(in_context);
+    idtable_destroy(table);
+}
+
+
+/*
+ *  stack_set_upgrade_progress_handler
+ *  ---------------------------------------------------------------------------------------------
+ *  Sets the handler to be notified of progress when stack_open() upgrades a file created by an
+ *  earlier version.  Applies to all subsequently opened stacks.
+ */
+
+void stack_set_upgrade_progress_handler(StackUpgradeProgressHandler in_handler, void *in_context)
+{
+    _g_stack_upgrade_progress = in_handler;
+    _g_stack_upgrade_progress_context = in_context;
+}
+
+
+static void _stack_upgrade_progress(Stack *in_stack, int in_step, int in_step_count)
+{
+    if (_g_stack_upgrade_progress)
+        _g_stack_upgrade_progress(in_stack->pathname, in_step, in_step_count, _g_stack_upgrade_progress_context);
+}
+
+
+/*
+ *  _stack_upgrade
+ *  ---------------------------------------------------------------------------------------------
+ *  Upgrades a writable stack file created by an earlier version to the current file format.
+ *  Older, read-only files remain readable in their original form.
+ *
+ *  Progress is reported to the handler set with stack_set_upgrade_progress_handler() (if any);
+ *  upgrading a large stack can take some time.
+ *
+ *  Returns STACK_YES if the file is now the current version.
+ */
+
+static int _stack_upgrade(Stack *in_stack)
+{
+    assert(in_stack != NULL);
+    
+    /* check the file format version */
+    sqlite3_stmt *stmt;
+    int version = _STACK_FILE_FORMAT_VERSION;
+    if (sqlite3_prepare_v2(in_stack->db, "SELECT version FROM stack", -1, &stmt, NULL) != SQLITE_OK) return STACK_NO;
+    if (sqlite3_step(stmt) == SQLITE_ROW) version = sqlite3_column_int(stmt, 0);
+    sqlite3_finalize(stmt);
+    if (version >= _STACK_FILE_FORMAT_VERSION) return STACK_YES;
+    
+    /* count the steps, for progress reporting */
+    int step = 0, step_count = 0;
+    if (version < 2) step_count++;
+    if (version < 3) step_count++;
+    if (version < 4) step_count += _stack_sql_count(_g_stack_lookup_index_sql);
+    _stack_upgrade_progress(in_stack, step, step_count);
+    
+    /* upgrade within a single transaction */
+    int err = sqlite3_exec(in_stack->db, "BEGIN", NULL, NULL, NULL);
+    if (err != SQLITE_OK) return STACK_NO;
+    
+    /* version 2: binary card & widget sequence tables */
+    if ((err == SQLITE_OK) && (version < 2))
+    {
+        err = sqlite3_create_function(in_stack->db, "_idtable_binary", 1, SQLITE_UTF8, in_stack,
+                                      &_sql_idtable_binary, NULL, NULL);
+        if (err == SQLITE_OK)
+            err = sqlite3_exec(in_stack->db, "UPDATE stack SET cards=_idtable_binary(cards) "
+                               "WHERE typeof(cards)!='blob'", NULL, NULL, NULL);
+        if (err == SQLITE_OK)
+            err = sqlite3_exec(in_stack->db, "UPDATE bkgnd SET widgets=_idtable_binary(widgets) "
+                               "WHERE typeof(widgets)!='blob'", NULL, NULL, NULL);
+        if (err == SQLITE_OK)
+            err = sqlite3_exec(in_stack->db, "UPDATE card SET widgets=_idtable_binary(widgets) "
+                               "WHERE typeof(widgets)!='blob'", NULL, NULL, NULL);
+        sqlite3_create_function(in_stack->db, "_idtable_binary", 1, SQLITE_UTF8, NULL, NULL, NULL, NULL);
+        if (err == SQLITE_OK) _stack_upgrade_progress(in_stack, ++step, step_count);
+    }
+    
+    /* version 3: word index; index the existing content */
+    if ((err == SQLITE_OK) && (version < 3))
+    {
+        err = _stack_create_word_index(in_stack->db);
+        if (err == SQLITE_OK)
+        {
+            in_stack->has_word_index = STACK_YES;
+            err = sqlite3_prepare_v2(in_stack->db, "SELECT widgetid,cardid,bkgndid,searchable FROM widget_content",
+                                     -1, &stmt, NULL);
+        }
+        if (err == SQLITE_OK)
+        {
+            while ((err = sqlite3_step(stmt)) == SQLITE_ROW)
+            {
+                if (!_stack_find_index_content(in_stack, sqlite3_column_int(stmt, 0), sqlite3_column_int(stmt, 1),
+                                               sqlite3_column_int(stmt, 2), (char const*)sqlite3_column_text(stmt, 3)))
+                    break;
+            }
+            if (err == SQLITE_DONE) err = SQLITE_OK;
+            else if (err == SQLITE_ROW) err = SQLITE_ERROR;
+            sqlite3_finalize(stmt);
+        }
+        if (err == SQLITE_OK) _stack_upgrade_progress(in_stack, ++step, step_count);
+    }
+    
+    /* version 4: lookup indicies; built one at a time, as each can take a while on a large stack */
+    for (int i = 0; (err == SQLITE_OK) && (version < 4) && _g_stack_lookup_index_sql[i]; i++)
+    {
+        err = sqlite3_exec(in_stack->db, _g_stack_lookup_index_sql[i], NULL, NULL, NULL);
+        if (err == SQLITE_OK) _stack_upgrade_progress(in_stack, ++step, step_count);
+    }
+    
+    /* record the new version */
+    if (err == SQLITE_OK)
+    {
+        err = sqlite3_prepare_v2(in_stack->db, "UPDATE stack SET version=?1", -1, &stmt, NULL);
+        if (err == SQLITE_OK)
+        {
+            sqlite3_bind_int(stmt, 1, _STACK_FILE_FORMAT_VERSION);
+            err = sqlite3_step(stmt);
+            if (err == SQLITE_DONE) err = SQLITE_OK;
+            sqlite3_finalize(stmt);
+        }
+    }
+    
+    if (err == SQLITE_OK)
+        err = sqlite3_exec(in_stack->db, "COMMIT", NULL, NULL, NULL);
+    if (err != SQLITE_OK)
+    {
+        sqlite3_exec(in_stack->db, "ROLLBACK", NULL, NULL, NULL);
+        in_stack->has_word_index = STACK_NO;
+        return STACK_NO;
+    }
+    return STACK_YES;
+}
+
+
 void _stack_card_table_load(Stack *in_stack);
 
 
@@ -298,8 +528,10 @@ Stack* stack_create(char const *in_path, long in_card_width, long in_card_height
                  "CREATE TABLE resource (resourceid INTEGER, resourcetype TEXT, resourcename TEXT, data BLOB, "
                  "PRIMARY KEY (resourceid,resourcetype))",
                  NULL, NULL, NULL);
+    _stack_create_word_index(stack->db);
+    _stack_exec_all(stack->db, _g_stack_lookup_index_sql);
     
-    sqlite3_prepare_v2(stack->db, "INSERT INTO stack VALUES (?3, '0000000001', '0000000001', 0, 0, 5, 0, '', '', ?1, ?2, "
+    sqlite3_prepare_v2(stack->db, "INSERT INTO stack VALUES (?3, '0000000001', X'4944540101000000', 0, 0, 5, 0, '', '', ?1, ?2, "
                        "0, 0, 0, 0, 0, 0, ?1, ?2, '', 0)", -1, &stmt, NULL);
     sqlite3_bind_int(stmt, 1, (int)in_card_width);
     sqlite3_bind_int(stmt, 2, (int)in_card_height);
@@ -307,10 +539,10 @@ Stack* stack_create(char const *in_path, long in_card_width, long in_card_height
     sqlite3_step(stmt);
     sqlite3_finalize(stmt);
     sqlite3_exec(stack->db,
-                 "INSERT INTO bkgnd VALUES (1, '', '', 0, 0, '', '', 0)",
+                 "INSERT INTO bkgnd VALUES (1, X'49445401', '', 0, 0, '', '', 0)",
                  NULL, NULL, NULL);
     sqlite3_exec(stack->db,
-                 "INSERT INTO card VALUES (1, 1, '', '', 0, 0, '', '', 0)",
+                 "INSERT INTO card VALUES (1, 1, X'49445401', '', 0, 0, '', '', 0)",
                  NULL, NULL, NULL);
 
     /* check database schema */
@@ -324,6 +556,7 @@ Stack* stack_create(char const *in_path, long in_card_width, long in_card_height
     
     /* load the stack's card table */
     _stack_card_table_load(stack);
+    stack->has_word_index = STACK_YES;
     
     /* set the fatal error handler */
     stack->fatal_handler = in_fatal_handler;
@@ -392,6 +625,17 @@ Stack* stack_open(char const *in_path, StackFatalErrorHandler in_fatal_handler,
         return NULL;
     }
     
+    /* upgrade files created by earlier versions */
+    if ((!stack->readonly) && (!_stack_upgrade(stack)))
+    {
+        *out_status = STACK_INVALID;
+        stack_close(stack);
+        return NULL;
+    }
+    
+    /* read-only files from before version 3 have no word index */
+    stack->has_word_index = _sql_table_exists(stack->db, "widget_word");
+    
     /* set the fatal error handler */
     stack->fatal_handler = in_fatal_handler;
     stack->fatal_context = in_error_context;
@@ -415,12 +659,15 @@ void stack_reset_find(Stack *in_stack);
 void stack_close(Stack *in_stack)
 {
     /* database */
+    _stack_stmt_finalize_all(in_stack);
     if (in_stack->db) sqlite3_close_v2(in_stack->db);
     
     /* caches */
     if (in_stack->card_widget_table) idtable_destroy(in_stack->card_widget_table);
     if (in_stack->bkgnd_widget_table) idtable_destroy(in_stack->bkgnd_widget_table);
     if (in_stack->stack_card_table) idtable_destroy(in_stack->stack_card_table);
+    _stack_card_bkgnd_map_invalidate(in_stack);
+    _stack_search_cache_invalidate(in_stack);
     
     /* undo */
     _undo_stack_destroy(in_stack);
@@ -241,6 +241,10 @@ typedef struct Stack Stack;
 
 typedef void (*StackFatalErrorHandler) (Stack *in_stack, void *in_context, int in_error);
 
+/* invoked as each step of upgrading an older stack file is completed; in_step is zero before
+ the first step begins */
+typedef void (*StackUpgradeProgressHandler) (char const *in_path, int in_step, int in_step_count, void *in_context);
+
 
 
 
@@ -253,6 +257,7 @@ typedef void (*StackFatalErrorHandler) (Stack *in_stack, void *in_context, int i
 Stack* stack_create(char const *in_path, long in_card_width, long in_card_height, StackFatalErrorHandler in_fatal_handler, void *in_error_context);
 Stack* stack_open(char const *in_path, StackFatalErrorHandler in_fatal_handler, void *in_error_context, StackOpenStatus *out_status);
 void stack_set_fatal_error_handler(Stack *in_stack, StackFatalErrorHandler in_fatal_handler, void *in_context);
+void stack_set_upgrade_progress_handler(StackUpgradeProgressHandler in_handler, void *in_context);
 void stack_close(Stack *in_stack);
 int stack_file_is_locked(Stack *in_stack);
 int stack_is_writable(Stack *in_stack);
@@ -323,6 +328,15 @@ int stack_script_get(Stack *in_stack, int in_type, long in_id, char const **out_
 int stack_script_set(Stack *in_stack, int in_type, long in_id, char const *in_script,
                      int const in_checkpoints[], int in_checkpoint_count, long in_sel_offset);
 
+/*
+ *  stack_script_revision
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns a number which changes whenever any script within the stack is changed, or a scripted
+ *  object is deleted.  Suitable for determining if a compiled script is still current; the number
+ *  is never shared with another stack, even one since opened at the same address.
+ */
+long stack_script_revision(Stack *in_stack);
+
 
 
 /******************
@@ -478,6 +492,13 @@ int stack_find_result(Stack *in_stack, long *out_card_id, long *out_field_id, lo
 const char* stack_find_terms(Stack *in_stack);
 
 
+/******************
+ Statistics
+ */
+
+void stack_statement_report(Stack *in_stack);
+
+
 
 
 
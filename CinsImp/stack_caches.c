@@ -61,20 +61,12 @@ void _stack_widget_seq_cache_load(Stack *in_stack, long in_card_id, long in_bkgn
     assert( (in_card_id < 1) || (in_bkgnd_id < 1) );
     
     /* load the sequence table data from disk */
-    sqlite3_stmt *stmt;
-    if (in_card_id > 0)
-    {
-        sqlite3_prepare_v2(in_stack->db, "SELECT widgets FROM card WHERE cardid=?1", -1, &stmt, NULL);
-        sqlite3_bind_int(stmt, 1, (int)in_card_id);
-    }
-    else
-    {
-        sqlite3_prepare_v2(in_stack->db, "SELECT widgets FROM bkgnd WHERE bkgndid=?1", -1, &stmt, NULL);
-        sqlite3_bind_int(stmt, 1, (int)in_bkgnd_id);
-    }
+    enum StackStatement which = ((in_card_id > 0) ? STMT_CARD_WIDGETS : STMT_BKGND_WIDGETS);
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, which);
+    sqlite3_bind_int(stmt, 1, (int)((in_card_id > 0) ? in_card_id : in_bkgnd_id));
     if (sqlite3_step(stmt) != SQLITE_ROW)
     {
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, which, stmt);
         return _stack_file_error_void(in_stack);
     }
     
@@ -85,15 +77,15 @@ void _stack_widget_seq_cache_load(Stack *in_stack, long in_card_id, long in_bkgn
     {
         if (in_stack->card_widget_table) idtable_destroy(in_stack->card_widget_table);
         in_stack->cached_card_id = in_card_id;
-        new_table = in_stack->card_widget_table = idtable_create_with_ascii(in_stack, (char*)sqlite3_column_text(stmt, 0));
+        new_table = in_stack->card_widget_table = idtable_create_with_column(in_stack, stmt, 0);
     }
     else
     {
         if (in_stack->bkgnd_widget_table) idtable_destroy(in_stack->bkgnd_widget_table);
         in_stack->cached_bkgnd_id = in_bkgnd_id;
-        new_table = in_stack->bkgnd_widget_table = idtable_create_with_ascii(in_stack, (char*)sqlite3_column_text(stmt, 0));
+        new_table = in_stack->bkgnd_widget_table = idtable_create_with_column(in_stack, stmt, 0);
     }
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, which, stmt);
     if (!new_table) return _stack_file_error_void(in_stack);
 }
 
@@ -153,21 +145,13 @@ void _stack_widget_seq_set(Stack *in_stack, long in_card_id, long in_bkgnd_id, I
     assert( (in_card_id < 1) || (in_bkgnd_id < 1) );
     
     /* write the specified sequence table to disk */
-    sqlite3_stmt *stmt;
+    enum StackStatement which = ((in_card_id > 0) ? STMT_CARD_SET_WIDGETS : STMT_BKGND_SET_WIDGETS);
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, which);
     int err;
-    if (in_card_id > 0)
-    {
-        sqlite3_prepare_v2(in_stack->db, "UPDATE card SET widgets=?2 WHERE cardid=?1", -1, &stmt, NULL);
-        sqlite3_bind_int(stmt, 1, (int)in_card_id);
-    }
-    else
-    {
-        sqlite3_prepare_v2(in_stack->db, "UPDATE bkgnd SET widgets=?2 WHERE bkgndid=?1", -1, &stmt, NULL);
-        sqlite3_bind_int(stmt, 1, (int)in_bkgnd_id);
-    }
-    sqlite3_bind_text(stmt, 2, idtable_to_ascii(in_seq), -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 1, (int)((in_card_id > 0) ? in_card_id : in_bkgnd_id));
+    idtable_bind(in_seq, stmt, 2);
     err = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, which, stmt);
     if (err != SQLITE_DONE) return _stack_file_error_void(in_stack);
     
     /* reload the cache, if necessary */
@@ -179,4 +163,288 @@ void _stack_widget_seq_set(Stack *in_stack, long in_card_id, long in_bkgnd_id, I
 
 
 
+/**********
+ Card Backgrounds
+ */
+
+
+/*
+ *  _stack_card_bkgnd_map_invalidate
+ *  ---------------------------------------------------------------------------------------------
+ *  Purges the card to background map.
+ *
+ *  Should be called anytime cards are created or destroyed, so that the map is reloaded on next
+ *  access.
+ */
+
+void _stack_card_bkgnd_map_invalidate(Stack *in_stack)
+{
+    if (in_stack->card_bkgnd_map) _stack_free(in_stack->card_bkgnd_map);
+    in_stack->card_bkgnd_map = NULL;
+    in_stack->card_bkgnd_count = 0;
+}
+
+
+/*
+ *  _stack_card_bkgnd_map_get
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns the number of cards in the stack file and sets <out_map> to an array of the
+ *  (card ID, background ID) pairs for every card, ordered by card ID.  If the map isn't cached,
+ *  it is loaded from disk with a single query.
+ *
+ *  The map remains valid until cards are created or destroyed, or the stack is closed.
+ *  You must not free the map yourself!
+ *
+ *  Returns -1 and reports a stack IO error if the map couldn't be loaded.
+ */
+
+long _stack_card_bkgnd_map_get(Stack *in_stack, struct CardBkgnd const **out_map)
+{
+    assert(in_stack != NULL);
+    assert(out_map != NULL);
+    
+    /* check if the cache has the data */
+    if (in_stack->card_bkgnd_map)
+    {
+        *out_map = in_stack->card_bkgnd_map;
+        return in_stack->card_bkgnd_count;
+    }
+    *out_map = NULL;
+    
+    /* load the entire mapping from disk */
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(in_stack->db, "SELECT cardid,bkgndid FROM card ORDER BY cardid", -1, &stmt, NULL) != SQLITE_OK)
+    {
+        _stack_file_error_void(in_stack);
+        return -1;
+    }
+    long count = 0, allocated = 0;
+    struct CardBkgnd *map = NULL;
+    int err;
+    while ((err = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        if (count == allocated)
+        {
+            allocated = (allocated ? allocated * 2 : 64);
+            struct CardBkgnd *new_map = _stack_realloc(map, sizeof(struct CardBkgnd) * allocated);
+            if (!new_map)
+            {
+                sqlite3_finalize(stmt);
+                if (map) _stack_free(map);
+                _stack_panic_void(in_stack, STACK_ERR_MEMORY);
+                return -1;
+            }
+            map = new_map;
+        }
+        map[count].card_id = sqlite3_column_int(stmt, 0);
+        map[count].bkgnd_id = sqlite3_column_int(stmt, 1);
+        count++;
+    }
+    sqlite3_finalize(stmt);
+    if ((err != SQLITE_DONE) || (count == 0))
+    {
+        if (map) _stack_free(map);
+        _stack_file_error_void(in_stack);
+        return -1;
+    }
+    
+    /* cache the map */
+    in_stack->card_bkgnd_map = map;
+    in_stack->card_bkgnd_count = count;
+    *out_map = map;
+    return count;
+}
+
+
+/*
+ *  _stack_card_bkgnd_map_lookup
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns the background ID of the specified card from the card to background map, or
+ *  STACK_NO_OBJECT if the card isn't in the map.
+ */
+
+long _stack_card_bkgnd_map_lookup(Stack *in_stack, long in_card_id)
+{
+    struct CardBkgnd const *map;
+    long count = _stack_card_bkgnd_map_get(in_stack, &map);
+    
+    /* binary search on card ID */
+    long low = 0, high = count - 1;
+    while (low <= high)
+    {
+        long mid = low + (high - low) / 2;
+        if (map[mid].card_id == in_card_id) return map[mid].bkgnd_id;
+        if (map[mid].card_id < in_card_id) low = mid + 1;
+        else high = mid - 1;
+    }
+    return STACK_NO_OBJECT;
+}
+
+
+
+
+/**********
+ Searchability
+ */
+
+
+/*
+ *  _stack_search_cache_invalidate
+ *  ---------------------------------------------------------------------------------------------
+ *  Purges the cached Don't Search settings of cards, backgrounds and fields.
+ *
+ *  Should be called anytime widgets are created or destroyed, a widget's style changes, or the
+ *  Don't Search property of anything changes, so the settings are reloaded on next access.
+ */
+
+void _stack_search_cache_invalidate(Stack *in_stack)
+{
+    struct SearchCache *cache = &(in_stack->search_cache);
+    if (cache->bkgnds) _stack_free(cache->bkgnds);
+    if (cache->card_dontsearch) _stack_free(cache->card_dontsearch);
+    if (cache->field_searchable) _stack_free(cache->field_searchable);
+    cache->bkgnds = NULL;
+    cache->bkgnd_count = 0;
+    cache->card_dontsearch = NULL;
+    cache->card_bytes = 0;
+    cache->field_searchable = NULL;
+    cache->field_bytes = 0;
+}
+
+
+/* sets a bit of a bitset, growing the set as required;
+ returns STACK_NO if there isn't enough memory */
+static int _stack_search_bit_set(unsigned char **io_bits, long *io_bytes, long in_index)
+{
+    if (in_index < 0) return STACK_YES;
+    long byte = in_index / 8;
+    if (byte >= *io_bytes)
+    {
+        long new_bytes = (*io_bytes ? *io_bytes * 2 : 64);
+        if (new_bytes <= byte) new_bytes = byte + 1;
+        unsigned char *new_bits = _stack_realloc(*io_bits, new_bytes);
+        if (!new_bits) return STACK_NO;
+        memset(new_bits + *io_bytes, 0, new_bytes - *io_bytes);
+        *io_bits = new_bits;
+        *io_bytes = new_bytes;
+    }
+    (*io_bits)[byte] |= (1 << (in_index % 8));
+    return STACK_YES;
+}
+
+
+static int _stack_search_bit_test(unsigned char const *in_bits, long in_bytes, long in_index)
+{
+    if ((in_index < 0) || (in_index / 8 >= in_bytes)) return STACK_NO;
+    return ((in_bits[in_index / 8] & (1 << (in_index % 8))) != 0);
+}
+
+
+/*
+ *  _stack_search_cache_load
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns the cached settings for the specified background.  If the background hasn't yet been
+ *  loaded, the Don't Search settings of the background, all its cards and all the fields of
+ *  those cards and the background are loaded with a single query.
+ *
+ *  Returns NULL and reports a stack error if the settings couldn't be loaded.
+ */
+
+static struct SearchBkgnd* _stack_search_cache_load(Stack *in_stack, long in_bkgnd_id)
+{
+    struct SearchCache *cache = &(in_stack->search_cache);
+    
+    /* check if the cache has the background */
+    for (long i = 0; i < cache->bkgnd_count; i++)
+    {
+        if (cache->bkgnds[i].bkgnd_id == in_bkgnd_id) return cache->bkgnds + i;
+    }
+    
+    /* make room for the background */
+    struct SearchBkgnd *new_bkgnds = _stack_realloc(cache->bkgnds, sizeof(struct SearchBkgnd) * (cache->bkgnd_count + 1));
+    if (!new_bkgnds) return _stack_panic_null(in_stack, STACK_ERR_MEMORY);
+    cache->bkgnds = new_bkgnds;
+    struct SearchBkgnd *bkgnd = cache->bkgnds + cache->bkgnd_count;
+    bkgnd->bkgnd_id = in_bkgnd_id;
+    bkgnd->dontsearch = STACK_NO;
+    
+    /* load the settings of the background, its cards and their fields */
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_SEARCH_BKGND);
+    if (!stmt) return _stack_file_error_null(in_stack);
+    sqlite3_bind_int(stmt, 1, (int)in_bkgnd_id);
+    int err, ok = STACK_YES;
+    while (ok && ((err = sqlite3_step(stmt)) == SQLITE_ROW))
+    {
+        long object_id = sqlite3_column_int(stmt, 1);
+        int dontsearch = sqlite3_column_int(stmt, 2);
+        switch (sqlite3_column_int(stmt, 0))
+        {
+            case 0: /* background */
+                bkgnd->dontsearch = (dontsearch != 0);
+                break;
+            case 1: /* card */
+                if (dontsearch)
+                    ok = _stack_search_bit_set(&(cache->card_dontsearch), &(cache->card_bytes), object_id);
+                break;
+            case 2: /* field */
+                switch (sqlite3_column_int(stmt, 3))
+                {
+                    case WIDGET_BUTTON_PUSH:
+                    case WIDGET_BUTTON_TRANSPARENT:
+                        dontsearch = STACK_YES;
+                        break;
+                    default:
+                        break;
+                }
+                if (!dontsearch)
+                    ok = _stack_search_bit_set(&(cache->field_searchable), &(cache->field_bytes), object_id);
+                break;
+        }
+    }
+    _stack_stmt_end(in_stack, STMT_SEARCH_BKGND, stmt);
+    if (!ok)
+    {
+        _stack_search_cache_invalidate(in_stack);
+        return _stack_panic_null(in_stack, STACK_ERR_MEMORY);
+    }
+    if (err != SQLITE_DONE)
+    {
+        _stack_search_cache_invalidate(in_stack);
+        return _stack_file_error_null(in_stack);
+    }
+    
+    cache->bkgnd_count++;
+    return bkgnd;
+}
+
+
+/*
+ *  _stack_search_cache_card
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns STACK_YES if the specified card may be searched; ie. neither the card or its
+ *  background are Don't Search.
+ */
+
+int _stack_search_cache_card(Stack *in_stack, long in_card_id)
+{
+    struct SearchBkgnd *bkgnd = _stack_search_cache_load(in_stack, _cards_bkgnd(in_stack, in_card_id));
+    if (!bkgnd) return STACK_NO;
+    if (bkgnd->dontsearch) return STACK_NO;
+    return !_stack_search_bit_test(in_stack->search_cache.card_dontsearch, in_stack->search_cache.card_bytes, in_card_id);
+}
+
+
+/*
+ *  _stack_search_cache_field
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns STACK_YES if the specified field, on the specified card or its background, may be
+ *  searched; ie. it isn't Don't Search and isn't a push or transparent button.
+ */
+
+int _stack_search_cache_field(Stack *in_stack, long in_card_id, long in_field_id)
+{
+    if (!_stack_search_cache_load(in_stack, _cards_bkgnd(in_stack, in_card_id))) return STACK_NO;
+    return _stack_search_bit_test(in_stack->search_cache.field_searchable, in_stack->search_cache.field_bytes, in_field_id);
+}
+
 
@@ -112,7 +112,7 @@ void _stack_card_table_flush(Stack *in_stack)
     int err;
     err = sqlite3_prepare_v2(in_stack->db, "UPDATE stack SET cards=?1", -1, &stmt, NULL);
     assert(err == SQLITE_OK);
-    err = sqlite3_bind_text(stmt, 1, idtable_to_ascii(in_stack->stack_card_table), -1, SQLITE_STATIC);
+    err = idtable_bind(in_stack->stack_card_table, stmt, 1);
     assert(err == SQLITE_OK);
     err = sqlite3_step(stmt);
     assert(err == SQLITE_DONE);
@@ -144,7 +144,7 @@ void _stack_card_table_load(Stack *in_stack)
     err = sqlite3_prepare_v2(in_stack->db, "SELECT cards FROM stack", -1, &stmt, NULL);
     err = sqlite3_step(stmt);
     assert(err == SQLITE_ROW);
-    in_stack->stack_card_table = idtable_create_with_ascii(in_stack, (char*)sqlite3_column_text(stmt, 0));
+    in_stack->stack_card_table = idtable_create_with_column(in_stack, stmt, 0);
     sqlite3_finalize(stmt);
     assert(in_stack->stack_card_table != NULL);
 
@@ -176,6 +176,9 @@ void _stack_card_table_load(Stack *in_stack)
  *  Returns the background ID for the specified card.
  *
  *  Supplied card ID must be valid or this function may report a stack IO error.
+ *
+ *  Answered from the card to background map where possible; cards which aren't yet in the map
+ *  (created within the current transaction) are looked up individually.
  */
 
 long _cards_bkgnd(Stack *in_stack, long in_card_id)
@@ -183,17 +186,16 @@ long _cards_bkgnd(Stack *in_stack, long in_card_id)
     assert(in_stack != NULL);
     assert(in_card_id > 0);
     
-    long bkgnd_id;
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(in_stack->db,
-                       "SELECT bkgndid FROM card WHERE cardid=?1",
-                       -1, &stmt, NULL);
+    long bkgnd_id = _stack_card_bkgnd_map_lookup(in_stack, in_card_id);
+    if (bkgnd_id != STACK_NO_OBJECT) return bkgnd_id;
+    
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_CARD_BKGND);
     sqlite3_bind_int(stmt, 1, (int)in_card_id);
     if (sqlite3_step(stmt) == SQLITE_ROW)
         bkgnd_id = sqlite3_column_int(stmt, 0);
     else
         bkgnd_id = STACK_NO_OBJECT;
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, STMT_CARD_BKGND, stmt);
     
     if (bkgnd_id == STACK_NO_OBJECT)
         _stack_panic_void(in_stack, STACK_ERR_IO);
@@ -271,15 +273,17 @@ long _stack_card_create(Stack *in_stack, long in_bkgnd_id, long in_after_card_id
         idtable_insert(in_stack->stack_card_table, new_card_id, next_card_index);
     
     /* record the undo step */
-    /*SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    /*SerBuff *undo_data = serbuff_create_scratch(in_stack);
     if (undo_data)
     {
         serbuff_write_long(undo_data, new_card_id);
         _undo_record_step(in_stack, UNDO_CARD_CREATE, undo_data);
     }*/
     
-    /* invalidate the widget cache */
+    /* invalidate the widget cache, card to background map and search cache */
     _stack_widget_cache_invalidate(in_stack);
+    _stack_card_bkgnd_map_invalidate(in_stack);
+    _stack_search_cache_invalidate(in_stack);
     
     /* return the new card ID */
     *out_error = STACK_OK;
@@ -353,20 +357,14 @@ long stack_bkgnd_card_count(Stack *in_stack, long in_bkgnd_id)
     assert(in_bkgnd_id > 0);
     assert(in_stack->stack_card_table != NULL);
     
+    /* count the cards of the stack in the background */
     long count = 0;
-    sqlite3_stmt *stmt = NULL;
-    
-    /* query the list of cards in a particular background */
-    sqlite3_prepare_v2(in_stack->db, "SELECT cardid FROM card WHERE bkgndid=?1", -1, &stmt, NULL);
-    sqlite3_bind_int(stmt, 1, (int)in_bkgnd_id);
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    long stack_card_count = idtable_size(in_stack->stack_card_table);
+    for (long card_index = 0; card_index < stack_card_count; card_index++)
     {
-        int cardid = sqlite3_column_int(stmt, 0);
-        
-        /* check if the card exists */
-        if (idtable_index_for_id(in_stack->stack_card_table, cardid) >= 0) count++;
+        if (_stack_card_bkgnd_map_lookup(in_stack, idtable_id_for_index(in_stack->stack_card_table, card_index)) == in_bkgnd_id)
+            count++;
     }
-    sqlite3_finalize(stmt);
     
     assert(count > 0);
     return count;
@@ -561,7 +559,7 @@ long stack_card_delete(Stack *in_stack, long in_card_id)
     assert(bkgnd_id > 0);
     
     /* prepare the undo step */
-    //SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    //SerBuff *undo_data = serbuff_create_scratch(in_stack);
     //if (undo_data)
     //{
    //     void const *card_data;
@@ -601,6 +599,8 @@ long stack_card_delete(Stack *in_stack, long in_card_id)
     sqlite3_bind_int(stmt, 2, (int)in_card_id);
     err = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
+    if ((err == SQLITE_DONE) && (!_stack_find_index_delete_card(in_stack, in_card_id, bkgnd_id)))
+        err = SQLITE_ERROR;
     if (err != SQLITE_DONE)
     {
         //if (undo_data) serbuff_destroy(undo_data, 1);
@@ -652,6 +652,9 @@ long stack_card_delete(Stack *in_stack, long in_card_id)
         return in_card_id;
     }
     
+    /* card and widget scripts are gone */
+    _stack_script_changed(in_stack);
+    
     /* remove from stack's card table */
     assert(in_stack->stack_card_table != NULL);
     sequence = idtable_index_for_id(in_stack->stack_card_table, in_card_id);
@@ -662,8 +665,10 @@ long stack_card_delete(Stack *in_stack, long in_card_id)
     //if (undo_data)
     //    _undo_record_step(in_stack, UNDO_CARD_DELETE, undo_data);
     
-    /* invalidate the widget cache */
+    /* invalidate the widget cache, card to background map and search cache */
     _stack_widget_cache_invalidate(in_stack);
+    _stack_card_bkgnd_map_invalidate(in_stack);
+    _stack_search_cache_invalidate(in_stack);
     
     /* return the next card ID */
     long next_card_id = idtable_id_for_index(in_stack->stack_card_table, sequence);
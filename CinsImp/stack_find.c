@@ -19,47 +19,409 @@
 
 
 /********
- Startup
+ Word Index
+ */
+
+/*
+ The word index (table widget_word) records each distinct word of each widget's searchable
+ content, case folded and stripped of leading and trailing punctuation.  It's maintained whenever
+ content is written or deleted and allows find to skip cards which can't possibly match the
+ search, without reading their content.
+ 
+ The index only rules out cards; candidate cards are still searched as normal, so the results
+ (and the behaviour of find again) are unchanged.
  */
 
 
-static int _is_card_searchable(Stack *in_stack, long in_card_id)
+/* matching rule for a search term against the words of the index */
+enum FindTermMatch
 {
-    // be sure to check background settings too
-    int searchable = 1;
+    _FIND_TERM_EQUALS,
+    _FIND_TERM_BEGINS,
+    _FIND_TERM_CONTAINS,
+};
+
+
+/* splits text into words as they are recorded by the index (see notes above);
+ words that consist entirely of punctuation are returned as empty strings */
+static void _find_index_words(char const *in_text, char **out_words[], int *out_count)
+{
+    *out_words = NULL;
+    *out_count = 0;
+    
+    long bytes = xte_cstring_fold(in_text, NULL, 0);
+    char *folded = _stack_malloc(bytes + 1);
+    if (!folded) return app_out_of_memory_void();
+    xte_cstring_fold(in_text, folded, bytes + 1);
+    
+    _stack_wordize(folded, out_words, NULL, out_count);
+    _stack_free(folded);
+    
+    for (int i = 0; i < *out_count; i++)
+        _stack_word_strip_prepost_punct((*out_words)[i], NULL, NULL);
+}
+
+
+/*
+ *  _stack_find_index_content
+ *  ---------------------------------------------------------------------------------------------
+ *  Replaces the words recorded in the index for a single widget's content.  The card and
+ *  background IDs are those of the content owner, as per _stack_widget_content_owner().
+ *
+ *  Should be called within a transaction, along with the change to the content itself.
+ *
+ *  Returns STACK_NO if the index couldn't be updated.
+ */
+
+int _stack_find_index_content(Stack *in_stack, long in_widget_id, long in_card_id, long in_bkgnd_id,
+                              char const *in_searchable)
+{
+    assert(in_stack != NULL);
+    assert(in_widget_id > 0);
+    
+    if (!in_stack->has_word_index) return STACK_YES;
+    in_stack->word_index_revision++;
+    
+    /* remove the existing words */
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_WORD_DELETE);
+    if (!stmt) return STACK_NO;
+    sqlite3_bind_int(stmt, 1, (int)in_widget_id);
+    sqlite3_bind_int(stmt, 2, (int)in_card_id);
+    sqlite3_bind_int(stmt, 3, (int)in_bkgnd_id);
+    int err = sqlite3_step(stmt);
+    _stack_stmt_end(in_stack, STMT_WORD_DELETE, stmt);
+    if (err != SQLITE_DONE) return STACK_NO;
+    
+    /* add the new words; duplicates are ignored */
+    char **words;
+    int word_count;
+    _find_index_words((in_searchable ? in_searchable : ""), &words, &word_count);
+    stmt = _stack_stmt_begin(in_stack, STMT_WORD_INSERT);
+    if (!stmt) err = SQLITE_ERROR;
+    for (int i = 0; (i < word_count) && (err == SQLITE_DONE); i++)
+    {
+        if (!words[i][0]) continue;
+        sqlite3_bind_text(stmt, 1, words[i], -1, SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 2, (int)in_widget_id);
+        sqlite3_bind_int(stmt, 3, (int)in_card_id);
+        sqlite3_bind_int(stmt, 4, (int)in_bkgnd_id);
+        err = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+    }
+    _stack_stmt_end(in_stack, STMT_WORD_INSERT, stmt);
+    _stack_items_free(words, word_count);
+    
+    return (err == SQLITE_DONE);
+}
+
+
+/*
+ *  _stack_find_index_delete_card
+ *  ---------------------------------------------------------------------------------------------
+ *  Removes the words of all content belonging to a card from the index; both content of the
+ *  card's own widgets and its content of unshared background fields.  Must be called before the
+ *  card's widgets are deleted.
+ *
+ *  Returns STACK_NO if the index couldn't be updated.
+ */
+
+int _stack_find_index_delete_card(Stack *in_stack, long in_card_id, long in_bkgnd_id)
+{
+    assert(in_stack != NULL);
+    
+    if (!in_stack->has_word_index) return STACK_YES;
+    in_stack->word_index_revision++;
+    
     sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(in_stack->db, "SELECT card.dontsearch, bkgnd.dontsearch "
-                       "FROM card JOIN bkgnd ON card.bkgndid=bkgnd.bkgndid WHERE card.cardid=?1", -1,
-                       &stmt, NULL);
+    int err = sqlite3_prepare_v2(in_stack->db, "DELETE FROM widget_word WHERE cardid=?1 AND widgetid IN "
+                                 "(SELECT widgetid FROM widget WHERE cardid=?1 OR bkgndid=?2)", -1, &stmt, NULL);
+    if (err != SQLITE_OK) return STACK_NO;
     sqlite3_bind_int(stmt, 1, (int)in_card_id);
-    sqlite3_step(stmt);
-    if (sqlite3_column_int(stmt, 0) || sqlite3_column_int(stmt, 1))
-        searchable = 0;
+    sqlite3_bind_int(stmt, 2, (int)in_bkgnd_id);
+    err = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
-    return searchable;
+    return (err == SQLITE_DONE);
 }
 
 
-static int _is_field_searchable(Stack *in_stack, long in_field_id)
+/*
+ *  _stack_find_index_delete_widget
+ *  ---------------------------------------------------------------------------------------------
+ *  Removes the words of all content of a widget from the index.
+ *
+ *  Returns STACK_NO if the index couldn't be updated.
+ */
+
+int _stack_find_index_delete_widget(Stack *in_stack, long in_widget_id)
 {
-    int searchable = 1;
+    assert(in_stack != NULL);
+    
+    if (!in_stack->has_word_index) return STACK_YES;
+    in_stack->word_index_revision++;
+    
     sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(in_stack->db, "SELECT dontsearch,type FROM widget WHERE widgetid=?1", -1,
-                       &stmt, NULL);
-    sqlite3_bind_int(stmt, 1, (int)in_field_id);
-    sqlite3_step(stmt);
-    if (sqlite3_column_int(stmt, 0)) searchable = 0;
-    switch (sqlite3_column_int(stmt, 1))
-    {
-        case WIDGET_BUTTON_PUSH:
-        case WIDGET_BUTTON_TRANSPARENT:
-            searchable = 0;
+    int err = sqlite3_prepare_v2(in_stack->db, "DELETE FROM widget_word WHERE widgetid=?1", -1, &stmt, NULL);
+    if (err != SQLITE_OK) return STACK_NO;
+    sqlite3_bind_int(stmt, 1, (int)in_widget_id);
+    err = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    return (err == SQLITE_DONE);
+}
+
+
+/* appends an ID to a growable list; returns STACK_NO if there isn't enough memory */
+static int _find_id_list_add(long **io_list, long *io_count, long *io_alloc, long in_id)
+{
+    if (*io_count == *io_alloc)
+    {
+        long new_alloc = (*io_alloc ? *io_alloc * 2 : 64);
+        long *new_list = _stack_realloc(*io_list, sizeof(long) * new_alloc);
+        if (!new_list) return STACK_NO;
+        *io_list = new_list;
+        *io_alloc = new_alloc;
+    }
+    (*io_list)[(*io_count)++] = in_id;
+    return STACK_YES;
+}
+
+
+static int _find_compare_ids(long const *in_id1, long const *in_id2)
+{
+    if (*in_id1 < *in_id2) return -1;
+    if (*in_id1 > *in_id2) return 1;
+    return 0;
+}
+
+
+static int _find_id_list_contains(long const *in_list, long in_count, long in_id)
+{
+    long low = 0, high = in_count - 1;
+    while (low <= high)
+    {
+        long mid = (low + high) / 2;
+        if (in_list[mid] == in_id) return STACK_YES;
+        if (in_list[mid] < in_id) low = mid + 1;
+        else high = mid - 1;
+    }
+    return STACK_NO;
+}
+
+
+/* returns the longest part of a folded search string which can't span a word boundary,
+ ie. which contains neither whitespace nor punctuation (for substring searches) */
+static char* _find_longest_run(char const *in_folded)
+{
+    char const *best = in_folded, *run = in_folded;
+    long best_bytes = 0;
+    for (char const *ptr = in_folded;; ptr++)
+    {
+        char c = *ptr;
+        if ((!c) || isspace(c) || ((c < 0x80) && ispunct(c)))
+        {
+            if (ptr - run > best_bytes)
+            {
+                best = run;
+                best_bytes = ptr - run;
+            }
+            if (!c) break;
+            run = ptr + 1;
+        }
+    }
+    char *result = _stack_malloc(best_bytes + 1);
+    if (!result) return app_out_of_memory_null();
+    memcpy(result, best, best_bytes);
+    result[best_bytes] = 0;
+    return result;
+}
+
+
+/* adds the cards and backgrounds with content matching a search term to a candidate list;
+ returns STACK_NO if there isn't enough memory or the index couldn't be read */
+static int _find_candidates_add(Stack *in_stack, struct FindCandidates *io_candidates, long *io_card_alloc,
+                                long *io_bkgnd_alloc, char const *in_term, enum FindTermMatch in_match)
+{
+    sqlite3_stmt *stmt;
+    int err;
+    
+    if (in_match == _FIND_TERM_CONTAINS)
+    {
+        /* find the words which contain the term and add each in turn */
+        err = sqlite3_prepare_v2(in_stack->db, "SELECT DISTINCT word FROM widget_word", -1, &stmt, NULL);
+        if (err != SQLITE_OK) return STACK_NO;
+        int ok = STACK_YES;
+        while (ok && (sqlite3_step(stmt) == SQLITE_ROW))
+        {
+            char const *word = (char const*)sqlite3_column_text(stmt, 0);
+            if (word && strstr(word, in_term))
+                ok = _find_candidates_add(in_stack, io_candidates, io_card_alloc, io_bkgnd_alloc, word, _FIND_TERM_EQUALS);
+        }
+        sqlite3_finalize(stmt);
+        return ok;
+    }
+    
+    if (in_match == _FIND_TERM_BEGINS)
+    {
+        /* words within the range [term, term + 0xF8); no UTF-8 sequence includes 0xF8 */
+        err = sqlite3_prepare_v2(in_stack->db, "SELECT cardid,bkgndid FROM widget_word "
+                                 "WHERE word>=?1 AND word<?1||?3 AND (?2<1 OR widgetid=?2)", -1, &stmt, NULL);
+        if (err == SQLITE_OK) sqlite3_bind_text(stmt, 3, "\xF8", -1, SQLITE_STATIC);
+    }
+    else
+        err = sqlite3_prepare_v2(in_stack->db, "SELECT cardid,bkgndid FROM widget_word "
+                                 "WHERE word=?1 AND (?2<1 OR widgetid=?2)", -1, &stmt, NULL);
+    if (err != SQLITE_OK) return STACK_NO;
+    sqlite3_bind_text(stmt, 1, in_term, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 2, (int)in_stack->find_field_id);
+    
+    int ok = STACK_YES;
+    while (ok && (sqlite3_step(stmt) == SQLITE_ROW))
+    {
+        long card_id = sqlite3_column_int(stmt, 0);
+        long bkgnd_id = sqlite3_column_int(stmt, 1);
+        if (bkgnd_id > 0)
+            ok = _find_id_list_add(&(io_candidates->bkgnd_ids), &(io_candidates->bkgnd_count), io_bkgnd_alloc, bkgnd_id);
+        else if (card_id > 0)
+            ok = _find_id_list_add(&(io_candidates->card_ids), &(io_candidates->card_count), io_card_alloc, card_id);
+    }
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+
+static void _find_candidates_free(Stack *in_stack)
+{
+    for (int i = 0; i < in_stack->find_candidate_count; i++)
+    {
+        if (in_stack->find_candidates[i].card_ids) _stack_free(in_stack->find_candidates[i].card_ids);
+        if (in_stack->find_candidates[i].bkgnd_ids) _stack_free(in_stack->find_candidates[i].bkgnd_ids);
+    }
+    if (in_stack->find_candidates) _stack_free(in_stack->find_candidates);
+    in_stack->find_candidates = NULL;
+    in_stack->find_candidate_count = 0;
+}
+
+
+/* looks up the candidate cards for each term of the current search in the word index;
+ if there is no index, or it can't be read, there are no candidate lists and every card is
+ searched */
+static void _find_candidates_build(Stack *in_stack)
+{
+    _find_candidates_free(in_stack);
+    in_stack->find_candidates_revision = in_stack->word_index_revision;
+    if ((!in_stack->has_word_index) || (!in_stack->find_search)) return;
+    
+    /* determine the terms which must each be present in a matching card, per the find mode */
+    char **terms = NULL;
+    int term_count = 0;
+    enum FindTermMatch match;
+    switch (in_stack->find_mode)
+    {
+        case FIND_WHOLE_WORDS:
+        case FIND_WORD_PHRASE:
+            match = _FIND_TERM_EQUALS;
+            _find_index_words(in_stack->find_search, &terms, &term_count);
             break;
-        default:
+        case FIND_WORDS_BEGINNING:
+            match = _FIND_TERM_BEGINS;
+            _find_index_words(in_stack->find_search, &terms, &term_count);
             break;
+        case FIND_WORDS_CONTAINING:
+        case FIND_CHAR_PHRASE:
+        {
+            /* search words (or the whole search string) may contain punctuation, which the index
+             doesn't necessarily record; so look for the longest part which can't include any */
+            match = _FIND_TERM_CONTAINS;
+            long bytes = xte_cstring_fold(in_stack->find_search, NULL, 0);
+            char *folded = _stack_malloc(bytes + 1);
+            if (!folded) return app_out_of_memory_void();
+            xte_cstring_fold(in_stack->find_search, folded, bytes + 1);
+            if (in_stack->find_mode == FIND_WORDS_CONTAINING)
+                _stack_wordize(folded, &terms, NULL, &term_count);
+            else if ((terms = _stack_malloc(sizeof(char*))))
+            {
+                terms[0] = _stack_clone_cstr(folded);
+                term_count = 1;
+            }
+            _stack_free(folded);
+            for (int i = 0; i < term_count; i++)
+            {
+                char *run = (terms[i] ? _find_longest_run(terms[i]) : NULL);
+                if (terms[i]) _stack_free(terms[i]);
+                terms[i] = run;
+            }
+            break;
+        }
+        default:
+            return;
     }
-    sqlite3_finalize(stmt);
-    return searchable;
+    
+    /* lookup the candidates for each term;
+     terms without any words to lookup (eg. punctuation) don't rule out any cards */
+    in_stack->find_candidates = _stack_calloc(term_count + 1, sizeof(struct FindCandidates));
+    if (!in_stack->find_candidates)
+    {
+        _stack_items_free(terms, term_count);
+        return app_out_of_memory_void();
+    }
+    int ok = STACK_YES;
+    for (int i = 0; (i < term_count) && ok; i++)
+    {
+        if ((!terms[i]) || (!terms[i][0])) continue;
+        struct FindCandidates *candidates = in_stack->find_candidates + in_stack->find_candidate_count++;
+        long card_alloc = 0, bkgnd_alloc = 0;
+        ok = _find_candidates_add(in_stack, candidates, &card_alloc, &bkgnd_alloc, terms[i], match);
+        if (candidates->card_count > 1)
+            qsort(candidates->card_ids, candidates->card_count, sizeof(long),
+                  (int (*)(void const*, void const*))&_find_compare_ids);
+        if (candidates->bkgnd_count > 1)
+            qsort(candidates->bkgnd_ids, candidates->bkgnd_count, sizeof(long),
+                  (int (*)(void const*, void const*))&_find_compare_ids);
+    }
+    _stack_items_free(terms, term_count);
+    
+    /* if the index couldn't be read, search every card */
+    if (!ok) _find_candidates_free(in_stack);
+}
+
+
+/* can the card possibly match the current search, according to the word index? */
+static int _find_card_is_candidate(Stack *in_stack, long in_card_id)
+{
+    if (in_stack->find_candidates_revision != in_stack->word_index_revision)
+        _find_candidates_build(in_stack);
+    
+    long bkgnd_id = STACK_NO_OBJECT;
+    for (int i = 0; i < in_stack->find_candidate_count; i++)
+    {
+        struct FindCandidates *candidates = in_stack->find_candidates + i;
+        if (_find_id_list_contains(candidates->card_ids, candidates->card_count, in_card_id)) continue;
+        if (candidates->bkgnd_count > 0)
+        {
+            if (bkgnd_id == STACK_NO_OBJECT) bkgnd_id = _cards_bkgnd(in_stack, in_card_id);
+            if (_find_id_list_contains(candidates->bkgnd_ids, candidates->bkgnd_count, bkgnd_id)) continue;
+        }
+        return STACK_NO;
+    }
+    return STACK_YES;
+}
+
+
+
+/********
+ Startup
+ */
+
+
+static int _is_card_searchable(Stack *in_stack, long in_card_id)
+{
+    // be sure to check background settings too
+    return _stack_search_cache_card(in_stack, in_card_id);
+}
+
+
+static int _is_field_searchable(Stack *in_stack, long in_card_id, long in_field_id)
+{
+    return _stack_search_cache_field(in_stack, in_card_id, in_field_id);
 }
 
 
@@ -70,7 +432,7 @@ static void _get_searchable_fields(Stack *in_stack, long in_card_id, long in_fie
     // if field_id is set, we check only that field and return a list of 1
     if (in_field_id != 0)
     {
-        if (_is_field_searchable(in_stack, in_field_id))
+        if (_is_field_searchable(in_stack, in_card_id, in_field_id))
         {
             *out_fields = _stack_malloc(sizeof(long));
             if (!*out_fields) return app_out_of_memory_void();
@@ -95,7 +457,7 @@ static void _get_searchable_fields(Stack *in_stack, long in_card_id, long in_fie
     for (int i = 0; i < idtable_size(bkgnd_table); i++)
     {
         long field_id = idtable_id_for_index(bkgnd_table, i);
-        if (_is_field_searchable(in_stack, field_id))
+        if (_is_field_searchable(in_stack, in_card_id, field_id))
             (*out_fields)[(*out_count)++] = field_id;
     }
     
@@ -103,17 +465,83 @@ static void _get_searchable_fields(Stack *in_stack, long in_card_id, long in_fie
     for (int i = 0; i < idtable_size(card_table); i++)
     {
         long field_id = idtable_id_for_index(card_table, i);
-        if (_is_field_searchable(in_stack, field_id))
+        if (_is_field_searchable(in_stack, in_card_id, field_id))
             (*out_fields)[(*out_count)++] = field_id;
     }
 }
 
 
+static void _find_content_free(Stack *in_stack)
+{
+    _stack_items_free(in_stack->find_content_text, (int)in_stack->find_content_count);
+    if (in_stack->find_content_field_ids) _stack_free(in_stack->find_content_field_ids);
+    in_stack->find_content_text = NULL;
+    in_stack->find_content_field_ids = NULL;
+    in_stack->find_content_count = 0;
+    in_stack->find_content_card_id = STACK_NO_OBJECT;
+}
+
+
+/* reads the content of all the fields of a card, and its background, with a single query;
+ returns STACK_NO if there isn't enough memory or the content couldn't be read */
+static int _find_content_load(Stack *in_stack, long in_card_id)
+{
+    _find_content_free(in_stack);
+    
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_CARD_CONTENT);
+    if (!stmt) return STACK_NO;
+    sqlite3_bind_int(stmt, 1, (int)in_card_id);
+    sqlite3_bind_int(stmt, 2, (int)_cards_bkgnd(in_stack, in_card_id));
+    sqlite3_bind_int(stmt, 3, STACK_NO_OBJECT);
+    long allocated = 0;
+    int err;
+    while ((err = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        if (in_stack->find_content_count == allocated)
+        {
+            allocated = (allocated ? allocated * 2 : 16);
+            long *new_ids = _stack_realloc(in_stack->find_content_field_ids, sizeof(long) * allocated);
+            if (new_ids) in_stack->find_content_field_ids = new_ids;
+            char **new_text = _stack_realloc(in_stack->find_content_text, sizeof(char*) * allocated);
+            if (new_text) in_stack->find_content_text = new_text;
+            if ((!new_ids) || (!new_text)) break;
+        }
+        char *text = _stack_clone_cstr((char const*)sqlite3_column_text(stmt, 1));
+        if (!text) break;
+        in_stack->find_content_field_ids[in_stack->find_content_count] = sqlite3_column_int(stmt, 0);
+        in_stack->find_content_text[in_stack->find_content_count++] = text;
+    }
+    _stack_stmt_end(in_stack, STMT_CARD_CONTENT, stmt);
+    if (err != SQLITE_DONE)
+    {
+        _find_content_free(in_stack);
+        return STACK_NO;
+    }
+    
+    in_stack->find_content_card_id = in_card_id;
+    return STACK_YES;
+}
+
+
 static char* _field_content(Stack *in_stack, long in_field_id, long in_card_id)
 {
-    char *searchable;
-    stack_widget_content_get(in_stack, in_field_id, in_card_id, 0, &searchable, NULL, NULL, NULL);
-    return _stack_clone_cstr(searchable);
+    // content of all the card's fields is read at once, the first time any is required
+    if (in_stack->find_content_card_id != in_card_id)
+    {
+        if (!_find_content_load(in_stack, in_card_id))
+        {
+            char *searchable;
+            stack_widget_content_get(in_stack, in_field_id, in_card_id, 0, &searchable, NULL, NULL, NULL);
+            return _stack_clone_cstr(searchable);
+        }
+    }
+    
+    for (long i = 0; i < in_stack->find_content_count; i++)
+    {
+        if (in_stack->find_content_field_ids[i] == in_field_id)
+            return _stack_clone_cstr(in_stack->find_content_text[i]);
+    }
+    return _stack_clone_cstr("");
 }
 
 
@@ -131,15 +559,28 @@ static void _find_get_next_card(Stack *in_stack)
         return;
     }
     
-    // get next card in sequence (in_stack->find_state_card_id)
+    // get next card in sequence (in_stack->find_state_card_id);
+    // skipping cards which the word index shows can't match, other than the card the find began on
     IDTable *table = NULL;
     if (!in_stack->find_marked)
         table = in_stack->stack_card_table;
     else
         ; // marked cards will be implemented in a future version
-    long seq = idtable_index_for_id(table, in_stack->find_state_card_id) + 1;
-    if (seq >= idtable_size(table)) seq = 0;
+    long card_count = idtable_size(table);
+    long seq = idtable_index_for_id(table, in_stack->find_state_card_id);
+    long skipped;
+    for (skipped = 0; skipped < card_count; skipped++)
+    {
+        if (++seq >= card_count) seq = 0;
     in_stack->find_state_card_id = idtable_id_for_index(table, seq);
+        if ((in_stack->find_state_card_id == in_stack->find_card_id) ||
+            _find_card_is_candidate(in_stack, in_stack->find_state_card_id)) break;
+    }
+    if (skipped == card_count)
+    {
+        in_stack->find_state = _FIND_FINISH;
+        return;
+    }
     
     // check for end
     if (in_stack->find_state_card_id == in_stack->find_card_id)
@@ -180,8 +621,11 @@ static void _find_card_setup(Stack *in_stack)
     in_stack->find_state_field_count = 0;
     if (in_stack->find_state_fields)
         _stack_free(in_stack->find_state_fields);
+    in_stack->find_state_fields = NULL;
     
-    // get list of fields for card (in_stack->find_state_card_id)
+    // get list of fields for card (in_stack->find_state_card_id);
+    // unless the word index shows the card can't match
+    if (_find_card_is_candidate(in_stack, in_stack->find_state_card_id))
     _get_searchable_fields(in_stack, in_stack->find_state_card_id, in_stack->find_field_id,
                            &(in_stack->find_state_fields), &(in_stack->find_state_field_count));
     in_stack->find_state_field_index = 0;
@@ -835,6 +1279,9 @@ int stack_find_step(Stack *in_stack)
 
 void stack_find(Stack *in_stack, long in_card_id, enum FindMode in_mode, char *in_search, long in_field_id, int in_marked)
 {
+    // field content may have changed since the last find
+    _find_content_free(in_stack);
+    
     if ((in_stack->find_mode != in_mode) ||
         (!in_stack->find_search) || 
         (in_stack->find_search && (strcmp(in_stack->find_search, in_search) != 0)) ||
@@ -932,6 +1379,9 @@ void stack_reset_find(Stack *in_stack)
     in_stack->find_words = NULL;
     _stack_items_free(in_stack->find_state_field_words, in_stack->find_state_field_word_count);
     in_stack->find_state_field_words = NULL;
+    _find_content_free(in_stack);
+    _find_candidates_free(in_stack);
+    in_stack->find_candidates_revision = -1;
     in_stack->matches_this_search = 0;
 
     /*in_stack->found_card_id = 0;
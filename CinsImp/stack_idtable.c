@@ -30,6 +30,44 @@
  the ID table */
 #define IDTABLE_ASCII_CHARS 10
 
+/* the binary representation of the ID table is a 4-byte header, comprising a 3-byte signature
+ and a 1-byte version, followed by each ID as a packed little-endian 32-bit number */
+#define IDTABLE_BINARY_SIGNATURE "IDT"
+#define IDTABLE_BINARY_VERSION 1
+#define IDTABLE_BINARY_HEADER 4
+
+/* tables with at least this many IDs are indexed the first time an ID is looked up */
+#define IDTABLE_INDEX_THRESHOLD 64
+
+/* the number of consecutive IDs in each chunk of the index when it's built;
+ a chunk may grow to twice this size before the index is discarded and rebuilt */
+#define IDTABLE_INDEX_CHUNK 32
+
+#define IDTABLE_INDEX_NO_ID 0
+
+
+
+/* the index maps an ID to the chunk of the table in which it's found;
+ the chunks partition the table into runs of consecutive IDs, and a Fenwick tree of the
+ chunk lengths gives the position of any chunk in O(log n), even after IDs have been
+ inserted or removed in the middle of the table */
+
+struct IDTableIndexEntry
+{
+    unsigned int id;
+    unsigned int chunk;
+};
+
+struct IDTableIndex
+{
+    long chunk_count;
+    long *chunk_lengths;
+    long *chunk_tree;
+    
+    long hash_size;
+    long hash_count;
+    struct IDTableIndexEntry *hash;
+};
 
 
 struct IDTable
@@ -39,10 +77,177 @@ struct IDTable
     unsigned int *ids; /* 32-bit number, 4 billion ids */
     Stack *stack;
     char *ascii;
+    unsigned char *binary;
+    struct IDTableIndex *index; /* optional; NULL if not built */
 };
 
 
 
+/*********
+ Index
+ */
+
+static void _idtable_index_destroy(IDTable *in_table)
+{
+    struct IDTableIndex *index = in_table->index;
+    if (!index) return;
+    if (index->chunk_lengths) _stack_free(index->chunk_lengths);
+    if (index->chunk_tree) _stack_free(index->chunk_tree);
+    if (index->hash) _stack_free(index->hash);
+    _stack_free(index);
+    in_table->index = NULL;
+}
+
+
+/* adds <in_delta> to the length of the specified chunk */
+static void _idtable_index_chunk_adjust(struct IDTableIndex *in_index, long in_chunk, long in_delta)
+{
+    in_index->chunk_lengths[in_chunk] += in_delta;
+    for (long i = in_chunk + 1; i <= in_index->chunk_count; i += (i & -i))
+        in_index->chunk_tree[i] += in_delta;
+}
+
+
+/* returns the position within the table of the first ID of the specified chunk */
+static long _idtable_index_chunk_start(struct IDTableIndex *in_index, long in_chunk)
+{
+    long start = 0;
+    for (long i = in_chunk; i > 0; i -= (i & -i))
+        start += in_index->chunk_tree[i];
+    return start;
+}
+
+
+/* returns the chunk containing the specified position within the table;
+ positions beyond the end of the table belong to the last chunk */
+static long _idtable_index_chunk_for(struct IDTableIndex *in_index, long in_position)
+{
+    long chunk = 0, step = 1;
+    while (step * 2 <= in_index->chunk_count) step *= 2;
+    for (; step > 0; step /= 2)
+    {
+        if ((chunk + step <= in_index->chunk_count) && (in_index->chunk_tree[chunk + step] <= in_position))
+        {
+            chunk += step;
+            in_position -= in_index->chunk_tree[chunk];
+        }
+    }
+    if (chunk >= in_index->chunk_count) chunk = in_index->chunk_count - 1;
+    return chunk;
+}
+
+
+/* returns the hash slot for the specified ID;
+ either the slot containing the ID, or the empty slot where it should be inserted */
+static long _idtable_index_slot(struct IDTableIndex *in_index, unsigned int in_id)
+{
+    long mask = in_index->hash_size - 1;
+    long slot = (in_id * 2654435761u) & mask;
+    while ((in_index->hash[slot].id != IDTABLE_INDEX_NO_ID) && (in_index->hash[slot].id != in_id))
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+
+/* records the chunk of an ID;
+ returns STACK_NO if the ID is already in the index, or the hash table is too full */
+static int _idtable_index_add(struct IDTableIndex *in_index, unsigned int in_id, long in_chunk)
+{
+    if ((in_id == IDTABLE_INDEX_NO_ID) || ((in_index->hash_count + 1) * 2 > in_index->hash_size)) return STACK_NO;
+    long slot = _idtable_index_slot(in_index, in_id);
+    if (in_index->hash[slot].id != IDTABLE_INDEX_NO_ID) return STACK_NO;
+    in_index->hash[slot].id = in_id;
+    in_index->hash[slot].chunk = (unsigned int)in_chunk;
+    in_index->hash_count++;
+    return STACK_YES;
+}
+
+
+/* removes an ID from the index;
+ subsequent entries in the same probe sequence are shifted back to fill the hole */
+static void _idtable_index_remove(struct IDTableIndex *in_index, unsigned int in_id)
+{
+    long mask = in_index->hash_size - 1;
+    long hole = _idtable_index_slot(in_index, in_id);
+    if (in_index->hash[hole].id == IDTABLE_INDEX_NO_ID) return;
+    in_index->hash_count--;
+    for (long slot = (hole + 1) & mask; in_index->hash[slot].id != IDTABLE_INDEX_NO_ID; slot = (slot + 1) & mask)
+    {
+        long home = (in_index->hash[slot].id * 2654435761u) & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            in_index->hash[hole] = in_index->hash[slot];
+            hole = slot;
+        }
+    }
+    in_index->hash[hole].id = IDTABLE_INDEX_NO_ID;
+}
+
+
+/* builds the index for the table;
+ if there isn't enough memory, or the table contains duplicate IDs, the table is left
+ without an index and lookups fall back to a linear search */
+static void _idtable_index_build(IDTable *in_table)
+{
+    _idtable_index_destroy(in_table);
+    
+    struct IDTableIndex *index = _stack_calloc(1, sizeof(struct IDTableIndex));
+    if (!index) return;
+    in_table->index = index;
+    
+    index->chunk_count = (in_table->count + IDTABLE_INDEX_CHUNK - 1) / IDTABLE_INDEX_CHUNK;
+    if (index->chunk_count < 1) index->chunk_count = 1;
+    index->hash_size = 16;
+    while (index->hash_size < in_table->count * 4) index->hash_size *= 2;
+    
+    index->chunk_lengths = _stack_calloc(index->chunk_count, sizeof(long));
+    index->chunk_tree = _stack_calloc(index->chunk_count + 1, sizeof(long));
+    index->hash = _stack_calloc(index->hash_size, sizeof(struct IDTableIndexEntry));
+    if ((!index->chunk_lengths) || (!index->chunk_tree) || (!index->hash))
+        return _idtable_index_destroy(in_table);
+    
+    for (long i = 0; i < in_table->count; i++)
+    {
+        long chunk = i / IDTABLE_INDEX_CHUNK;
+        if (!_idtable_index_add(index, in_table->ids[i], chunk))
+            return _idtable_index_destroy(in_table);
+        _idtable_index_chunk_adjust(index, chunk, 1);
+    }
+}
+
+
+/* updates the index following the insertion of an ID at the specified position */
+static void _idtable_index_inserted(IDTable *in_table, long in_position)
+{
+    struct IDTableIndex *index = in_table->index;
+    long chunk = _idtable_index_chunk_for(index, in_position);
+    if ((index->chunk_lengths[chunk] >= IDTABLE_INDEX_CHUNK * 2) ||
+        (!_idtable_index_add(index, in_table->ids[in_position], chunk)))
+    {
+        /* rebuilt on next lookup */
+        _idtable_index_destroy(in_table);
+        return;
+    }
+    _idtable_index_chunk_adjust(index, chunk, 1);
+}
+
+
+/* updates the index prior to the removal of the ID at the specified position */
+static void _idtable_index_removing(IDTable *in_table, long in_position)
+{
+    struct IDTableIndex *index = in_table->index;
+    _idtable_index_remove(index, in_table->ids[in_position]);
+    _idtable_index_chunk_adjust(index, _idtable_index_chunk_for(index, in_position), -1);
+}
+
+
+
+/*********
+ ID Table
+ */
+
+
+
 IDTable* idtable_create(Stack *in_stack)
 {
     assert(IS_STACK(in_stack));
@@ -55,13 +260,17 @@ IDTable* idtable_create(Stack *in_stack)
     table->ids = NULL;
     table->stack = in_stack;
     table->ascii = NULL;
+    table->binary = NULL;
+    table->index = NULL;
     return table;
 }
 
 
 void idtable_destroy(IDTable *in_table)
 {
+    _idtable_index_destroy(in_table);
     if (in_table->ascii) _stack_free(in_table->ascii);
+    if (in_table->binary) _stack_free(in_table->binary);
     if (in_table->ids) _stack_free(in_table->ids);
     _stack_free(in_table);
 }
@@ -90,6 +299,9 @@ void idtable_insert(IDTable *in_table, long in_id, long in_at_index)
     /* insert the new item */
     in_table->ids[in_at_index] = (int)in_id;
     in_table->count++;
+    
+    /* keep the index in sync */
+    if (in_table->index) _idtable_index_inserted(in_table, in_at_index);
 }
 
 
@@ -104,6 +316,9 @@ void idtable_remove(IDTable *in_table, long in_index)
     /* check the index is within bounds */
     if ((in_index < 0) || (in_index >= in_table->count)) return;
     
+    /* keep the index in sync */
+    if (in_table->index) _idtable_index_removing(in_table, in_index);
+    
     /* shuffle the other items over the top */
     memmove(in_table->ids + in_index, in_table->ids + in_index + 1, sizeof(unsigned int) * (in_table->count - in_index - 1));
 
@@ -120,6 +335,26 @@ long idtable_size(IDTable *in_table)
 
 long idtable_index_for_id(IDTable *in_table, long in_id)
 {
+    /* large tables are indexed */
+    if ((!in_table->index) && (in_table->count >= IDTABLE_INDEX_THRESHOLD))
+        _idtable_index_build(in_table);
+    if (in_table->index && (in_id != IDTABLE_INDEX_NO_ID))
+    {
+        struct IDTableIndex *index = in_table->index;
+        long slot = _idtable_index_slot(index, (unsigned int)in_id);
+        if (index->hash[slot].id != in_id) return -1;
+        
+        /* search the chunk */
+        long chunk = index->hash[slot].chunk;
+        long start = _idtable_index_chunk_start(index, chunk);
+        long end = start + index->chunk_lengths[chunk];
+        for (long i = start; i < end; i++)
+        {
+            if (in_table->ids[i] == in_id) return i;
+        }
+        assert(0); /* index is out of sync with the table */
+    }
+    
     for (long i = 0; i < in_table->count; i++)
     {
         if (in_table->ids[i] == in_id) return i;
@@ -138,6 +373,14 @@ long idtable_id_for_index(IDTable *in_table, long in_index)
 void idtable_mutate_slot(IDTable *in_table, long in_index, long in_new_id)
 {
     if ((in_index < 0) || (in_index >= in_table->count)) return;
+    if (in_table->index)
+    {
+        /* the replacement ID stays in the same chunk */
+        long chunk = _idtable_index_chunk_for(in_table->index, in_index);
+        _idtable_index_remove(in_table->index, in_table->ids[in_index]);
+        if (!_idtable_index_add(in_table->index, (unsigned int)in_new_id, chunk))
+            _idtable_index_destroy(in_table);
+    }
     in_table->ids[in_index] = (int)in_new_id;
 }
 
@@ -186,6 +429,119 @@ const char* idtable_to_ascii(IDTable *in_table)
 }
 
 
+/*
+ *  idtable_create_with_binary
+ *  ---------------------------------------------------------------------------------------------
+ *  Creates an ID table from its binary representation, see idtable_to_binary().
+ *
+ *  Returns NULL if the data isn't a valid binary representation of a supported version.
+ */
+
+IDTable* idtable_create_with_binary(Stack *in_stack, void const *in_data, long in_size)
+{
+    unsigned char const *data = in_data;
+    if ((in_size < IDTABLE_BINARY_HEADER) || ((in_size - IDTABLE_BINARY_HEADER) % 4 != 0) ||
+        (memcmp(data, IDTABLE_BINARY_SIGNATURE, 3) != 0) || (data[3] != IDTABLE_BINARY_VERSION))
+        return NULL;
+    
+    IDTable *table = idtable_create(in_stack);
+    if (!table) return NULL;
+    
+    long count = (in_size - IDTABLE_BINARY_HEADER) / 4;
+    if (count > 0)
+    {
+        table->ids = _stack_malloc(sizeof(unsigned int) * count);
+        if (!table->ids)
+        {
+            idtable_destroy(table);
+            return _stack_panic_null(in_stack, STACK_ERR_MEMORY);
+        }
+        table->alloc = count;
+    }
+    
+    data += IDTABLE_BINARY_HEADER;
+    for (long index = 0; index < count; index++, data += 4)
+        table->ids[index] = (unsigned int)data[0] | ((unsigned int)data[1] << 8) |
+            ((unsigned int)data[2] << 16) | ((unsigned int)data[3] << 24);
+    table->count = count;
+    
+    return table;
+}
+
+
+/*
+ *  idtable_to_binary
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns the binary representation of the ID table, and its size in <out_size>.
+ *
+ *  The result remains valid until the next call, or the table is destroyed.
+ */
+
+const void* idtable_to_binary(IDTable *in_table, long *out_size)
+{
+    if (in_table->binary) _stack_free(in_table->binary);
+    in_table->binary = NULL;
+    *out_size = 0;
+    
+    long size = IDTABLE_BINARY_HEADER + in_table->count * 4;
+    in_table->binary = _stack_malloc(size);
+    if (!in_table->binary) return _stack_panic_null(in_table->stack, STACK_ERR_MEMORY);
+    
+    unsigned char *data = in_table->binary;
+    memcpy(data, IDTABLE_BINARY_SIGNATURE, 3);
+    data[3] = IDTABLE_BINARY_VERSION;
+    data += IDTABLE_BINARY_HEADER;
+    for (long index = 0; index < in_table->count; index++, data += 4)
+    {
+        unsigned int the_id = in_table->ids[index];
+        data[0] = the_id & 0xFF;
+        data[1] = (the_id >> 8) & 0xFF;
+        data[2] = (the_id >> 16) & 0xFF;
+        data[3] = (the_id >> 24) & 0xFF;
+    }
+    
+    *out_size = size;
+    return in_table->binary;
+}
+
+
+/*
+ *  idtable_create_with_column
+ *  ---------------------------------------------------------------------------------------------
+ *  Creates an ID table from a column of the current result row of <in_stmt>.  The column may be
+ *  a binary representation, or the ASCII representation used by older stack files.
+ */
+
+IDTable* idtable_create_with_column(Stack *in_stack, sqlite3_stmt *in_stmt, int in_column)
+{
+    if (sqlite3_column_type(in_stmt, in_column) == SQLITE_BLOB)
+        return idtable_create_with_binary(in_stack, sqlite3_column_blob(in_stmt, in_column),
+                                          sqlite3_column_bytes(in_stmt, in_column));
+    
+    char const *ascii = (char const*)sqlite3_column_text(in_stmt, in_column);
+    return idtable_create_with_ascii(in_stack, (ascii ? ascii : ""));
+}
+
+
+/*
+ *  idtable_bind
+ *  ---------------------------------------------------------------------------------------------
+ *  Binds the binary representation of the ID table to the specified parameter of <in_stmt>.
+ *
+ *  The binding remains valid until the table is next converted or destroyed.  Returns the SQLite
+ *  result code.
+ */
+
+int idtable_bind(IDTable *in_table, sqlite3_stmt *in_stmt, int in_param)
+{
+    long size;
+    const void *data = idtable_to_binary(in_table, &size);
+    if (!data) return SQLITE_NOMEM;
+    return sqlite3_bind_blob(in_stmt, in_param, data, (int)size, SQLITE_STATIC);
+}
+
+
+
 
 static int _in_array(long *in_array, int in_count, long in_id)
 {
@@ -309,6 +665,7 @@ void idtable_shuffle_backward(IDTable *in_table, long *in_ids, int in_count)
 
 void idtable_clear(IDTable *in_table)
 {
+    _idtable_index_destroy(in_table);
     in_table->count = 0;
 }
 
@@ -47,6 +47,12 @@ void idtable_destroy(IDTable *in_table);
 
 const char* idtable_to_ascii(IDTable *in_table);
 
+IDTable* idtable_create_with_binary(Stack *in_stack, void const *in_data, long in_size);
+const void* idtable_to_binary(IDTable *in_table, long *out_size);
+
+IDTable* idtable_create_with_column(Stack *in_stack, sqlite3_stmt *in_stmt, int in_column);
+int idtable_bind(IDTable *in_table, sqlite3_stmt *in_stmt, int in_param);
+
 void idtable_insert(IDTable *in_table, long in_id, long in_at_index);
 void idtable_append(IDTable *in_table, long in_id);
 void idtable_remove(IDTable *in_table, long in_index);
@@ -73,11 +79,19 @@ void idtable_clear(IDTable *in_table);
 /* serialisation buffer */
 
 typedef struct SerBuff SerBuff;
+typedef struct SerArena SerArena;
+
+SerArena* serarena_create(void);
+void serarena_destroy(SerArena *in_arena);
 
 SerBuff* serbuff_create(Stack *in_stack, void *in_data, long in_size, int in_nocopy);
+SerBuff* serbuff_create_scratch(Stack *in_stack);
 long serbuff_data(SerBuff *in_buff, void **out_data);
 void serbuff_destroy(SerBuff *in_buff, int in_cleanup_data);
 
+int serbuff_reserve(SerBuff *in_buff, long in_bytes);
+void serbuff_truncate(SerBuff *in_buff);
+
 void serbuff_write_long(SerBuff *in_buff, long in_long);
 void serbuff_write_cstr(SerBuff *in_buff, const char *in_cstr);
 void serbuff_write_data(SerBuff *in_buff, void const *in_data, long in_size);
@@ -125,6 +139,126 @@ struct UndoFrame
 
 
 
+/* card to background mapping */
+
+struct CardBkgnd
+{
+    long card_id;
+    long bkgnd_id;
+};
+
+
+
+/* searchability of cards and fields */
+
+struct SearchBkgnd
+{
+    long bkgnd_id;
+    int dontsearch;
+};
+
+struct SearchCache
+{
+    struct SearchBkgnd *bkgnds; /* backgrounds loaded so far */
+    long bkgnd_count;
+    unsigned char *card_dontsearch; /* bitset indexed by card ID */
+    long card_bytes;
+    unsigned char *field_searchable; /* bitset indexed by widget ID */
+    long field_bytes;
+};
+
+
+
+/* find word index */
+
+/* cards which have content containing a search term; cards of the listed backgrounds are also
+ candidates.  both lists are sorted by ID, see _find_card_is_candidate() */
+struct FindCandidates
+{
+    long *card_ids;
+    long card_count;
+    long *bkgnd_ids;
+    long bkgnd_count;
+};
+
+
+
+/* statement cache */
+
+/* collect the time spent using each cached statement, see stack_statement_report() */
+#if DEBUG
+#define STACK_STATEMENT_TIMING 1
+#endif
+
+enum StackStatement
+{
+    STMT_CARD_BKGND,
+    STMT_CARD_WIDGETS,
+    STMT_BKGND_WIDGETS,
+    STMT_CARD_SET_WIDGETS,
+    STMT_BKGND_SET_WIDGETS,
+    
+    STMT_SEARCH_BKGND,
+    STMT_CARD_CONTENT,
+    
+    STMT_WIDGET_OWNER,
+    STMT_WIDGET_CARD,
+    STMT_WIDGET_TYPE,
+    STMT_WIDGET_TABBABLE,
+    STMT_WIDGET_CONTENT_OWNER,
+    
+    STMT_WIDGET_CONTENT,
+    STMT_WIDGET_CONTENT_UPDATE,
+    STMT_WIDGET_CONTENT_INSERT,
+    
+    STMT_WIDGET_NAME,
+    STMT_WIDGET_LOCKED,
+    STMT_WIDGET_DONTSEARCH,
+    STMT_WIDGET_SHARED,
+    STMT_WIDGET_ICON,
+    STMT_WIDGET_OPTION,
+    
+    STMT_WIDGET_SET_NAME,
+    STMT_WIDGET_SET_TYPE,
+    STMT_WIDGET_SET_LOCKED,
+    STMT_WIDGET_SET_DONTSEARCH,
+    STMT_WIDGET_SET_SHARED,
+    STMT_WIDGET_SET_ICON,
+    STMT_WIDGET_SET_OPTION,
+    STMT_WIDGET_ADD_OPTION,
+    
+    STMT_SCRIPT_STACK,
+    STMT_SCRIPT_BKGND,
+    STMT_SCRIPT_CARD,
+    STMT_SCRIPT_WIDGET,
+    
+    STMT_PICTURE_CARD,
+    STMT_PICTURE_BKGND,
+    
+    STMT_RESOURCE,
+    
+    STMT_WORD_DELETE,
+    STMT_WORD_INSERT,
+    
+    _STMT_COUNT
+};
+
+struct StackStatementEntry
+{
+    sqlite3_stmt *stmt;
+    int in_use;
+    
+    /* statistics */
+    long uses;
+    long prepares;
+#if STACK_STATEMENT_TIMING
+    double began;
+    double seconds;
+#endif
+};
+
+
+
 /* stack instance */
 
 #define _STACK_STRUCT_ID "STAK"
@@ -184,6 +318,28 @@ struct Stack
     IDTable *bkgnd_widget_table;
     IDTable *stack_card_table;
     
+    /* prepared statements, see _stack_stmt_begin() */
+    struct StackStatementEntry statements[_STMT_COUNT];
+    
+    /* background of every card, ordered by card ID; loaded in bulk on demand and discarded
+     whenever cards are created or deleted, see _stack_card_bkgnd_map_get() */
+    struct CardBkgnd *card_bkgnd_map;
+    long card_bkgnd_count;
+    
+    /* Don't Search of cards, backgrounds and fields; loaded in bulk a background at a time and
+     discarded whenever widgets are created or deleted, or Don't Search changes,
+     see _stack_search_cache_load() */
+    struct SearchCache search_cache;
+    
+    /* changed whenever a script may have changed; allows the scripting engine to cache
+     compiled handlers, see stack_script_revision() and _stack_script_changed() */
+    long script_revision;
+    
+    /* does the file have a word index for find? (files too old to have one can't be upgraded
+     when opened read-only)  the revision is incremented whenever the index changes */
+    int has_word_index;
+    long word_index_revision;
+    
     
     /* undo management */
     
@@ -192,6 +348,7 @@ struct Stack
     int undo_stack_top;
     int undo_redo_ptr;
     int record_undo_steps;
+    SerArena *undo_arena; /* scratch memory for the data of undo steps */
     
     
     /* unserialisation and widget creation */
@@ -259,6 +416,17 @@ struct Stack
     char **find_state_field_words;
     long *find_state_field_offsets;
     int find_state_field_word_count;
+    
+    /* content of the fields of the card being searched, see _field_content() */
+    long find_content_card_id;
+    long find_content_count;
+    long *find_content_field_ids;
+    char **find_content_text;
+    
+    /* candidate cards for each search term, from the word index */
+    struct FindCandidates *find_candidates;
+    int find_candidate_count;
+    long find_candidates_revision;
 };
 
 
@@ -294,6 +462,25 @@ IDTable* _stack_widget_seq_get(Stack *in_stack, long in_card_id, long in_bkgnd_i
 void _stack_widget_seq_set(Stack *in_stack, long in_card_id, long in_bkgnd_id, IDTable *in_list);
 void _stack_widget_cache_invalidate(Stack *in_stack);
 
+long _stack_card_bkgnd_map_get(Stack *in_stack, struct CardBkgnd const **out_map);
+long _stack_card_bkgnd_map_lookup(Stack *in_stack, long in_card_id);
+void _stack_card_bkgnd_map_invalidate(Stack *in_stack);
+
+int _stack_search_cache_card(Stack *in_stack, long in_card_id);
+int _stack_search_cache_field(Stack *in_stack, long in_card_id, long in_field_id);
+void _stack_search_cache_invalidate(Stack *in_stack);
+
+
+/* scripts */
+void _stack_script_changed(Stack *in_stack);
+
+
+/* statement cache */
+
+sqlite3_stmt* _stack_stmt_begin(Stack *in_stack, enum StackStatement in_which);
+void _stack_stmt_end(Stack *in_stack, enum StackStatement in_which, sqlite3_stmt *in_stmt);
+void _stack_stmt_finalize_all(Stack *in_stack);
+
 
 /* serialization */
 
@@ -325,6 +512,12 @@ void _undo_record_step(Stack *in_stack, enum UndoAction in_action, SerBuff *in_d
 /* find */
 
 void stack_reset_find(Stack *in_stack);
+void _stack_word_strip_prepost_punct(char *io_word, int *out_prefix_count, int *out_postfix_count);
+
+int _stack_find_index_content(Stack *in_stack, long in_widget_id, long in_card_id, long in_bkgnd_id,
+                              char const *in_searchable);
+int _stack_find_index_delete_card(Stack *in_stack, long in_card_id, long in_bkgnd_id);
+int _stack_find_index_delete_widget(Stack *in_stack, long in_widget_id);
 
 
 
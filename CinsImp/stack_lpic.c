@@ -43,19 +43,9 @@ long stack_layer_picture_get(Stack *in_stack, long in_card_id, long in_bkgnd_id,
     long data_size = 0;
     
     /* query the appropriate table */
-    sqlite3_stmt *stmt;
-    if (in_card_id > 0)
-    {
-        sqlite3_prepare_v2(in_stack->db, "SELECT visible, data FROM picture_card WHERE cardid=?1", -1,
-                           &stmt, NULL);
-        sqlite3_bind_int(stmt, 1, (int)in_card_id);
-    }
-    else
-    {
-        sqlite3_prepare_v2(in_stack->db, "SELECT visible, data FROM picture_bkgnd WHERE bkgndid=?1", -1,
-                           &stmt, NULL);
-        sqlite3_bind_int(stmt, 1, (int)in_bkgnd_id);
-    }
+    enum StackStatement which = ((in_card_id > 0) ? STMT_PICTURE_CARD : STMT_PICTURE_BKGND);
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, which);
+    sqlite3_bind_int(stmt, 1, (int)((in_card_id > 0) ? in_card_id : in_bkgnd_id));
     int err;
     err = sqlite3_step(stmt);
     
@@ -76,7 +66,7 @@ long stack_layer_picture_get(Stack *in_stack, long in_card_id, long in_bkgnd_id,
             visible = sqlite3_column_int(stmt, 0);
         }
     }
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, which, stmt);
     if (err != SQLITE_ROW) return 0;
     
     /* return the requested picture */
@@ -100,7 +90,7 @@ void stack_layer_picture_set(Stack *in_stack, long in_card_id, long in_bkgnd_id,
     
     /* check if there is any existing content;
      and prepare the undo step */
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     if (undo_data)
     {
         serbuff_write_long(undo_data, in_card_id);
@@ -99,19 +99,15 @@ const char* stack_widget_prop_get_string(Stack *in_stack, long in_widget_id, lon
     
     if (in_prop == PROPERTY_NAME)
     {
-        sqlite3_prepare_v2(in_stack->db,
-                           "SELECT name FROM widget WHERE widgetid=?1",
-                           -1, &stmt, NULL);
+        stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_NAME);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_step(stmt);
         in_stack->widget_result = _stack_clone_cstr( (char*)sqlite3_column_text(stmt, 0) );
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, STMT_WIDGET_NAME, stmt);
     }
     else if (in_prop == PROPERTY_STYLE)
     {
-        sqlite3_prepare_v2(in_stack->db,
-                           "SELECT type FROM widget WHERE widgetid=?1",
-                           -1, &stmt, NULL);
+        stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_TYPE);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_step(stmt);
         switch (sqlite3_column_int(stmt, 0))
@@ -135,7 +131,7 @@ const char* stack_widget_prop_get_string(Stack *in_stack, long in_widget_id, lon
                 in_stack->widget_result = _stack_clone_cstr("grid");
                 break;
         }
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, STMT_WIDGET_TYPE, stmt);
     }
     else if (in_prop == PROPERTY_CONTENT)
     {
@@ -145,14 +141,12 @@ const char* stack_widget_prop_get_string(Stack *in_stack, long in_widget_id, lon
     }
     else
     {
-        sqlite3_prepare_v2(in_stack->db,
-                           "SELECT value FROM widget_options WHERE widgetid=?1 AND optionid=?2",
-                           -1, &stmt, NULL);
+        stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_OPTION);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_bind_int(stmt, 2, (int)in_prop);
         sqlite3_step(stmt);
         in_stack->widget_result = _stack_clone_cstr( (char*)sqlite3_column_text(stmt, 0) );
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, STMT_WIDGET_OPTION, stmt);
     }
     
     if (!in_stack->widget_result) in_stack->widget_result = _stack_clone_cstr("");
@@ -179,7 +173,7 @@ void stack_widget_prop_set_string(Stack *in_stack, long in_widget_id, long in_ca
     sqlite3_stmt *stmt;
     
     /* record the undo step */
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     serbuff_write_long(undo_data, in_widget_id);
     serbuff_write_long(undo_data, in_card_id);
     serbuff_write_long(undo_data, in_prop);
@@ -188,19 +182,15 @@ void stack_widget_prop_set_string(Stack *in_stack, long in_widget_id, long in_ca
     
     if (in_prop == PROPERTY_NAME)
     {
-        sqlite3_prepare_v2(in_stack->db,
-                           "UPDATE widget SET name=?2 WHERE widgetid=?1",
-                           -1, &stmt, NULL);
+        stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_SET_NAME);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_bind_text(stmt, 2, in_string, -1, SQLITE_TRANSIENT);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, STMT_WIDGET_SET_NAME, stmt);
     }
     else if (in_prop == PROPERTY_STYLE)
     {
-        sqlite3_prepare_v2(in_stack->db,
-                           "UPDATE widget SET type=?2 WHERE widgetid=?1",
-                           -1, &stmt, NULL);
+        stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_SET_TYPE);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         if (_stack_str_same(in_string, "push"))
             sqlite3_bind_int(stmt, 2, (int)WIDGET_BUTTON_PUSH);
@@ -215,7 +205,10 @@ void stack_widget_prop_set_string(Stack *in_stack, long in_widget_id, long in_ca
         else if (_stack_str_same(in_string, "grid"))
             sqlite3_bind_int(stmt, 2, (int)WIDGET_FIELD_GRID);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, STMT_WIDGET_SET_TYPE, stmt);
+        
+        /* buttons and fields differ in searchability */
+        _stack_search_cache_invalidate(in_stack);
     }
     else if (in_prop == PROPERTY_CONTENT)
     {
@@ -223,24 +216,20 @@ void stack_widget_prop_set_string(Stack *in_stack, long in_widget_id, long in_ca
     }
     else
     {
-        sqlite3_prepare_v2(in_stack->db,
-                           "UPDATE widget_options SET value=?3 WHERE widgetid=?1 AND optionid=?2",
-                           -1, &stmt, NULL);
+        stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_SET_OPTION);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_bind_int(stmt, 2, (int)in_prop);
         sqlite3_bind_text(stmt, 3, in_string, -1, SQLITE_TRANSIENT);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, STMT_WIDGET_SET_OPTION, stmt);
         if (sqlite3_changes(in_stack->db) == 0)
         {
-            sqlite3_prepare_v2(in_stack->db,
-                               "INSERT INTO widget_options VALUES (?1, ?2, ?3)",
-                               -1, &stmt, NULL);
+            stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_ADD_OPTION);
             sqlite3_bind_int(stmt, 1, (int)in_widget_id);
             sqlite3_bind_int(stmt, 2, (int)in_prop);
             sqlite3_bind_text(stmt, 3, in_string, -1, SQLITE_TRANSIENT);
             sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            _stack_stmt_end(in_stack, STMT_WIDGET_ADD_OPTION, stmt);
         }
     }
 }
@@ -254,46 +243,37 @@ long stack_widget_prop_get_long(Stack *in_stack, long in_widget_id, long in_card
     if ((in_prop == PROPERTY_LOCKED) || (in_prop == PROPERTY_DONTSEARCH) || (in_prop == PROPERTY_SHARED)
          || (in_prop == PROPERTY_ICON))
     {
+        enum StackStatement which;
         switch (in_prop)
         {
             case PROPERTY_LOCKED:
-                sqlite3_prepare_v2(in_stack->db,
-                                   "SELECT locked FROM widget WHERE widgetid=?1",
-                                   -1, &stmt, NULL);
+                which = STMT_WIDGET_LOCKED;
                 break;
             case PROPERTY_DONTSEARCH:
-                sqlite3_prepare_v2(in_stack->db,
-                                   "SELECT dontsearch FROM widget WHERE widgetid=?1",
-                                   -1, &stmt, NULL);
+                which = STMT_WIDGET_DONTSEARCH;
                 break;
             case PROPERTY_SHARED:
-                sqlite3_prepare_v2(in_stack->db,
-                                   "SELECT shared FROM widget WHERE widgetid=?1",
-                                   -1, &stmt, NULL);
+                which = STMT_WIDGET_SHARED;
                 break;
             case PROPERTY_ICON:
-                sqlite3_prepare_v2(in_stack->db,
-                                   "SELECT iconid FROM widget WHERE widgetid=?1",
-                                   -1, &stmt, NULL);
-                break;
             default:
+                which = STMT_WIDGET_ICON;
                 break;
         }
+        stmt = _stack_stmt_begin(in_stack, which);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_step(stmt);
         result = sqlite3_column_int(stmt, 0);
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, which, stmt);
         return result;
     }
     
-    sqlite3_prepare_v2(in_stack->db,
-                       "SELECT value FROM widget_options WHERE widgetid=?1 AND optionid=?2",
-                       -1, &stmt, NULL);
+    stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_OPTION);
     sqlite3_bind_int(stmt, 1, (int)in_widget_id);
     sqlite3_bind_int(stmt, 2, (int)in_prop);
     sqlite3_step(stmt);
     result = sqlite3_column_int(stmt, 0);
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, STMT_WIDGET_OPTION, stmt);
     return result;
 }
 
@@ -303,7 +283,7 @@ void stack_widget_prop_set_long(Stack *in_stack, long in_widget_id, long in_card
     sqlite3_stmt *stmt = NULL;
     
     /* record the undo step */
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     serbuff_write_long(undo_data, in_widget_id);
     serbuff_write_long(undo_data, in_card_id);
     serbuff_write_long(undo_data, in_prop);
@@ -313,56 +293,46 @@ void stack_widget_prop_set_long(Stack *in_stack, long in_widget_id, long in_card
     if ((in_prop == PROPERTY_LOCKED) || (in_prop == PROPERTY_DONTSEARCH) || (in_prop == PROPERTY_SHARED) ||
          (in_prop == PROPERTY_ICON))
     {
+        enum StackStatement which;
         switch (in_prop)
         {
             case PROPERTY_LOCKED:
-                sqlite3_prepare_v2(in_stack->db,
-                                   "UPDATE widget SET locked=?2 WHERE widgetid=?1",
-                                   -1, &stmt, NULL);
+                which = STMT_WIDGET_SET_LOCKED;
                 break;
             case PROPERTY_DONTSEARCH:
-                sqlite3_prepare_v2(in_stack->db,
-                                   "UPDATE widget SET dontsearch=?2 WHERE widgetid=?1",
-                                   -1, &stmt, NULL);
+                which = STMT_WIDGET_SET_DONTSEARCH;
                 break;
             case PROPERTY_SHARED:
-                sqlite3_prepare_v2(in_stack->db,
-                                   "UPDATE widget SET shared=?2 WHERE widgetid=?1",
-                                   -1, &stmt, NULL);
+                which = STMT_WIDGET_SET_SHARED;
                 break;
             case PROPERTY_ICON:
-                sqlite3_prepare_v2(in_stack->db,
-                                   "UPDATE widget SET iconid=?2 WHERE widgetid=?1",
-                                   -1, &stmt, NULL);
-                break;
             default:
+                which = STMT_WIDGET_SET_ICON;
                 break;
         }
+        stmt = _stack_stmt_begin(in_stack, which);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_bind_int(stmt, 2, (int)in_long);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, which, stmt);
+        if (in_prop == PROPERTY_DONTSEARCH) _stack_search_cache_invalidate(in_stack);
         return;
     }
     
-    sqlite3_prepare_v2(in_stack->db,
-                       "UPDATE widget_options SET value=?3 WHERE widgetid=?1 AND optionid=?2",
-                       -1, &stmt, NULL);
+    stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_SET_OPTION);
     sqlite3_bind_int(stmt, 1, (int)in_widget_id);
     sqlite3_bind_int(stmt, 2, (int)in_prop);
     sqlite3_bind_int(stmt, 3, (int)in_long);
     sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, STMT_WIDGET_SET_OPTION, stmt);
     if (sqlite3_changes(in_stack->db) == 0)
     {
-        sqlite3_prepare_v2(in_stack->db,
-                           "INSERT INTO widget_options VALUES (?1, ?2, ?3)",
-                           -1, &stmt, NULL);
+        stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_ADD_OPTION);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_bind_int(stmt, 2, (int)in_prop);
         sqlite3_bind_int(stmt, 3, (int)in_long);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, STMT_WIDGET_ADD_OPTION, stmt);
     }
 }
 
@@ -407,7 +377,7 @@ long stack_prop_get_long(Stack *in_stack, long in_card_id, long in_bkgnd_id, enu
 
 void stack_prop_set_long(Stack *in_stack, long in_card_id, long in_bkgnd_id, enum Property in_prop, long in_long)
 {
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     serbuff_write_long(undo_data, in_card_id);
     serbuff_write_long(undo_data, in_bkgnd_id);
     serbuff_write_long(undo_data, in_prop);
@@ -444,6 +414,10 @@ void stack_prop_set_long(Stack *in_stack, long in_card_id, long in_bkgnd_id, enu
     /* cache Can't Modify */
     if (in_prop == PROPERTY_LOCKED)
         in_stack->soft_lock = (int)in_long;
+    
+    /* card and background searchability is cached */
+    if (in_prop == PROPERTY_DONTSEARCH)
+        _stack_search_cache_invalidate(in_stack);
 }
 
 
@@ -483,7 +457,7 @@ const char* stack_prop_get_string(Stack *in_stack, long in_card_id, long in_bkgn
 
 void stack_prop_set_string(Stack *in_stack, long in_card_id, long in_bkgnd_id, enum Property in_prop, char* in_string)
 {
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     serbuff_write_long(undo_data, in_card_id);
     serbuff_write_long(undo_data, in_bkgnd_id);
     serbuff_write_long(undo_data, in_prop);
@@ -158,8 +158,7 @@ int stack_res_get(Stack *in_stack, int in_id, char const *in_type, char **out_na
     in_stack->_returned_res_data = NULL;
     long data_size = 0;
     
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(in_stack->db, "SELECT resourcename,data FROM resource WHERE resourceid=?1 AND resourcetype=?2", -1, &stmt, NULL);
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_RESOURCE);
     sqlite3_bind_int(stmt, 1, in_id);
     sqlite3_bind_text(stmt, 2, in_type, -1, SQLITE_STATIC);
     int err = sqlite3_step(stmt);
@@ -170,13 +169,13 @@ int stack_res_get(Stack *in_stack, int in_id, char const *in_type, char **out_na
         if (!in_stack->_returned_res_data)
         {
             _stack_panic_void(in_stack, STACK_ERR_MEMORY);
-            sqlite3_finalize(stmt);
+            _stack_stmt_end(in_stack, STMT_RESOURCE, stmt);
             return STACK_NO;
         }
         else
             memcpy(in_stack->_returned_res_data, sqlite3_column_blob(stmt, 1), data_size);
     }
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, STMT_RESOURCE, stmt);
     
     if (err == SQLITE_ROW)
     {
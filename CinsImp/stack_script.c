@@ -23,22 +23,24 @@ int stack_script_get(Stack *in_stack, int in_type, long in_id, char const **out_
 {
     //printf("stack_script_get()\n");
     
-    sqlite3_stmt *stmt;
+    enum StackStatement which;
     switch (in_type)
     {
         case STACK_SELF:
-            sqlite3_prepare_v2(in_stack->db, "SELECT script,script_cp,script_sel FROM stack", -1, &stmt, NULL);
+            which = STMT_SCRIPT_STACK;
             break;
         case STACK_BKGND:
-            sqlite3_prepare_v2(in_stack->db, "SELECT script,script_cp,script_sel FROM bkgnd WHERE bkgndid=?1", -1, &stmt, NULL);
+            which = STMT_SCRIPT_BKGND;
             break;
         case STACK_CARD:
-            sqlite3_prepare_v2(in_stack->db, "SELECT script,script_cp,script_sel FROM card WHERE cardid=?1", -1, &stmt, NULL);
+            which = STMT_SCRIPT_CARD;
             break;
         case STACK_WIDGET:
-            sqlite3_prepare_v2(in_stack->db, "SELECT script,script_cp,script_sel FROM widget WHERE widgetid=?1", -1, &stmt, NULL);
+        default:
+            which = STMT_SCRIPT_WIDGET;
             break;
     }
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, which);
     if (in_type != STACK_SELF) sqlite3_bind_int(stmt, 1, (int)in_id);
     int err = sqlite3_step(stmt);
     if (err == SQLITE_ROW)
@@ -72,13 +74,30 @@ int stack_script_get(Stack *in_stack, int in_type, long in_id, char const **out_
         *out_checkpoint_count = (in_stack->_returned_checkpoints ? checkpoint_count : 0);
         if (out_sel_offset) *out_sel_offset = sqlite3_column_int(stmt, 2);
     }
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, which, stmt);
     
     if (err == SQLITE_ROW) return STACK_ERR_NONE;
     return STACK_ERR_NO_OBJECT;
 }
 
 
+long stack_script_revision(Stack *in_stack)
+{
+    return in_stack->script_revision;
+}
+
+
+/* revisions come from a single counter and are never reused, so a stack opened at the address of
+ one that has been closed can't be mistaken for it by the scripting engine's handler cache */
+static long _g_stack_script_revision = 0;
+
+void _stack_script_changed(Stack *in_stack)
+{
+    in_stack->script_revision = __sync_add_and_fetch(&_g_stack_script_revision, 1);
+}
+
+
+
 int stack_script_set(Stack *in_stack, int in_type, long in_id, char const *in_script,
                      int const in_checkpoints[], int in_checkpoint_count, long in_sel_offset)
 {
@@ -119,6 +138,8 @@ int stack_script_set(Stack *in_stack, int in_type, long in_id, char const *in_sc
     sqlite3_finalize(stmt);
     if (temp) _stack_free(temp);
     
+    _stack_script_changed(in_stack);
+    
     if (err == SQLITE_DONE) return STACK_ERR_NONE;
     return STACK_ERR_NO_OBJECT;
 }
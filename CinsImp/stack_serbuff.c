@@ -19,6 +19,28 @@
 
 
 
+/**********
+ Configuration
+ */
+
+/* minimum capacity of a buffer once something has been written */
+#define SERBUFF_MIN_ALLOC 64
+
+/* size of the regular blocks of a scratch arena;
+ and the limit on the total size of an arena, beyond which scratch buffers use the heap */
+#define SERARENA_CHUNK_SIZE 16384
+#define SERARENA_LIMIT (1024 * 1024)
+
+/* alignment of scratch arena allocations */
+#define SERARENA_ALIGN(x) (((x) + 15) & ~15L)
+#define SERARENA_HEADER SERARENA_ALIGN((long)sizeof(struct SerArenaChunk))
+
+
+
+/**********
+ Types
+ */
+
 struct SerBuff
 {
     long alloc;
@@ -27,9 +49,161 @@ struct SerBuff
     long read_offset;
     int readonly;
     Stack *stack;
+    SerArena *arena; /* scratch arena the buffer belongs to (if any) */
+    struct SerArenaChunk *chunk; /* arena chunk containing the buffer */
+    struct SerArenaChunk *data_chunk; /* arena chunk containing the data, or NULL if it's on the heap */
 };
 
 
+struct SerArenaChunk
+{
+    struct SerArenaChunk *next;
+    long size;
+    long used;
+    int live; /* number of allocations within the chunk that haven't yet been released */
+};
+
+
+struct SerArena
+{
+    struct SerArenaChunk *chunks; /* most recently allocated first */
+    long total;
+};
+
+
+
+/**********
+ Scratch Arena
+ */
+
+/*
+ *  serarena_create
+ *  ---------------------------------------------------------------------------------------------
+ *  Creates a scratch arena for short-lived serialisation buffers, such as those recorded by the
+ *  undo manager.  Buffers in the arena are never individually freed; each chunk of the arena is
+ *  reused or freed as soon as the last buffer within it is destroyed, so memory is recovered as
+ *  old undo steps are discarded.
+ *
+ *  Returns NULL if there isn't enough memory.
+ */
+
+SerArena* serarena_create(void)
+{
+    SerArena *arena = _stack_malloc(sizeof(struct SerArena));
+    if (!arena) return NULL;
+    arena->chunks = NULL;
+    arena->total = 0;
+    return arena;
+}
+
+
+void serarena_destroy(SerArena *in_arena)
+{
+    if (!in_arena) return;
+    struct SerArenaChunk *chunk = in_arena->chunks;
+    while (chunk)
+    {
+        struct SerArenaChunk *next = chunk->next;
+        _stack_free(chunk);
+        chunk = next;
+    }
+    _stack_free(in_arena);
+}
+
+
+/* removes a chunk from the arena and frees it */
+static void _serarena_free_chunk(SerArena *in_arena, struct SerArenaChunk *in_chunk)
+{
+    struct SerArenaChunk **link = &(in_arena->chunks);
+    while (*link != in_chunk) link = &((*link)->next);
+    *link = in_chunk->next;
+    in_arena->total -= in_chunk->size;
+    _stack_free(in_chunk);
+}
+
+
+/* releases an allocation within the chunk;
+ once nothing within the chunk is in use, it's either rewound, if it's the regular sized chunk
+ currently being allocated from, or freed */
+static void _serarena_release(SerArena *in_arena, struct SerArenaChunk *in_chunk)
+{
+    assert(in_chunk->live > 0);
+    in_chunk->live--;
+    if (in_chunk->live > 0) return;
+    if ((in_chunk == in_arena->chunks) && (in_chunk->size == SERARENA_CHUNK_SIZE))
+        in_chunk->used = 0;
+    else
+        _serarena_free_chunk(in_arena, in_chunk);
+}
+
+
+/* returns NULL if the arena has reached it's limit or there isn't enough memory;
+ otherwise the allocation must be released with _serarena_release() and the chunk in <out_chunk> */
+static void* _serarena_alloc(SerArena *in_arena, long in_bytes, struct SerArenaChunk **out_chunk)
+{
+    in_bytes = SERARENA_ALIGN(in_bytes);
+    struct SerArenaChunk *chunk = in_arena->chunks;
+    if ((!chunk) || (chunk->used + in_bytes > chunk->size))
+    {
+        /* the current chunk is only kept while it's in use */
+        if (chunk && (chunk->live == 0)) _serarena_free_chunk(in_arena, chunk);
+        
+        long size = (in_bytes > SERARENA_CHUNK_SIZE ? in_bytes : SERARENA_CHUNK_SIZE);
+        if (in_arena->total + size > SERARENA_LIMIT) return NULL;
+        chunk = _stack_malloc(SERARENA_HEADER + size);
+        if (!chunk) return NULL;
+        chunk->size = size;
+        chunk->used = 0;
+        chunk->live = 0;
+        chunk->next = in_arena->chunks;
+        in_arena->chunks = chunk;
+        in_arena->total += size;
+    }
+    void *result = (char*)chunk + SERARENA_HEADER + chunk->used;
+    chunk->used += in_bytes;
+    chunk->live++;
+    *out_chunk = chunk;
+    return result;
+}
+
+
+/* grows an allocation, in place if it was the last thing allocated and there's room;
+ <io_chunk> is the chunk of the allocation, or NULL if there isn't one yet, and is updated if
+ the allocation moves.  Returns NULL, leaving the allocation as it was, if the arena is full */
+static void* _serarena_grow(SerArena *in_arena, struct SerArenaChunk **io_chunk, void *in_memory,
+                            long in_old_size, long in_new_size)
+{
+    struct SerArenaChunk *chunk = *io_chunk;
+    if (chunk && (chunk == in_arena->chunks))
+    {
+        char *top = (char*)chunk + SERARENA_HEADER + chunk->used;
+        long old_size = SERARENA_ALIGN(in_old_size);
+        long new_size = SERARENA_ALIGN(in_new_size);
+        if (((char*)in_memory + old_size == top) && (chunk->used - old_size + new_size <= chunk->size))
+        {
+            chunk->used += new_size - old_size;
+            return in_memory;
+        }
+    }
+    
+    struct SerArenaChunk *new_chunk;
+    void *new_memory = _serarena_alloc(in_arena, in_new_size, &new_chunk);
+    if (!new_memory) return NULL;
+    if (chunk)
+    {
+        memcpy(new_memory, in_memory, in_old_size);
+        _serarena_release(in_arena, chunk);
+    }
+    *io_chunk = new_chunk;
+    return new_memory;
+}
+
+
+
+/**********
+ Buffers
+ */
+
 SerBuff* serbuff_create(Stack *in_stack, void *in_data, long in_size, int in_nocopy)
 {
     assert(IS_STACK(in_stack));
@@ -39,6 +213,9 @@ SerBuff* serbuff_create(Stack *in_stack, void *in_data, long in_size, int in_noc
     if (!buff) return _stack_panic_null(in_stack, STACK_ERR_MEMORY);
     buff->stack = in_stack;
     buff->readonly = 0;
+    buff->arena = NULL;
+    buff->chunk = NULL;
+    buff->data_chunk = NULL;
     if (in_nocopy)
     {
         buff->data = in_data;
@@ -63,6 +240,38 @@ SerBuff* serbuff_create(Stack *in_stack, void *in_data, long in_size, int in_noc
 }
 
 
+/*
+ *  serbuff_create_scratch
+ *  ---------------------------------------------------------------------------------------------
+ *  Creates an empty buffer for writing within the stack's scratch arena, if it has one and the
+ *  arena isn't full, otherwise on the heap.
+ *
+ *  Intended for the many small buffers recorded as undo steps.  The data of such a buffer
+ *  must not be retained beyond serbuff_destroy().
+ */
+
+SerBuff* serbuff_create_scratch(Stack *in_stack)
+{
+    assert(IS_STACK(in_stack));
+    
+    SerArena *arena = in_stack->undo_arena;
+    struct SerArenaChunk *chunk;
+    SerBuff *buff = (arena ? _serarena_alloc(arena, sizeof(struct SerBuff), &chunk) : NULL);
+    if (!buff) return serbuff_create(in_stack, NULL, 0, STACK_COPY);
+    
+    buff->stack = in_stack;
+    buff->readonly = 0;
+    buff->arena = arena;
+    buff->chunk = chunk;
+    buff->data_chunk = NULL;
+    buff->data = NULL;
+    buff->size = 0;
+    buff->alloc = 0;
+    buff->read_offset = 0;
+    return buff;
+}
+
+
 long serbuff_data(SerBuff *in_buff, void **out_data)
 {
     *out_data = in_buff->data;
@@ -72,18 +281,43 @@ long serbuff_data(SerBuff *in_buff, void **out_data)
 
 void serbuff_destroy(SerBuff *in_buff, int in_cleanup_data)
 {
-    if (in_buff->data && in_cleanup_data) _stack_free(in_buff->data);
-    _stack_free(in_buff);
+    if (in_buff->data_chunk) _serarena_release(in_buff->arena, in_buff->data_chunk);
+    else if (in_buff->data && in_cleanup_data) _stack_free(in_buff->data);
+    if (in_buff->arena) _serarena_release(in_buff->arena, in_buff->chunk);
+    else _stack_free(in_buff);
 }
 
 
+/* makes room for at least the required number of bytes;
+ capacity grows geometrically, so a long sequence of small writes doesn't reallocate each time */
 static int _begin_write(SerBuff *in_buff, long in_required)
 {
     if (in_required + in_buff->size > in_buff->alloc)
     {
-        long new_size = in_required + in_buff->size;
-        char *new_data = _stack_realloc(in_buff->data, new_size);
+        long new_size = in_buff->alloc * 2;
+        if (new_size < in_required + in_buff->size) new_size = in_required + in_buff->size;
+        if (new_size < SERBUFF_MIN_ALLOC) new_size = SERBUFF_MIN_ALLOC;
+        
+        char *new_data = NULL;
+        if (in_buff->arena && (in_buff->data_chunk || (!in_buff->data)))
+        {
+            /* the data is, or is yet to be, within the arena */
+            new_data = _serarena_grow(in_buff->arena, &(in_buff->data_chunk), in_buff->data, in_buff->size, new_size);
+            if ((!new_data) && in_buff->data_chunk)
+            {
+                /* arena is full; move the data to the heap */
+                new_data = _stack_malloc(new_size);
         if (!new_data) return _stack_panic_false(in_buff->stack, STACK_ERR_MEMORY);
+                memcpy(new_data, in_buff->data, in_buff->size);
+                _serarena_release(in_buff->arena, in_buff->data_chunk);
+                in_buff->data_chunk = NULL;
+            }
+        }
+        if (!new_data)
+        {
+            new_data = _stack_realloc(in_buff->data, new_size);
+            if (!new_data) return _stack_panic_false(in_buff->stack, STACK_ERR_MEMORY);
+        }
         
         in_buff->alloc = new_size;
         in_buff->data = new_data;
@@ -92,6 +326,36 @@ static int _begin_write(SerBuff *in_buff, long in_required)
 }
 
 
+/*
+ *  serbuff_reserve
+ *  ---------------------------------------------------------------------------------------------
+ *  Ensures the buffer can accept at least the specified number of additional bytes without
+ *  further allocation.  A hint; writes will still grow the buffer as necessary.
+ *
+ *  Returns STACK_NO if there isn't enough memory.
+ */
+
+int serbuff_reserve(SerBuff *in_buff, long in_bytes)
+{
+    assert(!in_buff->readonly);
+    return _begin_write(in_buff, in_bytes);
+}
+
+
+/*
+ *  serbuff_truncate
+ *  ---------------------------------------------------------------------------------------------
+ *  Empties the buffer for reuse, retaining it's capacity.
+ */
+
+void serbuff_truncate(SerBuff *in_buff)
+{
+    assert(!in_buff->readonly);
+    in_buff->size = 0;
+    in_buff->read_offset = 0;
+}
+
+
 void serbuff_write_long(SerBuff *in_buff, long in_long)
 {
     if (!_begin_write(in_buff, sizeof(long))) return _stack_panic_void(in_buff->stack, STACK_ERR_MEMORY);
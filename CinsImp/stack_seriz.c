@@ -46,12 +46,14 @@ long _widgets_serialize(Stack *in_stack, long *in_ids, int in_count, void **out_
     *out_data = NULL;
     
     /* create a serialization buffer to help build the result;
-     and cleanup the last one (if any) */
-    if (in_stack->serializer_widgets) serbuff_destroy(in_stack->serializer_widgets, 1);
-    in_stack->serializer_widgets = NULL;
-    in_stack->serializer_widgets = serbuff_create(in_stack, NULL, 0, 0);
+     or reuse the last one (if any) */
+    if (in_stack->serializer_widgets) serbuff_truncate(in_stack->serializer_widgets);
+    else in_stack->serializer_widgets = serbuff_create(in_stack, NULL, 0, 0);
     if (!in_stack->serializer_widgets) return 0;
     
+    /* typical widgets require a few hundred bytes, not including content */
+    if (!serbuff_reserve(in_stack->serializer_widgets, sizeof(long) + 256 * (long)in_count)) return 0;
+    
     /* serialize each widget */
     long card_id = STACK_NO_OBJECT, bkgnd_id = STACK_NO_OBJECT;
     int err;
@@ -353,18 +355,24 @@ int _widgets_unserialize(Stack *in_stack, void *in_data, long in_data_size, long
             err = SQLITE_DONE;
             for (int co = 0; co < content_count; co++)
             {
+                long content_card_id = serbuff_read_long(buff);
+                long content_bkgnd_id = serbuff_read_long(buff);
+                char const *searchable = serbuff_read_cstr(buff);
                 sqlite3_prepare_v2(in_stack->db, "INSERT INTO widget_content (widgetid,cardid,bkgndid,searchable,formatted) "
                                    "VALUES (?1,?2,?3,?4,?5)", -1, &stmt, NULL);
                 sqlite3_bind_int(stmt, 1, (int)widget_id);
-                sqlite3_bind_int(stmt, 2, (int)serbuff_read_long(buff));
-                sqlite3_bind_int(stmt, 3, (int)serbuff_read_long(buff));
-                sqlite3_bind_text(stmt, 4, serbuff_read_cstr(buff), -1, SQLITE_STATIC);
+                sqlite3_bind_int(stmt, 2, (int)content_card_id);
+                sqlite3_bind_int(stmt, 3, (int)content_bkgnd_id);
+                sqlite3_bind_text(stmt, 4, searchable, -1, SQLITE_STATIC);
                 void *data;
                 long size;
                 size = serbuff_read_data(buff, &data);
                 sqlite3_bind_blob(stmt, 5, data, (int)size, SQLITE_TRANSIENT);
                 err = sqlite3_step(stmt);
                 sqlite3_finalize(stmt);
+                if ((err == SQLITE_DONE) &&
+                    (!_stack_find_index_content(in_stack, widget_id, content_card_id, content_bkgnd_id, searchable)))
+                    err = SQLITE_ERROR;
                 if (err != SQLITE_DONE) break;
             }
             if (err != SQLITE_DONE) break;
@@ -449,13 +457,14 @@ int _widgets_unserialize(Stack *in_stack, void *in_data, long in_data_size, long
         _stack_cancel(in_stack);
         return STACK_NO_OBJECT;
     }
+    _stack_search_cache_invalidate(in_stack);
     
     if (in_undoable)
     {
         /* record the undo steps */
         for (int i = 0; i < count; i++)
         {
-            SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+            SerBuff *undo_data = serbuff_create_scratch(in_stack);
             if (undo_data)
             {
                 serbuff_write_long(undo_data, created_ids[i]);
@@ -512,9 +521,9 @@ long _card_serialize(Stack *in_stack, long in_card_id, void const **out_data)
     *out_data = NULL;
     
     /* create a serialization buffer to help build the result;
-     and cleanup the last one (if any) */
-    if (in_stack->serializer_card) serbuff_destroy(in_stack->serializer_card, 1);
-    in_stack->serializer_card = serbuff_create(in_stack, NULL, 0, 0);
+     or reuse the last one (if any) */
+    if (in_stack->serializer_card) serbuff_truncate(in_stack->serializer_card);
+    else in_stack->serializer_card = serbuff_create(in_stack, NULL, 0, 0);
     if (!in_stack->serializer_card) return 0;
     
     /* serialize the card particulars */
@@ -531,7 +540,13 @@ long _card_serialize(Stack *in_stack, long in_card_id, void const **out_data)
     
     serbuff_write_long(in_stack->serializer_card, in_card_id);
     serbuff_write_long(in_stack->serializer_card, sqlite3_column_int(stmt, 0));
-    serbuff_write_cstr(in_stack->serializer_card, (char*)sqlite3_column_text(stmt, 1));
+    
+    /* the widget sequence is serialized in ASCII form, regardless of the form on disk */
+    IDTable *widget_seq = ((err == SQLITE_ROW) ? idtable_create_with_column(in_stack, stmt, 1) : NULL);
+    char const *widget_seq_ascii = (widget_seq ? idtable_to_ascii(widget_seq) : NULL);
+    serbuff_write_cstr(in_stack->serializer_card, (widget_seq_ascii ? widget_seq_ascii : ""));
+    if (widget_seq) idtable_destroy(widget_seq);
+    
     serbuff_write_cstr(in_stack->serializer_card, (char*)sqlite3_column_text(stmt, 2));
     serbuff_write_long(in_stack->serializer_card, sqlite3_column_int(stmt, 3));
     serbuff_write_long(in_stack->serializer_card, sqlite3_column_int(stmt, 4));
@@ -679,12 +694,15 @@ long _card_unserialize(Stack *in_stack, void const *in_data, long in_size, long
     else
         sqlite3_bind_int(stmt, 1, (int)proposed_card_id); /* use the existing card ID */
     sqlite3_bind_int(stmt, 2, (int)serbuff_read_long(buff));
-    sqlite3_bind_text(stmt, 3, serbuff_read_cstr(buff), -1, SQLITE_STATIC);
+    char const *widget_seq_ascii = serbuff_read_cstr(buff);
+    IDTable *widget_seq = idtable_create_with_ascii(in_stack, (widget_seq_ascii ? widget_seq_ascii : ""));
+    if (widget_seq) idtable_bind(widget_seq, stmt, 3);
     sqlite3_bind_text(stmt, 4, serbuff_read_cstr(buff), -1, SQLITE_STATIC);
     sqlite3_bind_int(stmt, 5, (int)serbuff_read_long(buff));
     sqlite3_bind_int(stmt, 6, (int)serbuff_read_long(buff));
     err = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
+    if (widget_seq) idtable_destroy(widget_seq);
     if (err != SQLITE_DONE) {
         serbuff_destroy(buff, 0);
         _stack_cancel(in_stack);
@@ -774,9 +792,11 @@ long _card_unserialize(Stack *in_stack, void const *in_data, long in_size, long
     
     /* insert new card into stack */
     idtable_insert(in_stack->stack_card_table, card_id, proposed_sequence);
+    _stack_card_bkgnd_map_invalidate(in_stack);
+    _stack_search_cache_invalidate(in_stack);
     
     /* record the undo step */
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     if (undo_data)
     {
         serbuff_write_long(undo_data, card_id);
@@ -23,10 +23,17 @@
  */
 
 
+/* sort keys are evaluated once per card and normalised, so that comparisons during the sort
+ are simple number or byte-string comparisons;
+ keys are compared as numbers only if every key is numeric and at least one is a number
+ (rather than a string that looks like a number), otherwise by the collation key of the text */
 struct CardSortKey
 {
     long card_id;
-    XTEVariant *key;
+    int is_number; /* key is a number */
+    int has_number; /* key is a number, or a string that can be interpreted as one */
+    double number;
+    char *text;
 };
 
 
@@ -35,12 +42,69 @@ struct SortContext
     long card_count;
     struct CardSortKey *sort_keys;
     XTE *xtalk;
+    int by_number;
 };
 
 
 static int _compare_cards(Sorter *in_sorter, struct SortContext *in_context, struct CardSortKey *in_item1, struct CardSortKey *in_item2)
 {
-    return xte_compare_variants(in_context->xtalk, in_item1->key, in_item2->key);
+    if (in_context->by_number)
+    {
+        if (in_item1->number < in_item2->number) return -1;
+        if (in_item1->number > in_item2->number) return 1;
+        return 0;
+    }
+    int diff = strcmp(in_item1->text, in_item2->text);
+    if (diff < 0) return -1;
+    if (diff > 0) return 1;
+    return 0;
+}
+
+
+/* normalises the evaluated sort key for a card;
+ returns STACK_NO if there isn't enough memory */
+static int _sort_key_make(XTE *in_xtalk, XTEVariant *in_value, struct CardSortKey *out_key)
+{
+    XTEVariantType type = xte_variant_type(in_value);
+    if ((type == XTE_TYPE_INTEGER) || (type == XTE_TYPE_REAL))
+    {
+        out_key->is_number = out_key->has_number = STACK_YES;
+        out_key->number = xte_variant_as_double(in_value);
+    }
+    
+    /* obtain the text of the key */
+    xte_variant_convert(in_xtalk, in_value, XTE_TYPE_STRING);
+    char const *text = xte_variant_as_cstring(in_value);
+    
+    /* check if text looks like a number */
+    if (!out_key->is_number)
+    {
+        XTEVariant *number = xte_string_create_with_cstring(in_xtalk, text);
+        if (number && xte_variant_convert(in_xtalk, number, XTE_TYPE_REAL))
+        {
+            out_key->has_number = STACK_YES;
+            out_key->number = xte_variant_as_double(number);
+        }
+        if (number) xte_variant_release(number);
+    }
+    
+    /* make a collation key of the text, which sorts the same way as the localised comparison
+     used by the scripting language */
+    long bytes = xte_cstring_collation_key(text, NULL, 0);
+    out_key->text = _stack_malloc(bytes + 1);
+    if (!out_key->text) return STACK_NO;
+    xte_cstring_collation_key(text, out_key->text, bytes + 1);
+    return STACK_YES;
+}
+
+
+static void _sort_keys_free(struct SortContext *in_context)
+{
+    for (long card_index = 0; card_index < in_context->card_count; card_index++)
+    {
+        if (in_context->sort_keys[card_index].text) _stack_free(in_context->sort_keys[card_index].text);
+    }
+    _stack_free(in_context->sort_keys);
 }
 
 
@@ -59,6 +123,8 @@ void _stack_card_table_flush(Stack *in_stack);
  *  stack_sort
  *  ---------------------------------------------------------------------------------------------
  *  Sorts the cards of the stack using the specified XTE sort key.
+ *
+ *  The sort is stable; cards with equal keys retain their relative order.
  */
 void stack_sort(Stack *in_stack, XTE *in_xtalk, long in_bkgnd_id, int in_marked,
                 XTEVariant *in_sort_key, StackSortMode in_mode)
@@ -67,126 +133,81 @@ void stack_sort(Stack *in_stack, XTE *in_xtalk, long in_bkgnd_id, int in_marked,
     
     /* grab ID table for cards to be sorted */
     IDTable *idtable = in_stack->stack_card_table;
+    long stack_card_count = idtable_size(idtable);
     
     /* create and configure a sorter */
     struct SortContext context;
     Sorter *sorter = sorter_create((SorterComparator)&_compare_cards, &context);
     if (!sorter) return app_out_of_memory_void();
     
-    long *slot_indicies = NULL;
-    
     /* construct a list of card IDs, indicies and sort keys;
      the sorter will swap IDs around, but leave the indicies stationary,
      allowing us to write the sorted list interleaved in the correct
      places between cards of other backgrounds at the end. */
-    if (in_bkgnd_id != STACK_NO_OBJECT)
+    context.card_count = (in_bkgnd_id != STACK_NO_OBJECT ? stack_bkgnd_card_count(in_stack, in_bkgnd_id) : stack_card_count);
+    context.sort_keys = _stack_calloc(context.card_count, sizeof(struct CardSortKey));
+    context.xtalk = in_xtalk;
+    context.by_number = STACK_NO;
+    long *slot_indicies = _stack_calloc(context.card_count, sizeof(long));
+    if ((!context.sort_keys) || (!slot_indicies) || (!sorter_reserve(sorter, context.card_count)))
+    {
+        if (context.sort_keys) _stack_free(context.sort_keys);
+        if (slot_indicies) _stack_free(slot_indicies);
+        sorter_destroy(sorter);
+        return app_out_of_memory_void();
+    }
+    
+    /* evaluate the sort key for each card */
+    int any_number = STACK_NO, all_numbers = STACK_YES;
+    long slot_index = 0;
+    for (long card_index = 0; (card_index < stack_card_count) && (slot_index < context.card_count); card_index++)
     {
-        /* enumerate only cards in background */
-        context.card_count = stack_bkgnd_card_count(in_stack, in_bkgnd_id);
-        context.sort_keys = _stack_calloc(context.card_count, sizeof(struct CardSortKey));
-        context.xtalk = in_xtalk;
-        if (!context.sort_keys) return app_out_of_memory_void();
+        /* grab next card in stack;
+         and check if the card is in the background (if applicable) */
+        long card_id = idtable_id_for_index(idtable, card_index);
+        if ((in_bkgnd_id != STACK_NO_OBJECT) && (_cards_bkgnd(in_stack, card_id) != in_bkgnd_id)) continue;
         
-        slot_indicies = _stack_calloc(context.card_count, sizeof(long));
-        if (!slot_indicies)
+        /* evaluate the key */
+        struct CardSortKey *key = &(context.sort_keys[slot_index]);
+        in_stack->sort_card_id = key->card_id = card_id;
+        XTEVariant *value = xte_variant_value(in_xtalk, xte_evaluate_delayed_param(in_xtalk, in_sort_key));
+        int ok = (value && (!xte_has_error(in_xtalk)) && _sort_key_make(in_xtalk, value, key));
+        if (value) xte_variant_release(value);
+        if (!ok)
         {
-            _stack_free(context.sort_keys);
+            /* if there was a problem evaluating the expression,
+             stop and cleanup */
+            in_stack->sort_card_id = STACK_NO_OBJECT;
+            _sort_keys_free(&context);
+            _stack_free(slot_indicies);
             sorter_destroy(sorter);
+            if (!xte_has_error(in_xtalk)) app_out_of_memory_void();
             return;
         }
+        if (key->is_number) any_number = STACK_YES;
+        if (!key->has_number) all_numbers = STACK_NO;
         
-        long stack_card_count = idtable_size(idtable);
-        int slot_index = 0;
-        for (long card_index = 0; card_index < stack_card_count; card_index++)
-        {
-            /* grab next card in stack */
-            long card_id = idtable_id_for_index(idtable, card_index);
-            
-            /* check if the card is in the background */
-            long cards_bkgnd = _cards_bkgnd(in_stack, card_id);
-            if (cards_bkgnd == in_bkgnd_id)
-            {
-                /* it is, so add it to the sort list */
-                in_stack->sort_card_id = context.sort_keys[slot_index].card_id = card_id;
-                    
-                context.sort_keys[slot_index].key = xte_variant_value(in_xtalk, xte_evaluate_delayed_param(in_xtalk, in_sort_key));
-                if (xte_has_error(in_xtalk))
-                {
-                    /* if there was a problem evaluating the expression,
-                     stop and cleanup */
-                    for (card_index = 0; card_index < context.card_count; card_index++)
-                        xte_variant_release(context.sort_keys[card_index].key);
-                    _stack_free(context.sort_keys);
-                    sorter_destroy(sorter);
-                    return;
-                }
-                
-                sorter_add(sorter, &(context.sort_keys[slot_index]));
-                slot_indicies[slot_index++] = card_index;
-            }
-        }
-    }
-    else
-    {
-        /* enumerate all cards in stack */
-        context.card_count = idtable_size(idtable);
-        context.sort_keys = _stack_calloc(context.card_count, sizeof(struct CardSortKey));
-        context.xtalk = in_xtalk;
-        if (!context.sort_keys) return app_out_of_memory_void();
-        for (long card_index = 0; card_index < context.card_count; card_index++)
-        {
-            in_stack->sort_card_id = context.sort_keys[card_index].card_id = idtable_id_for_index(idtable, card_index);
-            context.sort_keys[card_index].key = xte_variant_value(in_xtalk, xte_evaluate_delayed_param(in_xtalk, in_sort_key));
-            if (xte_has_error(in_xtalk))
-            {
-                /* if there was a problem evaluating the expression,
-                 stop and cleanup */
-                for (card_index = 0; card_index < context.card_count; card_index++)
-                    xte_variant_release(context.sort_keys[card_index].key);
-                _stack_free(context.sort_keys);
-                sorter_destroy(sorter);
-                return;
-            }
-            
-            sorter_add(sorter, &(context.sort_keys[card_index]));
-        }
+        sorter_add(sorter, key);
+        slot_indicies[slot_index++] = card_index;
     }
     assert(sorter_count(sorter) == context.card_count);
+    context.by_number = (any_number && all_numbers);
     
     /* perform the sort */
     sorter_sort(sorter, (SorterDirection)in_mode);
     in_stack->sort_card_id = STACK_NO_OBJECT;
     
-    if (slot_indicies)
+    /* mutate the ID table with the sorted sequence;
+     only change the cards at the specified slot indicies */
+    for (long card_index = 0; card_index < context.card_count; card_index++)
     {
-        /* mutate the ID table with the sorted sequence;
-         only change the cards at the specified slot indicies */
-        for (long card_index = 0; card_index < context.card_count; card_index++)
-        {
-            struct CardSortKey *card = sorter_item(sorter, card_index);
-            idtable_mutate_slot(idtable, slot_indicies[card_index], card->card_id);
-            
-            xte_variant_release(card->key);
-        }
-        
-        _stack_free(slot_indicies);
-    }
-    else
-    {
-        /* rebuild the ID table with the sorted sequence;
-         and cleanup */
-        idtable_clear(idtable);
-        for (long card_index = 0; card_index < context.card_count; card_index++)
-        {
-            struct CardSortKey *card = sorter_item(sorter, card_index);
-            idtable_append(idtable, card->card_id);
-            
-            xte_variant_release(card->key);
-        }
+        struct CardSortKey *card = sorter_item(sorter, card_index);
+        idtable_mutate_slot(idtable, slot_indicies[card_index], card->card_id);
     }
     
     /* cleanup */
-    _stack_free(context.sort_keys);
+    _stack_free(slot_indicies);
+    _sort_keys_free(&context);
     sorter_destroy(sorter);
     
     /* write new order of cards to disk */
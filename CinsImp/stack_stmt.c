@@ -0,0 +1,234 @@
+/*
+ 
+ Stack Statement Cache
+ stack_stmt.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Cache of prepared SQLite statements for frequently used queries, so that accessors which are
+ invoked repeatedly (often from scripts in a loop) needn't compile the same SQL each time.
+ Also keeps usage statistics for each statement.
+ 
+ *************************************************************************************************
+ */
+
+#include "stack_int.h"
+
+#if STACK_STATEMENT_TIMING
+#include <sys/time.h>
+#endif
+
+
+/**********
+ Statements
+ */
+
+/* the SQL for each statement, indexed by enum StackStatement */
+static char const *_g_stack_statement_sql[_STMT_COUNT] = {
+    [STMT_CARD_BKGND] = "SELECT bkgndid FROM card WHERE cardid=?1",
+    [STMT_CARD_WIDGETS] = "SELECT widgets FROM card WHERE cardid=?1",
+    [STMT_BKGND_WIDGETS] = "SELECT widgets FROM bkgnd WHERE bkgndid=?1",
+    [STMT_CARD_SET_WIDGETS] = "UPDATE card SET widgets=?2 WHERE cardid=?1",
+    [STMT_BKGND_SET_WIDGETS] = "UPDATE bkgnd SET widgets=?2 WHERE bkgndid=?1",
+    
+    [STMT_SEARCH_BKGND] = "SELECT 0,bkgndid,dontsearch,0 FROM bkgnd WHERE bkgndid=?1 "
+        "UNION ALL SELECT 1,cardid,dontsearch,0 FROM card WHERE bkgndid=?1 "
+        "UNION ALL SELECT 2,widgetid,dontsearch,type FROM widget WHERE bkgndid=?1 OR cardid IN "
+        "(SELECT cardid FROM card WHERE bkgndid=?1)",
+    [STMT_CARD_CONTENT] = "SELECT widget_content.widgetid,widget_content.searchable "
+        "FROM widget_content JOIN widget ON widget.widgetid=widget_content.widgetid "
+        "WHERE (widget_content.cardid=?1 AND widget_content.bkgndid=?3 AND (widget.bkgndid<1 OR widget.shared=0)) "
+        "OR (widget_content.cardid=?3 AND widget_content.bkgndid=?2 AND widget.bkgndid=?2 AND widget.shared!=0)",
+    
+    [STMT_WIDGET_OWNER] = "SELECT cardid,bkgndid FROM widget WHERE widgetid=?1",
+    [STMT_WIDGET_CARD] = "SELECT cardid FROM widget WHERE widgetid=?1",
+    [STMT_WIDGET_TYPE] = "SELECT type FROM widget WHERE widgetid=?1",
+    [STMT_WIDGET_TABBABLE] = "SELECT shared,hidden,locked,type FROM widget WHERE widgetid=?1",
+    [STMT_WIDGET_CONTENT_OWNER] = "SELECT cardid,bkgndid,shared FROM widget WHERE widgetid=?1",
+    
+    [STMT_WIDGET_CONTENT] = "SELECT searchable,formatted FROM widget_content "
+        "WHERE widgetid=?1 AND cardid=?2 AND bkgndid=?3",
+    [STMT_WIDGET_CONTENT_UPDATE] = "UPDATE widget_content SET searchable=?4,formatted=?5 "
+        "WHERE widgetid=?1 AND cardid=?2 AND bkgndid=?3",
+    [STMT_WIDGET_CONTENT_INSERT] = "INSERT INTO widget_content VALUES (?1, ?2, ?3, ?4, ?5)",
+    
+    [STMT_WIDGET_NAME] = "SELECT name FROM widget WHERE widgetid=?1",
+    [STMT_WIDGET_LOCKED] = "SELECT locked FROM widget WHERE widgetid=?1",
+    [STMT_WIDGET_DONTSEARCH] = "SELECT dontsearch FROM widget WHERE widgetid=?1",
+    [STMT_WIDGET_SHARED] = "SELECT shared FROM widget WHERE widgetid=?1",
+    [STMT_WIDGET_ICON] = "SELECT iconid FROM widget WHERE widgetid=?1",
+    [STMT_WIDGET_OPTION] = "SELECT value FROM widget_options WHERE widgetid=?1 AND optionid=?2",
+    
+    [STMT_WIDGET_SET_NAME] = "UPDATE widget SET name=?2 WHERE widgetid=?1",
+    [STMT_WIDGET_SET_TYPE] = "UPDATE widget SET type=?2 WHERE widgetid=?1",
+    [STMT_WIDGET_SET_LOCKED] = "UPDATE widget SET locked=?2 WHERE widgetid=?1",
+    [STMT_WIDGET_SET_DONTSEARCH] = "UPDATE widget SET dontsearch=?2 WHERE widgetid=?1",
+    [STMT_WIDGET_SET_SHARED] = "UPDATE widget SET shared=?2 WHERE widgetid=?1",
+    [STMT_WIDGET_SET_ICON] = "UPDATE widget SET iconid=?2 WHERE widgetid=?1",
+    [STMT_WIDGET_SET_OPTION] = "UPDATE widget_options SET value=?3 WHERE widgetid=?1 AND optionid=?2",
+    [STMT_WIDGET_ADD_OPTION] = "INSERT INTO widget_options VALUES (?1, ?2, ?3)",
+    
+    [STMT_SCRIPT_STACK] = "SELECT script,script_cp,script_sel FROM stack",
+    [STMT_SCRIPT_BKGND] = "SELECT script,script_cp,script_sel FROM bkgnd WHERE bkgndid=?1",
+    [STMT_SCRIPT_CARD] = "SELECT script,script_cp,script_sel FROM card WHERE cardid=?1",
+    [STMT_SCRIPT_WIDGET] = "SELECT script,script_cp,script_sel FROM widget WHERE widgetid=?1",
+    
+    [STMT_PICTURE_CARD] = "SELECT visible, data FROM picture_card WHERE cardid=?1",
+    [STMT_PICTURE_BKGND] = "SELECT visible, data FROM picture_bkgnd WHERE bkgndid=?1",
+    
+    [STMT_RESOURCE] = "SELECT resourcename,data FROM resource WHERE resourceid=?1 AND resourcetype=?2",
+    
+    [STMT_WORD_DELETE] = "DELETE FROM widget_word WHERE widgetid=?1 AND cardid=?2 AND bkgndid=?3",
+    [STMT_WORD_INSERT] = "INSERT OR IGNORE INTO widget_word VALUES (?1, ?2, ?3, ?4)",
+};
+
+
+
+/**********
+ Implementation
+ */
+
+#if STACK_STATEMENT_TIMING
+static double _stack_stmt_seconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+#endif
+
+
+/*
+ *  _stack_stmt_begin
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns the prepared statement for the specified query, ready to bind and step.  The statement
+ *  is prepared the first time it is required and thereafter reused.
+ *
+ *  Every call must be balanced by a call to _stack_stmt_end(), which resets the statement, before
+ *  the same statement is used again.  If the statement is already in use (by a calling function)
+ *  a separate, temporary statement is prepared instead.
+ *
+ *  Returns NULL if the statement couldn't be prepared.
+ */
+
+sqlite3_stmt* _stack_stmt_begin(Stack *in_stack, enum StackStatement in_which)
+{
+    assert(in_stack != NULL);
+    assert((in_which >= 0) && (in_which < _STMT_COUNT));
+    
+    struct StackStatementEntry *entry = in_stack->statements + in_which;
+    entry->uses++;
+    
+    /* statement is already in use;
+     prepare a temporary statement */
+    if (entry->in_use)
+    {
+        sqlite3_stmt *stmt;
+        entry->prepares++;
+        if (sqlite3_prepare_v2(in_stack->db, _g_stack_statement_sql[in_which], -1, &stmt, NULL) != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return NULL;
+        }
+        return stmt;
+    }
+    
+    /* prepare the statement if it's not already */
+    if (!entry->stmt)
+    {
+        entry->prepares++;
+        if (sqlite3_prepare_v2(in_stack->db, _g_stack_statement_sql[in_which], -1, &(entry->stmt), NULL) != SQLITE_OK)
+        {
+            sqlite3_finalize(entry->stmt);
+            entry->stmt = NULL;
+            return NULL;
+        }
+    }
+    
+    entry->in_use = STACK_YES;
+#if STACK_STATEMENT_TIMING
+    entry->began = _stack_stmt_seconds();
+#endif
+    return entry->stmt;
+}
+
+
+/*
+ *  _stack_stmt_end
+ *  ---------------------------------------------------------------------------------------------
+ *  Finishes with a statement obtained from _stack_stmt_begin(); the statement is reset and its
+ *  bindings cleared, so that it doesn't hold locks on the database.
+ *
+ *  Any pointers to result column data are invalidated.
+ */
+
+void _stack_stmt_end(Stack *in_stack, enum StackStatement in_which, sqlite3_stmt *in_stmt)
+{
+    assert(in_stack != NULL);
+    assert((in_which >= 0) && (in_which < _STMT_COUNT));
+    
+    if (!in_stmt) return;
+    struct StackStatementEntry *entry = in_stack->statements + in_which;
+    
+    /* dispose of temporary statements */
+    if (in_stmt != entry->stmt)
+    {
+        sqlite3_finalize(in_stmt);
+        return;
+    }
+    
+    sqlite3_reset(in_stmt);
+    sqlite3_clear_bindings(in_stmt);
+    entry->in_use = STACK_NO;
+#if STACK_STATEMENT_TIMING
+    entry->seconds += _stack_stmt_seconds() - entry->began;
+#endif
+}
+
+
+/*
+ *  _stack_stmt_finalize_all
+ *  ---------------------------------------------------------------------------------------------
+ *  Finalizes all the cached statements.  Must be called prior to closing the database.
+ */
+
+void _stack_stmt_finalize_all(Stack *in_stack)
+{
+    assert(in_stack != NULL);
+    for (int i = 0; i < _STMT_COUNT; i++)
+    {
+        if (in_stack->statements[i].stmt) sqlite3_finalize(in_stack->statements[i].stmt);
+        in_stack->statements[i].stmt = NULL;
+        in_stack->statements[i].in_use = STACK_NO;
+    }
+}
+
+
+/*
+ *  stack_statement_report
+ *  ---------------------------------------------------------------------------------------------
+ *  Prints the usage statistics for each cached statement that has been used since the stack was
+ *  opened; the number of uses, how many of those required the statement to be prepared and
+ *  (if STACK_STATEMENT_TIMING is enabled) the total time spent using the statement.
+ */
+
+void stack_statement_report(Stack *in_stack)
+{
+    assert(in_stack != NULL);
+    printf("Stack: Statement cache:\n");
+    for (int i = 0; i < _STMT_COUNT; i++)
+    {
+        struct StackStatementEntry *entry = in_stack->statements + i;
+        if (entry->uses == 0) continue;
+        printf("  %3d: %8ld uses, %5.1f%% hits", i, entry->uses,
+               100.0 * (entry->uses - entry->prepares) / entry->uses);
+#if STACK_STATEMENT_TIMING
+        printf(", %9.3f ms", entry->seconds * 1000.0);
+#endif
+        printf("  %s\n", _g_stack_statement_sql[i]);
+    }
+}
+
+
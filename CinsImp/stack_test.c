@@ -19,6 +19,7 @@
 
 
 void _stack_test_general_integrity_1(void);
+void _stack_test_benchmark_indexes(char const *in_path, long in_card_count);
 
 
 void stack_test(void)
@@ -33,6 +34,10 @@ void stack_test(void)
     //_stack_test_general_integrity_1();
     
     
+    //printf("Stack: Benchmarking lookup indicies...\n");
+    //_stack_test_benchmark_indexes("/Users/josh/Desktop/bench.test.cinsstak", 100000);
+    
+    
     //printf("Stack: Tests completed.\n");
 }
 
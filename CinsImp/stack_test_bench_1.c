@@ -0,0 +1,195 @@
+/*
+ 
+ Stack Tests: Benchmark 1
+ stack_test_bench_1.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Benchmark of the lookup indicies introduced with version 4 of the Stack file format:
+ -  builds a synthetic stack of many cards, each with a card field and a background field
+ -  times field content and card name lookups on the stack as a version 3 file
+ -  times the upgrade of the file by stack_open()
+ -  times the same lookups on the upgraded file
+ 
+ *************************************************************************************************
+ */
+
+#include "stack_int.h"
+
+#include <sys/time.h>
+
+
+#if STACK_TESTS
+
+
+void _stack_card_table_load(Stack *in_stack);
+
+
+static double _bench_seconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+
+static void _bench_progress(char const *in_path, int in_step, int in_step_count, void *in_context)
+{
+    printf("Stack: Benchmark: upgrade step %d of %d\n", in_step, in_step_count);
+}
+
+
+/* builds the synthetic stack directly, as building it via the API would take far too long;
+ returns the stack, open, as a version 3 file */
+static Stack* _bench_build(char const *in_path, long in_card_count)
+{
+    Stack *stack = stack_create(in_path, 512, 342, NULL, NULL);
+    assert(stack != NULL);
+    IDTable *cards = idtable_create(stack);
+    IDTable *widgets = idtable_create(stack);
+    assert(cards && widgets);
+    
+    sqlite3 *db = stack->db;
+    sqlite3_stmt *stmt;
+    char name[64];
+    int err = sqlite3_exec(db, "BEGIN", NULL, NULL, NULL);
+    assert(err == SQLITE_OK);
+    
+    /* the background field */
+    err = sqlite3_exec(db, "INSERT INTO widget (widgetid,cardid,bkgndid,name,type,shared,dontsearch) "
+                       "VALUES (1,-1,1,'Name',1,0,0)", NULL, NULL, NULL);
+    assert(err == SQLITE_OK);
+    idtable_append(widgets, 1);
+    sqlite3_prepare_v2(db, "UPDATE bkgnd SET widgets=?1 WHERE bkgndid=1", -1, &stmt, NULL);
+    idtable_bind(widgets, stmt, 1);
+    err = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    assert(err == SQLITE_DONE);
+    
+    /* the cards, each with a card field and content for both fields */
+    for (long card_id = 1; card_id <= in_card_count; card_id++)
+    {
+        long widget_id = card_id + 1;
+        idtable_append(cards, card_id);
+        idtable_clear(widgets);
+        idtable_append(widgets, widget_id);
+        sprintf(name, "card %ld", card_id);
+        
+        sqlite3_prepare_v2(db, "INSERT OR REPLACE INTO card (cardid,bkgndid,widgets,name,cantdelete,dontsearch,script) "
+                           "VALUES (?1,1,?2,?3,0,0,'')", -1, &stmt, NULL);
+        sqlite3_bind_int(stmt, 1, (int)card_id);
+        idtable_bind(widgets, stmt, 2);
+        sqlite3_bind_text(stmt, 3, name, -1, SQLITE_STATIC);
+        err = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        assert(err == SQLITE_DONE);
+        
+        sqlite3_prepare_v2(db, "INSERT INTO widget (widgetid,cardid,bkgndid,name,type,shared,dontsearch) "
+                           "VALUES (?1,?2,-1,'Notes',1,0,0)", -1, &stmt, NULL);
+        sqlite3_bind_int(stmt, 1, (int)widget_id);
+        sqlite3_bind_int(stmt, 2, (int)card_id);
+        err = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        assert(err == SQLITE_DONE);
+        
+        sqlite3_prepare_v2(db, "INSERT INTO widget_content VALUES (?1,?2,-1,?3,NULL)", -1, &stmt, NULL);
+        sqlite3_bind_int(stmt, 1, 1);
+        sqlite3_bind_int(stmt, 2, (int)card_id);
+        sqlite3_bind_text(stmt, 3, name, -1, SQLITE_STATIC);
+        err = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        sqlite3_bind_int(stmt, 1, (int)widget_id);
+        sqlite3_bind_text(stmt, 3, "Some notes about the card.", -1, SQLITE_STATIC);
+        if (err == SQLITE_DONE) err = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        assert(err == SQLITE_DONE);
+    }
+    
+    /* the card sequence; and make it a version 3 file, without the lookup indicies */
+    sqlite3_prepare_v2(db, "UPDATE stack SET cards=?1,version=3", -1, &stmt, NULL);
+    idtable_bind(cards, stmt, 1);
+    err = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    assert(err == SQLITE_DONE);
+    err = sqlite3_exec(db, "DROP INDEX widget_content_owner; DROP INDEX widget_content_card; "
+                       "DROP INDEX widget_options_widget; DROP INDEX widget_card; DROP INDEX widget_bkgnd; "
+                       "DROP INDEX card_bkgnd; DROP INDEX card_name; DROP INDEX resource_type; COMMIT",
+                       NULL, NULL, NULL);
+    assert(err == SQLITE_OK);
+    
+    idtable_destroy(cards);
+    idtable_destroy(widgets);
+    
+    /* reload the card table */
+    idtable_destroy(stack->stack_card_table);
+    stack->stack_card_table = NULL;
+    _stack_card_table_load(stack);
+    return stack;
+}
+
+
+/* looks up the content of both fields of, and the name of, a selection of cards;
+ returns the elapsed time in seconds */
+static double _bench_lookups(Stack *in_stack, long in_card_count, int in_lookups)
+{
+    assert(stack_card_count(in_stack) == in_card_count);
+    
+    char name[64];
+    char *searchable;
+    double start = _bench_seconds();
+    for (int i = 0; i < in_lookups; i++)
+    {
+        long card_id = stack_card_id_for_index(in_stack, (i * 7919L) % in_card_count);
+        
+        stack_widget_content_get(in_stack, 1, card_id, STACK_NO, &searchable, NULL, NULL, NULL);
+        sprintf(name, "card %ld", card_id);
+        assert(strcmp(searchable, name) == 0);
+        
+        stack_widget_content_get(in_stack, stack_widget_n(in_stack, card_id, STACK_NO_OBJECT, 0), card_id, STACK_NO,
+                                 &searchable, NULL, NULL, NULL);
+        assert(strcmp(searchable, "Some notes about the card.") == 0);
+        
+        assert(stack_card_id_for_name(in_stack, name) == card_id);
+    }
+    return _bench_seconds() - start;
+}
+
+
+void _stack_test_benchmark_indexes(char const *in_path, long in_card_count)
+{
+    int lookups = 200;
+    
+    printf("Stack: Benchmark: building a stack of %ld cards...\n", in_card_count);
+    double start = _bench_seconds();
+    remove(in_path);
+    Stack *stack = _bench_build(in_path, in_card_count);
+    printf("Stack: Benchmark: built in %.2f s\n", _bench_seconds() - start);
+    
+    /* version 3 */
+    double before = _bench_lookups(stack, in_card_count, lookups);
+    stack_close(stack);
+    printf("Stack: Benchmark: %d lookups without indicies: %.3f s\n", lookups, before);
+    
+    /* upgrade to version 4 */
+    stack_set_upgrade_progress_handler(&_bench_progress, NULL);
+    start = _bench_seconds();
+    StackOpenStatus status;
+    stack = stack_open(in_path, NULL, NULL, &status);
+    assert(stack != NULL);
+    stack_set_upgrade_progress_handler(NULL, NULL);
+    printf("Stack: Benchmark: upgraded in %.2f s\n", _bench_seconds() - start);
+    
+    double after = _bench_lookups(stack, in_card_count, lookups);
+    stack_close(stack);
+    printf("Stack: Benchmark: %d lookups with indicies: %.3f s (%.0fx faster)\n", lookups, after,
+           (after > 0 ? before / after : 0));
+    
+    remove(in_path);
+}
+
+
+#endif
+
+
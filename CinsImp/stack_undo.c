@@ -60,10 +60,16 @@ void stack_undo_flush(Stack *in_stack)
 
 void _undo_stack_destroy(Stack *in_stack)
 {
-    if (!in_stack->undo_stack) return;
+    if (in_stack->undo_stack)
+    {
+        stack_undo_flush(in_stack);
+        _stack_free(in_stack->undo_stack);
+        in_stack->undo_stack = NULL;
+    }
     
-    stack_undo_flush(in_stack);
-    if (in_stack->undo_stack) _stack_free(in_stack->undo_stack);
+    /* all undo steps are gone */
+    serarena_destroy(in_stack->undo_arena);
+    in_stack->undo_arena = NULL;
 }
 
 
@@ -74,6 +80,7 @@ void _undo_stack_create(Stack *in_stack)
     in_stack->undo_stack_size = UNDO_STACK_DEPTH;
     in_stack->undo_stack_top = 0;
     in_stack->undo_redo_ptr = 0;
+    in_stack->undo_arena = serarena_create(); /* optional; undo steps use the heap without it */
     for (int i = 0; i < in_stack->undo_stack_size; i++)
     {
         struct UndoFrame *frame = in_stack->undo_stack + i;
@@ -235,7 +242,7 @@ static void _undo_play_step(Stack *in_stack, enum UndoAction in_action, SerBuff
             break;
             
         case UNDO_REARRANGE_WIDGETS:
-            undo_data = serbuff_create(in_stack, NULL, 0, 0);
+            undo_data = serbuff_create_scratch(in_stack);
             if (serbuff_read_long(in_data))
             {
                 card_id = serbuff_read_long(in_data);
@@ -173,7 +173,7 @@ static void _rearrange_widgets(Stack *in_stack, long *in_widgets, int in_count,
     assert(in_sequence_function != NULL);
     
     /* prepare undo record */
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     if (!undo_data) return _stack_panic_void(in_stack, STACK_ERR_MEMORY);
     
     /* split the widgets into their respective card and background layers;
@@ -254,9 +254,7 @@ void stack_widget_owner(Stack *in_stack, long in_widget_id, long *out_card_id, l
     assert(out_card_id != NULL);
     assert(out_bkgnd_id != NULL);
     
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(in_stack->db, "SELECT cardid,bkgndid FROM widget WHERE widgetid=?1",
-                       -1, &stmt, NULL);
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_OWNER);
     sqlite3_bind_int(stmt, 1, (int)in_widget_id);
     if (sqlite3_step(stmt) == SQLITE_ROW)
     {
@@ -268,7 +266,7 @@ void stack_widget_owner(Stack *in_stack, long in_widget_id, long *out_card_id, l
         *out_card_id = STACK_NO_OBJECT;
         *out_bkgnd_id = STACK_NO_OBJECT;
     }
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, STMT_WIDGET_OWNER, stmt);
     
     if (*out_card_id < 1) *out_card_id = STACK_NO_OBJECT;
     if (*out_bkgnd_id < 1) *out_bkgnd_id = STACK_NO_OBJECT;
@@ -316,11 +314,8 @@ static int _widget_tabbable(Stack *in_stack, long in_widget_id, int in_bkgnd)
     assert(in_widget_id > 0);
     assert((in_bkgnd == !0) || (in_bkgnd ==!!0));
     
-    sqlite3_stmt *stmt;
     int tabbable = STACK_YES;
-    sqlite3_prepare_v2(in_stack->db,
-                       "SELECT shared,hidden,locked,type FROM widget WHERE widgetid=?1",
-                       -1, &stmt, NULL);
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_TABBABLE);
     sqlite3_bind_int(stmt, 1, (int)in_widget_id);
     if (sqlite3_step(stmt) == SQLITE_ROW)
     {
@@ -341,7 +336,7 @@ static int _widget_tabbable(Stack *in_stack, long in_widget_id, int in_bkgnd)
             tabbable = STACK_NO;
             break;
     }
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, STMT_WIDGET_TABBABLE, stmt);
     
     if (!stack_is_writable(in_stack)) tabbable = STACK_NO;
     
@@ -383,10 +378,7 @@ void _stack_widget_content_owner(Stack *in_stack, long in_widget_id, long in_cur
     *out_bkgnd_id = STACK_NO_OBJECT;
     
     /* lookup the card, background and shared of the widget */
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(in_stack->db,
-                       "SELECT cardid,bkgndid,shared FROM widget WHERE widgetid=?1",
-                       -1, &stmt, NULL);
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_CONTENT_OWNER);
     sqlite3_bind_int(stmt, 1, (int)in_widget_id);
     int err = sqlite3_step(stmt);
     if (err == SQLITE_ROW)
@@ -406,7 +398,7 @@ void _stack_widget_content_owner(Stack *in_stack, long in_widget_id, long in_cur
         else
             *out_bkgnd_id = sqlite3_column_int(stmt, 1);
     }
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, STMT_WIDGET_CONTENT_OWNER, stmt);
     
     /* ignore database errors for this routine;
      used by get_content() which requires it to silently fail at the moment */
@@ -614,13 +606,12 @@ int stack_widget_is_card(Stack *in_stack, long in_widget_id)
     assert(in_stack != NULL);
     assert(in_widget_id > 0);
     
-    sqlite3_stmt *stmt;
     long card_id = STACK_NO_OBJECT;
-    sqlite3_prepare_v2(in_stack->db, "SELECT cardid FROM widget WHERE widgetid=?1", -1, &stmt, NULL);
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_CARD);
     sqlite3_bind_int(stmt, 1, (int)in_widget_id);
     if (sqlite3_step(stmt) == SQLITE_ROW)
         card_id = sqlite3_column_int(stmt, 0);
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, STMT_WIDGET_CARD, stmt);
     
     return (card_id > 0);
 }
@@ -643,8 +634,7 @@ int stack_widget_is_field(Stack *in_stack, long in_widget_id)
     assert(in_widget_id > 0);
     
     int is_field = 0;
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(in_stack->db, "SELECT type FROM widget WHERE widgetid=?1", -1, &stmt, NULL);
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_TYPE);
     sqlite3_bind_int(stmt, 1, (int)in_widget_id);
     if (sqlite3_step(stmt) == SQLITE_ROW)
     {
@@ -658,7 +648,7 @@ int stack_widget_is_field(Stack *in_stack, long in_widget_id)
                 break;
         }
     }
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, STMT_WIDGET_TYPE, stmt);
     
     return is_field;
 }
@@ -930,18 +920,20 @@ long stack_create_widget(Stack *in_stack, enum Widget in_type, long in_card_id,
     if (!widget_seq) return STACK_NO_OBJECT; /* leaves an orphan record, probably not a big deal given how unlikely it is;
                                               we could clean up later in _compact() */
     idtable_append(widget_seq, widget_id);
+    long widget_index = idtable_size(widget_seq) - 1; /* table is released by _stack_widget_seq_set() */
     _stack_widget_seq_set(in_stack, in_card_id, in_bkgnd_id, widget_seq);
+    _stack_search_cache_invalidate(in_stack);
     
     
     
     
     
     /* record the undo step */
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     if (undo_data)
     {
         serbuff_write_long(undo_data, widget_id);
-        serbuff_write_long(undo_data, idtable_size(widget_seq)-1);
+        serbuff_write_long(undo_data, widget_index);
         _undo_record_step(in_stack, UNDO_WIDGET_CREATE, undo_data);
     }
     
@@ -970,7 +962,7 @@ void stack_delete_widget(Stack *in_stack, long in_widget_id)
     assert(widget_seq != NULL);
     
     /* create the undo step */
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     if (undo_data)
     {
         void *widget_data;
@@ -992,6 +984,8 @@ void stack_delete_widget(Stack *in_stack, long in_widget_id)
     sqlite3_bind_int(stmt, 1, (int)in_widget_id);
     err = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
+    if ((err == SQLITE_DONE) && (!_stack_find_index_delete_widget(in_stack, in_widget_id)))
+        err = SQLITE_ERROR;
     if (err != SQLITE_DONE)
     {
         if (undo_data) serbuff_destroy(undo_data, 1);
@@ -1034,6 +1028,10 @@ void stack_delete_widget(Stack *in_stack, long in_widget_id)
         return _stack_panic_void(in_stack, STACK_ERR_IO);
     }
 
+    /* widget script is gone */
+    _stack_script_changed(in_stack);
+    _stack_search_cache_invalidate(in_stack);
+    
     /* record undo step */
     if (undo_data)
         _undo_record_step(in_stack, UNDO_WIDGET_DELETE, undo_data);
@@ -1053,7 +1051,7 @@ void stack_widget_set_rect(Stack *in_stack, long in_widget_id, long in_x, long i
     assert(in_widget_id > 0);
     
     /* prepare the undo step */
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     sqlite3_stmt *stmt;
     int err;
     if (undo_data)
@@ -1214,11 +1212,8 @@ void stack_widget_content_get(Stack *in_stack, long in_widget_id, long in_card_i
     if ( (!in_bkgnd) || (in_bkgnd && (bkgnd_id != STACK_NO_OBJECT)) )
     {
         /* access the content for the appropriate content owner */
-        sqlite3_stmt *stmt;
         int err;
-        sqlite3_prepare_v2(in_stack->db,
-                           "SELECT searchable,formatted FROM widget_content WHERE widgetid=?1 AND cardid=?2 AND bkgndid=?3",
-                           -1, &stmt, NULL);
+        sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_CONTENT);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_bind_int(stmt, 2, (int)card_id);
         sqlite3_bind_int(stmt, 3, (int)bkgnd_id);
@@ -1240,7 +1235,7 @@ void stack_widget_content_get(Stack *in_stack, long in_widget_id, long in_card_i
         }
         //else printf("stack_widget_content_get: SQLite error: %d\n", err);
         
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, STMT_WIDGET_CONTENT, stmt);
     }
     
     /* return the requested content */
@@ -1284,7 +1279,7 @@ void stack_widget_content_set(Stack *in_stack, long in_widget_id, long in_card_i
     
     /* check if there is any existing content;
      and prepare the undo step */
-    SerBuff *undo_data = serbuff_create(in_stack, NULL, 0, 0);
+    SerBuff *undo_data = serbuff_create_scratch(in_stack);
     //printf("create: \"%s\" (%ld, %ld, %ld)\n", in_searchable, in_widget_id, card_id, bkgnd_id);
     if (undo_data)
     {
@@ -1292,11 +1287,8 @@ void stack_widget_content_set(Stack *in_stack, long in_widget_id, long in_card_i
         serbuff_write_long(undo_data, in_card_id);
     }
     //printf("ids: \"%s\" (%ld, %ld, %ld)\n", in_searchable, in_widget_id, card_id, bkgnd_id);
-    sqlite3_stmt *stmt;
     int existing;
-    sqlite3_prepare_v2(in_stack->db,
-                       "SELECT searchable,formatted FROM widget_content WHERE widgetid=?1 AND cardid=?2 AND bkgndid=?3",
-                       -1, &stmt, NULL);
+    sqlite3_stmt *stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_CONTENT);
     sqlite3_bind_int(stmt, 1, (int)in_widget_id);
     sqlite3_bind_int(stmt, 2, (int)card_id);
     sqlite3_bind_int(stmt, 3, (int)bkgnd_id);
@@ -1324,41 +1316,44 @@ void stack_widget_content_set(Stack *in_stack, long in_widget_id, long in_card_i
             serbuff_write_data(undo_data, "", 0);
         }
     }
-    sqlite3_finalize(stmt);
+    _stack_stmt_end(in_stack, STMT_WIDGET_CONTENT, stmt);
     
     /* update/insert new content */
     int err;
+    _stack_begin(in_stack, STACK_NO_FLAGS);
     if (existing)
     {
         //printf("updating existing \"%s\"\n", in_searchable);
-        sqlite3_prepare_v2(in_stack->db,
-                           "UPDATE widget_content SET searchable=?4,formatted=?5 WHERE widgetid=?1 AND cardid=?2 AND bkgndid=?3",
-                           -1, &stmt, NULL);
+        stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_CONTENT_UPDATE);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_bind_int(stmt, 2, (int)card_id);
         sqlite3_bind_int(stmt, 3, (int)bkgnd_id);
         sqlite3_bind_text(stmt, 4, in_searchable, -1, SQLITE_TRANSIENT);
         sqlite3_bind_blob(stmt, 5, in_formatted, (int)in_formatted_size, SQLITE_TRANSIENT);
         err = sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, STMT_WIDGET_CONTENT_UPDATE, stmt);
     }
     else
     {
         //printf("inserting new \"%s\"\n", in_searchable);
-        sqlite3_prepare_v2(in_stack->db,
-                           "INSERT INTO widget_content VALUES (?1, ?2, ?3, ?4, ?5)",
-                           -1, &stmt, NULL);
+        stmt = _stack_stmt_begin(in_stack, STMT_WIDGET_CONTENT_INSERT);
         sqlite3_bind_int(stmt, 1, (int)in_widget_id);
         sqlite3_bind_int(stmt, 2, (int)card_id);
         sqlite3_bind_int(stmt, 3, (int)bkgnd_id);
         sqlite3_bind_text(stmt, 4, in_searchable, -1, SQLITE_TRANSIENT);
         sqlite3_bind_blob(stmt, 5, in_formatted, (int)in_formatted_size, SQLITE_TRANSIENT);
         err = sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        _stack_stmt_end(in_stack, STMT_WIDGET_CONTENT_INSERT, stmt);
     }
-    if (err != SQLITE_DONE)
+    
+    /* update the find word index */
+    if ((err == SQLITE_DONE) && (!_stack_find_index_content(in_stack, in_widget_id, card_id, bkgnd_id, in_searchable)))
+        err = SQLITE_ERROR;
+    
+    if ((err != SQLITE_DONE) || (_stack_commit(in_stack) != SQLITE_OK))
     {
         if (undo_data) serbuff_destroy(undo_data, STACK_YES);
+        _stack_cancel(in_stack);
         return _stack_panic_void(in_stack, STACK_ERR_IO);
     }
     
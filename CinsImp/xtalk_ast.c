@@ -21,10 +21,12 @@
 XTEAST* _xte_ast_create(XTE *in_engine, XTEASTType in_type)
 {
     //printf("created AST node\n");
-    XTEAST *tree = calloc(sizeof(struct XTEAST), 1);
+    XTEAST *tree = _xte_slab_alloc(in_engine->ast_arena ? in_engine->ast_arena : in_engine->ast_slab);
     if (!tree) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    memset(tree, 0, sizeof(struct XTEAST));
     tree->type = in_type;
     tree->engine = in_engine;
+    tree->var_slot = -1;
     return tree;
 }
 
@@ -143,6 +145,7 @@ XTE_AST_KEYWORD,
 void _xte_ast_destroy(XTEAST *in_tree)
 {
     if (!in_tree) return;
+    struct XTESlab *arena = NULL;
     //printf("destroyed AST node\n");
     for (int i = 0; i < in_tree->children_count; i++)
     {
@@ -160,6 +163,9 @@ void _xte_ast_destroy(XTEAST *in_tree)
             break;
         case XTE_AST_HANDLER:
             if (in_tree->value.handler.name) free(in_tree->value.handler.name);
+            if (in_tree->value.handler.slot_names) free(in_tree->value.handler.slot_names);
+            if (in_tree->value.handler.code) _xte_bytecode_destroy(in_tree->value.handler.code);
+            arena = in_tree->value.handler.arena;
             break;
         case XTE_AST_COMMAND:
             if (in_tree->value.command.named) free(in_tree->value.command.named);
@@ -172,7 +178,10 @@ void _xte_ast_destroy(XTEAST *in_tree)
             break;
     }
     if (in_tree->note) free(in_tree->note);
-    free(in_tree);
+    _xte_slab_free(in_tree);
+    
+    /* the nodes of a compiled handler are released together */
+    if (arena) _xte_slab_dispose(arena);
 }
 
 
@@ -285,7 +294,7 @@ struct XTEASTDebugContext
 
 static void _xte_ast_debug_vwrite(struct XTEASTDebugContext *in_context, const char *in_msg_format, va_list in_args)
 {
-    const char *text = _xte_cstr_format_fill(in_msg_format, in_args);
+    char *text = _xte_cstr_format_fill(in_msg_format, in_args);
     int length = (int)strlen(text);
     if (in_context->buffer_length + length > in_context->buffer_allocated)
     {
@@ -296,6 +305,7 @@ static void _xte_ast_debug_vwrite(struct XTEASTDebugContext *in_context, const c
     }
     strcpy(in_context->buffer + in_context->buffer_length, text);
     in_context->buffer_length += length;
+    free(text);
 }
 
 
@@ -624,6 +634,10 @@ static void _xte_ast_debug_subtree(struct XTEASTDebugContext *in_context, XTEAST
                 case XTE_AST_LOOP_WHILE: desc = "while"; break;
                 case XTE_AST_LOOP_COUNT_UP: desc = "count up"; break;
                 case XTE_AST_LOOP_COUNT_DOWN: desc = "count down"; break;
+                case XTE_AST_LOOP_EACH_CHAR: desc = "each character"; break;
+                case XTE_AST_LOOP_EACH_WORD: desc = "each word"; break;
+                case XTE_AST_LOOP_EACH_LINE: desc = "each line"; break;
+                case XTE_AST_LOOP_EACH_ITEM: desc = "each item"; break;
             }
             _ast_printf(in_context, "%sLOOP %s\n", _ast_indent(in_indent), desc);
             for (int i = 0; i < in_tree->children_count; i++)
@@ -53,6 +53,8 @@ struct XTEChunkData
     
     long write_prefix_insert;
     
+    long element_count; /* -1 unless known without counting the substring */
+    
     /*
     int offset;
     int length;
@@ -203,7 +205,7 @@ char const* _xte_utf8_index_line(char const *const in_string, long const in_line
         
         /* identify the start of the next line (CR, CRLF, LF) */
         if ((ptr[0] == 13) && (ptr[1] == 10)) ptr += 2;
-        else ptr++;
+        else if (ptr[0] != 0) ptr++;
         
         line_index++;
     }
@@ -355,6 +357,221 @@ long _xte_chunk_utf8_line_count(char const *in_string)
 
 
 
+/*********
+ Chunk Index
+ 
+ Finding a word, item or line means scanning the string from the beginning, thus reading each
+ line of a variable in turn would take time proportional to the square of it's length.
+ 
+ Instead, the first chunk expression of each type upon a variable records where every element
+ of that type begins, and the index is kept with the variable until it's value changes
+ (see _xte_variable_write()).  Character offsets are only sampled, every _CHAR_SAMPLE characters,
+ and aren't needed at all if the string is entirely ASCII.
+ */
+
+#define _CHAR_SAMPLE 64
+
+struct XTEChunkElements
+{
+    long count; /* -1 until indexed; as counted by _xte_chunk_utf8_*_count() */
+    long start_count;
+    long *starts; /* byte offset of the start of each element */
+};
+
+struct XTEChunkIndex
+{
+    long bytes;
+    long chars; /* -1 until indexed */
+    long *char_samples; /* byte offset of every _CHAR_SAMPLE'th character; NULL if ASCII */
+    
+    struct XTEChunkElements words;
+    struct XTEChunkElements lines;
+    struct XTEChunkElements items;
+    char *item_delimiter; /* items are indexed for one delimiter at a time */
+};
+
+
+static struct XTEChunkIndex* _xte_chunk_index_create(char const *in_string)
+{
+    struct XTEChunkIndex *index = calloc(1, sizeof(struct XTEChunkIndex));
+    if (!index) return NULL;
+    index->bytes = strlen(in_string);
+    index->chars = -1;
+    index->words.count = -1;
+    index->lines.count = -1;
+    index->items.count = -1;
+    return index;
+}
+
+
+void _xte_chunk_index_dispose(struct XTEChunkIndex *in_index)
+{
+    if (in_index->char_samples) free(in_index->char_samples);
+    if (in_index->words.starts) free(in_index->words.starts);
+    if (in_index->lines.starts) free(in_index->lines.starts);
+    if (in_index->items.starts) free(in_index->items.starts);
+    if (in_index->item_delimiter) free(in_index->item_delimiter);
+    free(in_index);
+}
+
+
+static void _xte_chunk_index_chars(struct XTEChunkIndex *in_index, char const *in_string)
+{
+    if (in_index->chars >= 0) return;
+    in_index->chars = _xte_utf8_strlen(in_string);
+    if (in_index->chars == in_index->bytes) return;
+    
+    in_index->char_samples = malloc(sizeof(long) * (in_index->chars / _CHAR_SAMPLE + 1));
+    if (!in_index->char_samples)
+    {
+        in_index->chars = -1;
+        return;
+    }
+    long char_index = 0;
+    for (long byte_index = 0; byte_index < in_index->bytes; byte_index++)
+    {
+        if ((in_string[byte_index] & 0xC0) == 0x80) continue;
+        if (char_index % _CHAR_SAMPLE == 0)
+            in_index->char_samples[char_index / _CHAR_SAMPLE] = byte_index;
+        char_index++;
+    }
+}
+
+
+/* equivalent to _xte_utf8_index_char() */
+static char const* _xte_chunk_index_char(struct XTEChunkIndex *in_index, char const *in_string, long in_char_offset)
+{
+    assert(in_char_offset >= 0);
+    
+    _xte_chunk_index_chars(in_index, in_string);
+    if (in_index->chars < 0) return _xte_utf8_index_char(in_string, in_char_offset);
+    if (in_char_offset >= in_index->chars) return in_string + in_index->bytes;
+    if (!in_index->char_samples) return in_string + in_char_offset;
+    
+    return _xte_utf8_index_char(in_string + in_index->char_samples[in_char_offset / _CHAR_SAMPLE],
+                                in_char_offset % _CHAR_SAMPLE);
+}
+
+
+/* equivalent to _xte_utf8_count_chars_between() from the beginning of the string */
+static long _xte_chunk_index_chars_before(struct XTEChunkIndex *in_index, char const *in_string, char const *in_ptr)
+{
+    _xte_chunk_index_chars(in_index, in_string);
+    if (in_index->chars < 0) return _xte_utf8_count_chars_between(in_string, in_ptr);
+    if (!in_index->char_samples) return in_ptr - in_string;
+    
+    /* find the last sample before the pointer */
+    long byte_offset = in_ptr - in_string;
+    long low = 0, high = (in_index->chars - 1) / _CHAR_SAMPLE;
+    while (low < high)
+    {
+        long middle = (low + high + 1) / 2;
+        if (in_index->char_samples[middle] <= byte_offset) low = middle;
+        else high = middle - 1;
+    }
+    
+    return low * _CHAR_SAMPLE + _xte_utf8_count_chars_between(in_string + in_index->char_samples[low], in_ptr);
+}
+
+
+/* returns the index of the specified type of element, building it if necessary;
+ or NULL if there isn't enough memory */
+static struct XTEChunkElements* _xte_chunk_index_elements(struct XTEChunkIndex *in_index, char const *in_string,
+                                                          XTEChunkType in_type, char const *in_item_delim)
+{
+    struct XTEChunkElements *elements;
+    switch (in_type)
+    {
+        case XTE_CHUNK_WORD: elements = &(in_index->words); break;
+        case XTE_CHUNK_LINE: elements = &(in_index->lines); break;
+        case XTE_CHUNK_ITEM:
+            elements = &(in_index->items);
+            if (in_index->item_delimiter && (strcmp(in_index->item_delimiter, in_item_delim) != 0))
+            {
+                free(in_index->item_delimiter);
+                in_index->item_delimiter = NULL;
+                free(elements->starts);
+                elements->starts = NULL;
+                elements->count = -1;
+            }
+            break;
+        default: return NULL;
+    }
+    if (elements->count >= 0) return elements;
+    
+    /* count the elements */
+    long count;
+    switch (in_type)
+    {
+        case XTE_CHUNK_WORD: count = _xte_chunk_utf8_word_count(in_string); break;
+        case XTE_CHUNK_LINE: count = _xte_chunk_utf8_line_count(in_string); break;
+        case XTE_CHUNK_ITEM: count = _xte_chunk_utf8_item_count(in_string, in_item_delim); break;
+        default: break;
+    }
+    
+    /* step from the start of one element to the next, as _xte_utf8_index_*() would;
+     the last start recorded may be the end of the string */
+    long start_alloc = count + 2;
+    long *starts = malloc(sizeof(long) * start_alloc);
+    if (!starts) return NULL;
+    long start_count = 0;
+    char const *ptr = (in_type == XTE_CHUNK_WORD ? _xte_utf8_index_word(in_string, 0) : in_string);
+    for (;;)
+    {
+        if (start_count == start_alloc)
+        {
+            long *new_starts = realloc(starts, sizeof(long) * (start_alloc *= 2));
+            if (!new_starts)
+            {
+                free(starts);
+                return NULL;
+            }
+            starts = new_starts;
+        }
+        starts[start_count++] = ptr - in_string;
+        if (*ptr == 0) break;
+        
+        char const *next = ptr;
+        switch (in_type)
+        {
+            case XTE_CHUNK_WORD: next = _xte_utf8_index_word(ptr, 1); break;
+            case XTE_CHUNK_LINE: next = _xte_utf8_index_line(ptr, 1); break;
+            case XTE_CHUNK_ITEM: next = _xte_utf8_index_item(ptr, in_item_delim, 1); break;
+            default: break;
+        }
+        if (next == ptr) break;
+        ptr = next;
+    }
+    
+    if (in_type == XTE_CHUNK_ITEM)
+    {
+        in_index->item_delimiter = malloc(strlen(in_item_delim) + 1);
+        if (!in_index->item_delimiter)
+        {
+            free(starts);
+            return NULL;
+        }
+        strcpy(in_index->item_delimiter, in_item_delim);
+    }
+    elements->count = count;
+    elements->start_count = start_count;
+    elements->starts = starts;
+    return elements;
+}
+
+
+/* equivalent to _xte_utf8_index_word(), _line() and _item() from the beginning of the string */
+static char const* _xte_chunk_index_element(struct XTEChunkIndex *in_index, struct XTEChunkElements *in_elements,
+                                            char const *in_string, long in_element_offset)
+{
+    assert(in_element_offset >= 0);
+    if (in_element_offset >= in_elements->start_count) return in_string + in_index->bytes;
+    return in_string + in_elements->starts[in_element_offset];
+}
+
+
+
+
 /*********
  Chunk Computation
  */
@@ -377,7 +594,9 @@ static long _xte_chunk_max(long in_1, long in_2)
 }
 
 
-static void _xte_chunk_compute(XTEChunkData *io_chunk, char const *in_parent_string, char const *in_item_delim)
+/* the index, if any, describes in_parent_string and is used instead of scanning it */
+static void _xte_chunk_compute(XTEChunkData *io_chunk, char const *in_parent_string, char const *in_item_delim,
+                               struct XTEChunkIndex *in_index)
 {
     if (io_chunk->parent_chunk && (io_chunk->parent_chunk->range_chars.length == 0))
     {
@@ -396,21 +615,43 @@ static void _xte_chunk_compute(XTEChunkData *io_chunk, char const *in_parent_str
     /* setup some variables */
     char const *parent_string;
     long parent_bytes;
-    long parent_chars;
     
     if (!in_parent_string) parent_string = io_chunk->parent_chunk->substring;
     else parent_string = in_parent_string;
-    parent_bytes = strlen(parent_string);
-    parent_chars = _xte_utf8_strlen(parent_string);
+    parent_bytes = (in_index ? in_index->bytes : strlen(parent_string));
     
     /* locate the start and end of the chunk range */
     char const *start;
     char const *end;
+    struct XTEChunkElements *elements = NULL;
+    if (in_index && (io_chunk->type != XTE_CHUNK_CHAR))
+        elements = _xte_chunk_index_elements(in_index, parent_string, io_chunk->type, in_item_delim);
     if ((io_chunk->range.offset < 0) && (io_chunk->range.length < 0))
     {
         /* return the entire container */
         start = parent_string;
-        end = _xte_utf8_end(parent_string);
+        end = parent_string + parent_bytes;
+    }
+    else if (in_index && (io_chunk->type == XTE_CHUNK_CHAR))
+    {
+        start = _xte_chunk_index_char(in_index, parent_string, io_chunk->range.offset);
+        end = _xte_utf8_index_char(start, io_chunk->range.length);
+    }
+    else if (elements)
+    {
+        start = _xte_chunk_index_element(in_index, elements, parent_string, io_chunk->range.offset);
+        if (io_chunk->range.length > 0)
+            end = _xte_chunk_index_element(in_index, elements, parent_string,
+                                           io_chunk->range.offset + io_chunk->range.length - 1);
+        else
+            end = start;
+        switch (io_chunk->type)
+        {
+            case XTE_CHUNK_WORD: end = _xte_utf8_index_word_end(end); break;
+            case XTE_CHUNK_ITEM: end = _xte_utf8_index_item_end(end, in_item_delim); break;
+            case XTE_CHUNK_LINE: end = _xte_utf8_index_line_end(end); break;
+            default: break;
+        }
     }
     else
     {
@@ -459,7 +700,8 @@ static void _xte_chunk_compute(XTEChunkData *io_chunk, char const *in_parent_str
     io_chunk->range_bytes.offset = start - parent_string +
     (io_chunk->parent_chunk ? io_chunk->parent_chunk->range_bytes.offset : 0);
     io_chunk->range_bytes.length = end - start;
-    io_chunk->range_chars.offset = _xte_utf8_count_chars_between(parent_string, start) + // need to count chars from start of substring to start
+    io_chunk->range_chars.offset = (in_index ? _xte_chunk_index_chars_before(in_index, parent_string, start) :
+                                    _xte_utf8_count_chars_between(parent_string, start)) + // need to count chars from start of substring to start
     (io_chunk->parent_chunk ? io_chunk->parent_chunk->range_chars.offset : 0);
     io_chunk->range_chars.length = _xte_utf8_strlen(io_chunk->substring);
     io_chunk->write_prefix_insert = 0;
@@ -467,16 +709,26 @@ static void _xte_chunk_compute(XTEChunkData *io_chunk, char const *in_parent_str
     /* count the number of io_chunk->type(s) in parent_string,
     if range.offset > than that count.... */
     long count_elements;
+    if (elements)
+        count_elements = elements->count;
+    else if (in_index && (io_chunk->type == XTE_CHUNK_CHAR))
+        count_elements = _xte_chunk_index_chars_before(in_index, parent_string, parent_string + parent_bytes);
+    else
+    {
     switch (io_chunk->type)
     {
         case XTE_CHUNK_CHAR: count_elements = _xte_utf8_strlen(parent_string); break;
         case XTE_CHUNK_ITEM: count_elements = _xte_chunk_utf8_item_count(parent_string, in_item_delim); break;
-        case XTE_CHUNK_LINE:
-            count_elements = _xte_chunk_utf8_line_count(parent_string);
-            if (parent_string[0] == 0) count_elements = 1;
-            break;
+            case XTE_CHUNK_LINE: count_elements = _xte_chunk_utf8_line_count(parent_string); break;
         case XTE_CHUNK_WORD: count_elements = _xte_chunk_utf8_word_count(parent_string); break;
     }
+    }
+    
+    /* the entire container knows how many elements it has */
+    if ((io_chunk->range.offset < 0) && (io_chunk->range.length < 0) && in_index)
+        io_chunk->element_count = count_elements;
+    
+    if ((io_chunk->type == XTE_CHUNK_LINE) && (parent_string[0] == 0)) count_elements = 1;
     if (io_chunk->range.offset + 1 > count_elements)
     {
         /* specified element doesn't exist;
@@ -495,7 +747,8 @@ static void _xte_chunk_compute(XTEChunkData *io_chunk, char const *in_parent_str
         io_chunk->range_chars.offset = (io_chunk->parent_chunk ?
                                         io_chunk->parent_chunk->range_chars.offset +
                                         io_chunk->parent_chunk->range_chars.length :
-                                        parent_chars);
+                                        (in_index ? _xte_chunk_index_chars_before(in_index, parent_string, parent_string + parent_bytes) :
+                                         _xte_utf8_strlen(parent_string)));
         io_chunk->range_chars.length = 0;
         
         //io_chunk->write_prefix_insert -= io_chunk->range_chars.offset;
@@ -513,7 +766,8 @@ static void _xte_chunk_delete(XTEChunkData *in_chunk)
 
 /* call this to get started with a non-chunk container */
 XTEChunkData* _xte_chunk_new_with_string(void *in_container_ref, char const *in_container_string,
-                                         XTEChunkType in_type, XTETextRange in_script_range, char const *in_item_delim)
+                                         XTEChunkType in_type, XTETextRange in_script_range, char const *in_item_delim,
+                                         struct XTEChunkIndex *in_index)
 {
     struct XTEChunkData *chunk = calloc(1, sizeof(struct XTEChunkData));
     if (!chunk) return NULL;
@@ -522,8 +776,9 @@ XTEChunkData* _xte_chunk_new_with_string(void *in_container_ref, char const *in_
     chunk->parent_chunk = NULL;//in_parent_chunk;
     chunk->type = in_type;
     chunk->range = in_script_range;
+    chunk->element_count = -1;
     
-    _xte_chunk_compute(chunk, in_container_string, in_item_delim);
+    _xte_chunk_compute(chunk, in_container_string, in_item_delim, in_index);
     
     return chunk;
 }
@@ -540,8 +795,9 @@ XTEChunkData* _xte_chunk_new_with_chunk(struct XTEChunkData *in_parent_chunk,
     chunk->parent_chunk = in_parent_chunk;
     chunk->type = in_type;
     chunk->range = in_script_range;
+    chunk->element_count = -1;
     
-    _xte_chunk_compute(chunk, NULL, in_item_delim);
+    _xte_chunk_compute(chunk, NULL, in_item_delim, NULL);
     
     return chunk;
 }
@@ -549,6 +805,7 @@ XTEChunkData* _xte_chunk_new_with_chunk(struct XTEChunkData *in_parent_chunk,
 
 static long _xte_chunk_element_count(XTEChunkData *in_chunk, char const *in_item_delim)
 {
+    if (in_chunk->element_count >= 0) return in_chunk->element_count;
     switch (in_chunk->type)
     {
         case XTE_CHUNK_CHAR: return _xte_utf8_strlen(in_chunk->substring);
@@ -640,6 +897,84 @@ int _xte_chunk_prepare_write(XTE *in_engine, XTEChunkData *in_chunk, char const
 
 
 
+/*********
+ Iteration
+ 
+ "repeat for each" walks a string with a cursor, rather than finding each element from the
+ beginning of the string; the elements are the same as "line 1 of", "line 2 of", etc. up to
+ "the number of lines of".
+ */
+
+static XTEChunkType _xte_chunk_each_type(int in_loop)
+{
+    switch (in_loop)
+    {
+        case XTE_AST_LOOP_EACH_WORD: return XTE_CHUNK_WORD;
+        case XTE_AST_LOOP_EACH_LINE: return XTE_CHUNK_LINE;
+        case XTE_AST_LOOP_EACH_ITEM: return XTE_CHUNK_ITEM;
+        default: break;
+    }
+    return XTE_CHUNK_CHAR;
+}
+
+
+/* returns the number of elements; the cursor is set to the byte offset of the first */
+long _xte_chunk_each_begin(char const *in_string, int in_loop, char const *in_item_delim, long *out_offset)
+{
+    *out_offset = 0;
+    switch (_xte_chunk_each_type(in_loop))
+    {
+        case XTE_CHUNK_CHAR: return _xte_utf8_strlen(in_string);
+        case XTE_CHUNK_WORD:
+            *out_offset = _xte_utf8_index_word(in_string, 0) - in_string;
+            return _xte_chunk_utf8_word_count(in_string);
+        case XTE_CHUNK_LINE: return _xte_chunk_utf8_line_count(in_string);
+        case XTE_CHUNK_ITEM: return _xte_chunk_utf8_item_count(in_string, in_item_delim);
+    }
+    return 0;
+}
+
+
+/* returns the element at the cursor, and advances the cursor to the next */
+XTEVariant* _xte_chunk_each_next(XTE *in_engine, char const *in_string, int in_loop, char const *in_item_delim, long *io_offset)
+{
+    char const *start = in_string + *io_offset;
+    char const *end, *next;
+    switch (_xte_chunk_each_type(in_loop))
+    {
+        case XTE_CHUNK_CHAR:
+            end = next = _xte_utf8_index_char(start, 1);
+            break;
+        case XTE_CHUNK_WORD:
+            end = _xte_utf8_index_word_end(start);
+            next = _xte_utf8_index_word(start, 1);
+            break;
+        case XTE_CHUNK_LINE:
+            end = _xte_utf8_index_line_end(start);
+            next = _xte_utf8_index_line(start, 1);
+            break;
+        case XTE_CHUNK_ITEM:
+            end = _xte_utf8_index_item_end(start, in_item_delim);
+            next = _xte_utf8_index_item(start, in_item_delim, 1);
+            break;
+    }
+    *io_offset = next - in_string;
+    
+    XTEVariant *result = xte_variant_create(in_engine);
+    if (!result) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    result->type = XTE_TYPE_STRING;
+    result->value.utf8_string = _xte_chunk_substring(start, end);
+    if (!result->value.utf8_string)
+    {
+        xte_variant_release(result);
+        return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    }
+    return result;
+}
+
+
+
+
 /*********
  Engine-Chunk Implementation Glue
  */
@@ -660,14 +995,32 @@ static void _xte_chunk_ref_dealloc(XTEVariant *in_variant, const char *in_type,
 
 static XTEVariant* _xte_chunk_ref_build(XTE *in_engine, XTEVariant *in_owner, XTEVariant *in_params[], int in_param_count, XTEChunkType in_type)
 {
-    /* get value of owner as string
-     (without resolving the owner if it's a reference) */
-    XTEVariant *value = xte_variant_value(in_engine, in_owner);
-    if (!xte_variant_convert(in_engine, value, XTE_TYPE_STRING))
+    /* a variable containing a string is used directly, along with it's index;
+     see Chunk Index */
+    XTEVariant *value = NULL;
+    struct XTEVariable *variable = NULL;
+    if (in_owner && (in_owner->type == XTE_TYPE_GLOBAL))
+        variable = _xte_variable_lookup(in_engine, in_owner);
+    if (variable && variable->value && (variable->value->type == XTE_TYPE_STRING))
     {
-        xte_variant_release(value);
-        xte_callback_error(in_engine, "Expected string here.", NULL, NULL, NULL);
-        return NULL;
+        if (!variable->chunk_index)
+            variable->chunk_index = _xte_chunk_index_create(variable->value->value.utf8_string);
+        value = variable->value;
+        xte_variant_retain(value);
+    }
+    else
+    {
+        variable = NULL;
+        
+        /* get value of owner as string
+         (without resolving the owner if it's a reference) */
+        value = xte_variant_value(in_engine, in_owner);
+        if (!xte_variant_convert(in_engine, value, XTE_TYPE_STRING))
+        {
+            xte_variant_release(value);
+            xte_callback_error(in_engine, "Expected string here.", NULL, NULL, NULL);
+            return NULL;
+        }
     }
     
     /* decode chunk parameters */
@@ -709,7 +1062,8 @@ static XTEVariant* _xte_chunk_ref_build(XTE *in_engine, XTEVariant *in_owner, XT
                                            xte_variant_as_cstring(value),
                                            in_type,
                                            _xte_text_make_range(the_offset, the_length),
-                                           in_engine->item_delimiter);
+                                           in_engine->item_delimiter,
+                                           (variable ? variable->chunk_index : NULL));
         chunk->parent_chunk_ref = NULL;
     }
     xte_variant_release(value);
@@ -47,6 +47,7 @@ static struct XTEClassInt* _xte_class_add(XTE *in_engine, struct XTEClassDef *in
     the_class->container_write = in_def->container_write;
     the_class->script_retr = in_def->script_retr;
     the_class->next_responder = in_def->next_responder;
+    the_class->script_ident = in_def->script_ident;
     
     /* add the class' properties */
     the_class->properties = calloc(in_def->property_count, sizeof(struct XTEPropertyInt*));
@@ -183,7 +184,9 @@ static XTEVariant* _bi_system_version(XTE *in_engine, void *in_context, int in_p
 
 static XTEVariant* _bi_system_name(XTE *in_engine, void *in_context, int in_prop, XTEVariant *in_owner, XTEPropRep in_representation)
 {
-    return xte_string_create_with_cstring(in_engine, _xte_platform_sys());
+    char buffer[64];
+    _xte_platform_sys(buffer, sizeof(buffer));
+    return xte_string_create_with_cstring(in_engine, buffer);
 }
 
 static XTEVariant* _bi_system_test(XTE *in_engine, void *in_context, int in_prop, XTEVariant *in_owner, XTEPropRep in_representation)
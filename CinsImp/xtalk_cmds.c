@@ -130,6 +130,7 @@ static void _match_element_end(struct CmdMatchContext *in_context, int in_succes
         for (int i = frame->old_param_list_size; i < in_context->param_list_size; i++)
         {
             if (in_context->param_list[i].name) free(in_context->param_list[i].name);
+            if (in_context->param_list[i].value) free(in_context->param_list[i].value);
         }
         in_context->param_list_size = frame->old_param_list_size;
     }
@@ -367,7 +368,11 @@ static int _xte_cmd_stmt_matches(XTE *in_engine, XTEAST *in_stmt, XTECmdPattern
         param->value.string = _xte_clone_cstr(in_engine, context.param_list[i].name);
         
         if ((context.param_list[i].offset < 0) && (context.param_list[i].length < 0))
-            _xte_ast_list_append(param, _xte_ast_create_word(in_engine, context.param_list[i].value));
+        {
+            XTEAST *keyword = _xte_ast_create_word(in_engine, context.param_list[i].value);
+            if (keyword) keyword->flags |= XTE_AST_FLAG_KEYWORD;
+            _xte_ast_list_append(param, keyword);
+        }
         else if ((context.param_list[i].offset >= 0) && (context.param_list[i].length > 0))
         {
             for (int j = 0; j < context.param_list[i].length; j++)
@@ -540,6 +545,7 @@ static int _xte_find_and_parse_command(XTE *in_engine, XTEAST *in_stmt, long in_
                 temp_tree->note = _xte_clone_cstr(in_engine, prefix->prefix_word);
                 temp_tree->value.command.ptr = cmd->imp;
                 temp_tree->value.command.named = _xte_clone_cstr(in_engine, prefix->prefix_word);
+                temp_tree->value.command.builtin = cmd->builtin;
                 /* eventually going to need to fill this with the command name, eg. prefix word,
                                                         also keep ptr, so that we know which grammar was triggered and can avoid issues
                                                         at the end of the message handling protocol... **TODO** */
@@ -617,6 +623,13 @@ static struct XTECmdPrefix* _cmd_prefix(XTE *in_engine, const char *in_prefix_wo
     assert(in_prefix_word != NULL);
     assert(IS_BOOL(in_create_new));
     
+    /* when parsing, the prefix table is searched via the hashed dictionary */
+    if (!in_create_new)
+    {
+        struct XTETerm const *term = _xte_dict_first(in_engine, XTE_TERM_COMMAND, in_prefix_word);
+        return (term ? term->def : NULL);
+    }
+    
     /* check if the specified prefix word is already in the prefix table;
      if it is, return a pointer to the appropriate entry, otherwise
      create and return a new entry in the prefix table */
@@ -625,7 +638,6 @@ static struct XTECmdPrefix* _cmd_prefix(XTE *in_engine, const char *in_prefix_wo
         if (_xte_compare_cstr(in_engine->cmd_prefix_table[i].prefix_word, in_prefix_word) == 0)
             return &(in_engine->cmd_prefix_table[i]); /* return matching prefix entry */
     }
-    if (!in_create_new) return NULL; /* not found */
     
     /* create a new prefix entry */
     struct XTECmdPrefix *new_prefix_table = realloc(in_engine->cmd_prefix_table,
@@ -651,6 +663,19 @@ static void _xte_command_add(XTE *in_engine, struct XTECommandDef *in_def)
     
     /* obtain a prefix table entry for this command definition */
     struct XTECmdPrefix *prefix = _cmd_prefix(in_engine, _xte_first_word(in_engine, in_def->syntax), XTE_TRUE);
+    if (!prefix) return;
+    
+    /* the syntaxes of a built-in prefix are shared with other engines, so must be copied
+     before they can be extended, see xtalk_vocab.c */
+    XTE const *base = _xte_vocab_shared(in_engine);
+    long prefix_index = prefix - in_engine->cmd_prefix_table;
+    if (base && (prefix_index < base->cmd_prefix_count) && (prefix->commands == base->cmd_prefix_table[prefix_index].commands))
+    {
+        struct XTECmdInt *own_commands = malloc(sizeof(struct XTECmdInt) * prefix->command_count);
+        if (!own_commands) return _xte_panic_void(in_engine, XTE_ERROR_MEMORY, NULL);
+        memcpy(own_commands, prefix->commands, sizeof(struct XTECmdInt) * prefix->command_count);
+        prefix->commands = own_commands;
+    }
 
     /* append this command definition to the prefix table entry */
     struct XTECmdInt *new_commands = realloc(prefix->commands, sizeof(struct XTECmdInt) * (prefix->command_count + 1));
@@ -658,6 +683,7 @@ static void _xte_command_add(XTE *in_engine, struct XTECommandDef *in_def)
     prefix->commands = new_commands;
     struct XTECmdInt *cmd = &(new_commands[prefix->command_count++]);
     cmd->imp = in_def->imp;
+    cmd->builtin = (_xte_vocab_shared(in_engine) == NULL); /* see _xte_function_add() */
     //cmd->pattern = NULL;
     cmd->pattern = _xte_bnf_parse(in_def->syntax);
     _xte_itemize_cstr(in_engine, in_def->params, ",", &(cmd->params), &(cmd->param_count));
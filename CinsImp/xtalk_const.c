@@ -45,11 +45,12 @@ void _xte_parse_consts(XTE *in_engine, XTEAST *in_stmt)
         XTEAST *child = in_stmt->children[i];
         if (child->type == XTE_AST_WORD)
         {
-            /* iterate through constants */
-            for (int j = in_engine->cons_count-1; j >= 0; j--)
+            /* iterate through constants beginning with this word */
+            for (struct XTETerm const *term = _xte_dict_first(in_engine, XTE_TERM_CONSTANT, child->value.string);
+                 term; term = _xte_dict_next(in_engine, term))
             {
                 /* compare constant against statement */
-                struct XTEConstantInt *cons = &(in_engine->cons[j]);
+                struct XTEConstantInt *cons = term->def;
                 if (i + cons->word_count >= in_stmt->children_count + 1) continue;
                 
                 int w;
@@ -208,6 +208,7 @@ static void _xte_cmd_convert_date(XTE *in_engine, void *in_context, XTEVariant *
             if (component_count != 7)
             {
                 _xte_cstrs_free(components, component_count);
+                xte_variant_release(value);
                 xte_callback_error(in_engine, "Expected dateItems here.", NULL, NULL, NULL);
                 return;
             }
@@ -223,11 +224,13 @@ static void _xte_cmd_convert_date(XTE *in_engine, void *in_context, XTEVariant *
         /* assume a timestamp */
         if (!xte_variant_convert(in_engine, value, XTE_TYPE_NUMBER))
         {
+            xte_variant_release(value);
             xte_callback_error(in_engine, "Expected number or string here.", NULL, NULL, NULL);
             return;
         }
-        _xte_os_conv_timestamp(in_engine->os_datetime_context, xte_variant_as_double(in_params[0]));
+        _xte_os_conv_timestamp(in_engine->os_datetime_context, xte_variant_as_double(value));
     }
+    xte_variant_release(value);
     
     /* convert to requested output format */
     XTEVariant *result = NULL;
@@ -270,6 +273,8 @@ static void _xte_cmd_convert_date(XTE *in_engine, void *in_context, XTEVariant *
     /* otherwise, set "it" to the result */
     else if (result)
         xte_set_global(in_engine, "it", result);
+    
+    xte_variant_release(result);
 }
 
 
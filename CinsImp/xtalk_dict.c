@@ -0,0 +1,186 @@
+/*
+ 
+ xTalk Engine Terminology Dictionary Unit
+ xtalk_dict.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Hashed index of the terminology dictionary, keyed on a single case-insensitive word, so that
+ the parser can find the few terms that might begin (or end) at a given position within a
+ statement, without scanning the entire vocabulary.
+ 
+ *************************************************************************************************
+ */
+
+#include "xtalk_internal.h"
+
+
+/*********
+ Configuration
+ */
+
+#define _EMPTY_SLOT -1
+
+
+
+/*********
+ Implementation
+ */
+
+/* the dictionary refers to the words of the existing terminology tables, and so is discarded
+ whenever terminology is added, see xte_configure_environment() */
+void _xte_dict_dispose(XTE *in_engine)
+{
+    struct XTEDictionary *dict = in_engine->dict;
+    if (!dict) return;
+    in_engine->dict = NULL;
+    
+    /* the dictionary of the built-in vocabulary is shared, see xtalk_vocab.c */
+    XTE const *base = _xte_vocab_shared(in_engine);
+    if (base && (dict == base->dict)) return;
+    
+    if (dict->terms) free(dict->terms);
+    if (dict->table) free(dict->table);
+    free(dict);
+}
+
+
+static int _xte_dict_slot(struct XTEDictionary *in_dict, enum XTETermKind in_kind, unsigned long in_hash)
+{
+    return (int)((in_hash + (unsigned long)in_kind * 31) & (in_dict->table_size - 1));
+}
+
+
+/* adds a term to the front of its bucket;
+ terms must therefore be added in the reverse of the order in which they should be found */
+static void _xte_dict_add(struct XTEDictionary *in_dict, enum XTETermKind in_kind, char const *in_word, void *in_def)
+{
+    struct XTETerm *term = in_dict->terms + in_dict->term_count;
+    term->kind = in_kind;
+    term->word = in_word;
+    term->hash = _xte_cstr_case_hash(in_word);
+    term->def = in_def;
+    
+    int slot = _xte_dict_slot(in_dict, in_kind, term->hash);
+    term->next = in_dict->table[slot];
+    in_dict->table[slot] = in_dict->term_count++;
+}
+
+
+/* the terms of each kind are found in the same order that the parser previously searched the
+ corresponding terminology table */
+struct XTEDictionary* _xte_dict_build(XTE *in_engine)
+{
+    struct XTEDictionary *dict = calloc(1, sizeof(struct XTEDictionary));
+    if (!dict) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    in_engine->dict = dict;
+    
+    int term_count = in_engine->syns_count + in_engine->cons_count + in_engine->ref_count + in_engine->func_count +
+        in_engine->cmd_prefix_count + (in_engine->global_prop_count + in_engine->class_prop_count) * 2;
+    dict->table_size = 16;
+    while (dict->table_size < term_count * 2)
+        dict->table_size *= 2;
+    
+    dict->terms = malloc(sizeof(struct XTETerm) * (term_count + 1));
+    dict->table = malloc(sizeof(int) * dict->table_size);
+    if ((!dict->terms) || (!dict->table))
+    {
+        _xte_dict_dispose(in_engine);
+        return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    }
+    for (int i = 0; i < dict->table_size; i++)
+        dict->table[i] = _EMPTY_SLOT;
+    
+    /* synonyms, constants and references are searched from the end of their tables */
+    for (int i = 0; i < in_engine->syns_count; i++)
+    {
+        if (in_engine->syns[i].word_count > 0)
+            _xte_dict_add(dict, XTE_TERM_SYNONYM, in_engine->syns[i].words[0], in_engine->syns + i);
+    }
+    for (int i = 0; i < in_engine->cons_count; i++)
+    {
+        if (in_engine->cons[i].word_count > 0)
+            _xte_dict_add(dict, XTE_TERM_CONSTANT, in_engine->cons[i].words[0], in_engine->cons + i);
+    }
+    for (int i = 0; i < in_engine->ref_count; i++)
+    {
+        if (in_engine->refs[i].word_count > 0)
+            _xte_dict_add(dict, XTE_TERM_REF, in_engine->refs[i].words[0], in_engine->refs + i);
+    }
+    
+    /* functions, commands and properties are searched from the beginning */
+    for (int i = in_engine->func_count - 1; i >= 0; i--)
+        _xte_dict_add(dict, XTE_TERM_FUNCTION, in_engine->funcs[i]->name, in_engine->funcs[i]);
+    for (int i = in_engine->cmd_prefix_count - 1; i >= 0; i--)
+        _xte_dict_add(dict, XTE_TERM_COMMAND, in_engine->cmd_prefix_table[i].prefix_word, in_engine->cmd_prefix_table + i);
+    for (int i = in_engine->global_prop_count - 1; i >= 0; i--)
+    {
+        struct XTEPropertyInt *prop = in_engine->global_props[i];
+        if (prop->word_count == 0) continue;
+        _xte_dict_add(dict, XTE_TERM_PROPERTY, prop->words[0], prop);
+        _xte_dict_add(dict, XTE_TERM_PROPERTY_LAST, prop->words[prop->word_count - 1], prop);
+    }
+    for (int i = in_engine->class_prop_count - 1; i >= 0; i--)
+    {
+        struct XTEPropertyInt *prop = in_engine->class_props[i];
+        if (prop->word_count == 0) continue;
+        _xte_dict_add(dict, XTE_TERM_CLASS_PROPERTY, prop->words[0], prop);
+        _xte_dict_add(dict, XTE_TERM_CLASS_PROPERTY_LAST, prop->words[prop->word_count - 1], prop);
+    }
+    
+    return dict;
+}
+
+
+/* returns the first of the specified terms within the bucket, beginning with term <in_index> */
+static struct XTETerm const* _xte_dict_match(struct XTEDictionary *in_dict, int in_index, enum XTETermKind in_kind,
+                                             char const *in_word, unsigned long in_hash)
+{
+    for (; in_index != _EMPTY_SLOT; in_index = in_dict->terms[in_index].next)
+    {
+        struct XTETerm const *term = in_dict->terms + in_index;
+        if ((term->kind == in_kind) && (term->hash == in_hash) && (_xte_compare_cstr(term->word, in_word) == 0))
+            return term;
+    }
+    return NULL;
+}
+
+
+/*
+ *  _xte_dict_first
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns the first term of the specified kind which is keyed on <in_word>, or NULL if there
+ *  are none.  Builds the dictionary if necessary.
+ */
+
+struct XTETerm const* _xte_dict_first(XTE *in_engine, enum XTETermKind in_kind, char const *in_word)
+{
+    assert(IS_XTE(in_engine));
+    assert(in_word != NULL);
+    
+    struct XTEDictionary *dict = in_engine->dict;
+    if (!dict) dict = _xte_dict_build(in_engine);
+    if (!dict) return NULL;
+    
+    unsigned long hash = _xte_cstr_case_hash(in_word);
+    return _xte_dict_match(dict, dict->table[_xte_dict_slot(dict, in_kind, hash)], in_kind, in_word, hash);
+}
+
+
+/*
+ *  _xte_dict_next
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns the next term of the same kind and word as <in_term>, or NULL if there are no more.
+ */
+
+struct XTETerm const* _xte_dict_next(XTE *in_engine, struct XTETerm const *in_term)
+{
+    assert(IS_XTE(in_engine));
+    assert(in_term != NULL);
+    
+    return _xte_dict_match(in_engine->dict, in_term->next, in_term->kind, in_term->word, in_term->hash);
+}
+
+
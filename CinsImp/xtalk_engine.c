@@ -22,14 +22,6 @@
  Initalization
  */
 
-void _xte_synonyms_add_builtins(XTE *in_engine);
-void _xte_classes_add_builtins(XTE *in_engine);
-void _xte_constants_add_builtins(XTE *in_engine);
-void _xte_properties_add_builtins(XTE *in_engine);
-void _xte_elements_add_builtins(XTE *in_engine);
-void _xte_functions_add_builtins(XTE *in_engine);
-void _xte_commands_add_builtins(XTE *in_engine);
-
 XTE* xte_create(void *in_context)
 {
     /* create an engine */
@@ -39,23 +31,38 @@ XTE* xte_create(void *in_context)
     strcpy(engine->struct_id, _XTE_STRUCT_ID);
     
     engine->handler_stack_ptr = -1;
+#if XTALK_TESTS
+    engine->use_bytecode = _g_xte_test_use_bytecode;
+#else
+    engine->use_bytecode = XTE_TRUE;
+#endif
     
     engine->context = in_context;
     
+    /* initalize the engine's built-in language terminology;
+     the terminology is built once, on first use, and is never disposed */
+    if (!_xte_vocab_share(engine))
+    {
+        free(engine);
+        return NULL;
+    }
+    
 #if DEBUG
     /* save how many bytes have been allocated at this point */
     engine->init_alloc_bytes = _xte_mem_allocated();
     _xte_mem_baseline();
 #endif
     
-    /* initalize the engine's built-in language terminology */
-    _xte_synonyms_add_builtins(engine);
-    _xte_classes_add_builtins(engine);
-    _xte_properties_add_builtins(engine);
-    _xte_constants_add_builtins(engine);
-    _xte_elements_add_builtins(engine);
-    _xte_functions_add_builtins(engine);
-    _xte_commands_add_builtins(engine);
+    /* create the slabs for variants and AST nodes */
+    engine->variant_slab = _xte_slab_create("variant", sizeof(struct XTEVariant));
+    engine->ast_slab = _xte_slab_create("ast", sizeof(struct XTEAST));
+    if ((!engine->variant_slab) || (!engine->ast_slab))
+    {
+        _xte_slab_dispose(engine->variant_slab);
+        _xte_slab_dispose(engine->ast_slab);
+        free(engine);
+        return NULL;
+    }
     
     /* initalize random number generator */
     srand((unsigned int)time(NULL));
@@ -82,132 +89,18 @@ XTE* xte_create(void *in_context)
 
 void xte_dispose(XTE *in_engine)
 {
+#if XTALK_TESTS
+    _xte_vm_test_engine_disposed(in_engine);
+#endif
+    
+    /* script cache */
+    _xte_script_cache_dispose(in_engine);
+    
     /* date/time */
     _xte_os_date_deinit(in_engine->os_datetime_context);
     
     /* dispose terminology dictionary */
-    for (int i = 0; i < in_engine->func_count; i++)
-    {
-        struct XTEFunctionInt *func = in_engine->funcs[i];
-        if (func->name) free(func->name);
-        free(func);
-    }
-    if (in_engine->funcs) free(in_engine->funcs);
-    
-    for (int i = 0; i < in_engine->syns_count; i++)
-    {
-        struct XTESynonymInt *syn = in_engine->syns + i;
-        if (syn->name) free(syn->name);
-        for (int w = 0; w < syn->word_count; w++)
-        {
-            if (syn->words[w]) free(syn->words[w]);
-        }
-        if (syn->words) free(syn->words);
-        for (int w = 0; w < syn->rep_word_count; w++)
-        {
-            if (syn->rep_words[w]) free(syn->rep_words[w]);
-        }
-        if (syn->rep_words) free(syn->rep_words);
-    }
-    if (in_engine->syns) free(in_engine->syns);
-    
-    for (int i = 0; i < in_engine->cons_count; i++)
-    {
-        struct XTEConstantInt *cons = in_engine->cons + i;
-        if (cons->name) free(cons->name);
-        for (int w = 0; w < cons->word_count; w++)
-        {
-            if (cons->words[w]) free(cons->words[w]);
-        }
-        if (cons->words) free(cons->words);
-    }
-    if (in_engine->cons) free(in_engine->cons);
-    
-    for (int i = 0; i < in_engine->ref_count; i++)
-    {
-        struct XTERefInt *ref = in_engine->refs + i;
-        if (ref->name) free(ref->name);
-        if (ref->type) free(ref->type);
-        for (int w = 0; w < ref->word_count; w++)
-        {
-            if (ref->words[w]) free(ref->words[w]);
-        }
-        if (ref->words) free(ref->words);
-        for (int u = 0; u < ref->uid_alt_count; u++)
-        {
-            if (ref->uid_alt[u].uid_name) free(ref->uid_alt[u].uid_name);
-            if (ref->uid_alt[u].uid_type) free(ref->uid_alt[u].uid_type);
-        }
-        if (ref->uid_alt) free(ref->uid_alt);
-    }
-    if (in_engine->refs) free(in_engine->refs);
-    
-    for (int i = 0; i < in_engine->class_prop_count; i++)
-    {
-        struct XTEPropertyInt *prop = in_engine->class_props[i];
-        if (prop->name) free(prop->name);
-        if (prop->usual_type) free(prop->usual_type);
-        for (int w = 0; w < prop->word_count; w++)
-        {
-            if (prop->words[w]) free(prop->words[w]);
-        }
-        if (prop->words) free(prop->words);
-        if (prop) free(prop);
-    }
-    if (in_engine->class_props) free(in_engine->class_props);
-    
-    for (int i = 0; i < in_engine->global_prop_count; i++)
-    {
-        struct XTEPropertyInt *prop = in_engine->global_props[i];
-        if (prop->name) free(prop->name);
-        if (prop->usual_type) free(prop->usual_type);
-        for (int w = 0; w < prop->word_count; w++)
-        {
-            if (prop->words[w]) free(prop->words[w]);
-        }
-        if (prop->words) free(prop->words);
-        if (prop) free(prop);
-    }
-    if (in_engine->global_props) free(in_engine->global_props);
-    
-    for (int i = 0; i < in_engine->prop_ptr_count; i++)
-    {
-        struct XTEPropertyPtrs *entry = in_engine->prop_ptr_table + i;
-        if (entry->name) free(entry->name);
-        if (entry->ptrs) free(entry->ptrs);
-    }
-    if (in_engine->prop_ptr_table) free(in_engine->prop_ptr_table);
-    
-    for (int i = 0; i < in_engine->class_count; i++)
-    {
-        struct XTEClassInt *a_class = in_engine->classes[i];
-        if (a_class->name) free(a_class->name);
-        /* this table is full of pointers to records free'd earlier */
-        if (a_class->properties) free(a_class->properties);
-        if (a_class) free(a_class);
-    }
-    if (in_engine->classes) free(in_engine->classes);
-    
-    for (int i = 0; i < in_engine->cmd_prefix_count; i++)
-    {
-        struct XTECmdPrefix *prefix = in_engine->cmd_prefix_table + i;
-        if (prefix->prefix_word) free(prefix->prefix_word);
-        for (int s = 0; s < prefix->command_count; s++)
-        {
-            struct XTECmdInt *syntax = prefix->commands + s;
-            if (syntax->pattern) _xte_bnf_destroy(syntax->pattern);
-            for (int p = 0; p < syntax->param_count; p++)
-            {
-                if (syntax->params[p]) free(syntax->params[p]);
-            }
-            if (syntax->params) free(syntax->params);
-            if (syntax->param_is_delayed) free(syntax->param_is_delayed);
-        }
-        if (prefix->commands) free(prefix->commands);
-    }
-    if (in_engine->cmd_prefix_table) free(in_engine->cmd_prefix_table);
-
-
+    _xte_vocab_dispose(in_engine);
 
     /* dispose of internal settings and operations variables */
     if (in_engine->item_delimiter) free(in_engine->item_delimiter);
@@ -217,9 +110,19 @@ void xte_dispose(XTE *in_engine)
     {
         if (in_engine->globals[i]->name) free(in_engine->globals[i]->name);
         xte_variant_release(in_engine->globals[i]->value);
+        if (in_engine->globals[i]->chunk_index) _xte_chunk_index_dispose(in_engine->globals[i]->chunk_index);
         free(in_engine->globals[i]);
     }
     if (in_engine->globals) free(in_engine->globals);
+    if (in_engine->global_table) free(in_engine->global_table);
+    
+    for (int i = 0; i < XTALK_LIMIT_NESTED_HANDLERS; i++)
+    {
+        if (in_engine->handler_stack[i].slots) free(in_engine->handler_stack[i].slots);
+        if (in_engine->handler_stack[i].vm_stack) free(in_engine->handler_stack[i].vm_stack);
+        if (in_engine->handler_stack[i].vm_cells) free(in_engine->handler_stack[i].vm_cells);
+        if (in_engine->handler_stack[i].vm_counters) free(in_engine->handler_stack[i].vm_counters);
+    }
     
     xte_variant_release(in_engine->the_result);
     xte_variant_release(in_engine->the_target);
@@ -237,10 +140,17 @@ void xte_dispose(XTE *in_engine)
     
     if (in_engine->f_result_cstr) free(in_engine->f_result_cstr);
     
+    long variants_in_use = _xte_slab_dispose(in_engine->variant_slab);
+    long nodes_in_use = _xte_slab_dispose(in_engine->ast_slab);
+    
     
     
 #if DEBUG
     
+    /* objects allocated from slabs aren't seen by the leak checker */
+    if (variants_in_use || nodes_in_use)
+        printf("WARNING! xTalk: leak detected on _dispose(): %ld variants, %ld AST nodes\n", variants_in_use, nodes_in_use);
+    
     /* check that we haven't leaked at all, during operation,
      and that dispose() was successful. */
     if (_xte_mem_allocated() != in_engine->init_alloc_bytes)
@@ -278,6 +188,9 @@ void xte_configure_environment(XTE *in_engine, struct XTEClassDef *in_classes, s
                             struct XTEFunctionDef *in_funcs, struct XTECommandDef *in_commands,
                             struct XTESynonymDef *in_syns)
 {
+    /* the engine's terminology tables must be it's own before they can be extended */
+    if (!_xte_vocab_detach(in_engine)) return _xte_panic_void(in_engine, XTE_ERROR_MEMORY, NULL);
+    
     /* initalize the environment's language terminology */
     _xte_synonyms_add(in_engine, in_syns);
     _xte_classes_add(in_engine, in_classes);
@@ -286,6 +199,12 @@ void xte_configure_environment(XTE *in_engine, struct XTEClassDef *in_classes, s
     _xte_elements_add(in_engine, in_elements);
     _xte_functions_add(in_engine, in_funcs);
     _xte_commands_add(in_engine, in_commands);
+    
+    /* the hashed dictionary is rebuilt to include the new terminology on next use */
+    _xte_dict_dispose(in_engine);
+    
+    /* handlers compiled with the old terminology are no longer valid */
+    _xte_script_cache_flush(in_engine);
 }
 
 
@@ -561,6 +480,7 @@ void xte_message(XTE *in_engine, const char *in_message, XTEVariant *in_first_re
 {
     in_engine->invoked_via_message = XTE_TRUE;
     in_engine->me = in_first_responder;
+    _xte_shadowed_invalidate(in_engine);
     
     in_engine->run_state = XTE_RUNSTATE_RUN;
     _xte_message(in_engine, in_message);
@@ -612,6 +532,13 @@ void xte_post_system_event(XTE *in_engine, XTEVariant *in_target, char const *in
 void xte_abort(XTE *in_engine)
 {
     in_engine->run_state = XTE_RUNSTATE_ABORT;
+    xte_attention(in_engine);
+}
+
+
+void xte_attention(XTE *in_engine)
+{
+    __sync_lock_test_and_set(&(in_engine->attention), XTE_TRUE);
 }
 
 
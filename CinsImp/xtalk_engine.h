@@ -337,6 +337,25 @@ typedef int (*XTENextResponder) (XTE *in_engine, void *in_context, XTEVariant *i
 /* no wait functionality ^ */
 
 
+/*
+ *  XTEScriptIdentifier
+ *  ---------------------------------------------------------------------------------------------
+ *  Environment provided xTalk script identity mechanism; optional.  Allows the engine to cache
+ *  compiled handlers between messages.
+ *
+ *  <in_object> will be a variant reference type as was previously constructed by the environment
+ *  using the xte_object_ref() function.
+ *
+ *  The environment should return XTE_TRUE if it can identify the script, setting <out_domain>
+ *  and <out_id> to values which together uniquely identify the scripted object for the lifetime
+ *  of the engine (eg. the owning document and object ID), and <out_revision> to a value which
+ *  changes whenever the script (or its checkpoints) may have changed.  If XTE_FALSE is returned
+ *  the script is retrieved and compiled for every message, as if no identifier were defined.
+ */
+typedef int (*XTEScriptIdentifier) (XTE *in_engine, void *in_context, XTEVariant *in_object,
+void const **out_domain, long *out_id, long *out_revision);
+
+
 /*
  *  Environment Terminology Definition Structures
  *  ---------------------------------------------------------------------------------------------
@@ -409,6 +428,7 @@ struct XTEClassDef
     XTEContainerWriter container_write;
     XTEScriptRetriever script_retr;
     XTENextResponder next_responder;
+    XTEScriptIdentifier script_ident;
 };
 
 struct XTECommandDef
@@ -629,6 +649,8 @@ char const* xte_cstring_index_word_end(char const *in_string);
 
 int xte_cstrings_equal(char const *in_string1, char const *in_string2);
 int xte_cstrings_szd_equal(char const *in_string1, long in_bytes1, char const *in_string2, long in_bytes2);
+long xte_cstring_fold(char const *in_string, char *out_buffer, long in_buffer_size);
+long xte_cstring_collation_key(char const *in_string, char *out_key, long in_key_size);
 
 long xte_cstring_chars_between(char const *in_begin, char const *const in_end);
 
@@ -682,6 +704,13 @@ void xte_abort(XTE *in_engine);
 void xte_continue(XTE *in_engine);
 
 
+/* signals the running engine that the environment has something for it, eg. a debug command or
+ a change to checkpoints, and that the script_progress callback should be invoked at the next
+ opportunity; may be safely called from a thread other than the one running the engine.
+ without it, the callback is only invoked periodically while a script is running */
+void xte_attention(XTE *in_engine);
+
+
 #define XTE_OK 0
 #define XTE_ABORT 1
 #define XTE_PANIC 2
@@ -19,23 +19,18 @@
  Utilities
  */
 
-static int _xte_node_is_function(XTEAST *in_node, XTEFunctionImp *out_func)
+static int _xte_node_is_function(XTEAST *in_node, struct XTEFunctionInt **out_func)
 {
     if (!in_node) return XTE_FALSE;
     if (in_node->type != XTE_AST_WORD) return XTE_FALSE;
     
     /* look for function in global function name list */
-    for (int i = 0; i < in_node->engine->func_count; i++)
-    {
-        struct XTEFunctionInt *func = in_node->engine->funcs[i];
-        if (_xte_compare_cstr(func->name, in_node->value.string) == 0)
-        {
-            if (out_func) *out_func = func->imp;
-            return XTE_TRUE;
-        }
-    }
+    struct XTETerm const *term = _xte_dict_first(in_node->engine, XTE_TERM_FUNCTION, in_node->value.string);
+    if (!term) return XTE_FALSE;
     
-    return XTE_FALSE;
+    struct XTEFunctionInt *func = term->def;
+    if (out_func) *out_func = func;
+    return XTE_TRUE;
 }
 
 
@@ -49,7 +44,7 @@ void _xte_parse_functions(XTE *in_engine, XTEAST *in_stmt)
     /* iterate through statement words */
     for (int i = 0; i < in_stmt->children_count; i++)
     {
-        XTEFunctionImp func;
+        struct XTEFunctionInt *func;
         XTEAST *node;
         XTEAST *child = in_stmt->children[i];
         if (child->type == XTE_AST_OF)
@@ -63,8 +58,9 @@ void _xte_parse_functions(XTE *in_engine, XTEAST *in_stmt)
                 node->note = _xte_clone_cstr(in_engine, node->value.string);
                 if (node->value.string) free(node->value.string);
                 //node->value.ptr = func;
-                node->value.function.ptr = func;
+                node->value.function.ptr = func->imp;
                 node->value.function.named = _xte_clone_cstr(in_engine, node->note);
+                node->value.function.builtin = func->builtin;
                 
                 /* check if the preceeding word is "the" */
                 node =_xte_ast_list_child(in_stmt, i-1);
@@ -96,14 +92,16 @@ void _xte_parse_functions(XTE *in_engine, XTEAST *in_stmt)
                 if (_xte_node_is_function(node, &func))
                 {
                     if (node->value.string) free(node->value.string);
-                    node->value.function.ptr = func;
+                    node->value.function.ptr = func->imp;
                     node->value.function.named = _xte_clone_cstr(in_engine, node->note);
+                    node->value.function.builtin = func->builtin;
                 }
                 else
                 {
                     if (node->value.string) free(node->value.string);
                     node->value.function.ptr = NULL;
                     node->value.function.named = _xte_clone_cstr(in_engine, node->note);
+                    node->value.function.builtin = XTE_FALSE;
                 }
                 node->type = XTE_AST_FUNCTION;
                 i--;
@@ -216,6 +214,9 @@ static void _xte_function_add(XTE *in_engine, struct XTEFunctionDef *in_def)
     new_function->name = _xte_clone_cstr(in_engine, in_def->name);
     new_function->arg_count = in_def->arg_count;
     new_function->imp = in_def->ptr;
+    
+    /* functions added while the base vocabulary is built are the built-ins, see xtalk_vocab.c */
+    new_function->builtin = (_xte_vocab_shared(in_engine) == NULL);
 }
 
 
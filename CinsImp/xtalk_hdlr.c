@@ -849,6 +849,11 @@ static int _xte_parse_stmt(struct ParseContext *in_context)
  *      XTE_AST_LOOP_COUNT_DOWN : 1st child is loop count variable name
  *                                2nd child is counter start value expression
  *                                3rd child is counter end value expression
+ *  -   XTE_AST_LOOP_EACH_CHAR,
+ *      XTE_AST_LOOP_EACH_WORD,
+ *      XTE_AST_LOOP_EACH_LINE,
+ *      XTE_AST_LOOP_EACH_ITEM  : 1st child is loop variable name
+ *                                2nd child is container expression
  *
  *  If there is an error during parsing of this line, returns XTE_FALSE.  If parsing the line
  *  raises no error, returns XTE_TRUE.  Normal reporting of syntax errors applies.
@@ -886,6 +891,9 @@ static int _xte_parse_repeat(struct ParseContext *in_context)
     if (in_context->line_offset > in_context->line_end) return XTE_TRUE;
     
     XTEAST *token = _xte_ast_list_child(in_context->stream, in_context->line_offset++);
+    XTEAST *next_token = NULL;
+    if (in_context->line_offset <= in_context->line_end)
+        next_token = _xte_ast_list_child(in_context->stream, in_context->line_offset);
     if (token && (token->type == XTE_AST_WORD) && (_xte_compare_cstr(token->value.string, "forever") == 0))
     {
         /* forever */
@@ -1041,6 +1049,79 @@ static int _xte_parse_repeat(struct ParseContext *in_context)
         
         return XTE_TRUE;
     }
+    else if (token && (token->type == XTE_AST_WORD) && (_xte_compare_cstr(token->value.string, "for") == 0) &&
+             next_token && (next_token->type == XTE_AST_WORD) && (_xte_compare_cstr(next_token->value.string, "each") == 0))
+    {
+        /* for each {character | word | line | item} <ident> in <expr> */
+        in_context->line_offset++;
+        
+        token = NULL;
+        if (in_context->line_offset <= in_context->line_end)
+            token = _xte_ast_list_child(in_context->stream, in_context->line_offset++);
+        if (token && (token->type == XTE_AST_WORD) && ((_xte_compare_cstr(token->value.string, "character") == 0) ||
+                                                       (_xte_compare_cstr(token->value.string, "char") == 0)))
+            loop_block->value.loop = XTE_AST_LOOP_EACH_CHAR;
+        else if (token && (token->type == XTE_AST_WORD) && (_xte_compare_cstr(token->value.string, "word") == 0))
+            loop_block->value.loop = XTE_AST_LOOP_EACH_WORD;
+        else if (token && (token->type == XTE_AST_WORD) && (_xte_compare_cstr(token->value.string, "line") == 0))
+            loop_block->value.loop = XTE_AST_LOOP_EACH_LINE;
+        else if (token && (token->type == XTE_AST_WORD) && (_xte_compare_cstr(token->value.string, "item") == 0))
+            loop_block->value.loop = XTE_AST_LOOP_EACH_ITEM;
+        else
+        {
+            ERROR_SYNTAX("Expected character, word, line or item after \"repeat for each\".", NULL, NULL);
+            return XTE_FALSE;
+        }
+        char const *chunk = token->value.string;
+        
+        if (in_context->line_offset > in_context->line_end)
+        {
+            ERROR_SYNTAX("Expected loop variable after \"repeat for each %s\".", chunk, NULL);
+            return XTE_FALSE;
+        }
+        token = _xte_ast_list_child(in_context->stream, in_context->line_offset++);
+        if ((!token) || (token->type != XTE_AST_WORD))
+        {
+            ERROR_SYNTAX("Expected loop variable here but found \"%s\".", _lexer_term_desc(token), NULL);
+            return XTE_FALSE;
+        }
+        if (!_xte_node_is_identifier(token))
+        {
+            ERROR_SYNTAX("\"%s\" is not a valid variable name.", _lexer_term_desc(token), NULL);
+            return XTE_FALSE;
+        }
+        char const *var = token->value.string;
+        _xte_ast_list_append(loop_block, token);
+        in_context->stream->children[in_context->line_offset-1] = NULL;
+        
+        token = NULL;
+        if (in_context->line_offset <= in_context->line_end)
+            token = _xte_ast_list_child(in_context->stream, in_context->line_offset++);
+        if ((!token) || (token->type != XTE_AST_IN))
+        {
+            ERROR_SYNTAX("Expected \"in\" after \"repeat for each %s %s\".", chunk, var);
+            return XTE_FALSE;
+        }
+        
+        XTEAST *loop_container = _xte_ast_create(in_context->engine, XTE_AST_LIST);
+        assert(loop_container != NULL);
+        _xte_ast_list_append(loop_block, loop_container);
+        
+        for (; in_context->line_offset <= in_context->line_end; in_context->line_offset++)
+        {
+            token = _xte_ast_list_child(in_context->stream, in_context->line_offset);
+            _xte_ast_list_append(loop_container, token);
+            in_context->stream->children[in_context->line_offset] = NULL;
+        }
+        if (loop_container->children_count == 0)
+        {
+            ERROR_SYNTAX("Expected container but found end of line.", NULL, NULL);
+            return XTE_FALSE;
+        }
+        if (!_xte_parse_expression(in_context->engine, loop_container, in_context->line_source)) return XTE_FALSE;
+        
+        return XTE_TRUE;
+    }
     else if (token)
     {
         /* [for] <number> [times] */
@@ -1298,6 +1379,43 @@ static int _xte_line_has_checkpoint(int const in_checkpoints[], int in_checkpoin
 }
 
 
+/*
+ *  _xte_resolve_slots
+ *  ---------------------------------------------------------------------------------------------
+ *  Assigns each distinct variable name within a handler (words, including parameter names and
+ *  global declarations) a slot within the handler frame.  The interpreter uses the slot to find
+ *  the variable without searching the frame by name.
+ *
+ *  Names are compared case-insensitively.  <io_names> is a list of the names assigned so far,
+ *  which is kept by the handler (the names themselves belong to the AST.)
+ */
+static void _xte_resolve_slots(XTE *in_engine, XTEAST *in_ast, char const ***io_names, int *io_count)
+{
+    if (!in_ast) return;
+    if ((in_ast->type == XTE_AST_WORD) && (in_ast->value.string) && (!(in_ast->flags & XTE_AST_FLAG_KEYWORD)))
+    {
+        /* lookup the name */
+        int slot;
+        for (slot = 0; slot < *io_count; slot++)
+        {
+            if (_xte_compare_cstr((*io_names)[slot], in_ast->value.string) == 0) break;
+        }
+        
+        /* assign a new slot to the name if necessary */
+        if (slot == *io_count)
+        {
+            char const **new_names = realloc(*io_names, sizeof(char*) * (*io_count + 1));
+            if (!new_names) return _xte_panic_void(in_engine, XTE_ERROR_MEMORY, NULL);
+            *io_names = new_names;
+            new_names[(*io_count)++] = in_ast->value.string;
+        }
+        in_ast->var_slot = slot;
+    }
+    for (int i = 0; i < in_ast->children_count; i++)
+        _xte_resolve_slots(in_engine, in_ast->children[i], io_names, io_count);
+}
+
+
 
 /*********
  Entry Points
@@ -1505,6 +1623,13 @@ int _xte_parse_handler(XTE *in_engine, XTEAST *in_stream, int const in_checkpoin
         return XTE_FALSE;
     }
 
+    /* assign slots to the handler's variables */
+    char const **slot_names = NULL;
+    int slot_count = 0;
+    _xte_resolve_slots(in_engine, result, &slot_names, &slot_count);
+    result->value.handler.slot_names = slot_names;
+    result->value.handler.slot_count = slot_count;
+    
     /* swap result with input stream and cleanup input stream */
     _xte_ast_swap_ptrs(result, in_stream);
     _xte_ast_destroy(result);
@@ -1543,104 +1668,20 @@ char* _xte_find_handler(XTE *in_engine, char const *in_script, int is_func, char
     assert(in_name_utf8[0] != 0);
     assert(out_handler_line_begin != NULL);
     
-    /* iterate over script lines; find start and end of matching handler (if present) */
-    char const *kw_begin = (is_func ? "function" : "on");
-    long kw_begin_bytes = strlen(kw_begin);
-    long name_bytes = strlen(in_name_utf8);
-    
-    char const *result_begin = NULL;
-    char const *result_end = NULL;
-    int result_line = 0;
+    /* index the script handlers (see _hdlridx.c) */
+    struct XTEHandlerIndex *index = _xte_handler_index_create(in_engine, in_script);
+    if (!index) return NULL;
     
-    char const *chr = in_script;
-    long script_line_number = 1;
-    char const *line_start = in_script;
-    for (;;)
+    /* extract the matching handler */
+    char *result = NULL;
+    int handler = _xte_handler_index_find(index, is_func, in_name_utf8);
+    if (handler >= 0)
     {
-        if ((*chr == 10) || (*chr == 13) || (*chr == 0))
-        {
-            /* identify the range of the line */
-            char const *line_end = chr-1;
-            long line_bytes = line_end - line_start + 1;
-            //printf("LINE: (%ld) %s\n", line_bytes, line_start);
-            
-            /* skip leading whitespace */
-            int offset;
-            for (offset = 0; offset < line_bytes; offset++)
-                if ( !isspace(*(line_start + offset)) ) break;
-            
-            /* does line begin with an appropriate keyword? */
-            if (!result_begin)
-            {
-                if ( (line_bytes > kw_begin_bytes + offset) &&
-                    (memcmp(kw_begin, line_start + offset, kw_begin_bytes) == 0) )
-                {
-                    //printf("APPROPRIATE HANDLER TYPE START at LINE %ld\n", script_line_number);
-                    
-                    int name_start;
-                    for (name_start = offset + (int)kw_begin_bytes; name_start < line_bytes; name_start++)
-                        if ( !isspace(*(line_start + name_start)) ) break;
-                    int name_end;
-                    for (name_end = name_start; name_end < line_bytes; name_end++)
-                        if ( isspace(*(line_start + name_end)) ) break;
-                    
-                    if (xte_cstrings_szd_equal(in_name_utf8, name_bytes, line_start + name_start, name_end - name_start))
-                    {
-                        //printf("Matching handler start on line %ld\n", script_line_number);
-                        result_begin = line_start;
-                        result_line = (int)script_line_number;
-                    }
-                }
-            }
-            else
-            {
-                if ( (line_bytes > 3 + offset) &&
-                    (memcmp("end", line_start + offset, 3) == 0) )
-                {
-                    int name_start;
-                    for (name_start = offset + 3; name_start < line_bytes; name_start++)
-                        if ( !isspace(*(line_start + name_start)) ) break;
-                    int name_end;
-                    for (name_end = name_start; name_end < line_bytes; name_end++)
-                        if ( isspace(*(line_start + name_end)) ) break;
-                    
-                    if (xte_cstrings_szd_equal(in_name_utf8, name_bytes, line_start + name_start, name_end - name_start))
-                    {
-                        result_end = line_start + line_bytes;
-                        break;
-                    }
-                }
-            }
-            
-            /* go to next line */
-            line_start = chr+1;
-            script_line_number++;
-            if (script_line_number > XTALK_LIMIT_MAX_SOURCE_LINES)
-            {
-                _xte_error_syntax(in_engine, 1, "Script is too long.", NULL, NULL, NULL);
-                return NULL;
-            }
-            if (*chr == 0) break;
-        }
-        chr++;
+        result = _xte_handler_index_extract(in_engine, index, in_script, handler);
+        if (result) *out_handler_line_begin = index->handlers[handler].line_begin;
     }
     
-    if (!result_begin) return NULL;
-    
-    /* if we found the start of a handler;
-     we rely on the handler parser (above) to detect the missing end
-     and output an approprite (hopefully) error message! */
-    if (!result_end) result_end = in_script + strlen(in_script);
-    
-    /* prepare the resulting handler */
-    char *result = malloc(result_end - result_begin + 1);
-    if (!result) return _xte_raise_null(in_engine, XTE_ERROR_MEMORY, NULL);
-    
-    memcpy(result, result_begin, result_end - result_begin);
-    result[result_end - result_begin] = 0;
-    
-    *out_handler_line_begin = result_line;
-    
+    _xte_handler_index_destroy(index);
     return result;
 }
 
@@ -0,0 +1,330 @@
+/*
+ 
+ xTalk Engine Handler Index Unit
+ xtalk_hdlridx.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Builds an index of the handlers within a script in a single pass, so that a handler can be
+ located by name without scanning the script again.  Used by the message heirarchy.
+ 
+ *************************************************************************************************
+ */
+
+#include "xtalk_internal.h"
+
+
+/*********
+ Configuration
+ */
+
+#define _INITIAL_TABLE_SIZE 16
+#define _EMPTY_SLOT -1
+#define _NO_MEMORY -2
+
+
+
+/*********
+ Implementation
+ */
+
+/*
+ *  _xte_handler_index_destroy
+ *  ---------------------------------------------------------------------------------------------
+ *  Disposes of a handler index.
+ */
+
+void _xte_handler_index_destroy(struct XTEHandlerIndex *in_index)
+{
+    if (!in_index) return;
+    for (int i = 0; i < in_index->handler_count; i++)
+    {
+        if (in_index->handlers[i].name) free(in_index->handlers[i].name);
+    }
+    if (in_index->handlers) free(in_index->handlers);
+    if (in_index->table) free(in_index->table);
+    free(in_index);
+}
+
+
+/* returns the table slot for the specified handler; either the slot of the handler,
+ or the empty slot where the handler should be inserted */
+static int _xte_handler_index_slot(struct XTEHandlerIndex *in_index, int is_func, char const *in_name, unsigned long in_hash)
+{
+    int mask = in_index->table_size - 1;
+    int slot = (int)(in_hash & mask);
+    for (;;)
+    {
+        int handler = in_index->table[slot];
+        if (handler == _EMPTY_SLOT) return slot;
+        struct XTEHandlerIndexEntry *entry = in_index->handlers + handler;
+        if ((entry->hash == in_hash) && (entry->is_func == is_func) && xte_cstrings_equal(entry->name, in_name))
+            return slot;
+        slot = (slot + 1) & mask;
+    }
+}
+
+
+/* resizes the hash table to accomodate more handlers */
+static int _xte_handler_index_grow(struct XTEHandlerIndex *in_index)
+{
+    int new_size = (in_index->table_size ? in_index->table_size * 2 : _INITIAL_TABLE_SIZE);
+    int *new_table = malloc(sizeof(int) * new_size);
+    if (!new_table) return XTE_FALSE;
+    for (int i = 0; i < new_size; i++)
+        new_table[i] = _EMPTY_SLOT;
+    
+    if (in_index->table) free(in_index->table);
+    in_index->table = new_table;
+    in_index->table_size = new_size;
+    
+    for (int h = 0; h < in_index->handler_count; h++)
+    {
+        struct XTEHandlerIndexEntry *entry = in_index->handlers + h;
+        in_index->table[_xte_handler_index_slot(in_index, entry->is_func, entry->name, entry->hash)] = h;
+    }
+    return XTE_TRUE;
+}
+
+
+/* adds a handler beginning on the specified line;
+ returns the index of the new handler, _EMPTY_SLOT if there's already a handler with the same name,
+ or _NO_MEMORY */
+static int _xte_handler_index_add(XTE *in_engine, struct XTEHandlerIndex *in_index, int is_func,
+                                  char const *in_name, long in_name_bytes, long in_offset, int in_line)
+{
+    /* make a copy of the name */
+    char *name = malloc(in_name_bytes + 1);
+    if (!name) return _NO_MEMORY;
+    memcpy(name, in_name, in_name_bytes);
+    name[in_name_bytes] = 0;
+    unsigned long hash = _xte_cstr_case_hash(name);
+    
+    /* only the first handler of a given name is significant */
+    int slot = _xte_handler_index_slot(in_index, is_func, name, hash);
+    if (in_index->table[slot] != _EMPTY_SLOT)
+    {
+        free(name);
+        return _EMPTY_SLOT;
+    }
+    
+    /* make room */
+    if ((in_index->handler_count + 1) * 2 > in_index->table_size)
+    {
+        if (!_xte_handler_index_grow(in_index))
+        {
+            free(name);
+            return _NO_MEMORY;
+        }
+        slot = _xte_handler_index_slot(in_index, is_func, name, hash);
+    }
+    struct XTEHandlerIndexEntry *new_handlers = realloc(in_index->handlers,
+                                                        sizeof(struct XTEHandlerIndexEntry) * (in_index->handler_count + 1));
+    if (!new_handlers)
+    {
+        free(name);
+        return _NO_MEMORY;
+    }
+    in_index->handlers = new_handlers;
+    
+    /* add the handler */
+    struct XTEHandlerIndexEntry *entry = in_index->handlers + in_index->handler_count;
+    entry->name = name;
+    entry->hash = hash;
+    entry->is_func = is_func;
+    entry->offset = in_offset;
+    entry->length = -1;
+    entry->line_begin = in_line;
+    entry->line_end = 0;
+    
+    in_index->table[slot] = in_index->handler_count;
+    return in_index->handler_count++;
+}
+
+
+/* determines the extent of the word following a keyword at the beginning of a line */
+static void _xte_handler_index_line_name(char const *in_line, long in_line_bytes, long in_kw_end,
+                                         long *out_name_start, long *out_name_end)
+{
+    long name_start;
+    for (name_start = in_kw_end; name_start < in_line_bytes; name_start++)
+        if ( !isspace(*(in_line + name_start)) ) break;
+    long name_end;
+    for (name_end = name_start; name_end < in_line_bytes; name_end++)
+        if ( isspace(*(in_line + name_end)) ) break;
+    *out_name_start = name_start;
+    *out_name_end = name_end;
+}
+
+
+/*
+ *  _xte_handler_index_create
+ *  ---------------------------------------------------------------------------------------------
+ *  Builds an index of the handlers within the supplied <in_script>.
+ *
+ *  A handler begins with a line starting with "on" or "function", and continues until the next
+ *  line starting with "end" and the name of the handler.  Only the first handler of a given
+ *  name and kind is indexed.  Handlers without an "end" line continue to the end of the script.
+ *
+ *  Line numbers begin at 1 and are based on actual lines, not logical lines (broken with the
+ *  line-continuation character.)
+ *
+ *  Returns NULL and reports a syntax error in the event the script length exceeds specified
+ *  limits (_limits.h), or if there isn't enough memory.
+ */
+
+struct XTEHandlerIndex* _xte_handler_index_create(XTE *in_engine, char const *in_script)
+{
+    assert(IS_XTE(in_engine));
+    assert(in_script != NULL);
+    
+    struct XTEHandlerIndex *index = calloc(1, sizeof(struct XTEHandlerIndex));
+    if (!index) return _xte_raise_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    if (!_xte_handler_index_grow(index))
+    {
+        _xte_handler_index_destroy(index);
+        return _xte_raise_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    }
+    
+    /* handlers awaiting an "end" line */
+    int *open_handlers = NULL;
+    int open_count = 0;
+    
+    /* iterate over script lines */
+    char const *chr = in_script;
+    long script_line_number = 1;
+    char const *line_start = in_script;
+    for (;;)
+    {
+        if ((*chr == 10) || (*chr == 13) || (*chr == 0))
+        {
+            /* identify the range of the line */
+            long line_bytes = chr - line_start;
+            long name_start, name_end;
+            
+            /* skip leading whitespace */
+            long offset;
+            for (offset = 0; offset < line_bytes; offset++)
+                if ( !isspace(*(line_start + offset)) ) break;
+            
+            /* does line end an open handler? */
+            if ( (open_count > 0) && (line_bytes > 3 + offset) &&
+                (memcmp("end", line_start + offset, 3) == 0) )
+            {
+                _xte_handler_index_line_name(line_start, line_bytes, offset + 3, &name_start, &name_end);
+                for (int i = 0; i < open_count; i++)
+                {
+                    struct XTEHandlerIndexEntry *entry = index->handlers + open_handlers[i];
+                    if (!xte_cstrings_szd_equal(entry->name, strlen(entry->name), line_start + name_start, name_end - name_start))
+                        continue;
+                    entry->length = (line_start - in_script) + line_bytes - entry->offset;
+                    entry->line_end = (int)script_line_number;
+                    open_handlers[i--] = open_handlers[--open_count];
+                }
+            }
+            
+            /* does line begin a handler? */
+            int is_func = XTE_FALSE;
+            long kw_bytes = 0;
+            if ( (line_bytes > 2 + offset) && (memcmp("on", line_start + offset, 2) == 0) )
+                kw_bytes = 2;
+            else if ( (line_bytes > 8 + offset) && (memcmp("function", line_start + offset, 8) == 0) )
+            {
+                kw_bytes = 8;
+                is_func = XTE_TRUE;
+            }
+            if (kw_bytes)
+            {
+                _xte_handler_index_line_name(line_start, line_bytes, offset + kw_bytes, &name_start, &name_end);
+                if (name_end > name_start)
+                {
+                    int handler = _xte_handler_index_add(in_engine, index, is_func, line_start + name_start,
+                                                         name_end - name_start, line_start - in_script,
+                                                         (int)script_line_number);
+                    if (handler >= 0)
+                    {
+                        int *new_open = realloc(open_handlers, sizeof(int) * (open_count + 1));
+                        if (!new_open) handler = _NO_MEMORY;
+                        else
+                        {
+                            open_handlers = new_open;
+                            open_handlers[open_count++] = handler;
+                        }
+                    }
+                    if (handler == _NO_MEMORY)
+                    {
+                        if (open_handlers) free(open_handlers);
+                        _xte_handler_index_destroy(index);
+                        return _xte_raise_null(in_engine, XTE_ERROR_MEMORY, NULL);
+                    }
+                }
+            }
+            
+            /* go to next line */
+            line_start = chr+1;
+            script_line_number++;
+            if (script_line_number > XTALK_LIMIT_MAX_SOURCE_LINES)
+            {
+                if (open_handlers) free(open_handlers);
+                _xte_handler_index_destroy(index);
+                _xte_error_syntax(in_engine, 1, "Script is too long.", NULL, NULL, NULL);
+                return NULL;
+            }
+            if (*chr == 0) break;
+        }
+        chr++;
+    }
+    
+    /* handlers without an "end" line continue to the end of the script;
+     the handler parser will detect and raise an appropriate error */
+    long script_bytes = chr - in_script;
+    for (int i = 0; i < open_count; i++)
+        index->handlers[open_handlers[i]].length = script_bytes - index->handlers[open_handlers[i]].offset;
+    if (open_handlers) free(open_handlers);
+    
+    return index;
+}
+
+
+/*
+ *  _xte_handler_index_find
+ *  ---------------------------------------------------------------------------------------------
+ *  Looks up the handler with the specified name in the index.  If <is_func> is XTE_TRUE, looks
+ *  for a function handler.
+ *
+ *  Returns the index of the handler within the <handlers> array, or -1 if the handler is not
+ *  found.
+ */
+
+int _xte_handler_index_find(struct XTEHandlerIndex *in_index, int is_func, char const *in_name)
+{
+    assert(in_index != NULL);
+    assert(in_name != NULL);
+    return in_index->table[_xte_handler_index_slot(in_index, is_func, in_name, _xte_cstr_case_hash(in_name))];
+}
+
+
+/*
+ *  _xte_handler_index_extract
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns a copy of the source of the handler <in_handler> from the <in_script> that was used
+ *  to build the index, including the "on" and "end" lines.  The caller is responsible for
+ *  disposing of the result.
+ */
+
+char* _xte_handler_index_extract(XTE *in_engine, struct XTEHandlerIndex *in_index, char const *in_script, int in_handler)
+{
+    assert(in_index != NULL);
+    assert((in_handler >= 0) && (in_handler < in_index->handler_count));
+    
+    struct XTEHandlerIndexEntry *entry = in_index->handlers + in_handler;
+    char *result = malloc(entry->length + 1);
+    if (!result) return _xte_raise_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    memcpy(result, in_script + entry->offset, entry->length);
+    result[entry->length] = 0;
+    return result;
+}
+
+
@@ -81,6 +81,12 @@ struct XTEVariant
             XTEPropRep rep;
         } prop;
         XTEAST *ast;
+        struct
+        {
+            char *name; /* shares storage with utf8_string */
+            int slot; /* slot within the handler frame; see _xte_resolve_slots() */
+            XTEAST *scope; /* handler the slot belongs to, which owns the name; NULL if the name is owned */
+        } var;
         
     } value;
     int ref_count;
@@ -279,6 +285,7 @@ struct XTECmdInt;
 
 
 #define XTE_AST_FLAG_DELAYED_EVAL 0x10
+#define XTE_AST_FLAG_KEYWORD 0x20 /* word is a keyword chosen by a command's syntax; not a variable */
 
 #define XTE_AST_FLAG_IS_CHECKPOINT 0x80
 
@@ -289,6 +296,12 @@ struct XTECmdInt;
 #define XTE_AST_LOOP_WHILE      3
 #define XTE_AST_LOOP_COUNT_UP   4
 #define XTE_AST_LOOP_COUNT_DOWN 5
+#define XTE_AST_LOOP_EACH_CHAR  6
+#define XTE_AST_LOOP_EACH_WORD  7
+#define XTE_AST_LOOP_EACH_LINE  8
+#define XTE_AST_LOOP_EACH_ITEM  9
+
+#define XTE_AST_LOOP_IS_EACH(in_loop) (((in_loop) >= XTE_AST_LOOP_EACH_CHAR) && ((in_loop) <= XTE_AST_LOOP_EACH_ITEM))
 
 
 #define XTE_AST_EXIT_EVENT      0 /* returns control to the user; exits current system event handling message chain */
@@ -319,16 +332,22 @@ struct XTEAST
         struct {
             char *name;
             int is_func;
+            int slot_count;
+            char const **slot_names; /* the name of each slot; the names belong to the handler's nodes */
+            struct XTEBytecode *code; /* compiled when first run; see xtalk_vm.c */
+            struct XTESlab *arena; /* the nodes of a handler compiled by _xte_compile_handler() */
         } handler;
         int loop;
         int exit;
         struct {
             void *ptr;
             char *named;
+            int builtin; /* part of the built-in vocabulary; see _xte_send_builtin() */
         } command;
         struct {
             void *ptr;
             char *named;
+            int builtin;
         } function;
     } value;
     char *note;
@@ -338,6 +357,9 @@ struct XTEAST
     long source_offset;
     int source_line;
     int logical_line;
+    
+    /* variable slot within the handler frame, for XTE_AST_WORD; -1 if unresolved */
+    int var_slot;
 };
 
 
@@ -378,6 +400,7 @@ struct XTEClassInt
     
     XTEScriptRetriever script_retr;
     XTENextResponder next_responder;
+    XTEScriptIdentifier script_ident;
 };
 
 
@@ -485,6 +508,7 @@ struct XTECmdInt
 {
     XTECmdPattern *pattern;
     XTECommandImp imp;
+    int builtin;
     int param_count;
     char **params;
     int *param_is_delayed;
@@ -498,11 +522,68 @@ struct XTECmdPrefix
 };
 
 
+/* kinds of term within the hashed terminology dictionary; see xtalk_dict.c */
+enum XTETermKind
+{
+    XTE_TERM_SYNONYM,               /* XTESynonymInt, by first word */
+    XTE_TERM_CONSTANT,              /* XTEConstantInt, by first word */
+    XTE_TERM_REF,                   /* XTERefInt, by first word */
+    XTE_TERM_FUNCTION,              /* XTEFunctionInt, by name */
+    XTE_TERM_COMMAND,               /* XTECmdPrefix, by prefix word */
+    XTE_TERM_PROPERTY,              /* global XTEPropertyInt, by first word */
+    XTE_TERM_PROPERTY_LAST,         /* global XTEPropertyInt, by last word */
+    XTE_TERM_CLASS_PROPERTY,        /* class XTEPropertyInt, by first word */
+    XTE_TERM_CLASS_PROPERTY_LAST,   /* class XTEPropertyInt, by last word */
+};
+
+struct XTETerm
+{
+    enum XTETermKind kind;
+    char const *word;
+    unsigned long hash;
+    void *def;
+    
+    /* next term in the same bucket, or -1 */
+    int next;
+};
+
+struct XTEDictionary
+{
+    int term_count;
+    struct XTETerm *terms;
+    
+    /* hash table of the first term in each bucket */
+    int table_size;
+    int *table;
+};
+
+struct XTETerm const* _xte_dict_first(XTE *in_engine, enum XTETermKind in_kind, char const *in_word);
+struct XTETerm const* _xte_dict_next(XTE *in_engine, struct XTETerm const *in_term);
+void _xte_dict_dispose(XTE *in_engine);
+
+int _xte_vocab_share(XTE *in_engine);
+int _xte_vocab_detach(XTE *in_engine);
+void _xte_vocab_dispose(XTE *in_engine);
+XTE const* _xte_vocab_shared(XTE *in_engine);
+
+
 struct XTEVariable
 {
     char *name;
     XTEVariant *value;
     int is_global; /* makes it easier for the debugger to find out what's going on */
+    unsigned long hash; /* case-insensitive hash of the name; globals only */
+    
+    /* once the variable is edited as a string, it's string is kept in a buffer with room to grow,
+     along with it's length in bytes and characters (-1 if not yet counted);
+     buffer_size is 0 if the value has been replaced since; see _xte_variable_write() */
+    long buffer_size;
+    long byte_length;
+    long char_count;
+    
+    /* where each line, item and word of the value begins; NULL until the variable is used
+     within a chunk expression and whenever the value changes, see xtalk_chunk.c */
+    struct XTEChunkIndex *chunk_index;
 };
 
 
@@ -511,6 +592,7 @@ struct XTEFunctionInt
     char *name;
     int arg_count;
     XTEFunctionImp imp;
+    int builtin;
 };
 
 
@@ -522,19 +604,30 @@ struct XTEHandlerFrame
     int param_count;
     XTEVariant **params;
     
-    /* **TODO** going to want a more efficient mechanism here than lists;
-     probably a hash map or a sorted list with a binary search
-     ** LOW PRIORITY ** */
-    
     int local_count;
+    int local_alloc;
     struct XTEVariable *locals;
     
+    /* variables by the slot assigned to their name when the handler was parsed;
+     NULL if the variable doesn't exist within this frame */
+    int slot_count;
+    int slot_alloc;
+    struct XTEVariable **slots;
+    
     int imported_global_count;
     struct XTEVariable **imported_globals;
     
     int nested_loops;
     int loop_abort_code;
     
+    /* operand stack and loop counters for bytecode; retained by the frame like the slots;
+     numbers and booleans on the operand stack are held unboxed in the corresponding cell */
+    int vm_stack_alloc;
+    XTEVariant **vm_stack;
+    struct XTEVariant *vm_cells;
+    int vm_counter_alloc;
+    int *vm_counters;
+    
     XTEVariant *return_value;
     
     int saved_run_error_line;
@@ -542,6 +635,152 @@ struct XTEHandlerFrame
 
 
 
+/* handler within a script; see xtalk_hdlridx.c */
+struct XTEHandlerIndexEntry
+{
+    char *name;
+    unsigned long hash;
+    int is_func;
+    
+    /* location of the handler source within the script, from the start of the "on" line
+     to the end of the "end" line (or the end of the script) */
+    long offset;
+    long length;
+    
+    /* line numbers of the "on" and "end" lines; line_end is zero if there isn't an "end" line */
+    int line_begin;
+    int line_end;
+};
+
+/* index of the handlers within a script; see xtalk_hdlridx.c */
+struct XTEHandlerIndex
+{
+    int handler_count;
+    struct XTEHandlerIndexEntry *handlers;
+    
+    /* hash table of indicies into handlers */
+    int table_size;
+    int *table;
+};
+
+struct XTEHandlerIndex* _xte_handler_index_create(XTE *in_engine, char const *in_script);
+void _xte_handler_index_destroy(struct XTEHandlerIndex *in_index);
+int _xte_handler_index_find(struct XTEHandlerIndex *in_index, int is_func, char const *in_name);
+char* _xte_handler_index_extract(XTE *in_engine, struct XTEHandlerIndex *in_index, char const *in_script, int in_handler);
+
+
+/* bytecode operations; see xtalk_vm.c */
+enum XTEOpcode
+{
+    XTE_OP_LINE,            /* begin statement <ast>; a: line for runtime errors */
+    XTE_OP_STEP,            /* end of statement; a: line for the debugger */
+    XTE_OP_JUMP,            /* a: target */
+    XTE_OP_IF,              /* pop condition; a: target if false, b: line for the debugger, c: target on error */
+    XTE_OP_WHILE,           /* pop condition; a: target to exit, b: exit if condition is true, c: target on error */
+    XTE_OP_REPEAT,          /* end of loop iteration; a: target, b: line for the debugger */
+    XTE_OP_COUNT_INIT,      /* pop count; a: counters, c: target on error */
+    XTE_OP_COUNT_TEST,      /* a: counters, b: target to exit */
+    XTE_OP_COUNT_NEXT,      /* a: counters */
+    XTE_OP_FOR_INIT,        /* pop start; write variable <ast>; a: counters, b: slot, c: target on error */
+    XTE_OP_FOR_LIMIT,       /* pop end; a: counters, c: target on error */
+    XTE_OP_FOR_NEXT,        /* write variable <ast>; a: counters, b: slot, c: step */
+    XTE_OP_EACH_INIT,       /* convert top of stack to string and push the itemDelimiter, for loop <ast>; a: counters, c: target on error */
+    XTE_OP_EACH_NEXT,       /* write next element of string below the itemDelimiter to variable of loop <ast>; a: counters */
+    XTE_OP_POP,
+    XTE_OP_RETURN,          /* a: pop return value, b: passing */
+    XTE_OP_EXIT_EVENT,
+    XTE_OP_EXEC,            /* interpret statement <ast> */
+    XTE_OP_EVAL,            /* interpret expression <ast>; push result */
+    XTE_OP_WRAP,            /* push <ast> for delayed evaluation */
+    XTE_OP_NULL,            /* push nothing (a missing parameter) */
+    XTE_OP_CONST,           /* push copy of constant a */
+    XTE_OP_VARIABLE,        /* push reference to variable <ast>; a: slot */
+    XTE_OP_LOAD,            /* push value of variable <ast> if it's a number or boolean, else a reference;
+                             a: slot, b: as a number */
+    XTE_OP_ADD_CONST,       /* push variable <ast> plus constant; a: slot, b: constant, c: operator flags */
+    XTE_OP_OPERATOR,        /* pop operands, push result; a: operator */
+    XTE_OP_CLEAR_RESULT,
+    XTE_OP_COMMAND,         /* pop parameters, send command <ast>; a: parameter count */
+    XTE_OP_FUNCTION,        /* pop parameters, send function <ast>, push result; a: parameter count */
+};
+
+struct XTEInstruction
+{
+    enum XTEOpcode op;
+    int a;
+    int b;
+    int c;
+    XTEAST *ast;
+};
+
+/* compiled handler; see xtalk_vm.c */
+struct XTEBytecode
+{
+    int instruction_count;
+    int instruction_alloc;
+    struct XTEInstruction *instructions;
+    
+    /* literals, decoded once when the handler is compiled */
+    int constant_count;
+    int constant_alloc;
+    XTEVariant **constants;
+    
+    /* maximum depth of the operand stack, and number of loop counters required */
+    int stack_size;
+    int counter_count;
+};
+
+struct XTEBytecode* _xte_compile_bytecode(XTE *in_engine, XTEAST *in_handler);
+void _xte_bytecode_destroy(struct XTEBytecode *in_code);
+void _xte_vm_run(XTE *in_engine, XTEAST *in_handler, struct XTEBytecode *in_code);
+
+
+/* script cache entry; see xtalk_msgheir.c */
+struct XTEScriptCacheEntry
+{
+    struct XTEScriptCacheEntry *next;
+    
+    /* identity of the owner object */
+    struct XTEClassInt *owner_class;
+    void const *owner_domain;
+    long owner_id;
+    long revision;
+    unsigned long hash;
+    
+    /* copy of the script and it's index */
+    char *script;
+    int *checkpoints;
+    int checkpoint_count;
+    struct XTEHandlerIndex *index;
+    
+    /* compiled handlers, corresponding to index->handlers; NULL until first use */
+    XTEAST **handlers;
+    
+    /* number of active invokations of the handlers;
+     stale entries are destroyed once they are no longer in use */
+    int use_count;
+    int is_stale;
+};
+
+
+/* names of the handlers within the scripts of the responder chain of "me";
+ built on demand and discarded whenever the chain or its scripts might have changed,
+ see xtalk_msgheir.c */
+struct XTEShadowSet
+{
+    int is_valid;
+    
+    /* false if the script of a responder couldn't be identified */
+    int is_complete;
+    XTEVariant *me;
+    
+    /* hash table of the entries of the handler indexes within the script cache */
+    int count;
+    int table_size;
+    struct XTEHandlerIndexEntry const **table;
+};
+
+
 void _xte_out_of_memory(XTE *in_engine);
 
 #define OUT_OF_MEMORY _xte_out_of_memory(in_engine); 
@@ -588,6 +827,9 @@ struct XTE
      contains representations of most language constructs with the notable exception of operators;
      populated with both engine built-ins & primitives, and with environment terminology.
      */
+    
+    /* the terminology tables below are shared with the built-in vocabulary until the
+     environment adds terminology, see xtalk_vocab.c */
 
     /* built-in functions */
     int func_count;
@@ -623,6 +865,9 @@ struct XTE
     int class_count;
     struct XTEClassInt **classes;
     
+    /* hashed index of the above by word; built on first use, see xtalk_dict.c */
+    struct XTEDictionary *dict;
+    
     
     /*********
      Operations
@@ -633,6 +878,13 @@ struct XTE
     long init_alloc_bytes;
 #endif
     
+    /* slabs from which variants and AST nodes are allocated; see xtalk_mem.c */
+    struct XTESlab *variant_slab;
+    struct XTESlab *ast_slab;
+    
+    /* arena for the nodes of the handler being compiled, if any */
+    struct XTESlab *ast_arena;
+    
     /* engine status and operational callbacks */
     struct XTECallbacks callback;
     
@@ -667,6 +919,11 @@ struct XTE
     /* run state of the script, ie. running, paused, etc. */
     int run_state;
     
+    /* set by the environment (possibly from another thread) when the progress callback has
+     something to deliver; otherwise the callback is only invoked every so many nodes */
+    volatile int attention;
+    int poll_countdown;
+    
     /* debug handler level at time of runstate change */
     int debug_handler_ref_point;
     long debug_ref_line;
@@ -674,13 +931,23 @@ struct XTE
     /* invoked via message protocol */
     int invoked_via_message;
     
+    /* compile handlers to bytecode before they're run;
+     otherwise handlers are interpreted directly from the AST */
+    int use_bytecode;
+    
     /* source line for runtime errors */
     long run_error_line;
     
-    /* global variables */
+    /* global variables, in the order they were defined;
+     the records are never moved or released until the engine is disposed */
     int global_count;
+    int global_alloc;
     struct XTEVariable **globals;
     
+    /* hash table of indicies into globals, by name; see _xte_global_lookup() */
+    int global_table_size;
+    int *global_table;
+    
     /* debug temporary output of variable */
     char *temp_debug_var_value;
     char **temp_debug_handlers;
@@ -705,6 +972,16 @@ struct XTE
     
     /* temporary function results */
     char *f_result_cstr;
+    
+    /* scripts and compiled handlers;
+     hashed by object identity, see xtalk_msgheir.c */
+    struct XTEScriptCacheEntry **script_cache;
+    int script_cache_size;
+    int script_cache_count;
+    struct XTEScriptCacheEntry *script_cache_stale;
+    
+    /* handler names which may override built-in functions and commands */
+    struct XTEShadowSet shadowed;
 };
 
 
@@ -725,6 +1002,11 @@ struct XTE
 
 XTEVariant* xte_variant_copy(XTE *in_engine, XTEVariant *in_variant);
 
+XTEVariant* _xte_immediate_integer(XTEVariant *in_cell, int in_integer);
+XTEVariant* _xte_immediate_real(XTEVariant *in_cell, double in_real);
+XTEVariant* _xte_immediate_boolean(XTEVariant *in_cell, int in_boolean);
+int _xte_is_immediate(XTEVariant *in_variant);
+
 
 
 
@@ -754,6 +1036,21 @@ void _xte_mem_print(void);
 void _xte_mem_baseline(void);
 #endif
 
+/* defined non-zero to allocate variants and AST nodes individually with the leak checking allocator,
+ rather than from slabs; required for the memory assertions of xte_test() */
+#ifndef XTALK_LEAK_CHECKING
+#if DEBUG
+#define XTALK_LEAK_CHECKING 1
+#else
+#define XTALK_LEAK_CHECKING 0
+#endif
+#endif
+
+struct XTESlab* _xte_slab_create(char const *in_name, long in_object_size);
+void* _xte_slab_alloc(struct XTESlab *in_slab);
+void _xte_slab_free(void *in_object);
+long _xte_slab_dispose(struct XTESlab *in_slab);
+
 
 
 
@@ -772,6 +1069,7 @@ char* _xte_cstr_format_fill(const char *in_format, va_list in_list);
 char* _xte_clone_cstr(XTE *in_engine, const char *in_string);
 void _xte_itemize_cstr(XTE *in_engine, const char *in_string, const char *in_delimiter, char **out_items[], int *out_count);
 int _xte_compare_cstr(const char *in_string_1, const char *in_string_2);
+unsigned long _xte_cstr_case_hash(char const *in_string);
 void _xte_cstrs__xte_free(char *in_strings[], int in_count);
 
 int xte_variant_is_variable(XTEVariant *in_variant);
@@ -846,6 +1144,12 @@ int _xte_parse_expression(XTE *in_engine, XTEAST *in_stream, long in_source_line
 XTEVariant* xte_property_ref(XTE *in_engine, struct XTEPropertyPtr *in_ptrs, XTEVariant *in_owner, XTEPropRep in_rep);
 
 void _xte_interpret(XTE *in_engine, XTEAST *in_ast);
+XTEVariant* _xte_interpret_subtree(XTE *in_engine, XTEAST *in_ast);
+int _xte_should_abort(XTE *in_engine, long in_source_line);
+int _xte_should_abort_node(XTE *in_engine, XTEAST *in_ast);
+XTEVariant* _xte_operator_apply(XTE *in_engine, XTEASTOperator in_op, XTEVariant *in_operands[2]);
+XTEVariant* _xte_function_send(XTE *in_engine, XTEAST *in_ast, XTEVariant *in_params[]);
+void _xte_command_send(XTE *in_engine, XTEAST *in_ast, XTEVariant *in_params[]);
 
 
 int _xte_make_variants_comparable(XTE *in_engine, XTEVariant *in_variant1, XTEVariant *in_variant2);
@@ -853,7 +1157,14 @@ int _xte_compare_variants(XTE *in_engine, XTEVariant *in_variant1, XTEVariant *i
 
 int _xte_operator_operand_count(XTEASTOperator in_op);
 
-void _xte_variable_write(XTE *in_engine, char const *in_var_name, XTEVariant *in_value, XTETextRange in_range, XTEPutMode in_mode);
+XTEVariant* _xte_variable_ref(XTE *in_engine, char const *in_var_name, int in_slot);
+XTEVariant* _xte_variable_peek(XTE *in_engine, char const *in_var_name, int in_slot);
+struct XTEVariable* _xte_variable_lookup(XTE *in_engine, XTEVariant *in_ref);
+void _xte_variable_write(XTE *in_engine, char const *in_var_name, int in_slot, XTEVariant *in_value, XTETextRange in_range, XTEPutMode in_mode);
+
+void _xte_chunk_index_dispose(struct XTEChunkIndex *in_index);
+long _xte_chunk_each_begin(char const *in_string, int in_loop, char const *in_item_delim, long *out_offset);
+XTEVariant* _xte_chunk_each_next(XTE *in_engine, char const *in_string, int in_loop, char const *in_item_delim, long *io_offset);
 
 
 XTEPropertyGetter _xte_property_getter(XTE *in_engine, int in_pmap_entry, struct XTEClassInt *in_class);
@@ -864,6 +1175,7 @@ struct XTEPropertyPtr* _xte_property_ptrs(XTE *in_engine, int in_pmap_entry, str
 
 int _xte_utf8_compare(const char *in_string1, const char *in_string2);
 int _xte_utf8_contains(const char *in_string1, const char *in_string2);
+int _xte_utf8_fold_compare(char const *in_string1, char const *in_string2);
 
 
 int _xte_global_exists(XTE *in_engine, const char *in_var_name);
@@ -875,6 +1187,11 @@ XTEVariant* _xte_resolve_value(XTE *in_engine, XTEVariant *in_variant);
 
 int _xte_send_message(XTE *in_engine, XTEVariant *in_target, XTEVariant *in_responder, int is_func, char const *in_message,
                       XTEVariant *in_params[], int in_param_count, void *in_builtin_hint, int *io_handled);
+int _xte_send_builtin(XTE *in_engine, int is_func, char const *in_message, XTEVariant *in_params[], int in_param_count,
+                     void *in_imp);
+void _xte_shadowed_invalidate(XTE *in_engine);
+void _xte_script_cache_flush(XTE *in_engine);
+void _xte_script_cache_dispose(XTE *in_engine);
 
 
 void _xte_error_syntax(XTE *in_engine, long in_source_line, char const *in_template,
@@ -931,6 +1248,7 @@ XTEVariant* _xte_op_comp_more_eq(XTE *in_engine, XTEVariant *in_left, XTEVariant
 
 void _xte_global_import(XTE *in_engine, char const *in_var_name);
 struct XTEVariable* _xte_define_global(XTE *in_engine, char const *in_var_name);
+struct XTEVariable* _xte_define_local(XTE *in_engine, char const *in_var_name, int in_slot, XTEVariant *in_value);
 
 
 struct XTEClassInt* _xte_variant_class(XTE *in_engine, XTEVariant *in_variant);
@@ -986,7 +1304,7 @@ void _xte_platform_suspend_thread(int in_microseconds);
 
 
 void _xte_platform_sys_version(int *out_major, int *out_minor, int *out_bugfix);
-const char* _xte_platform_sys(void);
+void _xte_platform_sys(char *out_name, int in_size);
 
 /*
 void* _xte_platform_utf8_begin(const char *in_string);
@@ -35,6 +35,15 @@
 #define _THREAD_PAUSE_USECS 100
 
 
+/*
+ *  Polling interval
+ *  ---------------------------------------------------------------------------------------------
+ *  Number of nodes interpreted between calls to the script_progress callback while the script is
+ *  running normally.  Pausing, stepping, checkpoints and xte_attention() bypass the interval.
+ */
+#define _POLL_INTERVAL_NODES 512
+
+
 /*********
  Utilities
  */
@@ -87,6 +96,9 @@ static int _xte_resolve_ordinal(int in_total_items, int in_ordinal)
  */
 static void _xte_routine_callback(XTE *in_engine, long in_source_line)
 {
+    /* the environment may change the responder chain or it's scripts */
+    _xte_shadowed_invalidate(in_engine);
+    
     /* notify environment of pause */
     if (in_engine->run_state == XTE_RUNSTATE_PAUSE)
     {
@@ -105,6 +117,26 @@ static void _xte_routine_callback(XTE *in_engine, long in_source_line)
 }
 
 
+/*
+ *  _xte_needs_attention
+ *  ---------------------------------------------------------------------------------------------
+ *  Determines if the engine should call _xte_routine_callback() at this point.  Avoids the cost
+ *  of the callback (which usually has to acquire a lock) on every node of a running script;
+ *  the callback is only invoked if the script is not simply running, the environment has
+ *  requested attention, or the polling interval has elapsed.
+ */
+static int _xte_needs_attention(XTE *in_engine)
+{
+    if (in_engine->run_state != XTE_RUNSTATE_RUN) return XTE_TRUE;
+    if ((!in_engine->attention) && (--in_engine->poll_countdown > 0)) return XTE_FALSE;
+    
+    /* reset the interval and acknowledge the request */
+    in_engine->poll_countdown = _POLL_INTERVAL_NODES;
+    if (in_engine->attention) __sync_lock_release(&(in_engine->attention));
+    return XTE_TRUE;
+}
+
+
 /*
  *  _xte_should_abort
  *  ---------------------------------------------------------------------------------------------
@@ -112,13 +144,16 @@ static void _xte_routine_callback(XTE *in_engine, long in_source_line)
  *  function blocks until the engine is manually resumed using () .  Designed to be used with
  *  the invoking process via the script_progress callback.
  */
-static int _xte_should_abort(XTE *in_engine, long in_source_line)
+int _xte_should_abort(XTE *in_engine, long in_source_line)
 {
     assert(IS_XTE(in_engine));
     
     /* first priority, has the script been aborted for any reason? */
     if (in_engine->run_state == XTE_RUNSTATE_ABORT) return XTE_TRUE;
     
+    /* nothing to do unless it's time to check in with the invoker */
+    if (!_xte_needs_attention(in_engine)) return XTE_FALSE;
+    
     /* give the engine's invoker an opportunity to do something */
     _xte_routine_callback(in_engine, in_source_line);
     in_source_line = INVALID_LINE_NUMBER;
@@ -157,6 +192,45 @@ static int _xte_should_abort(XTE *in_engine, long in_source_line)
 
 
 
+/*
+ *  _xte_should_abort_node
+ *  ---------------------------------------------------------------------------------------------
+ *  Checks the run state of the engine prior to interpreting the specified node; should it abort
+ *  or pause?  Pauses if the node is a checkpoint or a step out of a handler has completed.
+ */
+int _xte_should_abort_node(XTE *in_engine, XTEAST *in_ast)
+{
+    assert(IS_XTE(in_engine));
+    assert(in_ast != NULL);
+    
+    /* has the script been aborted? */
+    if (_xte_should_abort(in_engine, INVALID_LINE_NUMBER)) return XTE_TRUE;
+    
+    /* has the loop iteration been aborted? */
+    if ((in_engine->handler_stack_ptr >= 0) && (in_engine->handler_stack[in_engine->handler_stack_ptr].nested_loops > 0))
+    {
+        if (in_engine->handler_stack[in_engine->handler_stack_ptr].loop_abort_code != _LOOP_ABORT_NONE) return XTE_TRUE;
+    }
+    
+    /* check debugging state */
+    if ((in_engine->run_state == XTE_RUNSTATE_DEBUG_OUT) && (in_engine->handler_stack_ptr < in_engine->debug_handler_ref_point))
+    {
+        in_engine->run_state = XTE_RUNSTATE_PAUSE;
+        if (_xte_should_abort(in_engine, in_ast->source_line)) return XTE_TRUE;
+    }
+    
+    /* is there a checkpoint set for the current source line? */
+    if (in_ast->flags & XTE_AST_FLAG_IS_CHECKPOINT)
+    {
+        in_engine->run_state = XTE_RUNSTATE_PAUSE;
+        if (_xte_should_abort(in_engine, in_ast->source_line)) return XTE_TRUE;
+    }
+    
+    return XTE_FALSE;
+}
+
+
+
 /*********
  Implementation
  */
@@ -230,6 +304,7 @@ static int _xte_push_handler(XTE *in_engine, XTEAST *in_handler, XTEVariant *in_
     
     frame->handler = in_handler;
     frame->local_count = 0;
+    frame->local_alloc = 0;
     frame->locals = NULL;
     frame->imported_global_count = 0;
     frame->imported_globals = NULL;
@@ -239,6 +314,25 @@ static int _xte_push_handler(XTE *in_engine, XTEAST *in_handler, XTEVariant *in_
     frame->loop_abort_code = _LOOP_ABORT_NONE;
     frame->return_value = NULL;
     
+    /* prepare the slots for the handler's variables;
+     the slot table is retained by the frame for subsequent handlers */
+    frame->slot_count = in_handler->value.handler.slot_count;
+    if (frame->slot_count > frame->slot_alloc)
+    {
+        struct XTEVariable **new_slots = realloc(frame->slots, sizeof(struct XTEVariable*) * frame->slot_count);
+        if (!new_slots)
+        {
+            frame->slot_count = 0;
+            in_engine->handler_stack_ptr--;
+            _xte_panic_void(in_engine, XTE_ERROR_MEMORY, NULL);
+            return XTE_FALSE;
+        }
+        frame->slots = new_slots;
+        frame->slot_alloc = frame->slot_count;
+    }
+    if (frame->slot_count > 0)
+        memset(frame->slots, 0, sizeof(struct XTEVariable*) * frame->slot_count);
+    
     frame->saved_run_error_line = (int)in_engine->run_error_line;
     in_engine->run_error_line = in_handler->source_line;
     
@@ -269,10 +363,14 @@ static void _xte_pop_handler(XTE *in_engine)
     {
         if (frame->locals[i].name) free(frame->locals[i].name);
         if (frame->locals[i].value) xte_variant_release(frame->locals[i].value);
+        if (frame->locals[i].chunk_index) _xte_chunk_index_dispose(frame->locals[i].chunk_index);
     }
     if (frame->locals) free(frame->locals);
     if (frame->imported_globals) free(frame->imported_globals);
     frame->local_count = 0;
+    frame->local_alloc = 0;
+    frame->locals = NULL;
+    frame->slot_count = 0;
     frame->param_count = 0;
     frame->params = NULL;
     frame->imported_globals = NULL;
@@ -385,14 +483,12 @@ static void _xte_interpret_ast_param_names(XTE *in_engine, XTEAST *in_ast)
         else
             param_value = xte_string_create_with_cstring(in_engine, "");
         
-        struct XTEVariable *new_locals = realloc(frame->locals, sizeof(struct XTEVariable) * (frame->local_count + 1));
-        if (!new_locals) OUT_OF_MEMORY_RETURN_VOID;
-        frame->locals = new_locals;
-        int var_index = frame->local_count++;
-        
-        struct XTEVariable *var = &(new_locals[var_index]);
-        var->name = _xte_clone_cstr(in_engine, param_name->value.string);
-        var->value = param_value;
+        struct XTEVariable *var = _xte_define_local(in_engine, param_name->value.string, param_name->var_slot, param_value);
+        if (!var)
+        {
+            xte_variant_release(param_value);
+            return;
+        }
     }
 }
 
@@ -435,9 +531,20 @@ static void _xte_interpret_ast_loop(XTE *in_engine, XTEAST *in_ast)
         loop_count = xte_variant_as_int(initer);
         xte_variant_release(initer);
         
-        XTEVariant *start = xte_integer_create(in_engine, loop_count);
-        _xte_variable_write(in_engine, in_ast->children[0]->value.string, start, _xte_text_make_range(-1, -1), XTE_PUT_INTO);
-        xte_variant_release(start);
+        struct XTEVariant start;
+        _xte_variable_write(in_engine, in_ast->children[0]->value.string, in_ast->children[0]->var_slot,
+                            _xte_immediate_integer(&start, loop_count), _xte_text_make_range(-1, -1), XTE_PUT_INTO);
+        
+        /* the end value is only evaluated once */
+        initer = _xte_interpret_subtree(in_engine, in_ast->children[2]);
+        if (!xte_variant_convert(in_engine, initer, XTE_TYPE_INTEGER))
+        {
+            xte_variant_release(initer);
+            ERROR_RUNTIME("Expected integer end value for loop.", NULL, NULL);
+            return;
+        }
+        loop_limit = xte_variant_as_int(initer);
+        xte_variant_release(initer);
     }
     
     if (in_ast->value.loop == XTE_AST_LOOP_NUMBER)
@@ -453,6 +560,25 @@ static void _xte_interpret_ast_loop(XTE *in_engine, XTEAST *in_ast)
         xte_variant_release(initer);
     }
     
+    XTEVariant *each_string = NULL;
+    char *each_delimiter = NULL;
+    long each_offset = 0;
+    if (XTE_AST_LOOP_IS_EACH(in_ast->value.loop))
+    {
+        /* the container is only evaluated once, and its elements visited with a cursor;
+         the itemDelimiter is that when the loop began, as the count depends upon it */
+        each_string = _xte_interpret_subtree(in_engine, in_ast->children[1]);
+        if (!xte_variant_convert(in_engine, each_string, XTE_TYPE_STRING))
+        {
+            xte_variant_release(each_string);
+            ERROR_RUNTIME("Expected string here.", NULL, NULL);
+            return;
+        }
+        each_delimiter = _xte_clone_cstr(in_engine, in_engine->item_delimiter);
+        loop_limit = (int)_xte_chunk_each_begin(xte_variant_as_cstring(each_string), in_ast->value.loop,
+                                                each_delimiter, &each_offset);
+    }
+    
     int begin_loop_stmts = 0;
     switch (in_ast->value.loop)
     {
@@ -465,30 +591,39 @@ static void _xte_interpret_ast_loop(XTE *in_engine, XTEAST *in_ast)
         case XTE_AST_LOOP_COUNT_UP:
             begin_loop_stmts = 3;
             break;
+        case XTE_AST_LOOP_EACH_CHAR:
+        case XTE_AST_LOOP_EACH_WORD:
+        case XTE_AST_LOOP_EACH_LINE:
+        case XTE_AST_LOOP_EACH_ITEM:
+            begin_loop_stmts = 2;
+            break;
     }
     
     /* actually run the loop */
     for (;;)
     {
+        /* "next repeat" only applies to the iteration in which it occurs */
+        if (in_ast->engine->handler_stack_ptr >= 0)
+            in_ast->engine->handler_stack[in_ast->engine->handler_stack_ptr].loop_abort_code = _LOOP_ABORT_NONE;
+        
         /* check loop counter */
-        if (in_ast->value.loop == XTE_AST_LOOP_NUMBER)
+        if ((in_ast->value.loop == XTE_AST_LOOP_NUMBER) ||
+            (in_ast->value.loop == XTE_AST_LOOP_COUNT_UP) ||
+            (in_ast->value.loop == XTE_AST_LOOP_COUNT_DOWN) ||
+            each_string)
         {
             if (loop_count == loop_limit) break;
         }
-        else if ((in_ast->value.loop == XTE_AST_LOOP_COUNT_UP) ||
-                 (in_ast->value.loop == XTE_AST_LOOP_COUNT_DOWN))
+        
+        /* set the loop variable to the next element */
+        if (each_string)
         {
-            XTEVariant *initer = _xte_interpret_subtree(in_engine, in_ast->children[2]);
-            if (!xte_variant_convert(in_engine, initer, XTE_TYPE_INTEGER))
-            {
-                xte_variant_release(initer);
-                ERROR_RUNTIME("Expected integer end value for loop.", NULL, NULL);
-                return;
-            }
-            loop_limit = xte_variant_as_int(initer);
-            xte_variant_release(initer);
-            
-            if (loop_count == loop_limit) break;
+            XTEVariant *element = _xte_chunk_each_next(in_engine, xte_variant_as_cstring(each_string), in_ast->value.loop,
+                                                       each_delimiter, &each_offset);
+            if (!element) break;
+            _xte_variable_write(in_engine, in_ast->children[0]->value.string, in_ast->children[0]->var_slot,
+                                element, _xte_text_make_range(-1, -1), XTE_PUT_INTO);
+            xte_variant_release(element);
         }
         
         /* check loop condition */
@@ -521,10 +656,13 @@ static void _xte_interpret_ast_loop(XTE *in_engine, XTEAST *in_ast)
             if (in_engine->run_state == XTE_RUNSTATE_DEBUG_OVER)
                 in_engine->run_state = XTE_RUNSTATE_PAUSE;
             //if (_xte_should_abort(in_engine, in_ast->source_line)) return;
-            if (i + 1 < in_ast->children_count)
-                _xte_routine_callback(in_engine, in_ast->children[i+1]->source_line);
-            else
-                _xte_routine_callback(in_engine, in_ast->source_line);
+            if (_xte_needs_attention(in_engine))
+            {
+                if (i + 1 < in_ast->children_count)
+                    _xte_routine_callback(in_engine, in_ast->children[i+1]->source_line);
+                else
+                    _xte_routine_callback(in_engine, in_ast->source_line);
+            }
             if (in_ast->engine->run_state == XTE_RUNSTATE_ABORT) break;
             if (in_ast->engine->handler_stack_ptr >= 0)
             {
@@ -533,7 +671,8 @@ static void _xte_interpret_ast_loop(XTE *in_engine, XTEAST *in_ast)
             }
         }
         
-        _xte_routine_callback(in_engine, in_ast->source_line);
+        if (_xte_needs_attention(in_engine))
+            _xte_routine_callback(in_engine, in_ast->source_line);
         if (in_ast->engine->run_state == XTE_RUNSTATE_ABORT) break;
         if (in_ast->engine->handler_stack_ptr >= 0)
         {
@@ -543,7 +682,8 @@ static void _xte_interpret_ast_loop(XTE *in_engine, XTEAST *in_ast)
         
         /* increment / decrement loop count variable */
         if ((in_ast->value.loop == XTE_AST_LOOP_COUNT_UP) ||
-            (in_ast->value.loop == XTE_AST_LOOP_NUMBER))
+            (in_ast->value.loop == XTE_AST_LOOP_NUMBER) ||
+            each_string)
             loop_count++;
         else if (in_ast->value.loop == XTE_AST_LOOP_COUNT_DOWN)
             loop_count--;
@@ -552,16 +692,19 @@ static void _xte_interpret_ast_loop(XTE *in_engine, XTEAST *in_ast)
         if ((in_ast->value.loop == XTE_AST_LOOP_COUNT_UP) ||
             (in_ast->value.loop == XTE_AST_LOOP_COUNT_DOWN))
         {
-            XTEVariant *count = xte_integer_create(in_engine, loop_count);
-            _xte_variable_write(in_engine, in_ast->children[0]->value.string, count, _xte_text_make_range(-1, -1), XTE_PUT_INTO);
-            xte_variant_release(count);
+            struct XTEVariant count;
+            _xte_variable_write(in_engine, in_ast->children[0]->value.string, in_ast->children[0]->var_slot,
+                                _xte_immediate_integer(&count, loop_count), _xte_text_make_range(-1, -1), XTE_PUT_INTO);
         }
     }
     
-    /* cleanup */
+    /* cleanup; "exit repeat" only applies to this loop */
+    if (each_string) xte_variant_release(each_string);
+    if (each_delimiter) free(each_delimiter);
     if (in_ast->engine->handler_stack_ptr >= 0)
     {
         in_ast->engine->handler_stack[in_ast->engine->handler_stack_ptr].nested_loops--;
+        in_ast->engine->handler_stack[in_ast->engine->handler_stack_ptr].loop_abort_code = _LOOP_ABORT_NONE;
     }
     
     /* check debugging state */
@@ -780,9 +923,9 @@ static XTEVariant* _xte_interpret_ast_constant(XTE *in_engine, XTEAST *in_ast)
 
 
 /*
- *  _xte_interpret_ast_operator
+ *  _xte_operator_apply
  *  ---------------------------------------------------------------------------------------------
- *  Interpret an operator and it's operands, returning the result.
+ *  Applies an operator to it's evaluated operands, returning the result.
  *
  *  Ownership of the operands is transferred to the relevant implementation function to permit
  *  an optmisation for some operators where one of the operands is returned, mutated, rather
@@ -791,143 +934,148 @@ static XTEVariant* _xte_interpret_ast_constant(XTE *in_engine, XTEAST *in_ast)
  *  Implementors do not have to worry about cleaning up as this function automatically releases
  *  unused operands at exit.
  */
-static XTEVariant* _xte_interpret_ast_operator(XTE *in_engine, XTEAST *in_ast)
+XTEVariant* _xte_operator_apply(XTE *in_engine, XTEASTOperator in_op, XTEVariant *in_operands[2])
 {
     assert(IS_XTE(in_engine));
-    assert(in_ast != NULL);
-    assert(in_ast->type == XTE_AST_OPERATOR);
-    assert(IS_OPERATOR(in_ast->value.op));
-    
-    /* get the number of operands applicable to this particular operator */
-    int operand_count = _xte_operator_operand_count(in_ast->value.op);
-    assert(in_ast->children_count == operand_count);
-    
-    /* maximum number of operands is currently 2;
-     evaluate the operands individually */
-    XTEVariant *operands[2] = {NULL, NULL};
-    if (operand_count >= 1) operands[0] = _xte_interpret_subtree(in_engine, in_ast->children[0]);
-    if (operand_count >= 2) operands[1] = _xte_interpret_subtree(in_engine, in_ast->children[1]);
+    assert(IS_OPERATOR(in_op));
     
     /* prepare for the result */
     XTEVariant *result = NULL;
     
-    switch (in_ast->value.op)
+    switch (in_op)
     {
             /* unary */
         case XTE_AST_OP_NEGATE://- (preceeded by any operator, left parenthesis, beginning of stream, newline or OF)
-            result = _xte_op_math_negate(in_ast->engine, operands[0]);
+            result = _xte_op_math_negate(in_engine, in_operands[0]);
             break;
             
         case XTE_AST_OP_NOT://not
-            result = _xte_op_logic_not(in_ast->engine, operands[0]);
+            result = _xte_op_logic_not(in_engine, in_operands[0]);
             break;
             
         case XTE_AST_OP_THERE_IS_A:// add a ptr to the class to determine if something exists
         case XTE_AST_OP_THERE_IS_NO:
-            result = _xte_panic_null(in_ast->engine, XTE_ERROR_UNIMPLEMENTED, NULL);
+            result = _xte_panic_null(in_engine, XTE_ERROR_UNIMPLEMENTED, NULL);
             break;
             
             /* binary */
         case XTE_AST_OP_EQUAL://is, = equality of floats defined by book too
-            result = _xte_op_comp_eq(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_comp_eq(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_NOT_EQUAL:// is not, <>
-            result = _xte_op_comp_neq(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_comp_neq(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_GREATER://>
-            result = _xte_op_comp_more(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_comp_more(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_LESSER://<
-            result = _xte_op_comp_less(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_comp_less(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_LESS_EQ://<=
-            result = _xte_op_comp_less_eq(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_comp_less_eq(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_GREATER_EQ://>=
-            result = _xte_op_comp_more_eq(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_comp_more_eq(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_CONCAT://&
-            result = _xte_op_string_concat(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_string_concat(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_CONCAT_SP://&&
-            result = _xte_op_string_concat_sp(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_string_concat_sp(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_IS_IN: // reverse operands for "contains"
-            result = _xte_op_string_is_in(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_string_is_in(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_CONTAINS:
-            result = _xte_op_string_is_in(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_string_is_in(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_IS_NOT_IN:
-            result = _xte_op_string_is_not_in(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_string_is_not_in(in_engine, in_operands[0], in_operands[1]);
             break;
             
         case XTE_AST_OP_EXPONENT://^
-            result = _xte_op_math_exponent(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_math_exponent(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_MULTIPLY://*
-            result = _xte_op_math_multiply(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_math_multiply(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_DIVIDE_FP:///
-            result = _xte_op_math_divide_fp(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_math_divide_fp(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_ADD://+
-            //result = xte_integer_create(in_ast->engine, 1);
-            result = _xte_op_math_add(in_ast->engine, operands[0], operands[1]);
+            //result = xte_integer_create(in_engine, 1);
+            result = _xte_op_math_add(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_SUBTRACT://-
-            result = _xte_op_math_subtract(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_math_subtract(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_DIVIDE_INT://div
-            result = _xte_op_math_divide_int(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_math_divide_int(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_MODULUS://mod
-            result = _xte_op_math_modulus(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_math_modulus(in_engine, in_operands[0], in_operands[1]);
             break;
             
         case XTE_AST_OP_IS_WITHIN://is within (geometric)
         case XTE_AST_OP_IS_NOT_WITHIN://is not within (geometric)
-            result = _xte_panic_null(in_ast->engine, XTE_ERROR_UNIMPLEMENTED, NULL);
+            result = _xte_panic_null(in_engine, XTE_ERROR_UNIMPLEMENTED, NULL);
             break;
             
         case XTE_AST_OP_AND://and
-            result = _xte_op_logic_and(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_logic_and(in_engine, in_operands[0], in_operands[1]);
             break;
         case XTE_AST_OP_OR://or
-            result = _xte_op_logic_or(in_ast->engine, operands[0], operands[1]);
+            result = _xte_op_logic_or(in_engine, in_operands[0], in_operands[1]);
             break;
             
     }
     
     /* cleanup; release any operands whose address differs from the result */
-    if (operands[0] && (operands[0] != result)) xte_variant_release(operands[0]);
-    if (operands[1] && (operands[1] != result)) xte_variant_release(operands[1]);
+    if (in_operands[0] && (in_operands[0] != result)) xte_variant_release(in_operands[0]);
+    if (in_operands[1] && (in_operands[1] != result)) xte_variant_release(in_operands[1]);
     
     return result;
 }
 
 
 /*
- *  _xte_interpret_ast_function_call
+ *  _xte_interpret_ast_operator
  *  ---------------------------------------------------------------------------------------------
- *  Interpret a function call, returning the result.  The result is also available in "the result".
+ *  Interpret an operator and it's operands, returning the result.  See _xte_operator_apply().
  */
-static XTEVariant* _xte_interpret_ast_function_call(XTE *in_engine, XTEAST *in_ast)
+static XTEVariant* _xte_interpret_ast_operator(XTE *in_engine, XTEAST *in_ast)
 {
     assert(IS_XTE(in_engine));
     assert(in_ast != NULL);
-    assert(in_ast->type == XTE_AST_FUNCTION);
+    assert(in_ast->type == XTE_AST_OPERATOR);
+    assert(IS_OPERATOR(in_ast->value.op));
     
-    /* build param list */
-    XTEVariant **param_list = calloc(sizeof(XTEVariant*), in_ast->children_count + 1);
-    if (!param_list) return _xte_panic_null(in_ast->engine, XTE_ERROR_MEMORY, NULL);
-    for (int i = 0; i < in_ast->children_count; i++)
-    {
-        param_list[i] = _xte_interpret_subtree(in_engine, in_ast->children[i]);
-        
-        _xte_routine_callback(in_engine, INVALID_LINE_NUMBER);
-        if (in_ast->engine->run_state == XTE_RUNSTATE_ABORT) break;
-    }
+    /* get the number of operands applicable to this particular operator */
+    int operand_count = _xte_operator_operand_count(in_ast->value.op);
+    assert(in_ast->children_count == operand_count);
+    
+    /* maximum number of operands is currently 2;
+     evaluate the operands individually */
+    XTEVariant *operands[2] = {NULL, NULL};
+    if (operand_count >= 1) operands[0] = _xte_interpret_subtree(in_engine, in_ast->children[0]);
+    if (operand_count >= 2) operands[1] = _xte_interpret_subtree(in_engine, in_ast->children[1]);
+    
+    return _xte_operator_apply(in_engine, in_ast->value.op, operands);
+}
+
+
+/*
+ *  _xte_function_send
+ *  ---------------------------------------------------------------------------------------------
+ *  Sends the message for a function call with it's evaluated parameters, returning the result.
+ *  The result is also available in "the result".  The parameters remain the caller's
+ *  responsibility.
+ */
+XTEVariant* _xte_function_send(XTE *in_engine, XTEAST *in_ast, XTEVariant *in_params[])
+{
+    assert(IS_XTE(in_engine));
+    assert(in_ast != NULL);
+    assert(in_ast->type == XTE_AST_FUNCTION);
     
     _xte_set_result(in_engine, NULL);
     
@@ -935,21 +1083,20 @@ static XTEVariant* _xte_interpret_ast_function_call(XTE *in_engine, XTEAST *in_a
     int err = XTE_ERROR_NO_HANDLER;
     if (in_ast->engine->run_state != XTE_RUNSTATE_ABORT)
     {
-        if (in_ast->value.function.named)
+        if (in_ast->value.function.builtin && in_ast->value.function.ptr)
+            err = _xte_send_builtin(in_ast->engine, XTE_TRUE, in_ast->value.function.named, in_params, in_ast->children_count,
+                                    in_ast->value.function.ptr);
+        else if (in_ast->value.function.named)
         {
             /* execute a command message send */
             err = _xte_send_message(in_ast->engine, in_engine->me, in_engine->me, XTE_TRUE, in_ast->value.function.named,
-                                    param_list, in_ast->children_count, in_ast->value.function.ptr, NULL);
+                                    in_params, in_ast->children_count, in_ast->value.function.ptr, NULL);
+            
+            /* the environment's functions may change the responder chain or it's scripts */
+            _xte_shadowed_invalidate(in_engine);
         }
     }
     
-    /* cleanup */
-    for (int i = 0; i < in_ast->children_count; i++)
-    {
-        xte_variant_release(param_list[i]);
-    }
-    free(param_list);
-    
     /* check the result and issue an error if necessary */
     if (err != XTE_ERROR_NONE)
     {
@@ -975,56 +1122,75 @@ static XTEVariant* _xte_interpret_ast_function_call(XTE *in_engine, XTEAST *in_a
 }
 
 
-
 /*
- *  _xte_interpret_ast_command_call
+ *  _xte_interpret_ast_function_call
  *  ---------------------------------------------------------------------------------------------
- *  Interpret a command call.  If there is a result, it's available only in "the result".
+ *  Interpret a function call, returning the result.  The result is also available in "the result".
  */
-static void _xte_interpret_ast_command_call(XTE *in_engine, XTEAST *in_ast)
+static XTEVariant* _xte_interpret_ast_function_call(XTE *in_engine, XTEAST *in_ast)
 {
     assert(IS_XTE(in_engine));
     assert(in_ast != NULL);
-    assert(in_ast->type == XTE_AST_COMMAND);
-    
-    /* clear the result */
-    _xte_set_result(in_engine, xte_string_create_with_cstring(in_engine, ""));
+    assert(in_ast->type == XTE_AST_FUNCTION);
     
     /* build param list */
     XTEVariant **param_list = calloc(sizeof(XTEVariant*), in_ast->children_count + 1);
-    if (!param_list) return _xte_panic_void(in_ast->engine, XTE_ERROR_MEMORY, NULL);
+    if (!param_list) return _xte_panic_null(in_ast->engine, XTE_ERROR_MEMORY, NULL);
     for (int i = 0; i < in_ast->children_count; i++)
     {
-        if (in_ast->children[i] && (in_ast->children[i]->flags & XTE_AST_FLAG_DELAYED_EVAL))
-            param_list[i] = _xte_ast_wrap(in_ast->engine, in_ast->children[i]);
-        else
-            param_list[i] = _xte_interpret_subtree(in_engine, in_ast->children[i]);
+        param_list[i] = _xte_interpret_subtree(in_engine, in_ast->children[i]);
         
-        _xte_routine_callback(in_engine, INVALID_LINE_NUMBER);
+        if (_xte_needs_attention(in_engine))
+            _xte_routine_callback(in_engine, INVALID_LINE_NUMBER);
         if (in_ast->engine->run_state == XTE_RUNSTATE_ABORT) break;
     }
     
+    /* send the message */
+    XTEVariant *result = _xte_function_send(in_engine, in_ast, param_list);
+    
+    /* cleanup */
+    for (int i = 0; i < in_ast->children_count; i++)
+    {
+        xte_variant_release(param_list[i]);
+    }
+    free(param_list);
+    
+    return result;
+}
+
+
+/*
+ *  _xte_command_send
+ *  ---------------------------------------------------------------------------------------------
+ *  Sends the message for a command call with it's evaluated parameters.  If there is a result,
+ *  it's available only in "the result".  The parameters remain the caller's responsibility.
+ */
+void _xte_command_send(XTE *in_engine, XTEAST *in_ast, XTEVariant *in_params[])
+{
+    assert(IS_XTE(in_engine));
+    assert(in_ast != NULL);
+    assert(in_ast->type == XTE_AST_COMMAND);
+    
     _xte_set_result(in_engine, NULL);
     
     /* send the message to obtain the function value */
     int err = XTE_ERROR_NO_HANDLER;
     if (in_ast->engine->run_state != XTE_RUNSTATE_ABORT)
     {
-        if (in_ast->value.command.named)
+        if (in_ast->value.command.builtin && in_ast->value.command.ptr)
+            err = _xte_send_builtin(in_ast->engine, XTE_FALSE, in_ast->value.command.named, in_params, in_ast->children_count,
+                                    in_ast->value.command.ptr);
+        else if (in_ast->value.command.named)
         {
             /* execute a command message send */
             err = _xte_send_message(in_ast->engine, in_engine->me, in_engine->me, XTE_FALSE, in_ast->value.command.named,
-                                    param_list, in_ast->children_count, in_ast->value.command.ptr, NULL);
+                                    in_params, in_ast->children_count, in_ast->value.command.ptr, NULL);
+            
+            /* the environment's commands may change the responder chain or it's scripts */
+            _xte_shadowed_invalidate(in_engine);
         }
     }
     
-    /* cleanup */
-    for (int i = 0; i < in_ast->children_count; i++)
-    {
-        xte_variant_release(param_list[i]);
-    }
-    free(param_list);
-    
     /* check the result and issue an error if necessary */
     if (err != XTE_ERROR_NONE)
     {
@@ -1042,11 +1208,53 @@ static void _xte_interpret_ast_command_call(XTE *in_engine, XTEAST *in_ast)
 }
 
 
+/*
+ *  _xte_interpret_ast_command_call
+ *  ---------------------------------------------------------------------------------------------
+ *  Interpret a command call.  If there is a result, it's available only in "the result".
+ */
+static void _xte_interpret_ast_command_call(XTE *in_engine, XTEAST *in_ast)
+{
+    assert(IS_XTE(in_engine));
+    assert(in_ast != NULL);
+    assert(in_ast->type == XTE_AST_COMMAND);
+    
+    /* clear the result */
+    _xte_set_result(in_engine, xte_string_create_with_cstring(in_engine, ""));
+    
+    /* build param list */
+    XTEVariant **param_list = calloc(sizeof(XTEVariant*), in_ast->children_count + 1);
+    if (!param_list) return _xte_panic_void(in_ast->engine, XTE_ERROR_MEMORY, NULL);
+    for (int i = 0; i < in_ast->children_count; i++)
+    {
+        if (in_ast->children[i] && (in_ast->children[i]->flags & XTE_AST_FLAG_DELAYED_EVAL))
+            param_list[i] = _xte_ast_wrap(in_ast->engine, in_ast->children[i]);
+        else
+            param_list[i] = _xte_interpret_subtree(in_engine, in_ast->children[i]);
+        
+        if (_xte_needs_attention(in_engine))
+            _xte_routine_callback(in_engine, INVALID_LINE_NUMBER);
+        if (in_ast->engine->run_state == XTE_RUNSTATE_ABORT) break;
+    }
+    
+    /* send the message */
+    _xte_command_send(in_engine, in_ast, param_list);
+    
+    /* cleanup */
+    for (int i = 0; i < in_ast->children_count; i++)
+    {
+        xte_variant_release(param_list[i]);
+    }
+    free(param_list);
+}
+
+
 /*
  *  _xte_interpret_ast_variable
  *  ---------------------------------------------------------------------------------------------
- *  Creates a reference to a variable, by name.  If the variable cannot be found at evaluation,
- *  the interpreter will return the name itself as a string literal.
+ *  Creates a reference to a variable, by name and the slot assigned to the name when the handler
+ *  was parsed.  If the variable cannot be found at evaluation, the interpreter will return the
+ *  name itself as a string literal.
  */
 static XTEVariant* _xte_interpret_ast_variable(XTE *in_engine, XTEAST *in_ast)
 {
@@ -1054,7 +1262,7 @@ static XTEVariant* _xte_interpret_ast_variable(XTE *in_engine, XTEAST *in_ast)
     assert(in_ast != NULL);
     assert(in_ast->type == XTE_AST_WORD);
     
-    return xte_global_ref(in_ast->engine, in_ast->value.string);
+    return _xte_variable_ref(in_ast->engine, in_ast->value.string, in_ast->var_slot);
 }
 
 
@@ -1324,28 +1532,8 @@ XTEVariant* _xte_interpret_subtree(XTE *in_engine, XTEAST *in_ast)
     /* we allow NULL AST execution to support missing command parameters, etc. */
     if (!in_ast) return NULL;
     
-    /* has the script been aborted? */
-    if (_xte_should_abort(in_engine, INVALID_LINE_NUMBER)) return NULL;
-    
-    /* has the loop iteration been aborted? */
-    if ((in_ast->engine->handler_stack_ptr >= 0) && (in_ast->engine->handler_stack[in_ast->engine->handler_stack_ptr].nested_loops > 0))
-    {
-        if (in_ast->engine->handler_stack[in_ast->engine->handler_stack_ptr].loop_abort_code != _LOOP_ABORT_NONE) return NULL;
-    }
-    
-    /* check debugging state */
-    if ((in_engine->run_state == XTE_RUNSTATE_DEBUG_OUT) && (in_engine->handler_stack_ptr < in_engine->debug_handler_ref_point))
-    {
-        in_engine->run_state = XTE_RUNSTATE_PAUSE;
-        if (_xte_should_abort(in_engine, in_ast->source_line)) return NULL;
-    }
-    
-    /* is there a checkpoint set for the current source line? */
-    if (in_ast->flags & XTE_AST_FLAG_IS_CHECKPOINT)
-    {
-        in_engine->run_state = XTE_RUNSTATE_PAUSE;
-        if (_xte_should_abort(in_engine, in_ast->source_line)) return NULL;
-    }
+    /* has the script or loop iteration been aborted? or should we pause here? */
+    if (_xte_should_abort_node(in_engine, in_ast)) return NULL;
     
     /* branch according to type of node being executed */
     switch (in_ast->type)
@@ -1527,7 +1715,15 @@ void _xte_interpret_handler(XTE *in_engine, XTEAST *in_handler, XTEVariant *in_p
     
     in_engine->exited_passing = XTE_FALSE;
     _xte_prepare_to_interpret(in_engine);
-    _xte_interpret_subtree(in_engine, in_handler);
+    
+    /* run the handler's bytecode, compiling it the first time;
+     if the handler can't be compiled, interpret the AST instead */
+    if (in_engine->use_bytecode && (!in_handler->value.handler.code))
+        in_handler->value.handler.code = _xte_compile_bytecode(in_engine, in_handler);
+    if (in_engine->use_bytecode && in_handler->value.handler.code)
+        _xte_vm_run(in_engine, in_handler, in_handler->value.handler.code);
+    else
+        _xte_interpret_subtree(in_engine, in_handler);
     
     _xte_pop_handler(in_engine);
 }
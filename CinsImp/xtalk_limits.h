@@ -79,6 +79,16 @@
 
 #define XTALK_LIMIT_NESTED_HANDLERS 500
 
+/*
+ *  XTALK_LIMIT_SCRIPT_CACHE_ENTRIES
+ *  ---------------------------------------------------------------------------------------------
+ *  Restricts the number of object scripts (and their compiled handlers) remembered by the
+ *  message heirarchy between messages.  When exceeded, the cache is flushed.
+ *
+ *  Implemented in _msgheir.c.
+ */
+#define XTALK_LIMIT_SCRIPT_CACHE_ENTRIES 1024
+
 
 
 #endif
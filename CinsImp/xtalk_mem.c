@@ -30,6 +30,7 @@
 #include "xtalk_internal.h"
 
 #include <libgen.h> /* required for basename() */
+#include <stdint.h> /* required for uintptr_t */
 
 
 #if DEBUG
@@ -371,3 +372,143 @@ void _xte_free_static(void *in_mem)
 
 
 
+
+
+
+/******************
+ Slab Allocator
+ 
+ Variants and AST nodes are created and destroyed in great numbers while a script runs.  Rather
+ than go to the general allocator for each, they're allocated from slabs: chunks of fixed size
+ objects, with a free list of the objects which have been released.  Each engine has it's own
+ slabs, and an engine is only ever used by one thread at a time, so the free lists require no
+ locking.
+ 
+ Chunks are aligned to their size, so the chunk (and slab) to which an object belongs is found
+ from the object's address, and objects can be freed without reference to the engine.
+ 
+ A slab may also be used as an arena for a group of objects which are all destroyed together,
+ eg. the nodes of a compiled handler; disposing of the slab releases all of it's chunks at once.
+ 
+ If XTALK_LEAK_CHECKING is set, objects are allocated individually by _xte_malloc() instead, so
+ that leaks are detected and reported the same as for any other allocation.
+ */
+
+#define _SLAB_CHUNK_SIZE 16384
+
+struct XTESlab
+{
+    char const *name;
+    long object_size;
+    int objects_per_chunk;
+    struct _SlabChunk *chunks;
+    void *free_list;
+};
+
+struct _SlabChunk
+{
+    struct XTESlab *slab; /* NULL if the slab was disposed while objects were still in use */
+    struct _SlabChunk *next;
+    int live_count;
+    int unused_count;
+};
+
+#define _SLAB_CHUNK_HEADER_SIZE ((sizeof(struct _SlabChunk) + 15) & ~15)
+
+/* the chunk containing an object */
+#define _SLAB_CHUNK_OF(object) ((struct _SlabChunk*)((uintptr_t)(object) & ~(uintptr_t)(_SLAB_CHUNK_SIZE - 1)))
+
+
+struct XTESlab* _xte_slab_create(char const *in_name, long in_object_size)
+{
+    struct XTESlab *slab = _xte_malloc(sizeof(struct XTESlab), _XTE_MALLOC_ZONE_GENERAL, __func__, __LINE__);
+    if (!slab) return NULL;
+    slab->name = in_name;
+    slab->object_size = (in_object_size + 15) & ~15;
+    slab->objects_per_chunk = (int)((_SLAB_CHUNK_SIZE - _SLAB_CHUNK_HEADER_SIZE) / slab->object_size);
+    slab->chunks = NULL;
+    slab->free_list = NULL;
+    return slab;
+}
+
+
+void* _xte_slab_alloc(struct XTESlab *in_slab)
+{
+#if XTALK_LEAK_CHECKING
+    return _xte_malloc(in_slab->object_size, _XTE_MALLOC_ZONE_GENERAL, in_slab->name, 0);
+#else
+    
+    /* reuse a free object if there is one */
+    void *object = in_slab->free_list;
+    if (object)
+    {
+        in_slab->free_list = *((void**)object);
+        _SLAB_CHUNK_OF(object)->live_count++;
+        return object;
+    }
+    
+    /* otherwise carve a new object from the most recent chunk, allocating another if it's full */
+    struct _SlabChunk *chunk = in_slab->chunks;
+    if ((!chunk) || (chunk->unused_count == 0))
+    {
+        void *memory;
+        if (posix_memalign(&memory, _SLAB_CHUNK_SIZE, _SLAB_CHUNK_SIZE) != 0) return NULL;
+        chunk = memory;
+        chunk->slab = in_slab;
+        chunk->next = in_slab->chunks;
+        chunk->live_count = 0;
+        chunk->unused_count = in_slab->objects_per_chunk;
+        in_slab->chunks = chunk;
+    }
+    object = (void*)chunk + _SLAB_CHUNK_HEADER_SIZE +
+        (in_slab->objects_per_chunk - chunk->unused_count) * in_slab->object_size;
+    chunk->unused_count--;
+    chunk->live_count++;
+    return object;
+    
+#endif
+}
+
+
+void _xte_slab_free(void *in_object)
+{
+#if XTALK_LEAK_CHECKING
+    _xte_free(in_object);
+#else
+    
+    struct _SlabChunk *chunk = _SLAB_CHUNK_OF(in_object);
+    chunk->live_count--;
+    if (chunk->slab)
+    {
+        *((void**)in_object) = chunk->slab->free_list;
+        chunk->slab->free_list = in_object;
+    }
+    else if (chunk->live_count == 0)
+        free(chunk);
+    
+#endif
+}
+
+
+/* releases all the slab's chunks; any chunk that still has objects in use is released when the
+ last of them is freed.  Returns the number of objects still in use. */
+long _xte_slab_dispose(struct XTESlab *in_slab)
+{
+    if (!in_slab) return 0;
+    long live_count = 0;
+#if !XTALK_LEAK_CHECKING
+    struct _SlabChunk *chunk = in_slab->chunks;
+    while (chunk)
+    {
+        struct _SlabChunk *next = chunk->next;
+        live_count += chunk->live_count;
+        if (chunk->live_count == 0)
+            free(chunk);
+        else
+            chunk->slab = NULL;
+        chunk = next;
+    }
+#endif
+    _xte_free(in_slab);
+    return live_count;
+}
@@ -29,14 +29,6 @@
 
 /* return value to this indicates if we were successful, or if something bad has happened and execution has terminated probably */
 
-/* ! SCRIPT CACHE can be ignored for now - there are a multitude of possibilities for this, some simpler
- than others, including perhaps keeping track of handler names for a given invokation of _xte_send_message and their
- compiled responders down the chain, thus avoiding identity issues, etc.
- 
- realistically do need eventually a script cache, even so we can identify what message handler names are along the current
- responder chain, which might be necessary during messagebox determination too... */
-/* probably use a map for this. need a good UTF-8 hashing function.  periodic rebuilding shouldn't be an issue. */
-
 
 
 
@@ -44,16 +36,289 @@ char* _xte_find_handler(XTE *in_engine, char const *in_script, int is_func, char
 int _xte_parse_handler(XTE *in_engine, XTEAST *in_stream, int const in_checkpoint[], int checkpoint_count, int in_checkpoint_offset);
 
 
-/* if it does respond to the message, return a compiled AST ready to execute for the handler;
- otherwise return NULL */
 
-static XTEAST* _xte_target_handler(XTE *in_engine, XTEVariant *in_target, int is_func, char const *in_message)
+/*********
+ Script Cache
+ 
+ Scripts are retained between messages for objects whose class provides a script identifier
+ (XTEScriptIdentifier), along with an index of their handlers (see xtalk_hdlridx.c) and the
+ compiled form of each handler that has been used.  Entries are keyed by the identity of the
+ owner object, and are only used if the script revision reported by the environment hasn't
+ changed since the script was retrieved.
+ 
+ Thus determining that an object doesn't have a particular handler requires neither retrieving
+ nor scanning its script, which is the common case as messages travel the responder chain.
+ 
+ Entries which are in use when they're invalidated (eg. a script that edits its own script)
+ are moved to a stale list, and destroyed when the last invokation of their handlers returns.
+ */
+
+#define _SCRIPT_CACHE_INITIAL_SIZE 64
+
+
+static void _xte_script_cache_entry_destroy(struct XTEScriptCacheEntry *in_entry)
+{
+    if (in_entry->handlers)
+    {
+        for (int h = 0; h < in_entry->index->handler_count; h++)
+        {
+            if (in_entry->handlers[h]) _xte_ast_destroy(in_entry->handlers[h]);
+        }
+        free(in_entry->handlers);
+    }
+    if (in_entry->index) _xte_handler_index_destroy(in_entry->index);
+    if (in_entry->script) free(in_entry->script);
+    if (in_entry->checkpoints) free(in_entry->checkpoints);
+    free(in_entry);
+}
+
+
+/* the entry must already have been unlinked from the table */
+static void _xte_script_cache_retire(XTE *in_engine, struct XTEScriptCacheEntry *in_entry)
+{
+    /* the shadowed names may refer to the entry's index */
+    _xte_shadowed_invalidate(in_engine);
+    
+    if (in_entry->use_count > 0)
+    {
+        in_entry->is_stale = XTE_TRUE;
+        in_entry->next = in_engine->script_cache_stale;
+        in_engine->script_cache_stale = in_entry;
+    }
+    else
+        _xte_script_cache_entry_destroy(in_entry);
+}
+
+
+/* invoked when the environment terminology changes, the cache grows too large,
+ and when the engine is disposed */
+void _xte_script_cache_flush(XTE *in_engine)
+{
+    for (int b = 0; b < in_engine->script_cache_size; b++)
+    {
+        struct XTEScriptCacheEntry *entry = in_engine->script_cache[b];
+        while (entry)
+        {
+            struct XTEScriptCacheEntry *next = entry->next;
+            _xte_script_cache_retire(in_engine, entry);
+            entry = next;
+        }
+        in_engine->script_cache[b] = NULL;
+    }
+    in_engine->script_cache_count = 0;
+}
+
+
+void _xte_script_cache_dispose(XTE *in_engine)
+{
+    _xte_script_cache_flush(in_engine);
+    
+    /* only non-empty if the engine is disposed during execution */
+    while (in_engine->script_cache_stale)
+    {
+        struct XTEScriptCacheEntry *next = in_engine->script_cache_stale->next;
+        _xte_script_cache_entry_destroy(in_engine->script_cache_stale);
+        in_engine->script_cache_stale = next;
+    }
+    
+    if (in_engine->script_cache) free(in_engine->script_cache);
+    in_engine->script_cache = NULL;
+    in_engine->script_cache_size = 0;
+    
+    if (in_engine->shadowed.table) free(in_engine->shadowed.table);
+    in_engine->shadowed.table = NULL;
+    in_engine->shadowed.table_size = 0;
+}
+
+
+static unsigned long _xte_script_cache_hash(void const *in_domain, long in_id)
+{
+    unsigned long hash = (unsigned long)in_domain;
+    hash = (hash * 31) ^ (unsigned long)in_id;
+    return hash;
+}
+
+
+/* returns the table slot pointing to the matching entry (regardless of revision),
+ or NULL if there isn't one */
+static struct XTEScriptCacheEntry** _xte_script_cache_find(XTE *in_engine, struct XTEClassInt *in_class, void const *in_domain,
+                                                           long in_id, unsigned long in_hash)
+{
+    if (in_engine->script_cache_size == 0) return NULL;
+    
+    struct XTEScriptCacheEntry **slot = in_engine->script_cache + (in_hash % in_engine->script_cache_size);
+    while (*slot)
+    {
+        struct XTEScriptCacheEntry *entry = *slot;
+        if ((entry->owner_id == in_id) && (entry->owner_domain == in_domain) && (entry->owner_class == in_class))
+            return slot;
+        slot = &(entry->next);
+    }
+    return NULL;
+}
+
+
+static void _xte_script_cache_grow(XTE *in_engine)
+{
+    int new_size = (in_engine->script_cache_size ? in_engine->script_cache_size * 2 : _SCRIPT_CACHE_INITIAL_SIZE);
+    struct XTEScriptCacheEntry **new_table = calloc(new_size, sizeof(struct XTEScriptCacheEntry*));
+    if (!new_table) return;
+    
+    for (int b = 0; b < in_engine->script_cache_size; b++)
+    {
+        struct XTEScriptCacheEntry *entry = in_engine->script_cache[b];
+        while (entry)
+        {
+            struct XTEScriptCacheEntry *next = entry->next;
+            entry->next = new_table[entry->hash % new_size];
+            new_table[entry->hash % new_size] = entry;
+            entry = next;
+        }
+    }
+    
+    if (in_engine->script_cache) free(in_engine->script_cache);
+    in_engine->script_cache = new_table;
+    in_engine->script_cache_size = new_size;
+}
+
+
+/* retrieves and indexes the script of the target, adding it to the cache;
+ returns NULL if the script couldn't be retrieved or indexed */
+static struct XTEScriptCacheEntry* _xte_script_cache_add(XTE *in_engine, XTEVariant *in_target, void const *in_domain,
+                                                         long in_id, long in_revision, unsigned long in_hash)
 {
     char const *script;
     int const *checkpoints;
     int checkpoint_count;
     
-    if ((!in_target->value.ref.type) || (!in_target->value.ref.type->script_retr)) return NULL;
+    int err = in_target->value.ref.type->script_retr(in_engine, in_engine->context, in_target,
+                                                     &script, &checkpoints, &checkpoint_count);
+    if (err != XTE_TRUE) return NULL;
+    
+    /* make room */
+    if (in_engine->script_cache_count >= XTALK_LIMIT_SCRIPT_CACHE_ENTRIES)
+        _xte_script_cache_flush(in_engine);
+    if (in_engine->script_cache_count >= in_engine->script_cache_size)
+        _xte_script_cache_grow(in_engine);
+    if (in_engine->script_cache_size == 0) return _xte_raise_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    
+    /* copy the script; the retriever's output is transient */
+    struct XTEScriptCacheEntry *entry = calloc(1, sizeof(struct XTEScriptCacheEntry));
+    if (!entry) return _xte_raise_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    entry->script = _xte_clone_cstr(in_engine, script);
+    if (checkpoint_count > 0)
+    {
+        entry->checkpoints = malloc(sizeof(int) * checkpoint_count);
+        if (entry->checkpoints)
+        {
+            memcpy(entry->checkpoints, checkpoints, sizeof(int) * checkpoint_count);
+            entry->checkpoint_count = checkpoint_count;
+        }
+    }
+    if ((!entry->script) || ((checkpoint_count > 0) && (!entry->checkpoints)))
+    {
+        _xte_script_cache_entry_destroy(entry);
+        return _xte_raise_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    }
+    
+    /* index the handlers */
+    entry->index = _xte_handler_index_create(in_engine, entry->script);
+    if (entry->index && (entry->index->handler_count > 0))
+        entry->handlers = calloc(entry->index->handler_count, sizeof(XTEAST*));
+    if ((!entry->index) || ((entry->index->handler_count > 0) && (!entry->handlers)))
+    {
+        if (entry->index) _xte_raise_void(in_engine, XTE_ERROR_MEMORY, NULL);
+        _xte_script_cache_entry_destroy(entry);
+        return NULL;
+    }
+    
+    entry->owner_class = in_target->value.ref.type;
+    entry->owner_domain = in_domain;
+    entry->owner_id = in_id;
+    entry->revision = in_revision;
+    entry->hash = in_hash;
+    
+    int b = (int)(in_hash % in_engine->script_cache_size);
+    entry->next = in_engine->script_cache[b];
+    in_engine->script_cache[b] = entry;
+    in_engine->script_cache_count++;
+    
+    return entry;
+}
+
+
+/* invoked when a handler obtained from _xte_target_handler() is no longer required */
+static void _xte_handler_release(XTE *in_engine, XTEAST *in_handler, struct XTEScriptCacheEntry *in_entry)
+{
+    if (!in_entry)
+    {
+        _xte_ast_destroy(in_handler);
+        return;
+    }
+    
+    assert(in_entry->use_count > 0);
+    in_entry->use_count--;
+    if ((in_entry->use_count > 0) || (!in_entry->is_stale)) return;
+    
+    struct XTEScriptCacheEntry **slot = &(in_engine->script_cache_stale);
+    while (*slot && (*slot != in_entry))
+        slot = &((*slot)->next);
+    assert(*slot == in_entry);
+    *slot = in_entry->next;
+    _xte_script_cache_entry_destroy(in_entry);
+}
+
+
+
+
+/* compiles the source of a single handler; returns NULL if the handler contains a syntax error */
+
+static XTEAST* _xte_compile_handler(XTE *in_engine, XTEVariant *in_target, char const *in_handler_script,
+                                    int const in_checkpoints[], int in_checkpoint_count, int in_handler_line_begin)
+{
+    /* the nodes of the handler are allocated together, in their own arena */
+    struct XTESlab *arena = _xte_slab_create("handler", sizeof(struct XTEAST));
+    if (!arena) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    struct XTESlab *save_arena = in_engine->ast_arena;
+    in_engine->ast_arena = arena;
+    
+    XTEVariant *save_me = in_engine->me;
+    in_engine->me = in_target;
+    
+    XTEAST *result = _xte_lex(in_engine, in_handler_script);
+    
+    if (result) 
+    {
+        _xte_parse_handler(in_engine, result, in_checkpoints, in_checkpoint_count, -(in_handler_line_begin - 1));
+    }
+    
+    in_engine->ast_arena = save_arena;
+    
+    if (result && (result->type != XTE_AST_HANDLER))
+    {
+        _xte_ast_destroy(result);
+        result = NULL;
+    }
+    
+    if (result)
+        result->value.handler.arena = arena;
+    else
+        _xte_slab_dispose(arena);
+    
+    in_engine->me = save_me;
+    
+    return result;
+}
+
+
+/* retrieves the script of the target and compiles the handler for the message, if there is one;
+ used for objects which cannot be cached */
+
+static XTEAST* _xte_retrieve_handler(XTE *in_engine, XTEVariant *in_target, int is_func, char const *in_message)
+{
+    char const *script;
+    int const *checkpoints;
+    int checkpoint_count;
     
     int err = in_target->value.ref.type->script_retr(in_engine, in_engine->context, in_target,
                                                      &script, &checkpoints, &checkpoint_count);
@@ -67,27 +332,240 @@ static XTEAST* _xte_target_handler(XTE *in_engine, XTEVariant *in_target, int is
     int handler_line_begin;
     char *handler_script = _xte_find_handler(in_engine, script, is_func, in_message, &handler_line_begin);
     
+    in_engine->me = save_me;
+    
     XTEAST *result = NULL;
     if (handler_script)
     {
-        result = _xte_lex(in_engine, handler_script);
+        result = _xte_compile_handler(in_engine, in_target, handler_script, checkpoints, checkpoint_count, handler_line_begin);
         free(handler_script);
     }
     
-    if (result) 
+    return result;
+}
+
+
+/* returns the cache entry for the script of the target, retrieving and indexing the script if
+ it isn't cached or has changed; returns NULL if the script couldn't be retrieved or indexed.
+ <out_is_cacheable> is set to XTE_FALSE if the script can't be identified, in which case it must
+ be retrieved for every message */
+
+static struct XTEScriptCacheEntry* _xte_script_cache_entry(XTE *in_engine, XTEVariant *in_target, int *out_is_cacheable)
+{
+    struct XTEClassInt *the_class = in_target->value.ref.type;
+    
+    /* identify the script, if possible */
+    void const *domain;
+    long obj_id, revision;
+    *out_is_cacheable = ((the_class->script_ident) &&
+        (the_class->script_ident(in_engine, in_engine->context, in_target, &domain, &obj_id, &revision) == XTE_TRUE));
+    if (!(*out_is_cacheable)) return NULL;
+    
+    /* look in the cache */
+    unsigned long hash = _xte_script_cache_hash(domain, obj_id);
+    struct XTEScriptCacheEntry *entry = NULL;
+    struct XTEScriptCacheEntry **slot = _xte_script_cache_find(in_engine, the_class, domain, obj_id, hash);
+    if (slot)
     {
-        _xte_parse_handler(in_engine, result, checkpoints, checkpoint_count, -(handler_line_begin - 1));
+        entry = *slot;
+        if (entry->revision != revision)
+        {
+            /* script has changed since it was retrieved */
+            *slot = entry->next;
+            in_engine->script_cache_count--;
+            _xte_script_cache_retire(in_engine, entry);
+            entry = NULL;
+        }
     }
+    if (!entry)
+        entry = _xte_script_cache_add(in_engine, in_target, domain, obj_id, revision, hash);
+    return entry;
+}
+
+
+/* if it does respond to the message, return a compiled AST ready to execute for the handler;
+ otherwise return NULL.  <out_entry> is set to the cache entry which owns the handler, if any;
+ the handler must be released with _xte_handler_release() */
+
+static XTEAST* _xte_target_handler(XTE *in_engine, XTEVariant *in_target, int is_func, char const *in_message,
+                                   struct XTEScriptCacheEntry **out_entry)
+{
+    *out_entry = NULL;
     
-    if (result && (result->type != XTE_AST_HANDLER))
+    struct XTEClassInt *the_class = in_target->value.ref.type;
+    if ((!the_class) || (!the_class->script_retr)) return NULL;
+    
+    int is_cacheable;
+    struct XTEScriptCacheEntry *entry = _xte_script_cache_entry(in_engine, in_target, &is_cacheable);
+    if (!is_cacheable) return _xte_retrieve_handler(in_engine, in_target, is_func, in_message);
+    if (!entry) return NULL;
+    
+    /* lookup the handler */
+    int handler = _xte_handler_index_find(entry->index, is_func, in_message);
+    if (handler < 0) return NULL;
+    
+    /* compile the handler on first use */
+    if (!entry->handlers[handler])
     {
-        _xte_ast_destroy(result);
-        result = NULL;
+        char *handler_script = _xte_handler_index_extract(in_engine, entry->index, entry->script, handler);
+        if (!handler_script) return NULL;
+        entry->handlers[handler] = _xte_compile_handler(in_engine, in_target, handler_script, entry->checkpoints,
+                                                        entry->checkpoint_count, entry->index->handlers[handler].line_begin);
+        free(handler_script);
+        if (!entry->handlers[handler]) return NULL;
     }
     
-    in_engine->me = save_me;
+    entry->use_count++;
+    *out_entry = entry;
+    return entry->handlers[handler];
+}
+
+
+
+
+/*********
+ Built-in Dispatch
+ 
+ Built-in functions and commands are only run once their message has travelled the responder
+ chain without finding a handler.  So that the chain needn't be searched for every call, the
+ engine keeps the set of handler names within the scripts of the responder chain of "me", and
+ runs a built-in directly if its name isn't in the set.
+ 
+ The set is discarded whenever the responder chain or its scripts might have changed; that is,
+ whenever a handler is run, the environment is given control (by its own commands and
+ functions, property and container writes and the routine callback) or a script cache entry is
+ retired.  If a script in the chain can't be cached, built-ins always travel the chain.
+ */
+
+#define _SHADOWED_INITIAL_SIZE 32
+
+
+void _xte_shadowed_invalidate(XTE *in_engine)
+{
+    in_engine->shadowed.is_valid = XTE_FALSE;
+}
+
+
+/* returns the table slot for the specified handler name; either the slot of the name,
+ or the empty slot where it should be inserted */
+static int _xte_shadowed_slot(struct XTEShadowSet *in_set, int is_func, char const *in_name, unsigned long in_hash)
+{
+    int mask = in_set->table_size - 1;
+    int slot = (int)(in_hash & mask);
+    for (;;)
+    {
+        struct XTEHandlerIndexEntry const *handler = in_set->table[slot];
+        if (!handler) return slot;
+        if ((handler->hash == in_hash) && (handler->is_func == is_func) && xte_cstrings_equal(handler->name, in_name))
+            return slot;
+        slot = (slot + 1) & mask;
+    }
+}
+
+
+static int _xte_shadowed_add(struct XTEShadowSet *in_set, struct XTEHandlerIndexEntry const *in_handler)
+{
+    /* resize the table to keep it at most half full */
+    if ((in_set->count + 1) * 2 > in_set->table_size)
+    {
+        int old_size = in_set->table_size;
+        struct XTEHandlerIndexEntry const **old_table = in_set->table;
+        int new_size = (old_size ? old_size * 2 : _SHADOWED_INITIAL_SIZE);
+        struct XTEHandlerIndexEntry const **new_table = calloc(new_size, sizeof(struct XTEHandlerIndexEntry*));
+        if (!new_table) return XTE_FALSE;
+        
+        in_set->table = new_table;
+        in_set->table_size = new_size;
+        for (int i = 0; i < old_size; i++)
+        {
+            if (old_table[i])
+                new_table[_xte_shadowed_slot(in_set, old_table[i]->is_func, old_table[i]->name, old_table[i]->hash)] = old_table[i];
+        }
+        if (old_table) free(old_table);
+    }
     
-    return result;
+    int slot = _xte_shadowed_slot(in_set, in_handler->is_func, in_handler->name, in_handler->hash);
+    if (!in_set->table[slot])
+    {
+        in_set->table[slot] = in_handler;
+        in_set->count++;
+    }
+    return XTE_TRUE;
+}
+
+
+/* collects the names of the handlers of the responder chain of "me", in the same manner as
+ _xte_send_message() searches the chain */
+static void _xte_shadowed_build(XTE *in_engine)
+{
+    struct XTEShadowSet *set = &(in_engine->shadowed);
+    if (set->table) memset(set->table, 0, sizeof(struct XTEHandlerIndexEntry*) * set->table_size);
+    set->count = 0;
+    set->me = in_engine->me;
+    set->is_valid = XTE_TRUE;
+    set->is_complete = XTE_TRUE;
+    
+    XTEVariant *responder = in_engine->me;
+    while (responder && set->is_complete)
+    {
+        struct XTEClassInt *the_class = responder->value.ref.type;
+        if (the_class && the_class->script_retr)
+        {
+            int is_cacheable;
+            struct XTEScriptCacheEntry *entry = _xte_script_cache_entry(in_engine, responder, &is_cacheable);
+            if (!entry) set->is_complete = XTE_FALSE;
+            for (int h = 0; entry && (h < entry->index->handler_count); h++)
+            {
+                if (!_xte_shadowed_add(set, entry->index->handlers + h)) set->is_complete = XTE_FALSE;
+            }
+        }
+        
+        /* identify the next responder */
+        XTEVariant *next_responder = NULL;
+        if (set->is_complete && the_class && the_class->next_responder)
+        {
+            int err = the_class->next_responder(in_engine, in_engine->context, responder, &next_responder);
+            if ((err != XTE_ERROR_NONE) && ((err != XTE_ERROR_NO_OBJECT) || next_responder))
+                set->is_complete = XTE_FALSE;
+        }
+        if (responder != in_engine->me) xte_variant_release(responder);
+        responder = next_responder;
+    }
+    if (responder && (responder != in_engine->me)) xte_variant_release(responder);
+}
+
+
+/* returns XTE_TRUE if a handler in the responder chain of "me" might respond to the message */
+static int _xte_is_shadowed(XTE *in_engine, int is_func, char const *in_message)
+{
+    struct XTEShadowSet *set = &(in_engine->shadowed);
+    if ((!set->is_valid) || (set->me != in_engine->me))
+        _xte_shadowed_build(in_engine);
+    
+    /* the set may have been discarded while it was built, eg. if a script had changed */
+    if ((!set->is_valid) || (!set->is_complete)) return XTE_TRUE;
+    if (set->count == 0) return XTE_FALSE;
+    return (set->table[_xte_shadowed_slot(set, is_func, in_message, _xte_cstr_case_hash(in_message))] != NULL);
+}
+
+
+/* invokes the C implementation of a function or command, once its message has found no handler */
+static void _xte_run_builtin(XTE *in_engine, int is_func, char const *in_message, XTEVariant *in_params[], int in_param_count,
+                             void *in_imp)
+{
+    if (in_engine->callback.debug_message)
+        in_engine->callback.debug_message(in_engine, in_engine->context, in_message, in_engine->handler_stack_ptr + 1, XTE_TRUE);
+    
+    if (!is_func)
+    {
+        XTECommandImp imp = (XTECommandImp)in_imp;
+        imp(in_engine, in_engine->context, in_params, in_param_count);
+    }
+    else
+    {
+        XTEFunctionImp imp = (XTEFunctionImp)in_imp;
+        _xte_set_result(in_engine, imp(in_engine, in_params, in_param_count));
+    }
 }
 
 
@@ -115,13 +593,14 @@ int _xte_send_message(XTE *in_engine, XTEVariant *in_target, XTEVariant *in_resp
     
     /* check if there is a target */
     XTEAST *handler = NULL;
+    struct XTEScriptCacheEntry *handler_entry = NULL;
     if (in_responder)
     {
         
         
         /* look for a handler in the target object */
         /* this subroutine is the one that should identify function ptrs for built-in system event handlers */
-        handler = _xte_target_handler(in_engine, in_responder, is_func, in_message);
+        handler = _xte_target_handler(in_engine, in_responder, is_func, in_message, &handler_entry);
         
    
         
@@ -138,6 +617,9 @@ int _xte_send_message(XTE *in_engine, XTEVariant *in_target, XTEVariant *in_resp
             
             
             
+            /* the handler may change the responder chain or its scripts */
+            _xte_shadowed_invalidate(in_engine);
+            
             /* set "me" */
             XTEVariant *save_me = in_engine->me;
             in_engine->me = in_responder;
@@ -155,7 +637,7 @@ int _xte_send_message(XTE *in_engine, XTEVariant *in_target, XTEVariant *in_resp
                 goto _send_message_cleanup;
             
             /* if it passed the message, look for the next responder of the target */
-            _xte_ast_destroy(handler);
+            _xte_handler_release(in_engine, handler, handler_entry);
             handler = NULL;
         }
         
@@ -182,22 +664,7 @@ int _xte_send_message(XTE *in_engine, XTEVariant *in_target, XTEVariant *in_resp
         err = XTE_ERROR_NONE;
         
         if (in_builtin_hint)
-        {
-            if (in_engine->callback.debug_message)
-                in_engine->callback.debug_message(in_engine, in_engine->context, in_message, in_engine->handler_stack_ptr + 1, XTE_TRUE);
-            
-            if (!is_func)
-            {
-                XTECommandImp imp = (XTECommandImp)in_builtin_hint;
-                imp(in_engine, in_engine->context, in_params, in_param_count);
-            }
-            else
-            {
-                XTEFunctionImp imp = (XTEFunctionImp)in_builtin_hint;
-                _xte_set_result(in_engine, imp(in_engine, in_params, in_param_count));
-            }
-            
-        }
+            _xte_run_builtin(in_engine, is_func, in_message, in_params, in_param_count, in_builtin_hint);
         else
         {
             /* there is no handler either in CinsImp or in the stack;
@@ -225,7 +692,7 @@ int _xte_send_message(XTE *in_engine, XTEVariant *in_target, XTEVariant *in_resp
 _send_message_cleanup:
     
     /* cleanup and exit */
-    if (handler) _xte_ast_destroy(handler);
+    if (handler) _xte_handler_release(in_engine, handler, handler_entry);
     handler = NULL;
     
     in_engine->the_target = saved_target;
@@ -234,3 +701,30 @@ _send_message_cleanup:
 }
 
 
+/*
+ *  _xte_send_builtin
+ *  ---------------------------------------------------------------------------------------------
+ *  Sends the message for a call to a function or command of the built-in vocabulary from "me".
+ *  Unless a handler for the message might be found in the responder chain, the message isn't
+ *  sent; <in_imp> is invoked directly.  Returns as for _xte_send_message().
+ */
+
+int _xte_send_builtin(XTE *in_engine, int is_func, char const *in_message, XTEVariant *in_params[], int in_param_count,
+                      void *in_imp)
+{
+    /* as for a sent message, nothing further runs once there's an error */
+    if (xte_has_error(in_engine)) return XTE_ERROR_NONE;
+    
+    if (_xte_is_shadowed(in_engine, is_func, in_message))
+        return _xte_send_message(in_engine, in_engine->me, in_engine->me, is_func, in_message, in_params, in_param_count,
+                                 in_imp, NULL);
+    
+    /* "the target" is the same as it would be had the message been sent */
+    XTEVariant *saved_target = in_engine->the_target;
+    in_engine->the_target = in_engine->me;
+    _xte_run_builtin(in_engine, is_func, in_message, in_params, in_param_count, in_imp);
+    in_engine->the_target = saved_target;
+    return XTE_ERROR_NONE;
+}
+
+
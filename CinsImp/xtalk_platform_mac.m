@@ -12,6 +12,7 @@
  */
 
 #import <Foundation/Foundation.h>
+#import <CoreServices/CoreServices.h>
 #include "xtalk_platform.h"
 #include <stdlib.h>
 
@@ -225,6 +226,58 @@ int utf8_contains(const char *in_string1, const char *in_string2)
     }
 }
 
+
+/* collation keys are the case-insensitive collation values of the text for the user's locale,
+ each written as five base-128 digits offset by one, so that keys have no NULs and order by strcmp() */
+long utf8_collation_key(const char *in_string, char *out_key, long in_key_size)
+{
+    static CollatorRef collator = NULL;
+    static dispatch_once_t collator_once;
+    dispatch_once(&collator_once, ^{
+        LocaleRef locale = NULL;
+        LocaleRefFromLocaleString([[[NSLocale currentLocale] localeIdentifier] UTF8String], &locale);
+        if (UCCreateCollator(locale, 0, kUCCollateStandardOptions | kUCCollateCaseInsensitiveMask, &collator) != noErr)
+            collator = NULL;
+    });
+    
+    @autoreleasepool {
+        NSString *string = [NSString stringWithCString:in_string encoding:NSUTF8StringEncoding];
+        NSUInteger length = [string length];
+        UniChar *text = malloc(sizeof(UniChar) * (length + 1));
+        ItemCount value_limit = length * 5 + 16, value_count = 0;
+        UCCollationValue *values = malloc(sizeof(UCCollationValue) * value_limit);
+        if (collator && text && values)
+        {
+            [string getCharacters:text range:NSMakeRange(0, length)];
+            OSStatus err;
+            while ((err = UCGetCollationKey(collator, text, length, value_limit, &value_count, values)) == kCollateBufferTooSmall)
+            {
+                UCCollationValue *larger = realloc(values, sizeof(UCCollationValue) * value_limit * 2);
+                if (!larger) break;
+                values = larger;
+                value_limit *= 2;
+            }
+            if (err != noErr) value_count = 0;
+        }
+        
+        long required = value_count * 5;
+        if (in_key_size > required)
+        {
+            for (ItemCount i = 0; i < value_count; i++)
+            {
+                for (int digit = 0; digit < 5; digit++)
+                    out_key[i * 5 + digit] = ((values[i] >> (7 * (4 - digit))) & 0x7F) + 1;
+            }
+            out_key[required] = 0;
+        }
+        else if (in_key_size > 0) out_key[0] = 0;
+        
+        if (text) free(text);
+        if (values) free(values);
+        return required;
+    }
+}
+
 /*
 static NSString *utf8_string = NULL;
 static NSArray *utf8_words = NULL;
@@ -398,9 +451,9 @@ void _xte_platform_sys_version(int *out_major, int *out_minor, int *out_bugfix)
 }
 
 
-const char* _xte_platform_sys(void)
+void _xte_platform_sys(char *out_name, int in_size)
 {
-    return "MacOS X";
+    snprintf(out_name, in_size, "MacOS X");
 }
 
 
@@ -16,3 +16,485 @@ void _xte_platform_suspend_thread(int in_microseconds)
 
 
 
+/* on Mac OS X, the remaining glue is provided by xtalk_platform_mac.m */
+#ifndef __APPLE__
+
+#include <strings.h>
+#include <sys/time.h>
+#include <sys/utsname.h>
+
+#include "xtalk_internal.h"
+#include "xtalk_platform.h"
+
+
+/* 1983-09-19 16:30:00 +0930, in seconds since the UNIX epoch */
+#define XTALK_TIMESTAMP_EPOCH_DATE 432802800.0
+
+
+/*********
+ Date/Time
+
+ Dates are formatted as Mac OS X does for the en_US locale.  Parsing accepts the formats that are
+ output, ISO 8601 dates (YYYY-MM-DD) and times with or without seconds and AM/PM; it's much less
+ forgiving than the Mac OS X data detector.
+ */
+
+struct XTEDateTimeOSContext
+{
+    double working_date;    /* seconds since the UNIX epoch */
+    char result[64];
+};
+
+
+static char const *const _MONTH_NAMES[] = {
+    "January", "February", "March", "April", "May", "June", "July", "August", "September",
+    "October", "November", "December"
+};
+
+static char const *const _WEEKDAY_NAMES[] = {
+    "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"
+};
+
+
+void _xte_os_current_datetime(void *in_context)
+{
+    struct XTEDateTimeOSContext *context = in_context;
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    context->working_date = now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+
+void* _xte_os_date_init(void)
+{
+    struct XTEDateTimeOSContext *context = malloc(sizeof(struct XTEDateTimeOSContext));
+    if (!context) return NULL;
+    _xte_os_current_datetime(context);
+    context->result[0] = 0;
+    return context;
+}
+
+
+void _xte_os_date_deinit(void *in_context)
+{
+    if (in_context) free(in_context);
+}
+
+
+double _xte_os_timestamp(void *in_context)
+{
+    struct XTEDateTimeOSContext *context = in_context;
+    return context->working_date - XTALK_TIMESTAMP_EPOCH_DATE;
+}
+
+
+void _xte_os_conv_timestamp(void *in_context, double in_timestamp)
+{
+    struct XTEDateTimeOSContext *context = in_context;
+    context->working_date = XTALK_TIMESTAMP_EPOCH_DATE + in_timestamp;
+}
+
+
+static void _xte_os_local_time(struct XTEDateTimeOSContext *in_context, struct tm *out_parts)
+{
+    time_t seconds = (time_t)floor(in_context->working_date);
+    localtime_r(&seconds, out_parts);
+}
+
+
+void _xte_os_dateitems(void *in_context, int *out_year, int *out_month, int *out_dayOfMonth,
+                       int *out_hour24, int *out_minute, int *out_second, int *out_dayOfWeek)
+{
+    struct XTEDateTimeOSContext *context = in_context;
+    struct tm parts;
+    _xte_os_local_time(context, &parts);
+    *out_year = parts.tm_year + 1900;
+    *out_month = parts.tm_mon + 1;
+    *out_dayOfMonth = parts.tm_mday;
+    
+    *out_hour24 = parts.tm_hour;
+    *out_minute = parts.tm_min;
+    *out_second = parts.tm_sec;
+    
+    *out_dayOfWeek = parts.tm_wday + 1;
+}
+
+
+/* out of range items are normalised, eg. the 32nd of January is the 1st of February;
+ the day of the week is ignored */
+void _xte_os_conv_dateitems(void *in_context, int in_year, int in_month, int in_dayOfMonth,
+                            int in_hour24, int in_minute, int in_second, int in_dayOfWeek)
+{
+    struct XTEDateTimeOSContext *context = in_context;
+    struct tm parts;
+    memset(&parts, 0, sizeof(parts));
+    parts.tm_year = in_year - 1900;
+    parts.tm_mon = in_month - 1;
+    parts.tm_mday = in_dayOfMonth;
+    
+    parts.tm_hour = in_hour24;
+    parts.tm_min = in_minute;
+    parts.tm_sec = in_second;
+    
+    parts.tm_isdst = -1;
+    context->working_date = (double)mktime(&parts);
+}
+
+
+char const* _xte_os_date_string(void *in_context, int in_format)
+{
+    struct XTEDateTimeOSContext *context = in_context;
+    struct tm parts;
+    _xte_os_local_time(context, &parts);
+    int hour12 = (parts.tm_hour % 12 ? parts.tm_hour % 12 : 12);
+    char const *meridian = (parts.tm_hour < 12 ? "AM" : "PM");
+    
+    char *result = context->result;
+    int const size = sizeof(context->result);
+    switch (in_format)
+    {
+        case XTE_DATE_SHORT:
+            snprintf(result, size, "%d/%d/%02d", parts.tm_mon + 1, parts.tm_mday, parts.tm_year % 100);
+            break;
+        case XTE_DATE_ABBREVIATED:
+            snprintf(result, size, "%s %d, %d", _MONTH_NAMES[parts.tm_mon], parts.tm_mday, parts.tm_year + 1900);
+            break;
+        case XTE_DATE_LONG:
+            snprintf(result, size, "%s, %s %d, %d", _WEEKDAY_NAMES[parts.tm_wday], _MONTH_NAMES[parts.tm_mon],
+                     parts.tm_mday, parts.tm_year + 1900);
+            break;
+        case XTE_TIME_SHORT:
+            snprintf(result, size, "%d:%02d %s", hour12, parts.tm_min, meridian);
+            break;
+        case XTE_TIME_LONG:
+            snprintf(result, size, "%d:%02d:%02d %s", hour12, parts.tm_min, parts.tm_sec, meridian);
+            break;
+        case XTE_MONTH_SHORT:
+            snprintf(result, size, "%.3s", _MONTH_NAMES[parts.tm_mon]);
+            break;
+        case XTE_MONTH_LONG:
+            snprintf(result, size, "%s", _MONTH_NAMES[parts.tm_mon]);
+            break;
+        case XTE_WEEKDAY_SHORT:
+            snprintf(result, size, "%.3s", _WEEKDAY_NAMES[parts.tm_wday]);
+            break;
+        case XTE_WEEKDAY_LONG:
+            snprintf(result, size, "%s", _WEEKDAY_NAMES[parts.tm_wday]);
+            break;
+        default:
+            result[0] = 0;
+            break;
+    }
+    return result;
+}
+
+
+/* returns the index of the name which begins with the word, if the word is at least three
+ letters; otherwise -1 */
+static int _xte_os_date_name(char const *in_word, int in_length, char const *const in_names[], int in_count)
+{
+    if (in_length < 3) return -1;
+    for (int i = 0; i < in_count; i++)
+    {
+        if ((in_length <= strlen(in_names[i])) && (strncasecmp(in_word, in_names[i], in_length) == 0))
+            return i;
+    }
+    return -1;
+}
+
+
+/* if the string contains a recognisable date and/or time, makes it the working date;
+ a date without a time is taken to be at noon, and a time without a date to be today */
+void _xte_os_parse_date(void *in_context, char const *in_date)
+{
+    struct XTEDateTimeOSContext *context = in_context;
+    struct tm now;
+    struct XTEDateTimeOSContext current;
+    _xte_os_current_datetime(&current);
+    _xte_os_local_time(&current, &now);
+    
+    int year = -1, month = -1, day = -1, hour = -1, minute = 0, second = 0, meridian = -1;
+    char const *scan = in_date;
+    while (*scan)
+    {
+        if (isalpha((unsigned char)*scan))
+        {
+            /* month names and AM/PM; other words, such as weekdays, are ignored */
+            char const *word = scan;
+            while (isalpha((unsigned char)*scan)) scan++;
+            int length = (int)(scan - word);
+            int name = _xte_os_date_name(word, length, _MONTH_NAMES, 12);
+            if ((name >= 0) && (month < 0)) month = name + 1;
+            else if ((length == 2) && (strncasecmp(word, "am", 2) == 0)) meridian = 0;
+            else if ((length == 2) && (strncasecmp(word, "pm", 2) == 0)) meridian = 1;
+        }
+        else if (isdigit((unsigned char)*scan))
+        {
+            /* a number, or a group of numbers separated by : / or - */
+            int numbers[3] = {0}, digits[3] = {0}, count = 0;
+            char separator = 0;
+            while (count < 3)
+            {
+                while (isdigit((unsigned char)*scan))
+                {
+                    numbers[count] = numbers[count] * 10 + (*scan - '0');
+                    digits[count]++;
+                    scan++;
+                }
+                count++;
+                if ((count == 1) && ((*scan == ':') || (*scan == '/') || (*scan == '-'))) separator = *scan;
+                if ((count == 3) || (*scan != separator) || (!separator) || (!isdigit((unsigned char)scan[1]))) break;
+                scan++;
+            }
+            
+            if ((separator == ':') && (count >= 2))
+            {
+                hour = numbers[0];
+                minute = numbers[1];
+                second = (count == 3 ? numbers[2] : 0);
+            }
+            else if ((separator == '-') && (count == 3) && (digits[0] == 4))
+            {
+                year = numbers[0];
+                month = numbers[1];
+                day = numbers[2];
+            }
+            else if (((separator == '/') || (separator == '-')) && (count >= 2))
+            {
+                month = numbers[0];
+                day = numbers[1];
+                if (count == 3)
+                {
+                    year = numbers[2];
+                    if (digits[2] <= 2)
+                    {
+                        /* two digit years are within 80 years before and 20 years after now */
+                        int century = (now.tm_year + 1900 + 20) / 100 * 100;
+                        year += century;
+                        if (year > now.tm_year + 1900 + 20) year -= 100;
+                    }
+                }
+            }
+            else if (count == 1)
+            {
+                if ((digits[0] <= 2) && (day < 0)) day = numbers[0];
+                else if ((digits[0] == 4) && (year < 0)) year = numbers[0];
+            }
+        }
+        else scan++;
+    }
+    
+    /* check what was found */
+    if (meridian >= 0)
+    {
+        if ((hour < 1) || (hour > 12)) return;
+        hour = hour % 12 + (meridian ? 12 : 0);
+    }
+    if ((hour > 23) || (minute > 59) || (second > 59)) return;
+    if ((month >= 0) && ((month < 1) || (month > 12) || (day < 1) || (day > 31))) return;
+    if ((month < 0) && (hour < 0)) return;
+    
+    if (month < 0)
+    {
+        year = now.tm_year + 1900;
+        month = now.tm_mon + 1;
+        day = now.tm_mday;
+    }
+    if (year < 0) year = now.tm_year + 1900;
+    if (hour < 0) hour = 12;
+    
+    _xte_os_conv_dateitems(context, year, month, day, hour, minute, second, 0);
+}
+
+
+
+
+/*********
+ Strings
+
+ Strings are compared and searched by their full Unicode case folding (see xtalk_utf8_equal.c).
+ Collation is by code point, rather than by locale as on Mac OS X.
+ */
+
+int utf8_compare(const char *in_string1, const char *in_string2)
+{
+    return _xte_utf8_fold_compare(in_string1, in_string2);
+}
+
+
+/* the folded form orders byte-wise the same way as utf8_compare() */
+long utf8_collation_key(const char *in_string, char *out_key, long in_key_size)
+{
+    long required = xte_cstring_fold(in_string, NULL, 0);
+    if (in_key_size > required) xte_cstring_fold(in_string, out_key, in_key_size);
+    else if (in_key_size > 0) out_key[0] = 0;
+    return required;
+}
+
+
+/* returns the folded form of a string, in <in_buffer> if it's large enough;
+ otherwise in a new allocation that must be freed by the caller */
+static char* _xte_os_fold(char const *in_string, char *in_buffer, long in_buffer_size, long *out_length)
+{
+    *out_length = xte_cstring_fold(in_string, in_buffer, in_buffer_size);
+    if (*out_length < in_buffer_size) return in_buffer;
+    
+    char *folded = malloc(*out_length + 1);
+    if (!folded) return NULL;
+    xte_cstring_fold(in_string, folded, *out_length + 1);
+    return folded;
+}
+
+
+/* finds the maximal suffix of <in_needle> under the normal (or with <in_reversed>, reversed)
+ ordering of bytes; returns the position before the suffix and sets <out_period> to it's period */
+static long _xte_os_max_suffix(unsigned char const *in_needle, long in_length, int in_reversed, long *out_period)
+{
+    long suffix = -1, j = 0, k = 1, period = 1;
+    while (j + k < in_length)
+    {
+        unsigned char a = in_needle[j + k], b = in_needle[suffix + k];
+        if (in_reversed ? (a > b) : (a < b))
+        {
+            j += k;
+            k = 1;
+            period = j - suffix;
+        }
+        else if (a == b)
+        {
+            if (k != period) k++;
+            else
+            {
+                j += period;
+                k = 1;
+            }
+        }
+        else
+        {
+            suffix = j;
+            j = suffix + 1;
+            k = period = 1;
+        }
+    }
+    *out_period = period;
+    return suffix;
+}
+
+
+/*
+ *  _xte_os_find
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns the byte offset of the first occurrence of <in_needle> in <in_haystack>, or -1 if
+ *  there isn't one.  Uses the Two-Way algorithm of Crochemore and Perrin, which runs in linear
+ *  time and constant space.
+ */
+static long _xte_os_find(unsigned char const *in_haystack, long in_haystack_length,
+                         unsigned char const *in_needle, long in_needle_length)
+{
+    if (in_needle_length > in_haystack_length) return -1;
+    if (in_needle_length == 0) return 0;
+    
+    /* split the needle at a critical factorisation */
+    long period, reversed_period;
+    long split = _xte_os_max_suffix(in_needle, in_needle_length, XTE_FALSE, &period);
+    long reversed_split = _xte_os_max_suffix(in_needle, in_needle_length, XTE_TRUE, &reversed_period);
+    if (reversed_split > split)
+    {
+        split = reversed_split;
+        period = reversed_period;
+    }
+    
+    long j = 0, i;
+    if (memcmp(in_needle, in_needle + period, split + 1) == 0)
+    {
+        /* the needle is periodic; remember how much of the left half already matches */
+        long memory = -1;
+        while (j <= in_haystack_length - in_needle_length)
+        {
+            i = (split > memory ? split : memory) + 1;
+            while ((i < in_needle_length) && (in_needle[i] == in_haystack[i + j])) i++;
+            if (i >= in_needle_length)
+            {
+                i = split;
+                while ((i > memory) && (in_needle[i] == in_haystack[i + j])) i--;
+                if (i <= memory) return j;
+                j += period;
+                memory = in_needle_length - period - 1;
+            }
+            else
+            {
+                j += i - split;
+                memory = -1;
+            }
+        }
+    }
+    else
+    {
+        period = (split + 1 > in_needle_length - split - 1 ? split + 1 : in_needle_length - split - 1) + 1;
+        while (j <= in_haystack_length - in_needle_length)
+        {
+            i = split + 1;
+            while ((i < in_needle_length) && (in_needle[i] == in_haystack[i + j])) i++;
+            if (i >= in_needle_length)
+            {
+                i = split;
+                while ((i >= 0) && (in_needle[i] == in_haystack[i + j])) i--;
+                if (i < 0) return j;
+                j += period;
+            }
+            else
+                j += i - split;
+        }
+    }
+    return -1;
+}
+
+
+/* as on Mac OS X, an empty string isn't contained by anything */
+int utf8_contains(const char *in_string1, const char *in_string2)
+{
+    if (!in_string2[0]) return XTE_FALSE;
+    
+    char buffer1[256], buffer2[64];
+    long length1, length2;
+    char *haystack = _xte_os_fold(in_string1, buffer1, sizeof(buffer1), &length1);
+    char *needle = _xte_os_fold(in_string2, buffer2, sizeof(buffer2), &length2);
+    
+    int result = XTE_FALSE;
+    if (haystack && needle)
+        result = (_xte_os_find((unsigned char const*)haystack, length1, (unsigned char const*)needle, length2) >= 0);
+    
+    if (haystack && (haystack != buffer1)) free(haystack);
+    if (needle && (needle != buffer2)) free(needle);
+    return result;
+}
+
+
+
+
+/*********
+ Host
+ */
+
+void _xte_platform_sys_version(int *out_major, int *out_minor, int *out_bugfix)
+{
+    struct utsname host;
+    *out_major = *out_minor = *out_bugfix = 0;
+    if (uname(&host) == 0)
+        sscanf(host.release, "%d.%d.%d", out_major, out_minor, out_bugfix);
+}
+
+
+void _xte_platform_sys(char *out_name, int in_size)
+{
+    struct utsname host;
+    if (uname(&host) == 0)
+        snprintf(out_name, in_size, "%s", host.sysname);
+    else
+        snprintf(out_name, in_size, "POSIX");
+}
+
+
+#endif
+
+
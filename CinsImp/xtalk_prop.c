@@ -61,13 +61,16 @@ static int _xte_node_is_prop_rep(XTEAST *in_node, XTEPropRep *out_rep)
 static struct XTEPropertyInt* _xte_prop_lookup_backward(XTE *in_engine, XTEAST *in_stmt, int in_offset)
 {
     if (in_offset < 0) return NULL;
+    if (in_stmt->children[in_offset]->type != XTE_AST_WORD) return NULL;
+    char const *last_word = in_stmt->children[in_offset]->value.string;
     
     /* search global table first */
-    for (int i = 0; i < in_engine->global_prop_count; i++)
+    for (struct XTETerm const *term = _xte_dict_first(in_engine, XTE_TERM_PROPERTY_LAST, last_word);
+         term; term = _xte_dict_next(in_engine, term))
     {
         /* ignore properties whose names are too long */
-        if (in_offset + 1 - in_engine->global_props[i]->word_count < 1) continue;
-        struct XTEPropertyInt *prop = in_engine->global_props[i];
+        struct XTEPropertyInt *prop = term->def;
+        if (in_offset + 1 - prop->word_count < 1) continue;
         
         /* match words of property */
         int w = 0;
@@ -84,11 +87,12 @@ static struct XTEPropertyInt* _xte_prop_lookup_backward(XTE *in_engine, XTEAST *
     }
     
     /* search class properties table */
-    for (int i = 0; i < in_engine->class_prop_count; i++)
+    for (struct XTETerm const *term = _xte_dict_first(in_engine, XTE_TERM_CLASS_PROPERTY_LAST, last_word);
+         term; term = _xte_dict_next(in_engine, term))
     {
         /* ignore properties whose names are too long */
-        if (in_offset + 1 - in_engine->class_props[i]->word_count < 0) continue;
-        struct XTEPropertyInt *prop = in_engine->class_props[i];
+        struct XTEPropertyInt *prop = term->def;
+        if (in_offset + 1 - prop->word_count < 0) continue;
         
         /* match words of property */
         int w = 0;
@@ -113,13 +117,16 @@ static struct XTEPropertyInt* _xte_prop_lookup_backward(XTE *in_engine, XTEAST *
 static struct XTEPropertyInt* _xte_prop_lookup_forward(XTE *in_engine, XTEAST *in_stmt, int in_offset)
 {
     if (in_offset >= in_stmt->children_count) return NULL;
+    if (in_stmt->children[in_offset]->type != XTE_AST_WORD) return NULL;
+    char const *first_word = in_stmt->children[in_offset]->value.string;
     
     /* search global table first */
-    for (int i = 0; i < in_engine->global_prop_count; i++)
+    for (struct XTETerm const *term = _xte_dict_first(in_engine, XTE_TERM_PROPERTY, first_word);
+         term; term = _xte_dict_next(in_engine, term))
     {
         /* ignore properties whose names are too long */
-        if (in_offset + in_engine->global_props[i]->word_count > in_stmt->children_count) continue;
-        struct XTEPropertyInt *prop = in_engine->global_props[i];
+        struct XTEPropertyInt *prop = term->def;
+        if (in_offset + prop->word_count > in_stmt->children_count) continue;
         
         /* match words of property */
         int w = 0;
@@ -136,11 +143,12 @@ static struct XTEPropertyInt* _xte_prop_lookup_forward(XTE *in_engine, XTEAST *i
     }
     
     /* search class properties table */
-    for (int i = 0; i < in_engine->class_prop_count; i++)
+    for (struct XTETerm const *term = _xte_dict_first(in_engine, XTE_TERM_CLASS_PROPERTY, first_word);
+         term; term = _xte_dict_next(in_engine, term))
     {
         /* ignore properties whose names are too long */
-        if (in_offset + in_engine->class_props[i]->word_count > in_stmt->children_count) continue;
-        struct XTEPropertyInt *prop = in_engine->class_props[i];
+        struct XTEPropertyInt *prop = term->def;
+        if (in_offset + prop->word_count > in_stmt->children_count) continue;
         
         /* match words of property */
         int w = 0;
@@ -341,6 +349,17 @@ static int _xte_map_property_pointer(XTE *in_engine, struct XTEPropertyDef *in_d
     if (table_index < 0) return _xte_panic_int(in_engine, XTE_ERROR_INTERNAL, NULL);
     struct XTEPropertyPtrs *table_entry = &(in_engine->prop_ptr_table[table_index]);
     
+    /* the pointers of a built-in property are shared with other engines, so must be copied
+     before they can be extended, see xtalk_vocab.c */
+    XTE const *base = _xte_vocab_shared(in_engine);
+    if (base && (table_index < base->prop_ptr_count) && (table_entry->ptrs == base->prop_ptr_table[table_index].ptrs))
+    {
+        struct XTEPropertyPtr *own_ptrs = malloc(sizeof(struct XTEPropertyPtr) * table_entry->ptr_count);
+        if (!own_ptrs) return _xte_panic_int(in_engine, XTE_ERROR_MEMORY, NULL);
+        memcpy(own_ptrs, table_entry->ptrs, sizeof(struct XTEPropertyPtr) * table_entry->ptr_count);
+        table_entry->ptrs = own_ptrs;
+    }
+    
     struct XTEPropertyPtr *new_ptrs = realloc(table_entry->ptrs, sizeof(struct XTEPropertyPtr) * (table_entry->ptr_count + 1));
     if (!new_ptrs) return _xte_panic_int(in_engine, XTE_ERROR_MEMORY, NULL);
     table_entry->ptrs = new_ptrs;
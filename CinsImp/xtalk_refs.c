@@ -233,11 +233,12 @@ void _xte_parse_refs(XTE *in_engine, XTEAST *in_stmt)
         XTEAST *child = in_stmt->children[i];
         if (child->type == XTE_AST_WORD)
         {
-            /* iterate through reference clauses */
-            for (int j = in_engine->ref_count-1; j >= 0; j--)
+            /* iterate through reference clauses beginning with this word */
+            for (struct XTETerm const *term = _xte_dict_first(in_engine, XTE_TERM_REF, child->value.string);
+                 term; term = _xte_dict_next(in_engine, term))
             {
                 /* compare reference clause against statement */
-                struct XTERefInt *ref = in_engine->refs + j;
+                struct XTERefInt *ref = term->def;
                 if (i + ref->word_count < in_stmt->children_count + 1)
                 {
                     int w;
@@ -88,11 +88,12 @@ void _xte_parse_convert_synonyms(XTE *in_engine, XTEAST *in_stmt)
         XTEAST *child = in_stmt->children[i];
         if ( (child->type == XTE_AST_WORD) && (!(child->flags & XTE_AST_FLAG_SYNREP)) )
         {
-            /* iterate through synonyms */
-            for (int j = in_engine->syns_count-1; j >= 0; j--)
+            /* iterate through synonyms beginning with this word */
+            for (struct XTETerm const *term = _xte_dict_first(in_engine, XTE_TERM_SYNONYM, child->value.string);
+                 term; term = _xte_dict_next(in_engine, term))
             {
                 /* compare synonym against statement */
-                struct XTESynonymInt *syn = &(in_engine->syns[j]);
+                struct XTESynonymInt *syn = term->def;
                 if (i + syn->word_count >= in_stmt->children_count + 1) continue;
                 
                 int w;
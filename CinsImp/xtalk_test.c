@@ -34,6 +34,9 @@ void xte_test(void)
     printf("Testing The Message Protocol API...\n");
     //_xte_message_proto_test();
     
+    printf("Testing message heirarchy...\n");
+    _xte_vm_differential_test("message heirarchy", &_xte_msgheir_test);
+    
     printf("Testing memory allocation...\n");
     printf("MEMORY ALLOCATION TESTS DISABLED UNTIL FIXED\n");
     //_xte_memory_test(); // revisit, after expression parsing fixed.
@@ -44,6 +47,26 @@ void xte_test(void)
     printf("Testing handler parser...\n");
     _xte_parse_handler_test();
     
+    printf("Testing bytecode...\n");
+    _xte_vm_test();
+    
+    printf("Testing UTF-8...\n");
+    _xte_utf8_test();
+    
+#if XTALK_BENCHMARKS
+    printf("Benchmarking bytecode...\n");
+    _xte_vm_benchmark();
+    
+    printf("Benchmarking parser...\n");
+    _xte_parse_benchmark();
+    
+    printf("Benchmarking engine creation...\n");
+    _xte_engine_benchmark();
+    
+    printf("Benchmarking UTF-8...\n");
+    _xte_utf8_benchmark();
+#endif
+    
     printf("xTalk: Tests completed.\n");
 }
 
@@ -18,6 +18,9 @@
 #define XTALK_TESTS 1
 #endif
 
+/* defined non-zero if benchmarks are run with the tests */
+#define XTALK_BENCHMARKS 0
+
 #if XTALK_TESTS
 
 /* run all tests; report results to stdout */
@@ -77,7 +77,7 @@ static struct XTETestParserCase const TEST_BASIC[] = {
         "   EXPRESSION (source)\n"
         "      CONSTANT fPTR=$0 (zero)\n"
         "   EXPRESSION (mode)\n"
-        "      WORD into (FLAGS=$0)\n"
+        "      WORD into (FLAGS=$20)\n"
         "   EXPRESSION (dest)\n"
         "      WORD theVariable (FLAGS=$0)\n"
     },
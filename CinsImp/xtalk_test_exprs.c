@@ -475,9 +475,93 @@ static struct XTETestParserCase const EXPR_TEST_OK[] = {
 
 
 
+/* terminology added by the environment after the dictionary has been built must be recognised */
+static void _xte_tests_late_terminology(char const *in_file, int in_line)
+{
+    static struct XTEConstantDef consts[] = {
+        {"late constant", NULL},
+        NULL
+    };
+    static struct XTESynonymDef syns[] = {
+        {"lc", "late constant"},
+        NULL
+    };
+    char const *expected = "EXPRESSION ()\n   CONSTANT fPTR=$0 (late constant)\n";
+    
+    _xte_ast_debug_text(NULL, 0); /* release the debug text, so it's not mistaken for a leak */
+    XTE *engine = xte_create(NULL);
+    XTEAST *tree = _xte_lex(engine, "pi");
+    _xte_parse_expression(engine, tree, 0);
+    _xte_ast_destroy(tree);
+    
+    xte_configure_environment(engine, NULL, consts, NULL, NULL, NULL, NULL, syns);
+    tree = _xte_lex(engine, "lc");
+    if ((!_xte_parse_expression(engine, tree, 0)) ||
+        (strcmp(_xte_ast_debug_text(tree, XTE_AST_DEBUG_NO_POINTERS), expected) != 0))
+        printf("%s:%d: late terminology test: failed!\n", in_file, in_line);
+    _xte_ast_destroy(tree);
+    
+    _xte_ast_debug_text(NULL, 0);
+    xte_dispose(engine);
+}
+
+
+/* terminology added to one engine must not be seen by others sharing the built-in terminology,
+ including additions to a built-in property name or command prefix */
+static void _xte_tests_engine_isolation(char const *in_file, int in_line)
+{
+    static struct XTEConstantDef consts[] = {
+        {"own constant", NULL},
+        NULL
+    };
+    static struct XTEPropertyDef props[] = {
+        {"itemDelimiter", 0, "string", 0, NULL, NULL, NULL},
+        NULL
+    };
+    static struct XTECommandDef cmds[] = {
+        {"wait forever", "", NULL},
+        NULL
+    };
+    
+    XTE *before = xte_create(NULL);
+    XTE *configured = xte_create(NULL);
+    xte_configure_environment(configured, NULL, consts, props, NULL, NULL, cmds, NULL);
+    struct XTETerm const *term = _xte_dict_first(configured, XTE_TERM_COMMAND, "wait");
+    int configured_waits = (term ? ((struct XTECmdPrefix*)term->def)->command_count : 0);
+    int configured_const = (_xte_dict_first(configured, XTE_TERM_CONSTANT, "own") != NULL);
+    
+    XTE *after = xte_create(NULL);
+    term = _xte_dict_first(after, XTE_TERM_COMMAND, "wait");
+    int shared_waits = 0;
+    for (int i = 0; term && (i < ((struct XTECmdPrefix*)term->def)->command_count); i++)
+    {
+        if (((struct XTECmdPrefix*)term->def)->commands[i].pattern) shared_waits++;
+    }
+    
+    if ((!configured_const) || (configured_waits != shared_waits + 1))
+        printf("%s:%d: engine isolation test: configured engine: failed!\n", in_file, in_line);
+    if ((_xte_dict_first(before, XTE_TERM_CONSTANT, "own")) || (_xte_dict_first(after, XTE_TERM_CONSTANT, "own")) ||
+        (configured->prop_ptr_table == after->prop_ptr_table) || (before->prop_ptr_table != after->prop_ptr_table) ||
+        (shared_waits == 0))
+        printf("%s:%d: engine isolation test: other engines: failed!\n", in_file, in_line);
+    
+    /* disposed in reverse, as the leak check assumes engines are disposed in that order */
+    xte_dispose(after);
+    xte_dispose(configured);
+    
+    term = _xte_dict_first(before, XTE_TERM_COMMAND, "wait");
+    if ((!term) || (((struct XTECmdPrefix*)term->def)->command_count != shared_waits))
+        printf("%s:%d: engine isolation test: after dispose: failed!\n", in_file, in_line);
+    xte_dispose(before);
+}
+
+
 /* test runner */
 void _xte_parse_expression_test(void)
 {
+    _xte_tests_late_terminology(__FILE__, __LINE__);
+    _xte_tests_engine_isolation(__FILE__, __LINE__);
+    
     _xte_tests_parsing_run(__FILE__, __LINE__, TEST_SYNONYMS);
     _xte_tests_parsing_run(__FILE__, __LINE__, TEST_CONSTANTS);
     _xte_tests_parsing_run(__FILE__, __LINE__, TEST_PROPERTIES);
@@ -491,6 +575,39 @@ void _xte_parse_expression_test(void)
 }
 
 
+#if XTALK_BENCHMARKS
+
+#define _BENCH_ENGINES 10000
+
+/*
+ *  _xte_engine_benchmark
+ *  ---------------------------------------------------------------------------------------------
+ *  Times the creation and disposal of engines, and reports the memory allocated by each in
+ *  DEBUG builds.  Only the timing of an optimised build is meaningful.
+ */
+void _xte_engine_benchmark(void)
+{
+    /* the first engine also builds the shared built-in terminology */
+    XTE *first = xte_create(NULL);
+    
+#if DEBUG
+    long before = _xte_mem_allocated();
+    XTE *engine = xte_create(NULL);
+    printf("engine allocates %ld bytes\n", _xte_mem_allocated() - before);
+    xte_dispose(engine);
+#endif
+    
+    clock_t start = clock();
+    for (int i = 0; i < _BENCH_ENGINES; i++)
+        xte_dispose(xte_create(NULL));
+    printf("create %d engines: %.3f seconds\n", _BENCH_ENGINES, (double)(clock() - start) / CLOCKS_PER_SEC);
+    
+    xte_dispose(first);
+}
+
+#endif
+
+
 
 
 
@@ -230,5 +230,91 @@ void _xte_parse_handler_test(void)
 }
 
 
+#if XTALK_BENCHMARKS
+
+#define _BENCH_HOST_TERMS 300
+#define _BENCH_LINES 20000
+
+/*
+ *  _xte_parse_benchmark
+ *  ---------------------------------------------------------------------------------------------
+ *  Times the parsing of a large handler, with the built-in terminology supplemented by a few
+ *  hundred constants, functions, properties and synonyms as a host environment might add.
+ *  Allocations are tracked in DEBUG builds, so the figures are only meaningful from an optimised
+ *  build.
+ */
+void _xte_parse_benchmark(void)
+{
+    int dummy_checkpoints[1];
+    
+    /* configure a host vocabulary */
+    static char names[4][_BENCH_HOST_TERMS][32];
+    static struct XTEConstantDef consts[_BENCH_HOST_TERMS + 1];
+    static struct XTEFunctionDef funcs[_BENCH_HOST_TERMS + 1];
+    static struct XTEPropertyDef props[_BENCH_HOST_TERMS + 1];
+    static struct XTESynonymDef syns[_BENCH_HOST_TERMS + 1];
+    for (int i = 0; i < _BENCH_HOST_TERMS; i++)
+    {
+        sprintf(names[0][i], "hostConst%d", i);
+        sprintf(names[1][i], "hostFunc%d", i);
+        sprintf(names[2][i], "hostProp%d", i);
+        sprintf(names[3][i], "hostSyn%d", i);
+        consts[i].name = names[0][i];
+        funcs[i].name = names[1][i];
+        props[i].name = names[2][i];
+        syns[i].synonym = names[3][i];
+        syns[i].name = names[0][i];
+    }
+    
+    XTE *engine = xte_create(NULL);
+    struct XTECallbacks callbacks = {
+        NULL,
+        (XTEScriptErrorCB)&_handle_script_error,
+        NULL,
+    };
+    xte_configure_callbacks(engine, callbacks);
+    xte_configure_environment(engine, NULL, consts, props, NULL, funcs, NULL, syns);
+    
+    /* generate the script */
+    char *script = malloc(_BENCH_LINES * 128 + 64);
+    char *line = script + sprintf(script, "on mouseUp\n");
+    for (int i = 0; i < _BENCH_LINES; i++)
+    {
+        int t = i % _BENCH_HOST_TERMS;
+        switch (i % 4)
+        {
+            case 0:
+                line += sprintf(line, "  put hostFunc%d(x) + hostConst%d * pi into y\n", t, t);
+                break;
+            case 1:
+                line += sprintf(line, "  put the hostProp%d & char 2 of word 3 of line 4 of s into y\n", t);
+                break;
+            case 2:
+                line += sprintf(line, "  if abs(y) > hostSyn%d then put the itemDelimiter after s\n", t);
+                break;
+            case 3:
+                line += sprintf(line, "  put the number of items of s + length(y) into n\n");
+                break;
+        }
+    }
+    sprintf(line, "end mouseUp");
+    
+    /* time the parse */
+    _g_error_msg = NULL;
+    clock_t start = clock();
+    XTEAST *tree = _xte_lex(engine, script);
+    int ok = _xte_parse_handler(engine, tree, dummy_checkpoints, 0, 0);
+    _xte_error_post(engine);
+    printf("parse %d lines: %.3f seconds (%s)\n", _BENCH_LINES, (double)(clock() - start) / CLOCKS_PER_SEC,
+           (ok ? "ok" : _g_error_msg));
+    
+    _xte_ast_destroy(tree);
+    free(script);
+    xte_dispose(engine);
+}
+
+#endif
+
+
 
 #endif
@@ -187,6 +187,40 @@ struct XTETestParserCase const _TEST_LOOPS_OK[] = {
         "      COMMAND fPTR=$0 (beep)\n"
         "      PARAMS:\n"
     },
+    {
+        "on mouseUp\n"
+        "  repeat for each line x in t\n"
+        "    beep\n"
+        "  end repeat\n"
+        "end mouseUp"
+        ,
+        "HANDLER C \"mouseUp\"\n"
+        "   PARAM-NAMES\n"
+        "   LOOP each line\n"
+        "      WORD x (FLAGS=$0)\n"
+        "      EXPRESSION ()\n"
+        "         WORD t (FLAGS=$0)\n"
+        "      COMMAND fPTR=$0 (beep)\n"
+        "      PARAMS:\n"
+    },
+    {
+        "on mouseUp\n"
+        "  repeat for each char c in \"abc\" & t\n"
+        "    beep\n"
+        "  end repeat\n"
+        "end mouseUp"
+        ,
+        "HANDLER C \"mouseUp\"\n"
+        "   PARAM-NAMES\n"
+        "   LOOP each character\n"
+        "      WORD c (FLAGS=$0)\n"
+        "      EXPRESSION ()\n"
+        "         OPERATOR concat\n"
+        "            STRING \"abc\"\n"
+        "            WORD t (FLAGS=$0)\n"
+        "      COMMAND fPTR=$0 (beep)\n"
+        "      PARAMS:\n"
+    },
     NULL
 };
 
@@ -336,6 +370,46 @@ struct XTETestParserCase const _TEST_LOOPS_ERROR[] = {
         ,
         "Expected end of line after \"end repeat\"."
     },
+    {
+        "on mouseUp\n"
+        "  repeat for each\n"
+        "  end repeat\n"
+        "end mouseUp"
+        ,
+        "Expected character, word, line or item after \"repeat for each\"."
+    },
+    {
+        "on mouseUp\n"
+        "  repeat for each sentence x in t\n"
+        "  end repeat\n"
+        "end mouseUp"
+        ,
+        "Expected character, word, line or item after \"repeat for each\"."
+    },
+    {
+        "on mouseUp\n"
+        "  repeat for each word\n"
+        "  end repeat\n"
+        "end mouseUp"
+        ,
+        "Expected loop variable after \"repeat for each word\"."
+    },
+    {
+        "on mouseUp\n"
+        "  repeat for each item x of t\n"
+        "  end repeat\n"
+        "end mouseUp"
+        ,
+        "Expected \"in\" after \"repeat for each item x\"."
+    },
+    {
+        "on mouseUp\n"
+        "  repeat for each line x in\n"
+        "  end repeat\n"
+        "end mouseUp"
+        ,
+        "Expected container but found end of line."
+    },
     
     NULL
 };
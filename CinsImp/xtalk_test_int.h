@@ -23,9 +23,23 @@ void _xte_lexer_test(void);
 void _xte_parse_expression_test(void);
 void _xte_parse_command_test(void);
 void _xte_message_proto_test(void);
+void _xte_msgheir_test(void);
 void _xte_memory_test(void);
 void _xte_srcfmat_test(void);
 void _xte_parse_handler_test(void);
+void _xte_vm_test(void);
+void _xte_utf8_test(void);
+void _xte_vm_benchmark(void);
+void _xte_parse_benchmark(void);
+void _xte_engine_benchmark(void);
+void _xte_utf8_benchmark(void);
+
+/* runs a suite with the tree interpreter and then with bytecode, checking that each engine
+ disposed during the suite ends with the same globals and error line; see xtalk_test_vm.c */
+struct XTE;
+extern int _g_xte_test_use_bytecode;
+void _xte_vm_differential_test(char const *in_suite_name, void (*in_suite)(void));
+void _xte_vm_test_engine_disposed(struct XTE *in_engine);
 
 struct XTETestParserCase
 {
@@ -0,0 +1,22 @@
+/*
+ 
+ xTalk Engine Test Driver
+ xtalk_test_main.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Runs the xTalk engine unit tests outside of the application, on platforms other than
+ Mac OS X; see the Makefile
+ 
+ */
+
+#include "xtalk_test.h"
+
+
+int main(void)
+{
+    xte_test();
+    return 0;
+}
@@ -0,0 +1,352 @@
+/*
+ 
+ xTalk Engine Tests: Message Heirarchy
+ xtalk_test_msgheir.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Unit tests for the message heirarchy; handler index, the script cache and handler variables
+ 
+ *************************************************************************************************
+ */
+
+#include "xtalk_internal.h"
+#include "xtalk_test_int.h"
+
+
+#if XTALK_TESTS
+
+
+int _xte_parse_handler(XTE *in_engine, XTEAST *in_stream, int const in_checkpoints[], int in_checkpoint_count, int in_checkpoint_offset);
+
+
+struct TestScriptedObject
+{
+    long obj_id;
+    char const *script;
+    long revision;
+    struct TestScriptedObject *next_responder;
+};
+
+
+static int g_test_retrievals = 0;
+static int g_test_idents = 0;
+
+
+static int _test_script_retr(XTE *in_engine, void *in_context, XTEVariant *in_object,
+                             char const **out_script, int const *out_checkpoints[], int *out_checkpoint_count)
+{
+    struct TestScriptedObject *obj = in_object->value.ref.ident;
+    g_test_retrievals++;
+    *out_script = obj->script;
+    *out_checkpoints = NULL;
+    *out_checkpoint_count = 0;
+    return XTE_TRUE;
+}
+
+
+static int _test_next_responder(XTE *in_engine, void *in_context, XTEVariant *in_current_responder, XTEVariant **out_next_responder)
+{
+    struct TestScriptedObject *obj = in_current_responder->value.ref.ident;
+    if (!obj->next_responder) return XTE_ERROR_NO_OBJECT;
+    *out_next_responder = xte_object_ref(in_engine, "tobject", obj->next_responder, NULL);
+    return XTE_ERROR_NONE;
+}
+
+
+static int _test_script_ident(XTE *in_engine, void *in_context, XTEVariant *in_object,
+                              void const **out_domain, long *out_id, long *out_revision)
+{
+    struct TestScriptedObject *obj = in_object->value.ref.ident;
+    g_test_idents++;
+    *out_domain = NULL;
+    *out_id = obj->obj_id;
+    *out_revision = obj->revision;
+    return XTE_TRUE;
+}
+
+
+static struct XTEClassDef _test_classes[] = {
+    {"tobject", 0, 0, NULL, NULL, NULL, &_test_script_retr, &_test_next_responder, &_test_script_ident},
+    /* an object whose script can't be cached */
+    {"uobject", 0, 0, NULL, NULL, NULL, &_test_script_retr, &_test_next_responder, NULL},
+    NULL,
+};
+
+
+static int _test_global_int(XTE *in_engine, char const *in_name)
+{
+    for (int i = 0; i < in_engine->global_count; i++)
+    {
+        if (xte_cstrings_equal(in_engine->globals[i]->name, in_name))
+            return xte_variant_as_int(in_engine->globals[i]->value);
+    }
+    return -1;
+}
+
+
+static char const* _test_global_str(XTE *in_engine, char const *in_name)
+{
+    for (int i = 0; i < in_engine->global_count; i++)
+    {
+        if (xte_cstrings_equal(in_engine->globals[i]->name, in_name))
+        {
+            xte_variant_convert(in_engine, in_engine->globals[i]->value, XTE_TYPE_STRING);
+            return xte_variant_as_cstring(in_engine->globals[i]->value);
+        }
+    }
+    return "";
+}
+
+
+static void _test_send(XTE *in_engine, struct TestScriptedObject *in_object, char const *in_message, int in_times)
+{
+    for (int i = 0; i < in_times; i++)
+    {
+        XTEVariant *target = xte_object_ref(in_engine, "tobject", in_object, NULL);
+        xte_post_system_event(in_engine, target, in_message, NULL, 0);
+        xte_variant_release(target);
+    }
+}
+
+
+#define _CHECK(cond) if (!(cond)) printf("%s:%d: Message heirarchy test: failed! %s\n", __FILE__, __LINE__, #cond)
+
+
+static void _test_handler_index(void)
+{
+    XTE *engine = xte_create(NULL);
+    
+    char const *script =
+        "on mouseUp\n"
+        "  beep\n"
+        "end mouseUp\n"
+        "\n"
+        "  function Double x\n"
+        "    return x * 2\n"
+        "  end double\n"
+        "on mouseUp\n"
+        "end mouseUp\n"
+        "on unfinished\n"
+        "  beep";
+    struct XTEHandlerIndex *index = _xte_handler_index_create(engine, script);
+    _CHECK(index != NULL);
+    _CHECK(index->handler_count == 3);
+    
+    int handler = _xte_handler_index_find(index, XTE_FALSE, "MouseUp");
+    _CHECK(handler >= 0);
+    _CHECK(index->handlers[handler].line_begin == 1);
+    _CHECK(index->handlers[handler].line_end == 3);
+    char *source = _xte_handler_index_extract(engine, index, script, handler);
+    _CHECK(strcmp(source, "on mouseUp\n  beep\nend mouseUp") == 0);
+    free(source);
+    
+    handler = _xte_handler_index_find(index, XTE_TRUE, "double");
+    _CHECK(handler >= 0);
+    _CHECK(index->handlers[handler].line_begin == 5);
+    _CHECK(index->handlers[handler].line_end == 7);
+    _CHECK(_xte_handler_index_find(index, XTE_FALSE, "double") < 0);
+    _CHECK(_xte_handler_index_find(index, XTE_FALSE, "mouseDown") < 0);
+    
+    handler = _xte_handler_index_find(index, XTE_FALSE, "unfinished");
+    _CHECK(handler >= 0);
+    _CHECK(index->handlers[handler].line_end == 0);
+    source = _xte_handler_index_extract(engine, index, script, handler);
+    _CHECK(strcmp(source, "on unfinished\n  beep") == 0);
+    free(source);
+    
+    _xte_handler_index_destroy(index);
+    xte_dispose(engine);
+}
+
+
+static void _test_handler_variables(void)
+{
+    struct TestScriptedObject obj = {
+        3,
+        "on calc a, b\n"
+        "  global gResult\n"
+        "  put a into x\n"
+        "  repeat 3 times\n"
+        "    put X + b into x\n"
+        "  end repeat\n"
+        "  put x & \",\" & undefinedName into gResult\n"
+        "end calc", 1, NULL
+    };
+    
+    XTE *engine = xte_create(NULL);
+    xte_configure_environment(engine, _test_classes, NULL, NULL, NULL, NULL, NULL, NULL);
+    
+    /* variables are assigned slots by name, case-insensitively;
+     a, b, gResult, x and undefinedName, but not the keywords of the put command */
+    XTEAST *handler = _xte_lex(engine, obj.script);
+    _CHECK(_xte_parse_handler(engine, handler, NULL, 0, 0));
+    _CHECK(handler->value.handler.slot_count == 5);
+    char const *slot_names[] = {"a", "b", "gResult", "x", "undefinedName"};
+    for (int i = 0; i < 5; i++)
+        _CHECK(strcmp(handler->value.handler.slot_names[i], slot_names[i]) == 0);
+    _xte_ast_destroy(handler);
+    
+    /* parameters, locals and globals; undefined variables evaluate to their name */
+    XTEVariant *params[2] = { xte_integer_create(engine, 1), xte_integer_create(engine, 2) };
+    for (int i = 0; i < 2; i++)
+    {
+        XTEVariant *target = xte_object_ref(engine, "tobject", &obj, NULL);
+        xte_post_system_event(engine, target, "calc", params, 2);
+        xte_variant_release(target);
+        _CHECK(strcmp(_test_global_str(engine, "gResult"), "7,undefinedName") == 0);
+    }
+    xte_variant_release(params[0]);
+    xte_variant_release(params[1]);
+    
+    /* many globals; found by name case-insensitively, and kept in the order they were defined */
+    char name[32];
+    for (int i = 0; i < 300; i++)
+    {
+        sprintf(name, "gGlobal%d", i);
+        XTEVariant *value = xte_integer_create(engine, i);
+        xte_set_global(engine, name, value);
+        xte_variant_release(value);
+    }
+    _CHECK(_test_global_int(engine, "GGLOBAL123") == 123);
+    _CHECK(_xte_global_exists(engine, "gglobal299"));
+    _CHECK(!_xte_global_exists(engine, "gGlobal300"));
+    _CHECK(xte_cstrings_equal(engine->globals[engine->global_count - 300]->name, "gGlobal0"));
+    _CHECK(xte_cstrings_equal(engine->globals[engine->global_count - 1]->name, "gGlobal299"));
+    
+    xte_dispose(engine);
+}
+
+
+static void _test_builtin_dispatch(void)
+{
+    struct TestScriptedObject obj_b = {
+        6, "on mouseDown\n  beep\nend mouseDown\n", 1, NULL
+    };
+    struct TestScriptedObject obj_a = {
+        5,
+        "on count\n"
+        "  global gResult\n"
+        "  put 0 into gResult\n"
+        "  repeat 100 times\n"
+        "    put abs(0 - gResult) + 1 into gResult\n"
+        "  end repeat\n"
+        "end count", 1, &obj_b
+    };
+    
+    XTE *engine = xte_create(NULL);
+    xte_configure_environment(engine, _test_classes, NULL, NULL, NULL, NULL, NULL, NULL);
+    
+    /* built-ins which no script in the chain handles are run without searching the chain */
+    g_test_idents = 0;
+    _test_send(engine, &obj_a, "count", 1);
+    _CHECK(_test_global_int(engine, "gResult") == 100);
+    _CHECK(g_test_idents < 10);
+    
+    /* but a script can still override a built-in */
+    XTEVariant *zero = xte_integer_create(engine, 0);
+    xte_set_global(engine, "gOverrides", zero);
+    obj_b.script = "function abs x\n  global gOverrides\n  put gOverrides + 1 into gOverrides\nend abs\n";
+    obj_b.revision++;
+    _test_send(engine, &obj_a, "count", 1);
+    _CHECK(_test_global_int(engine, "gOverrides") == 100);
+    
+    obj_b.script = "on mouseDown\n  beep\nend mouseDown\n";
+    obj_b.revision++;
+    _test_send(engine, &obj_a, "count", 1);
+    _CHECK(_test_global_int(engine, "gResult") == 100);
+    
+    /* and if a script in the chain can't be cached, built-ins travel the chain */
+    obj_b.script = "function abs x\n  global gOverrides\n  put gOverrides + 1 into gOverrides\nend abs\n";
+    obj_b.revision++;
+    XTEVariant *target = xte_object_ref(engine, "uobject", &obj_a, NULL);
+    xte_set_global(engine, "gOverrides", zero);
+    xte_variant_release(zero);
+    xte_post_system_event(engine, target, "count", NULL, 0);
+    xte_variant_release(target);
+    _CHECK(_test_global_int(engine, "gOverrides") == 100);
+    
+    xte_dispose(engine);
+}
+
+
+/* once a handler called by a script fails to compile, the script runs no further built-ins */
+static void _test_builtin_after_error(void)
+{
+    struct TestScriptedObject obj = {
+        7,
+        "on go\n"
+        "  global gResult\n"
+        "  put 10 into x\n"
+        "  put q(x) & x into gResult\n"
+        "end go\n"
+        "function q a\n"
+        "  put a into\n"
+        "end q\n", 1, NULL
+    };
+    
+    XTE *engine = xte_create(NULL);
+    xte_configure_environment(engine, _test_classes, NULL, NULL, NULL, NULL, NULL, NULL);
+    
+    XTEVariant *unchanged = xte_string_create_with_cstring(engine, "unchanged");
+    xte_set_global(engine, "gResult", unchanged);
+    xte_variant_release(unchanged);
+    _test_send(engine, &obj, "go", 1);
+    _CHECK(strcmp(_test_global_str(engine, "gResult"), "unchanged") == 0);
+    
+    xte_dispose(engine);
+}
+
+
+void _xte_msgheir_test(void)
+{
+    _test_handler_index();
+    _test_handler_variables();
+    _test_builtin_dispatch();
+    _test_builtin_after_error();
+    
+    struct TestScriptedObject obj_b = {
+        2, "on mouseUp\n  global gCount\n  put gCount + 10 into gCount\nend mouseUp\n", 1, NULL
+    };
+    struct TestScriptedObject obj_a = {
+        1, "on mouseUp\n  global gCount\n  put gCount + 1 into gCount\nend mouseUp\n", 1, &obj_b
+    };
+    
+    XTE *engine = xte_create(NULL);
+    xte_configure_environment(engine, _test_classes, NULL, NULL, NULL, NULL, NULL, NULL);
+    XTEVariant *zero = xte_integer_create(engine, 0);
+    xte_set_global(engine, "gCount", zero);
+    xte_variant_release(zero);
+    
+    /* compiled handler is reused;
+     the put command is also offered to both objects, but each script is only retrieved once */
+    g_test_retrievals = 0;
+    _test_send(engine, &obj_a, "mouseUp", 3);
+    _CHECK(_test_global_int(engine, "gCount") == 3);
+    _CHECK(g_test_retrievals == 2);
+    
+    /* handler name is case-insensitive */
+    _test_send(engine, &obj_a, "MOUSEUP", 1);
+    _CHECK(_test_global_int(engine, "gCount") == 4);
+    _CHECK(g_test_retrievals == 2);
+    
+    /* objects without a handler are identified without retrieving the script again */
+    g_test_retrievals = 0;
+    _test_send(engine, &obj_a, "mouseDown", 3);
+    _CHECK(g_test_retrievals == 0);
+    
+    /* changed script is recompiled; other objects are unaffected */
+    obj_a.script = "on mouseUp\n  global gCount\n  put gCount + 100 into gCount\n  pass mouseUp\nend mouseUp\n";
+    obj_a.revision++;
+    g_test_retrievals = 0;
+    _test_send(engine, &obj_a, "mouseUp", 2);
+    _CHECK(_test_global_int(engine, "gCount") == 4 + 220);
+    _CHECK(g_test_retrievals == 1);
+    
+    xte_dispose(engine);
+}
+
+
+#endif
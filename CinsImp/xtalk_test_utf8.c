@@ -0,0 +1,370 @@
+/*
+ 
+ xTalk Engine Tests: UTF-8
+ xtalk_test_utf8.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Unit tests for case-insensitive string comparison and case folding
+ 
+ *************************************************************************************************
+ */
+
+#include "xtalk_internal.h"
+
+
+
+#if XTALK_TESTS
+
+
+extern char const *const _XTE_UTF8_CASE_DATA;
+
+
+#define _CHECK(cond) if (!(cond)) printf("%s:%d: UTF-8 test: failed! %s\n", __FILE__, __LINE__, #cond)
+
+
+/* checks every means of comparing the two strings gives the expected result */
+static void _test_equal(int in_line, char const *in_string1, char const *in_string2, int in_expected)
+{
+    char folded1[256], folded2[256];
+    xte_cstring_fold(in_string1, folded1, sizeof(folded1));
+    xte_cstring_fold(in_string2, folded2, sizeof(folded2));
+    
+    if ((xte_cstrings_equal(in_string1, in_string2) != in_expected) ||
+        (xte_cstrings_equal(in_string2, in_string1) != in_expected) ||
+        (xte_cstrings_szd_equal(in_string1, strlen(in_string1), in_string2, -1) != in_expected) ||
+        (xte_cstrings_szd_equal(in_string1, -1, in_string2, strlen(in_string2)) != in_expected) ||
+        ((strcmp(folded1, folded2) == 0) != in_expected))
+        printf("%s:%d: UTF-8 test: failed! \"%s\" %s \"%s\"\n", __FILE__, in_line, in_string1,
+               (in_expected ? "!=" : "=="), in_string2);
+}
+
+
+static int _test_encode(unsigned int in_codepoint, char *out_bytes)
+{
+    if (in_codepoint < 0x80)
+    {
+        out_bytes[0] = in_codepoint;
+        return 1;
+    }
+    else if (in_codepoint < 0x800)
+    {
+        out_bytes[0] = 0xC0 | (in_codepoint >> 6);
+        out_bytes[1] = 0x80 | (in_codepoint & 0x3F);
+        return 2;
+    }
+    else if (in_codepoint < 0x10000)
+    {
+        out_bytes[0] = 0xE0 | (in_codepoint >> 12);
+        out_bytes[1] = 0x80 | ((in_codepoint >> 6) & 0x3F);
+        out_bytes[2] = 0x80 | (in_codepoint & 0x3F);
+        return 3;
+    }
+    out_bytes[0] = 0xF0 | (in_codepoint >> 18);
+    out_bytes[1] = 0x80 | ((in_codepoint >> 12) & 0x3F);
+    out_bytes[2] = 0x80 | ((in_codepoint >> 6) & 0x3F);
+    out_bytes[3] = 0x80 | (in_codepoint & 0x3F);
+    return 4;
+}
+
+
+/* reads space separated hex code points up to a semi-colon as UTF-8, following <in_prefix> */
+static char const* _test_read_codes(char const *in_data, char const *in_prefix, char *out_string)
+{
+    out_string += sprintf(out_string, "%s", in_prefix);
+    while (*in_data != ';')
+    {
+        char *next;
+        out_string += _test_encode((unsigned int)strtoul(in_data, &next, 16), out_string);
+        in_data = next;
+        while (*in_data == ' ') in_data++;
+    }
+    *out_string = 0;
+    return in_data;
+}
+
+
+/*
+ *  _test_conformance
+ *  ---------------------------------------------------------------------------------------------
+ *  Checks every code point in the Unicode case folding data equals its folded form, alone and
+ *  amongst ASCII (either side of the word-at-a-time comparison.)  The Turkic (T) mappings mustn't
+ *  apply.
+ */
+static void _test_conformance(void)
+{
+    static char const *const prefixes[] = { "", "x", "abcdefgh", "abcdefghijklmno" };
+    static char const *const upper_prefixes[] = { "", "X", "ABCDEFGH", "ABCDEFGHIJKLMNO" };
+    
+    int rules = 0;
+    char const *data = _XTE_UTF8_CASE_DATA;
+    while (*data)
+    {
+        char code[32], mapping[32], status;
+        char *next;
+        code[_test_encode((unsigned int)strtoul(data, &next, 16), code)] = 0;
+        status = next[2];
+        
+        for (int p = 0; p < sizeof(prefixes) / sizeof(char const*); p++)
+        {
+            char string1[64], string2[64];
+            sprintf(string1, "%s%s", prefixes[p], code);
+            _test_read_codes(next + 5, upper_prefixes[p], string2);
+            _test_equal(__LINE__, string1, string2, (status != 'T'));
+            
+            strcat(string1, "y");
+            strcat(string2, "Y");
+            _test_equal(__LINE__, string1, string2, (status != 'T'));
+            
+            strcat(string2, "Z");
+            _test_equal(__LINE__, string1, string2, XTE_FALSE);
+        }
+        
+        _test_read_codes(next + 5, "", mapping);
+        _CHECK(xte_cstrings_szd_equal(code, strlen(code), mapping, strlen(mapping)) == (status != 'T'));
+        
+        rules++;
+        data = strchr(data, '\n') + 1;
+    }
+    _CHECK(rules > 1000);
+}
+
+
+static void _test_cases(void)
+{
+    /* ASCII, both sides of the word-at-a-time comparison */
+    _test_equal(__LINE__, "", "", XTE_TRUE);
+    _test_equal(__LINE__, "a", "", XTE_FALSE);
+    _test_equal(__LINE__, "abc", "ABC", XTE_TRUE);
+    _test_equal(__LINE__, "abc", "abd", XTE_FALSE);
+    _test_equal(__LINE__, "abc", "abcd", XTE_FALSE);
+    _test_equal(__LINE__, "itemDelimiter", "ITEMdelimiter", XTE_TRUE);
+    _test_equal(__LINE__, "itemDelimiter", "itemDelimitor", XTE_FALSE);
+    _test_equal(__LINE__, "itemDelimiter", "itemDelimiters", XTE_FALSE);
+    _test_equal(__LINE__, "Hello, World! 0123456789", "hELLO, wORLD! 0123456789", XTE_TRUE);
+    _test_equal(__LINE__, "Hello, World! 0123456789", "hELLO, wORLD! 0123456788", XTE_FALSE);
+    
+    /* characters that differ from letters only by case bit */
+    _test_equal(__LINE__, "@", "`", XTE_FALSE);
+    _test_equal(__LINE__, "[\\]^_", "{|}~\x7F", XTE_FALSE);
+    _test_equal(__LINE__, "@@@@@@@@", "````````", XTE_FALSE);
+    _test_equal(__LINE__, "az[{AZ@`", "AZ[{az@`", XTE_TRUE);
+    _test_equal(__LINE__, "az[{AZ@`", "AZ{[az@`", XTE_FALSE);
+    _test_equal(__LINE__, "0123456789 !#$", "0123456789 !#$", XTE_TRUE);
+    
+    /* full case folding */
+    _test_equal(__LINE__, "stra\xC3\x9F" "e", "STRASSE", XTE_TRUE);
+    _test_equal(__LINE__, "\xC3\x9F", "ss", XTE_TRUE);
+    _test_equal(__LINE__, "\xC3\x9F", "s", XTE_FALSE);
+    _test_equal(__LINE__, "\xC3\x9Fs", "sss", XTE_TRUE);
+    _test_equal(__LINE__, "\xEF\xAC\x81le", "FILE", XTE_TRUE);
+    _test_equal(__LINE__, "\xE2\x84\xAA" "elvin", "kelvin", XTE_TRUE);
+    _test_equal(__LINE__, "\xCE\xA3\xCE\x91\xCE\xA3", "\xCF\x83\xCE\xB1\xCF\x82", XTE_TRUE);
+    _test_equal(__LINE__, "\xC2\xB5", "\xCE\x9C", XTE_TRUE);
+    _test_equal(__LINE__, "\xC2\xB5", "\xCE\xBC", XTE_TRUE);
+    _test_equal(__LINE__, "\xC4\xB0", "i", XTE_FALSE);
+    _test_equal(__LINE__, "\xC4\xB1", "I", XTE_FALSE);
+    _test_equal(__LINE__, "\xC4\xB0", "i\xCC\x87", XTE_TRUE);
+    
+    /* words which are identical up to part way through a character */
+    _test_equal(__LINE__, "abcdefg\xC3\xA9", "ABCDEFG\xC3\x89", XTE_TRUE);
+    _test_equal(__LINE__, "abcdefg\xC3\xA9", "abcdefg\xC3\x89", XTE_TRUE);
+    _test_equal(__LINE__, "abcdefg\xC3\xA9", "abcdefg\xC3\xA8", XTE_FALSE);
+    _test_equal(__LINE__, "abcdef\xE2\x84\xAA", "abcdef\xE2\x84\xAA", XTE_TRUE);
+    _test_equal(__LINE__, "abcdef\xE2\x84\xAAzz", "ABCDEF\xE2\x84\xAAZZ", XTE_TRUE);
+    _test_equal(__LINE__, "abcdef\xE2\x84\xAAzz", "abcdef\xE2\x84\xAA" "k", XTE_FALSE);
+    
+    /* invalid sequences only ever equal themselves */
+    _test_equal(__LINE__, "\xB5", "\xB5", XTE_TRUE);
+    _test_equal(__LINE__, "\xB5", "\xC2\xB5", XTE_FALSE);
+    _test_equal(__LINE__, "\xB5", "\xCE\xBC", XTE_FALSE);
+    _test_equal(__LINE__, "a\xC3", "A\xC3", XTE_TRUE);
+    _test_equal(__LINE__, "\xC3", "\xC3\x83", XTE_FALSE);
+    _test_equal(__LINE__, "\xF8\x88\x80\x80\x80", "\xF8\x88\x80\x80\x80", XTE_TRUE);
+    _test_equal(__LINE__, "\xF4\x90\x80\x80", "\xF4\x90\x80\x81", XTE_FALSE);
+    
+    /* sized strings */
+    _CHECK(xte_cstrings_szd_equal("abcdef", 3, "ABCxyz", 3) == XTE_TRUE);
+    _CHECK(xte_cstrings_szd_equal("abcdef", 4, "ABCxyz", 4) == XTE_FALSE);
+    _CHECK(xte_cstrings_szd_equal("abcdefghijklm", 12, "ABCDEFGHIJKLxyz", 12) == XTE_TRUE);
+    _CHECK(xte_cstrings_szd_equal("abcdefghij\0klmn", 15, "ABCDEFGHIJ", 10) == XTE_TRUE);
+    _CHECK(xte_cstrings_szd_equal("abc\xC3\xA9", 4, "ABC\xC3\x89", 4) == XTE_TRUE);
+    _CHECK(xte_cstrings_szd_equal("abc\xC3\xA9", 4, "ABC\xC3\x89", 5) == XTE_FALSE);
+    
+    /* folding */
+    char folded[16];
+    _CHECK(xte_cstring_fold("Stra\xC3\x9F" "e", folded, sizeof(folded)) == 7);
+    _CHECK(strcmp(folded, "STRASSE") == 0);
+    _CHECK(xte_cstring_fold("\xC3\x89t\xC3\xA9", folded, sizeof(folded)) == 5);
+    _CHECK(strcmp(folded, "\xC3\xA9T\xC3\xA9") == 0);
+    _CHECK(xte_cstring_fold("A\xC3\x9F", folded, 3) == 3);
+    _CHECK(strcmp(folded, "A") == 0);
+    _CHECK(xte_cstring_fold("\xB5", folded, sizeof(folded)) == 1);
+    _CHECK(strcmp(folded, "\xB5") == 0);
+}
+
+
+/* compares random ASCII strings of characters either side of the letters */
+static void _test_random_ascii(void)
+{
+    static char const alphabet[] = "aAzZmM@[`{09 _~";
+    unsigned long seed = 1;
+    for (int i = 0; i < 20000; i++)
+    {
+        char string1[40], string2[40];
+        seed = seed * 1103515245 + 12345;
+        int length = (seed >> 16) % 36;
+        for (int c = 0; c < length; c++)
+        {
+            seed = seed * 1103515245 + 12345;
+            string1[c] = alphabet[(seed >> 16) % (sizeof(alphabet) - 1)];
+            string2[c] = string1[c];
+            if (((seed >> 24) & 3) == 0)
+                string2[c] = ((string2[c] >= 'A') && (string2[c] <= 'Z') ? string2[c] + 0x20 :
+                              ((string2[c] >= 'a') && (string2[c] <= 'z') ? string2[c] - 0x20 : string2[c]));
+            else if (((seed >> 24) & 63) == 1)
+                string2[c] = alphabet[(seed >> 26) % (sizeof(alphabet) - 1)];
+        }
+        string1[length] = string2[length] = 0;
+        
+        int expected = XTE_TRUE;
+        for (int c = 0; c < length; c++)
+            if (toupper(string1[c]) != toupper(string2[c])) expected = XTE_FALSE;
+        _test_equal(__LINE__, string1, string2, expected);
+    }
+}
+
+
+/* searches random strings of few letters, so that needles are often periodic; the result must
+ agree with a naive search */
+static void _test_random_contains(void)
+{
+    static char const alphabet[] = "abAB";
+    unsigned long seed = 1;
+    for (int i = 0; i < 20000; i++)
+    {
+        char haystack[40], needle[12];
+        seed = seed * 1103515245 + 12345;
+        int haystack_length = (seed >> 16) % 36;
+        int needle_length = 1 + (seed >> 24) % 10;
+        for (int c = 0; c < haystack_length; c++)
+        {
+            seed = seed * 1103515245 + 12345;
+            haystack[c] = alphabet[(seed >> 16) % 4];
+        }
+        for (int c = 0; c < needle_length; c++)
+        {
+            seed = seed * 1103515245 + 12345;
+            needle[c] = alphabet[(seed >> 16) % ((seed >> 28) & 1 ? 2 : 4)];
+        }
+        haystack[haystack_length] = needle[needle_length] = 0;
+        
+        int expected = XTE_FALSE;
+        for (int start = 0; start + needle_length <= haystack_length; start++)
+        {
+            int c = 0;
+            while ((c < needle_length) && (toupper(haystack[start + c]) == toupper(needle[c]))) c++;
+            if (c == needle_length) expected = XTE_TRUE;
+        }
+        if (_xte_utf8_contains(haystack, needle) != expected)
+            printf("%s:%d: UTF-8 test: failed! \"%s\" %s \"%s\"\n", __FILE__, __LINE__, haystack,
+                   (expected ? "doesn't contain" : "contains"), needle);
+    }
+}
+
+
+/* ordering and searching of strings with case differences */
+static void _test_collation(void)
+{
+    _CHECK(_xte_utf8_fold_compare("apple", "APPLE") == 0);
+    _CHECK(_xte_utf8_fold_compare("apple", "Banana") < 0);
+    _CHECK(_xte_utf8_fold_compare("Banana", "apple") > 0);
+    _CHECK(_xte_utf8_fold_compare("app", "apple") < 0);
+    _CHECK(_xte_utf8_fold_compare("", "") == 0);
+    _CHECK(_xte_utf8_fold_compare("stra\xC3\x9F" "e", "STRASSE") == 0);
+    _CHECK(_xte_utf8_fold_compare("\xC3\xA9t\xC3\xA9", "\xC3\x89T\xC3\x89") == 0);
+    
+    _CHECK(_xte_utf8_compare("apple", "Banana") < 0);
+    _CHECK(_xte_utf8_contains("Hello World", "o w"));
+    _CHECK(_xte_utf8_contains("caf\xC3\x89 au lait", "\xC3\xA9 AU"));
+    _CHECK(!_xte_utf8_contains("Hello World", "worlds"));
+    _CHECK(!_xte_utf8_contains("Hello World", ""));
+}
+
+
+/* collation keys must order strings the same way as the comparison operators */
+static void _test_collation_keys(void)
+{
+    static char const *const strings[] = {
+        "", "a", "A", "ab", "Abc", "apple", "Banana", "b", "z", "Zebra", "_x", "10", "9", " a",
+        "\xC3\xA9t\xC3\xA9", "\xC3\x89T\xC3\x89", "ete", "\xCE\xA9mega",
+        NULL
+    };
+    for (int i = 0; strings[i]; i++)
+    {
+        char key1[128];
+        long length = xte_cstring_collation_key(strings[i], key1, sizeof(key1));
+        _CHECK((length < sizeof(key1)) && (strlen(key1) == length));
+        _CHECK(xte_cstring_collation_key(strings[i], NULL, 0) == length);
+        for (int j = 0; strings[j]; j++)
+        {
+            char key2[128];
+            xte_cstring_collation_key(strings[j], key2, sizeof(key2));
+            int expected = _xte_utf8_compare(strings[i], strings[j]);
+            int actual = strcmp(key1, key2);
+            if ((expected < 0) != (actual < 0) || (expected > 0) != (actual > 0))
+                printf("%s:%d: UTF-8 test: failed! collation key of \"%s\" against \"%s\"\n", __FILE__, __LINE__,
+                       strings[i], strings[j]);
+        }
+    }
+}
+
+
+void _xte_utf8_test(void)
+{
+    _test_conformance();
+    _test_cases();
+    _test_random_ascii();
+    _test_random_contains();
+    _test_collation();
+    _test_collation_keys();
+}
+
+
+#if XTALK_BENCHMARKS
+
+#define _BENCH_COMPARISONS 1000000
+
+/*
+ *  _xte_utf8_benchmark
+ *  ---------------------------------------------------------------------------------------------
+ *  Times case-insensitive comparisons of typical names, and of non-ASCII text.
+ */
+void _xte_utf8_benchmark(void)
+{
+    static char const *const pairs[][2] = {
+        { "itemDelimiter", "itemdelimiter" },
+        { "numberFormat", "numberFormat" },
+        { "gCounter", "gCounted" },
+        { "mouseUp", "mouseDown" },
+        { "Caf\xC3\xA9 cr\xC3\xA8me br\xC3\xBBl\xC3\xA9" "e", "CAF\xC3\x89 CR\xC3\x88ME BR\xC3\x9BL\xC3\x89" "E" },
+    };
+    
+    for (int p = 0; p < sizeof(pairs) / sizeof(pairs[0]); p++)
+    {
+        int equal = 0;
+        clock_t start = clock();
+        for (int i = 0; i < _BENCH_COMPARISONS; i++)
+            equal += xte_cstrings_equal(pairs[p][0], pairs[p][1]);
+        printf("compare \"%s\" %d times: %.3f seconds (%s)\n", pairs[p][0], _BENCH_COMPARISONS,
+               (double)(clock() - start) / CLOCKS_PER_SEC, (equal ? "equal" : "not equal"));
+    }
+}
+
+#endif
+
+
+#endif
+
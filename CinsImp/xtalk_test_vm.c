@@ -0,0 +1,514 @@
+/*
+ 
+ xTalk Engine Tests: Bytecode
+ xtalk_test_vm.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Unit tests for the bytecode compiler and virtual machine; each script is run both by the tree
+ interpreter and as bytecode, and must produce the same result, as must the other suites that
+ run scripts (see Differential Testing)
+ 
+ *************************************************************************************************
+ */
+
+#include "xtalk_internal.h"
+#include "xtalk_test_int.h"
+
+#include <time.h>
+
+
+#if XTALK_TESTS
+
+
+int _xte_parse_handler(XTE *in_engine, XTEAST *in_stream, int const in_checkpoints[], int in_checkpoint_count, int in_checkpoint_offset);
+
+
+struct TestScriptedObject
+{
+    long obj_id;
+    char const *script;
+    long revision;
+};
+
+
+static int _test_script_retr(XTE *in_engine, void *in_context, XTEVariant *in_object,
+                             char const **out_script, int const *out_checkpoints[], int *out_checkpoint_count)
+{
+    struct TestScriptedObject *obj = in_object->value.ref.ident;
+    *out_script = obj->script;
+    *out_checkpoints = NULL;
+    *out_checkpoint_count = 0;
+    return XTE_TRUE;
+}
+
+
+static int _test_next_responder(XTE *in_engine, void *in_context, XTEVariant *in_current_responder, XTEVariant **out_next_responder)
+{
+    return XTE_ERROR_NO_OBJECT;
+}
+
+
+static int _test_script_ident(XTE *in_engine, void *in_context, XTEVariant *in_object,
+                              void const **out_domain, long *out_id, long *out_revision)
+{
+    struct TestScriptedObject *obj = in_object->value.ref.ident;
+    *out_domain = NULL;
+    *out_id = obj->obj_id;
+    *out_revision = obj->revision;
+    return XTE_TRUE;
+}
+
+
+static struct XTEClassDef _test_classes[] = {
+    {"tobject", 0, 0, NULL, NULL, NULL, &_test_script_retr, &_test_next_responder, &_test_script_ident},
+    NULL,
+};
+
+
+static void _test_script_error(XTE *in_engine, void *in_context, XTEVariant *in_handler_object, long in_source_line,
+                               char const *in_template, char const *in_arg1, char const *in_arg2, char const *in_arg3,
+                               int in_runtime)
+{
+    xte_abort(in_engine);
+}
+
+
+static void _test_script_progress(XTE *in_engine, void *in_context, int in_paused, XTEVariant *in_handler_object, long in_source_line)
+{
+    /* runtime errors otherwise wait for the debugger */
+    if (in_engine->run_state == XTE_RUNSTATE_DEBUG_ERROR) xte_abort(in_engine);
+}
+
+
+#define _RESULT_SIZE 256
+
+#define _CHECK(cond) if (!(cond)) printf("%s:%d: Bytecode test: failed! %s\n", __FILE__, __LINE__, #cond)
+
+
+/*
+ *  _test_run
+ *  ---------------------------------------------------------------------------------------------
+ *  Sends mouseUp to an object with the supplied script and returns the resulting value of the
+ *  global gResult, and the line of any error.
+ */
+static void _test_run(char const *in_script, int in_use_bytecode, char out_result[], long *out_error_line)
+{
+    struct TestScriptedObject obj = { 1, in_script, 1 };
+    
+    XTE *engine = xte_create(NULL);
+    engine->use_bytecode = in_use_bytecode;
+    xte_configure_environment(engine, _test_classes, NULL, NULL, NULL, NULL, NULL, NULL);
+    struct XTECallbacks callbacks = {0};
+    callbacks.script_error = &_test_script_error;
+    callbacks.script_progress = &_test_script_progress;
+    xte_configure_callbacks(engine, callbacks);
+    
+    XTEVariant *target = xte_object_ref(engine, "tobject", &obj, NULL);
+    xte_post_system_event(engine, target, "mouseUp", NULL, 0);
+    xte_variant_release(target);
+    
+    out_result[0] = 0;
+    for (int i = 0; i < engine->global_count; i++)
+    {
+        if (xte_cstrings_equal(engine->globals[i]->name, "gResult") && engine->globals[i]->value)
+        {
+            xte_variant_convert(engine, engine->globals[i]->value, XTE_TYPE_STRING);
+            strncpy(out_result, xte_variant_as_cstring(engine->globals[i]->value), _RESULT_SIZE - 1);
+            out_result[_RESULT_SIZE - 1] = 0;
+        }
+    }
+    *out_error_line = (engine->error_message ? engine->run_error_line : 0);
+    
+    xte_dispose(engine);
+}
+
+
+/*
+ *  _test_script
+ *  ---------------------------------------------------------------------------------------------
+ *  Checks the script produces the expected result, and the same errors, with and without
+ *  bytecode.
+ */
+static void _test_script(int in_line, char const *in_script, char const *in_expected)
+{
+    char tree_result[_RESULT_SIZE], vm_result[_RESULT_SIZE];
+    long tree_error, vm_error;
+    _test_run(in_script, XTE_FALSE, tree_result, &tree_error);
+    _test_run(in_script, XTE_TRUE, vm_result, &vm_error);
+    
+    if (strcmp(tree_result, in_expected) != 0)
+        printf("%s:%d: Bytecode test: failed! tree interpreter: got \"%s\", expected \"%s\"\n", __FILE__, in_line, tree_result, in_expected);
+    if (strcmp(vm_result, in_expected) != 0)
+        printf("%s:%d: Bytecode test: failed! bytecode: got \"%s\", expected \"%s\"\n", __FILE__, in_line, vm_result, in_expected);
+    if (tree_error != vm_error)
+        printf("%s:%d: Bytecode test: failed! error on line %ld, expected line %ld\n", __FILE__, in_line, vm_error, tree_error);
+}
+
+
+/*
+ *  _test_compiles_to
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles the handler and returns the number of instructions with the specified opcode.
+ */
+static int _test_compiles_to(char const *in_handler, enum XTEOpcode in_op)
+{
+    XTE *engine = xte_create(NULL);
+    XTEAST *handler = _xte_lex(engine, in_handler);
+    int count = -1;
+    if (_xte_parse_handler(engine, handler, NULL, 0, 0))
+    {
+        struct XTEBytecode *code = _xte_compile_bytecode(engine, handler);
+        if (code)
+        {
+            count = 0;
+            for (int i = 0; i < code->instruction_count; i++)
+            {
+                if (code->instructions[i].op == in_op) count++;
+            }
+        }
+        _xte_bytecode_destroy(code);
+    }
+    _xte_ast_destroy(handler);
+    xte_dispose(engine);
+    return count;
+}
+
+
+/*
+ *  Differential Testing
+ *  ---------------------------------------------------------------------------------------------
+ *  The tree interpreter is the reference for the bytecode.  Engines are created with the
+ *  interpreter selected by _g_xte_test_use_bytecode, and as each is disposed, it's globals and
+ *  the line of any error are appended to the outcomes of the current run.  The outcomes are kept
+ *  in static buffers, so they aren't mistaken for leaks by the engine.
+ */
+
+#define _OUTCOMES_SIZE 16384
+
+int _g_xte_test_use_bytecode = XTE_TRUE;
+
+static char *_g_test_outcomes = NULL;
+
+
+void _xte_vm_test_engine_disposed(XTE *in_engine)
+{
+    if (!_g_test_outcomes) return;
+    long length = strlen(_g_test_outcomes);
+    snprintf(_g_test_outcomes + length, _OUTCOMES_SIZE - length, "[error line %ld]",
+             (in_engine->error_message ? in_engine->run_error_line : 0));
+    for (int i = 0; i < in_engine->global_count; i++)
+    {
+        XTEVariant *value = in_engine->globals[i]->value;
+        if (value) xte_variant_convert(in_engine, value, XTE_TYPE_STRING);
+        length = strlen(_g_test_outcomes);
+        snprintf(_g_test_outcomes + length, _OUTCOMES_SIZE - length, " %s=\"%s\"", in_engine->globals[i]->name,
+                 (value ? xte_variant_as_cstring(value) : ""));
+    }
+    length = strlen(_g_test_outcomes);
+    snprintf(_g_test_outcomes + length, _OUTCOMES_SIZE - length, "\n");
+}
+
+
+void _xte_vm_differential_test(char const *in_suite_name, void (*in_suite)(void))
+{
+    static char tree_outcomes[_OUTCOMES_SIZE], vm_outcomes[_OUTCOMES_SIZE];
+    
+    tree_outcomes[0] = 0;
+    _g_test_outcomes = tree_outcomes;
+    _g_xte_test_use_bytecode = XTE_FALSE;
+    in_suite();
+    
+    vm_outcomes[0] = 0;
+    _g_test_outcomes = vm_outcomes;
+    _g_xte_test_use_bytecode = XTE_TRUE;
+    in_suite();
+    
+    _g_test_outcomes = NULL;
+    if (strcmp(tree_outcomes, vm_outcomes) != 0)
+        printf("%s:%d: Bytecode test: failed! %s suite differs; tree interpreter:\n%sbytecode:\n%s", __FILE__, __LINE__,
+               in_suite_name, tree_outcomes, vm_outcomes);
+}
+
+
+void _xte_vm_test(void)
+{
+    /* common idioms are compiled to specialised instructions */
+    _CHECK(_test_compiles_to("on t\n  repeat with i = 1 to 10\n    put x + 1 into x\n  end repeat\nend t", XTE_OP_ADD_CONST) == 1);
+    _CHECK(_test_compiles_to("on t\n  repeat with i = 1 to n\n  end repeat\nend t", XTE_OP_FOR_LIMIT) == 1);
+    _CHECK(_test_compiles_to("on t\n  if i mod 2 = 0 then put i * j into x\nend t", XTE_OP_LOAD) == 3);
+    _CHECK(_test_compiles_to("on t\n  put i & j into x\nend t", XTE_OP_LOAD) == 0);
+    _CHECK(_test_compiles_to("on t\n  put 2 - x into x\nend t", XTE_OP_ADD_CONST) == 0);
+    _CHECK(_test_compiles_to("on t\n  repeat\n    next repeat\n    exit repeat\n  end repeat\nend t", XTE_OP_JUMP) == 2);
+    _CHECK(_test_compiles_to("on t\n  repeat for each word w in s\n  end repeat\nend t", XTE_OP_EACH_NEXT) == 1);
+    
+    /* expressions and variables */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  put 5 into x\n"
+                 "  put x * 2 into y\n"
+                 "  put X + y & \",\" & the number of chars of \"abc\" & \",\" & undefinedName into gResult\n"
+                 "  put \",\" & 1 + x & \",\" & x - 1.5 & \",\" & 2 * x & \",\" & x after gResult\n"
+                 "end mouseUp\n",
+                 "15,3,undefinedName,6,3.5,10,5");
+    
+    /* conditions */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  repeat with n = 1 to 8\n"
+                 "    if n mod 2 = 0 then\n"
+                 "      put \"e\" after gResult\n"
+                 "    else if n mod 3 = 0 then\n"
+                 "      put \"t\" after gResult\n"
+                 "    else\n"
+                 "      put \"o\" after gResult\n"
+                 "    end if\n"
+                 "  end repeat\n"
+                 "end mouseUp\n",
+                 "oeteoeo");
+    
+    /* loops; "next repeat" and "exit repeat" only affect the innermost loop */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  repeat with i = 1 to 6\n"
+                 "    if i = 3 then next repeat\n"
+                 "    put i after gResult\n"
+                 "  end repeat\n"
+                 "  repeat with j = 1 to 3\n"
+                 "    repeat with k = 1 to 5\n"
+                 "      if k = 2 then exit repeat\n"
+                 "      put j & k after gResult\n"
+                 "    end repeat\n"
+                 "    put \"/\" after gResult\n"
+                 "  end repeat\n"
+                 "  repeat with q = 5 down to 1\n"
+                 "    put q after gResult\n"
+                 "  end repeat\n"
+                 "  put 0 into n\n"
+                 "  repeat while n < 3\n"
+                 "    put n + 1 into n\n"
+                 "  end repeat\n"
+                 "  repeat until n = 0\n"
+                 "    put n - 1 into n\n"
+                 "    put \"u\" after gResult\n"
+                 "  end repeat\n"
+                 "  repeat 2 times\n"
+                 "    put \"x\" after gResult\n"
+                 "  end repeat\n"
+                 "  repeat\n"
+                 "    put n + 1 into n\n"
+                 "    if n > 2 then exit repeat\n"
+                 "  end repeat\n"
+                 "  put n after gResult\n"
+                 "end mouseUp\n",
+                 "124511/21/5432uuuxx3");
+    
+    /* numbers and booleans; the end value of a loop is only evaluated once */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  put 3 into k\n"
+                 "  repeat with i = 1 to k\n"
+                 "    put 10 into k\n"
+                 "    put i after gResult\n"
+                 "  end repeat\n"
+                 "  put \",\" & (1.5 = 1) & \",\" & (\"2.5\" + 0) & \",\" & 7 div 2 & \",\" & 7 mod 2 & \",\" & 2 ^ 3 after gResult\n"
+                 "  put 4 into x\n"
+                 "  put \",\" & (x / 8 < 1 and not (x > 4)) & \",\" & -x & \",\" & (x = \"4.0\") & \",\" & x after gResult\n"
+                 "end mouseUp\n",
+                 "12,false,2.5,3,1,8,true,-4,true,4");
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  put 1 into gResult\n"
+                 "  put 0 into z\n"
+                 "  put 5 mod z into gResult\n"
+                 "end mouseUp\n",
+                 "1");
+    
+    /* strings are edited in place, including ranges of multi-byte characters */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  put \"abc\" into s\n"
+                 "  put \"XY\" into char 2 of s\n"
+                 "  put \"-\" before s\n"
+                 "  put \"!\" after s\n"
+                 "  put 42 into n\n"
+                 "  put \"x\" after n\n"
+                 "  put \"\xC3\xA9\" into u\n"
+                 "  put \"a\xC3\xA9\" after u\n"
+                 "  put \"Z\" into char 2 of u\n"
+                 "  put \"q\" before char 1 of u\n"
+                 "  put \"r\" after char 3 of u\n"
+                 "  put \"1\" into e\n"
+                 "  repeat with i = 1 to 4\n"
+                 "    put i after e\n"
+                 "    put \",\" after char 1 of e\n"
+                 "  end repeat\n"
+                 "  put s & \"/\" & n & \"/\" & u & \"/\" & e & \"/\" & the number of chars of u into gResult\n"
+                 "end mouseUp\n",
+                 "-aXYc!/42x/q\xC3\xA9Zr\xC3\xA9/1,,,123/5");
+    
+    /* chunks of a variable are found from it's index until the variable changes */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  put \"one\" into line 1 of t\n"
+                 "  put \"two, three\" into line 3 of t\n"
+                 "  repeat with i = 1 to 5\n"
+                 "    put \"[\" & line i of t & \"]\" & word i of t & item i of t after gResult\n"
+                 "  end repeat\n"
+                 "  put \"x\" into line 2 of t\n"
+                 "  put line 2 of t & word 2 of t & the number of lines of t & \",\" after gResult\n"
+                 "  set the itemDelimiter to \"e\"\n"
+                 "  put item 2 of t & the number of items of t after gResult\n"
+                 "  put \"\xC3\xA9t\xC3\xA9 \xC3\xBC\" into u\n"
+                 "  put char 3 to 5 of u & the number of chars of u & word 2 of u after gResult\n"
+                 "end mouseUp\n",
+                 "[one]oneone\n\ntwo[]two, three[two, three]three[]xx3,\nx\ntwo, thr4\xC3\xA9 \xC3\xBC" "5\xC3\xBC");
+    
+    /* "repeat for each" visits the same elements as chunk expressions, of the container as it was
+     when the loop began */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  put \"one two\" & newline & newline & \"three, four, five\" & newline into t\n"
+                 "  repeat for each line x in t\n"
+                 "    put \"[\" & x & \"]\" after gResult\n"
+                 "  end repeat\n"
+                 "  repeat for each word x in t\n"
+                 "    put \"<\" & x & \">\" after gResult\n"
+                 "    put \"z\" into t\n"
+                 "  end repeat\n"
+                 "  repeat for each item x in \"a,b,,c\"\n"
+                 "    if x is \"c\" then exit repeat\n"
+                 "    put \"{\" & x & \"}\" after gResult\n"
+                 "  end repeat\n"
+                 "  repeat for each char c in \"h\xC3\xA9llo\"\n"
+                 "    if c is \"l\" then next repeat\n"
+                 "    put c after gResult\n"
+                 "  end repeat\n"
+                 "  repeat for each item x in empty\n"
+                 "    put \"never\" after gResult\n"
+                 "  end repeat\n"
+                 "  repeat for each char c in 1234\n"
+                 "    put c + 1 after gResult\n"
+                 "  end repeat\n"
+                 "  repeat for each item x in \"a;b,c;d\"\n"
+                 "    set the itemDelimiter to \";\"\n"
+                 "    put \"(\" & x & \")\" after gResult\n"
+                 "  end repeat\n"
+                 "end mouseUp\n",
+                 "[one two][][three, four, five][]<one><two><three,><four,><five>{a}{b}{}h\xC3\xA9o2345(a;b)(c;d)");
+    
+    /* commands, including script handlers; "exit" leaves the handler */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  countdown 3\n"
+                 "  put \"!\" after gResult\n"
+                 "end mouseUp\n"
+                 "on countdown a\n"
+                 "  global gResult\n"
+                 "  put a after gResult\n"
+                 "  if a > 0 then countdown a - 1\n"
+                 "  exit countdown\n"
+                 "  put \"never\" after gResult\n"
+                 "end countdown\n",
+                 "3210!");
+    
+    /* runtime errors stop the handler on the same line */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  put \"a\" into gResult\n"
+                 "  repeat with i = gResult to 3\n"
+                 "    put i after gResult\n"
+                 "  end repeat\n"
+                 "end mouseUp\n",
+                 "a");
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  put 1 into gResult\n"
+                 "  put \"abc\" into s\n"
+                 "  put s + 1 into gResult\n"
+                 "end mouseUp\n",
+                 "1");
+    
+    /* case-insensitive comparison and searching */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  put (\"abc\" = \"ABC\") & \",\" & (\"apple\" < \"Banana\") into gResult\n"
+                 "  put \",\" & (\"O w\" is in \"Hello World\") after gResult\n"
+                 "  put \",\" & (\"WORLD\" is in \"Hello World\") after gResult\n"
+                 "  put \",\" & (\"worlds\" is in \"Hello World\") after gResult\n"
+                 "end mouseUp\n",
+                 "true,true,true,true,false");
+    
+    /* dates convert between dateItems, timestamps and formatted dates */
+    _test_script(__LINE__,
+                 "on mouseUp\n"
+                 "  global gResult\n"
+                 "  put weekday(1) & \",\" & weekday(7) into gResult\n"
+                 "  convert \"2013,8,19,16,30,5,2\" to timestamp\n"
+                 "  convert it + 86400 to dateItems\n"
+                 "  put \"|\" & it after gResult\n"
+                 "  put \"2013,8,19,16,30,5,2\" into d\n"
+                 "  convert d to short date\n"
+                 "  put \"|\" & d after gResult\n"
+                 "  put \"2013,8,19,16,30,5,2\" into d\n"
+                 "  convert d to long date\n"
+                 "  put \"|\" & d after gResult\n"
+                 "  put \"2013,8,19,16,30,5,2\" into d\n"
+                 "  convert d to long time\n"
+                 "  put \"|\" & d after gResult\n"
+                 "  convert \"Monday 19 August 2013\" to dateItems\n"
+                 "  put \"|\" & it after gResult\n"
+                 "  convert \"8/19/13 4:30 PM\" to dateItems\n"
+                 "  put \"|\" & it after gResult\n"
+                 "end mouseUp\n",
+                 "Sun,Sat|2013,8,20,16,30,5,3|8/19/13|Monday, August 19, 2013|4:30:05 PM"
+                 "|2013,8,19,12,0,0,2|2013,8,19,16,30,0,2");
+}
+
+
+/*
+ *  _xte_vm_benchmark
+ *  ---------------------------------------------------------------------------------------------
+ *  Times a 10 million iteration numeric loop with and without bytecode.  Allocations are
+ *  tracked in DEBUG builds, so the figures are only meaningful from an optimised build.
+ */
+void _xte_vm_benchmark(void)
+{
+    char const *script =
+        "on mouseUp\n"
+        "  global gResult\n"
+        "  put 0 into x\n"
+        "  repeat with i = 0 to 10000000\n"
+        "    if i mod 3 = 0 then next repeat\n"
+        "    put x + 1 into x\n"
+        "  end repeat\n"
+        "  put x into gResult\n"
+        "end mouseUp\n";
+    
+    for (int use_bytecode = XTE_FALSE; use_bytecode <= XTE_TRUE; use_bytecode++)
+    {
+        char result[_RESULT_SIZE];
+        long error_line;
+        clock_t start = clock();
+        _test_run(script, use_bytecode, result, &error_line);
+        printf("%s: %.3f seconds (%s)\n", (use_bytecode ? "bytecode" : "tree interpreter"),
+               (double)(clock() - start) / CLOCKS_PER_SEC, result);
+    }
+}
+
+
+#endif
@@ -20,6 +20,7 @@
 
 int utf8_compare(const char *in_string1, const char *in_string2);
 int utf8_contains(const char *in_string1, const char *in_string2);
+long utf8_collation_key(const char *in_string, char *out_key, long in_key_size);
 
 int _xte_utf8_compare(const char *in_string1, const char *in_string2)
 {
@@ -33,6 +34,24 @@ int _xte_utf8_contains(const char *in_string1, const char *in_string2)
 }
 
 
+/*
+ *  xte_cstring_collation_key
+ *  ---------------------------------------------------------------------------------------------
+ *  Writes a collation key for <in_string> to <out_key>, such that byte-wise comparison (strcmp)
+ *  of the keys of two strings orders them the same way as the comparison operators of the
+ *  language.  At most <in_key_size> bytes are written, including the terminating NULL; if the
+ *  buffer is too small, an empty key is written.  <out_key> may be NULL if <in_key_size> is zero.
+ *
+ *  Returns the number of bytes required for the key, excluding the terminating NULL.
+ */
+long xte_cstring_collation_key(char const *in_string, char *out_key, long in_key_size)
+{
+    assert(in_string != NULL);
+    assert((out_key != NULL) || (in_key_size == 0));
+    return utf8_collation_key(in_string, out_key, in_key_size);
+}
+
+
 
 /*
  *  _xte_utf8_strlen()
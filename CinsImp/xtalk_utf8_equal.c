@@ -8,6 +8,8 @@
 
 #include "xtalk_internal.h"
 
+#include <stdint.h>
+
 
 /********
  UTF-8
@@ -17,57 +19,48 @@ extern char const _XTE_UTF8_CHAR_TAIL_SIZES[256];
 extern unsigned long const _XTE_UTF8_CP_OFFSETS_FOR_TAIL_SIZE[6];
 
 
+/* bytes that aren't part of a valid UTF-8 sequence are decoded as this plus the byte value;
+ being outside of Unicode, they only ever equal the same byte */
+#define _XTE_UTF8_INVALID_BYTE 0x110000
+
 
-static int _xte_utf8_to_ucs(unsigned int *io_dest, int in_dest_size, char const *in_source, long in_source_size)
+/* decodes the character at <io_string> and advances past it.  returns zero at the end of the
+ string, which is either <in_end> (if non-NULL) or a NULL byte */
+static unsigned int _xte_utf8_decode(char const **io_string, char const *in_end)
 {
-    assert(in_source != NULL);
-    assert(io_dest != NULL);
-    assert(in_dest_size > 0);
+    char const *source = *io_string;
+    if ((source == in_end) || (*source == 0)) return 0;
     
-    /* prepare to convert */
-    unsigned int codepoint;
-    char const *source_end = in_source + in_source_size;
-    int tail_size;
-    int dest_offset = 0;
+    /* check the sequence is complete */
+    int tail_size = _XTE_UTF8_CHAR_TAIL_SIZES[(unsigned char)*source];
+    int is_valid = (((*source & 0xC0) != 0x80) && (tail_size <= 3));
+    for (int i = 1; is_valid && (i <= tail_size); i++)
+    {
+        if ((in_end && (source + i >= in_end)) || ((source[i] & 0xC0) != 0x80))
+            is_valid = XTE_FALSE;
+    }
     
-    /* iterate over source bytes */
-    while (dest_offset < in_dest_size) {
-        /* get UTF-8 character tail size */
-        tail_size = _XTE_UTF8_CHAR_TAIL_SIZES[(unsigned char)*in_source];
-        
-        /* check if we've reached the limit of valid characters in the input string */
-        if ( ((in_source_size < 0) && (*in_source == 0)) ||
-            ((in_source_size >= 0) && (in_source + tail_size >= source_end)) ) break;
-        
-        /* convert UTF-8 character to UCS-4 codepoint */
-        codepoint = 0;
+    /* convert UTF-8 character to UCS-4 codepoint */
+    unsigned long codepoint = 0;
+    if (is_valid)
+    {
         switch (tail_size) {
                 /* these fall through deliberately */
-            case 3: codepoint += (unsigned char)*in_source++; codepoint <<= 6;
-            case 2: codepoint += (unsigned char)*in_source++; codepoint <<= 6;
-            case 1: codepoint += (unsigned char)*in_source++; codepoint <<= 6;
-            case 0: codepoint += (unsigned char)*in_source++;
+            case 3: codepoint += (unsigned char)*source++; codepoint <<= 6;
+            case 2: codepoint += (unsigned char)*source++; codepoint <<= 6;
+            case 1: codepoint += (unsigned char)*source++; codepoint <<= 6;
+            case 0: codepoint += (unsigned char)*source++;
         }
         codepoint -= _XTE_UTF8_CP_OFFSETS_FOR_TAIL_SIZE[tail_size];
-        
-        /* write the codepoint to the output */
-        io_dest[dest_offset++] = codepoint;
     }
-    
-    /* return the number of codepoints output */
-    return dest_offset;
-}
-
-
-
-static char const* _xte_utf8_equal_next_char(char const *in_string)
-{
-    if ((!in_string) || (!*in_string)) return NULL;
-    while (*(++in_string))
+    if ((!is_valid) || (codepoint >= _XTE_UTF8_INVALID_BYTE))
     {
-        if ((*in_string & 0xC0) != 0x80) return in_string;
+        source = *io_string;
+        codepoint = _XTE_UTF8_INVALID_BYTE + (unsigned char)*(source++);
     }
-    return NULL;
+    
+    *io_string = source;
+    return (unsigned int)codepoint;
 }
 
 
@@ -75,276 +68,292 @@ static char const* _xte_utf8_equal_next_char(char const *in_string)
 
 /********
  Case Folding
+ 
+ Strings are compared by their full Unicode case folding.  The folding is looked up in the
+ tables of xte_utf8_fold.c, which are generated from the Unicode data by Tools/xte_mkfold.c.
+ Folded ASCII letters are upper case.
  */
 
 
-#define MAX_CODE_HEX_BYTES 6
 #define MAX_CODE_POINTS_MAPPING 3
+#define _XTE_UTF8_FOLD_EXPANDS 0x80000000U
 
-extern char const *const _XTE_UTF8_CASE_DATA;
+extern unsigned char const _XTE_UTF8_FOLD_BLOCK_INDEX[0x1100];
+extern unsigned int const _XTE_UTF8_FOLD_BLOCKS[][256];
+extern unsigned int const _XTE_UTF8_FOLD_EXPANSIONS[][MAX_CODE_POINTS_MAPPING];
 
 
-struct UTF8CaseFoldingRule
+/* writes the folded form of the code point to <out_ucs>; returns the number of code points */
+static int _xte_utf8_fold(unsigned int in_ucs, unsigned int out_ucs[MAX_CODE_POINTS_MAPPING])
 {
-    int pattern_points;
-    unsigned int pattern[MAX_CODE_POINTS_MAPPING];
-    unsigned int uppercase_point;
-};
+    unsigned int folded = 0;
+    if (in_ucs < _XTE_UTF8_INVALID_BYTE)
+        folded = _XTE_UTF8_FOLD_BLOCKS[_XTE_UTF8_FOLD_BLOCK_INDEX[in_ucs >> 8]][in_ucs & 0xFF];
+    
+    if (!folded)
+    {
+        out_ucs[0] = in_ucs;
+        return 1;
+    }
+    if (!(folded & _XTE_UTF8_FOLD_EXPANDS))
+    {
+        out_ucs[0] = folded;
+        return 1;
+    }
+    
+    unsigned int const *expansion = _XTE_UTF8_FOLD_EXPANSIONS[folded & ~_XTE_UTF8_FOLD_EXPANDS];
+    int count = 0;
+    while ((count < MAX_CODE_POINTS_MAPPING) && expansion[count])
+    {
+        out_ucs[count] = expansion[count];
+        count++;
+    }
+    return count;
+}
 
 
-struct UTF8CaseFoldingTable
+/* reads the case folded code points of a string, one at a time */
+struct XTEUTF8FoldReader
 {
-    int rules_count;
-    struct UTF8CaseFoldingRule *rules;
+    char const *string;
+    char const *end;
+    unsigned int folded[MAX_CODE_POINTS_MAPPING];
+    int folded_count;
+    int folded_index;
 };
 
 
-static struct UTF8CaseFoldingTable _g_xte_utf8_case_table = { 0, NULL };
+/* returns the next folded code point; or zero at the end of the string */
+static unsigned int _xte_utf8_fold_next(struct XTEUTF8FoldReader *in_reader)
+{
+    if (in_reader->folded_index == in_reader->folded_count)
+    {
+        unsigned int codepoint = _xte_utf8_decode(&(in_reader->string), in_reader->end);
+        if (!codepoint) return 0;
+        in_reader->folded_count = _xte_utf8_fold(codepoint, in_reader->folded);
+        in_reader->folded_index = 0;
+    }
+    return in_reader->folded[in_reader->folded_index++];
+}
+
+
 
 
-static char const* _xte_utf8_next_line(char const *in_string)
+/********
+ Equality
+ */
+
+
+#define _ONES 0x0101010101010101ULL
+#define _HIGH_BITS (_ONES * 0x80)
+
+/* non-zero if any of the bytes of the word is zero */
+#define _HAS_ZERO_BYTE(word) (((word) - _ONES) & ~(word) & _HIGH_BITS)
+
+
+/* folds an ASCII character */
+static inline unsigned char _xte_ascii_fold(unsigned char in_char)
 {
-    if ((!in_string) || (!*in_string)) return NULL;
-    while ( *in_string && ((*in_string != 10) && (*in_string != 13)) )
-        in_string++;
-    while ( *in_string && ((*in_string == 10) || (*in_string == 13)) )
-        in_string++;
-    if (!(*in_string)) return NULL;
-    return in_string;
+    return ((in_char >= 'a') && (in_char <= 'z') ? in_char - 0x20 : in_char);
 }
 
 
-static int _xte_utf8_read_hex_to_unicode(char const **io_hex)
+/* folds eight ASCII characters at once; the high bit of each byte must be clear */
+static inline uint64_t _xte_ascii_fold_word(uint64_t in_word)
 {
-    assert(io_hex);
-    if (!(*io_hex)) return 0;
-    
-    const char *hex = *io_hex;
-    int value = 0;
-    while (*hex)
-    {
-        int half_value;
-        switch (*hex)
-        {
-            case '0':
-                half_value = 0; break;
-            case '1':
-                half_value = 1; break;
-            case '2':
-                half_value = 2; break;
-            case '3':
-                half_value = 3; break;
-            case '4':
-                half_value = 4; break;
-            case '5':
-                half_value = 5; break;
-            case '6':
-                half_value = 6; break;
-            case '7':
-                half_value = 7; break;
-            case '8':
-                half_value = 8; break;
-            case '9':
-                half_value = 9; break;
-            case 'A':
-            case 'a':
-                half_value = 0xA; break;
-            case 'B':
-            case 'b':
-                half_value = 0xB; break;
-            case 'C':
-            case 'c':
-                half_value = 0xC; break;
-            case 'D':
-            case 'd':
-                half_value = 0xD; break;
-            case 'E':
-            case 'e':
-                half_value = 0xE; break;
-            case 'F':
-            case 'f':
-                half_value = 0xF; break;
-            default:
-                *io_hex = hex;
-                return value;
-        }
-        value <<= 4;
-        value += half_value;
-        hex++;
-    }
-    return value;
+    uint64_t lower = (in_word + _ONES * (0x80 - 'a')) & ~(in_word + _ONES * (0x80 - 'z' - 1)) & _HIGH_BITS;
+    return in_word - (lower >> 2);
 }
 
 
-static int _xte_utf8_init_case_folding(void)
+static int _xte_utf8_streq(char const *const in_string1, long in_bytes1, char const *const in_string2, long in_bytes2)
 {
-    /* don't init case folding if we've already done it */
-    if (_g_xte_utf8_case_table.rules_count > 0) return 1;
+    assert(in_string1 != NULL);
+    assert(in_string2 != NULL);
     
-    /* get the case folding Unicode data */
-    char const *data = _XTE_UTF8_CASE_DATA;
-    struct UTF8CaseFoldingRule rule;
+    if (in_bytes1 < 0) in_bytes1 = strlen(in_string1);
+    if (in_bytes2 < 0) in_bytes2 = strlen(in_string2);
+    char const *ptr1 = in_string1;
+    char const *ptr2 = in_string2;
+    char const *const string1_end = in_string1 + in_bytes1;
+    char const *const string2_end = in_string2 + in_bytes2;
     
-    /* count the number of rules */
-    _g_xte_utf8_case_table.rules_count = 0;
-    while (data && (*data))
+    /* compare a word at a time while the strings are identical or ASCII */
+    while ((string1_end - ptr1 >= sizeof(uint64_t)) && (string2_end - ptr2 >= sizeof(uint64_t)))
     {
-        /* skip an uppercase code point */
-        _xte_utf8_read_hex_to_unicode(&data);
-        
-        /* skip semi-colon, space */
-        if (*data) data++;
-        if (*data) data++;
-        
-        /* check status is Common or Full */
-        if ((*data == 'C') || (*data == 'F'))
-            _g_xte_utf8_case_table.rules_count++;
-        
-        /* find next line */
-        data = _xte_utf8_next_line(data);
+        uint64_t word1, word2;
+        memcpy(&word1, ptr1, sizeof(uint64_t));
+        memcpy(&word2, ptr2, sizeof(uint64_t));
+        if (_HAS_ZERO_BYTE(word1) || _HAS_ZERO_BYTE(word2)) break;
+        if (word1 != word2)
+        {
+            if ((word1 | word2) & _HIGH_BITS) break;
+            if (_xte_ascii_fold_word(word1) != _xte_ascii_fold_word(word2)) return XTE_FALSE;
+        }
+        ptr1 += sizeof(uint64_t);
+        ptr2 += sizeof(uint64_t);
     }
     
-    /* load the rules */
-    data = _XTE_UTF8_CASE_DATA;
-    _g_xte_utf8_case_table.rules = _xte_malloc_static(_g_xte_utf8_case_table.rules_count * sizeof(struct UTF8CaseFoldingRule));
-    if (!_g_xte_utf8_case_table.rules) return 0;
-    memset(_g_xte_utf8_case_table.rules, 0, _g_xte_utf8_case_table.rules_count * sizeof(struct UTF8CaseFoldingRule));
-    int rule_index = 0;
-    while (data && (*data))
+    /* and then a byte at a time while they're ASCII */
+    while ((ptr1 != string1_end) && (ptr2 != string2_end))
     {
-        /* read a uppercase code point */
-        rule.uppercase_point = _xte_utf8_read_hex_to_unicode(&data);
-        
-        /* skip semi-colon, space */
-        if (*data) data++;
-        if (*data) data++;
-        
-        /* check status is Common or Full */
-        if ((*data == 'C') || (*data == 'F'))
+        unsigned char char1 = *ptr1, char2 = *ptr2;
+        if ((!char1) || (!char2) || ((char1 | char2) & 0x80)) break;
+        if (_xte_ascii_fold(char1) != _xte_ascii_fold(char2)) return XTE_FALSE;
+        ptr1++;
+        ptr2++;
+    }
+    
+    /* identical words may have ended part way through a character; if so, back up to the start
+     of the character, everything before being the same in both strings */
+    if (ptr1 != in_string1)
+    {
+        char const *lead = ptr1 - 1;
+        while ((lead != in_string1) && ((*lead & 0xC0) == 0x80)) lead--;
+        if (lead + 1 + _XTE_UTF8_CHAR_TAIL_SIZES[(unsigned char)*lead] > ptr1)
         {
-            /* skip the status, semicolon and space */
-            data += 3;
-            
-            /* read mapping code point(s) */
-            rule.pattern_points = 0;
-            while (rule.pattern_points < MAX_CODE_POINTS_MAPPING)
-            {
-                /* read mapping code point */
-                rule.pattern[rule.pattern_points++] = _xte_utf8_read_hex_to_unicode(&data);
-                
-                /* look for space / semicolon */
-                if ( (!(*data)) || (*data == ';') ) break;
-                
-                /* skip space */
-                data++;
-            }
-            
-            /* register rule */
-            if (rule.pattern_points > 0)
-                _g_xte_utf8_case_table.rules[rule_index++] = rule;
+            ptr2 -= ptr1 - lead;
+            ptr1 = lead;
         }
-        
-        /* find next line */
-        data = _xte_utf8_next_line(data);
     }
     
-    /* return success */
-    return 1;
+    /* compare the remainder by folding each character */
+    struct XTEUTF8FoldReader reader1 = { ptr1, string1_end, {0}, 0, 0 };
+    struct XTEUTF8FoldReader reader2 = { ptr2, string2_end, {0}, 0, 0 };
+    for (;;)
+    {
+        unsigned int folded1 = _xte_utf8_fold_next(&reader1);
+        if (folded1 != _xte_utf8_fold_next(&reader2)) return XTE_FALSE;
+        if (!folded1) return XTE_TRUE;
+    }
 }
 
 
 
-/*
- returns the number of codepoints consumed during the transformation
- */
-static int _xte_utf8_toupper(unsigned int *io_ucs)
+int xte_cstrings_equal(char const *in_string1, char const *in_string2)
 {
-    /* ASCII case transform (shortcut) */
-    /*if (*io_ucs < 0x80)
-     {
-     *io_ucs = toupper(*io_ucs);
-     return 1;
-     }*/
-    
-    /* Unicode case transform */
-    for (int rule_index = 0; rule_index < _g_xte_utf8_case_table.rules_count; rule_index++)
-    {
-        struct UTF8CaseFoldingRule *rule = _g_xte_utf8_case_table.rules + rule_index;
-        if (memcmp(rule->pattern, io_ucs, sizeof(unsigned int) * rule->pattern_points) == 0)
-        {
-            memset(io_ucs, 0, MAX_CODE_POINTS_MAPPING * sizeof(unsigned int));
-            io_ucs[0] = rule->uppercase_point;
-            return rule->pattern_points;
-        }
-    }
-    
-    return 1;
+    return _xte_utf8_streq(in_string1, strlen(in_string1), in_string2, strlen(in_string2));
 }
 
 
+int xte_cstrings_szd_equal(char const *in_string1, long in_bytes1, char const *in_string2, long in_bytes2)
+{
+    return _xte_utf8_streq(in_string1, in_bytes1, in_string2, in_bytes2);
+}
 
-/*
- this may be incorrectly (not) handling multi-codepoints - must check with one from UTF8 table data...
- */
-static int _xte_utf8_streq(char const *const in_string1, long in_bytes1, char const *const in_string2, long in_bytes2)
+
+
+/* orders two strings by the code points of their case folded forms; returns -1, 0 or 1 */
+int _xte_utf8_fold_compare(char const *in_string1, char const *in_string2)
 {
     assert(in_string1 != NULL);
     assert(in_string2 != NULL);
     
-    if (!_xte_utf8_init_case_folding()) return 0;
-    
-    char const *ptr1 = in_string1;
-    char const *ptr2 = in_string2;
-    char const *string1_end = (in_bytes1 >= 0 ? in_string1 + in_bytes1 : NULL);
-    char const *string2_end = (in_bytes2 >= 0 ? in_string2 + in_bytes2 : NULL);
-    
-    while (ptr1 && ptr2 && (ptr1 != string1_end) && (*ptr1 != 0) && (ptr2 != string2_end) && (*ptr2 != 0))
+    struct XTEUTF8FoldReader reader1 = { in_string1, NULL, {0}, 0, 0 };
+    struct XTEUTF8FoldReader reader2 = { in_string2, NULL, {0}, 0, 0 };
+    for (;;)
     {
-        unsigned int conversion_buffer_1[MAX_CODE_POINTS_MAPPING];
-        unsigned int conversion_buffer_2[MAX_CODE_POINTS_MAPPING];
-        
-        int converted_chars_1 = _xte_utf8_to_ucs(conversion_buffer_1,
-                                                 MAX_CODE_POINTS_MAPPING,
-                                                 ptr1,
-                                                 (string1_end ? string1_end-ptr1 : -1));
-        int converted_chars_2 = _xte_utf8_to_ucs(conversion_buffer_2,
-                                                 MAX_CODE_POINTS_MAPPING,
-                                                 ptr2,
-                                                 (string2_end ? string2_end-ptr2 : -1));
-        if (converted_chars_1 != converted_chars_2) return 0;
-        
-        converted_chars_1 = _xte_utf8_toupper(conversion_buffer_1);
-        converted_chars_2 = _xte_utf8_toupper(conversion_buffer_2);
-        
-        if (conversion_buffer_1[0] != conversion_buffer_2[0]) return 0;
-        
-        for (int i = 0; i < converted_chars_1; i++)
-            ptr1 = _xte_utf8_equal_next_char(ptr1);
-        for (int i = 0; i < converted_chars_2; i++)
-            ptr2 = _xte_utf8_equal_next_char(ptr2);
+        unsigned int folded1 = _xte_utf8_fold_next(&reader1);
+        unsigned int folded2 = _xte_utf8_fold_next(&reader2);
+        if (folded1 != folded2) return (folded1 < folded2 ? -1 : 1);
+        if (!folded1) return 0;
     }
-    
-    if (string1_end && (*string1_end == 0)) string1_end = NULL;
-    if (string2_end && (*string2_end == 0)) string2_end = NULL;
-    
-    return ( ((ptr1 == NULL) && (ptr2 == NULL)) ||
-            ((ptr1 == string1_end) && (ptr2 == string2_end)) );
 }
 
 
 
-int xte_cstrings_equal(char const *in_string1, char const *in_string2)
+/* writes the UTF-8 encoding of a code point to <out_bytes> (if non-NULL);
+ returns the number of bytes */
+static int _xte_utf8_from_ucs(unsigned int in_codepoint, char *out_bytes)
 {
-    return _xte_utf8_streq(in_string1, strlen(in_string1), in_string2, strlen(in_string2));
+    char bytes[4];
+    int count;
+    if (in_codepoint < 0x80)
+    {
+        bytes[0] = in_codepoint;
+        count = 1;
+    }
+    else if (in_codepoint < 0x800)
+    {
+        bytes[0] = 0xC0 | (in_codepoint >> 6);
+        bytes[1] = 0x80 | (in_codepoint & 0x3F);
+        count = 2;
+    }
+    else if (in_codepoint < 0x10000)
+    {
+        bytes[0] = 0xE0 | (in_codepoint >> 12);
+        bytes[1] = 0x80 | ((in_codepoint >> 6) & 0x3F);
+        bytes[2] = 0x80 | (in_codepoint & 0x3F);
+        count = 3;
+    }
+    else
+    {
+        bytes[0] = 0xF0 | (in_codepoint >> 18);
+        bytes[1] = 0x80 | ((in_codepoint >> 12) & 0x3F);
+        bytes[2] = 0x80 | ((in_codepoint >> 6) & 0x3F);
+        bytes[3] = 0x80 | (in_codepoint & 0x3F);
+        count = 4;
+    }
+    if (out_bytes) memcpy(out_bytes, bytes, count);
+    return count;
 }
 
 
-int xte_cstrings_szd_equal(char const *in_string1, long in_bytes1, char const *in_string2, long in_bytes2)
+/*
+ *  xte_cstring_fold
+ *  ---------------------------------------------------------------------------------------------
+ *  Writes a case-folded copy of <in_string> to <out_buffer>, using the same case folding rules
+ *  as xte_cstrings_equal().  At most <in_buffer_size> bytes are written, including the 
+ *  terminating NULL.  <out_buffer> may be NULL if <in_buffer_size> is zero.
+ *
+ *  Byte-wise comparison (strcmp) of folded strings gives a case-insensitive ordering by Unicode
+ *  code point, without the overhead of folding characters on every comparison.
+ *
+ *  Returns the number of bytes required for the folded string, excluding the terminating NULL.
+ */
+long xte_cstring_fold(char const *in_string, char *out_buffer, long in_buffer_size)
 {
-    return _xte_utf8_streq(in_string1, in_bytes1, in_string2, in_bytes2);
+    assert(in_string != NULL);
+    assert((out_buffer != NULL) || (in_buffer_size == 0));
+    
+    long required = 0, written = 0;
+    char const *ptr = in_string;
+    while (*ptr)
+    {
+        char folded[MAX_CODE_POINTS_MAPPING * 4];
+        int folded_bytes = 0;
+        
+        if (!(*ptr & 0x80))
+        {
+            /* ASCII shortcut; the ASCII rules fold only to ASCII */
+            folded[folded_bytes++] = _xte_ascii_fold(*ptr);
+            ptr++;
+        }
+        else
+        {
+            unsigned int codepoint = _xte_utf8_decode(&ptr, NULL);
+            if (codepoint >= _XTE_UTF8_INVALID_BYTE)
+                folded[folded_bytes++] = codepoint - _XTE_UTF8_INVALID_BYTE;
+            else
+            {
+                unsigned int conversion_buffer[MAX_CODE_POINTS_MAPPING];
+                int converted_chars = _xte_utf8_fold(codepoint, conversion_buffer);
+                for (int i = 0; i < converted_chars; i++)
+                    folded_bytes += _xte_utf8_from_ucs(conversion_buffer[i], folded + folded_bytes);
+            }
+        }
+        
+        if ((written == required) && (required + folded_bytes < in_buffer_size))
+        {
+            memcpy(out_buffer + written, folded, folded_bytes);
+            written += folded_bytes;
+        }
+        required += folded_bytes;
+    }
+    
+    if (in_buffer_size > 0) out_buffer[written] = 0;
+    return required;
 }
 
 
 
-
-
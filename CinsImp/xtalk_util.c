@@ -229,6 +229,31 @@ int _xte_compare_cstr(char const *in_string_1, char const *in_string_2)
 }
 
 
+/*
+ *  _xte_cstr_case_hash()
+ *  ---------------------------------------------------------------------------------------------
+ *  Computes a case-insensitive hash of a UTF-8 string, suitable for use with hash tables whose
+ *  keys are compared using xte_cstrings_equal().
+ *
+ *  Only the ASCII-roman characters contribute to the hash (folded to upper-case); the bytes of
+ *  multi-byte sequences are ignored, so that strings which differ only in the case of non-ASCII
+ *  characters will still hash to the same value.
+ */
+
+unsigned long _xte_cstr_case_hash(char const *in_string)
+{
+    assert(in_string != NULL);
+    
+    unsigned long hash = 5381;
+    for (unsigned char const *b = (unsigned char const*)in_string; *b; b++)
+    {
+        if (*b >= 0x80) continue;
+        hash = ((hash << 5) + hash) ^ (unsigned long)toupper(*b);
+    }
+    return hash;
+}
+
+
 /*
  *  _xte_itemize_cstr()
  *  ---------------------------------------------------------------------------------------------
@@ -33,8 +33,9 @@
 
 XTEVariant* xte_variant_create(XTE *in_engine)
 {
-    XTEVariant *result = calloc(sizeof(struct XTEVariant), 1);
+    XTEVariant *result = _xte_slab_alloc(in_engine->variant_slab);
     if (!result) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    memset(result, 0, sizeof(struct XTEVariant));
     result->type = XTE_TYPE_NULL;
     result->ref_count = 1;
     return result;
@@ -184,6 +185,46 @@ XTEVariant* xte_real_create(XTE *in_engine, double in_real)
 }
 
 
+/* initialises an unboxed number or boolean in caller supplied storage, usually on the stack,
+ avoiding an allocation for short-lived values such as loop counters and intermediate results;
+ the result must never be retained or released, and is copied if it must outlive the storage */
+XTEVariant* _xte_immediate_integer(XTEVariant *in_cell, int in_integer)
+{
+    in_cell->type = XTE_TYPE_INTEGER;
+    in_cell->value.integer = in_integer;
+    in_cell->ref_count = 1;
+    return in_cell;
+}
+
+
+XTEVariant* _xte_immediate_real(XTEVariant *in_cell, double in_real)
+{
+    in_cell->type = XTE_TYPE_REAL;
+    in_cell->value.real = in_real;
+    in_cell->ref_count = 1;
+    return in_cell;
+}
+
+
+XTEVariant* _xte_immediate_boolean(XTEVariant *in_cell, int in_boolean)
+{
+    in_cell->type = XTE_TYPE_BOOLEAN;
+    in_cell->value.boolean = in_boolean;
+    in_cell->ref_count = 1;
+    return in_cell;
+}
+
+
+/* can the variant be held unboxed?  ie. it doesn't own any external memory */
+int _xte_is_immediate(XTEVariant *in_variant)
+{
+    if (!in_variant) return XTE_FALSE;
+    return ((in_variant->type == XTE_TYPE_INTEGER) ||
+            (in_variant->type == XTE_TYPE_REAL) ||
+            (in_variant->type == XTE_TYPE_BOOLEAN));
+}
+
+
 /*  assumes ownership of the owner (if any) */
 XTEVariant* xte_property_ref(XTE *in_engine, struct XTEPropertyPtr *in_ptrs, XTEVariant *in_owner, XTEPropRep in_rep)
 {
@@ -226,16 +267,45 @@ XTEVariant* xte_object_create(XTE *in_engine, char const *in_class_name, void *i
 
 XTEVariant* xte_global_ref(XTE *in_engine, char *in_var_name)
 {
+    return _xte_variable_ref(in_engine, in_var_name, -1);
+}
     
+
+/* creates a reference to a variable; the slot is where the variable is found in the current
+ handler frame, or -1 if the variable can only be looked up by name;
+ a reference with a slot borrows the name from the handler, which is executing */
+XTEVariant* _xte_variable_ref(XTE *in_engine, char const *in_var_name, int in_slot)
+{
     /* create the reference variant */
     XTEVariant *result = xte_variant_create(in_engine);
     if (!result) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
     result->type = XTE_TYPE_GLOBAL;
-    result->value.utf8_string = _xte_clone_cstr(in_engine, in_var_name);
+    if ((in_slot >= 0) && (in_engine->handler_stack_ptr >= 0))
+    {
+        result->value.var.name = (char*)in_var_name;
+        result->value.var.slot = in_slot;
+        result->value.var.scope = in_engine->handler_stack[in_engine->handler_stack_ptr].handler;
+    }
+    else
+    {
+    result->value.var.name = _xte_clone_cstr(in_engine, in_var_name);
+        result->value.var.slot = -1;
+        result->value.var.scope = NULL;
+    }
     return result;
 }
 
 
+/* returns the slot of a variable reference, if it belongs to the handler that's executing,
+ otherwise -1, as references can be passed between handlers */
+static int _xte_variable_ref_slot(XTE *in_engine, XTEVariant *in_ref)
+{
+    if ((!in_ref->value.var.scope) || (in_engine->handler_stack_ptr < 0)) return -1;
+    if (in_engine->handler_stack[in_engine->handler_stack_ptr].handler != in_ref->value.var.scope) return -1;
+    return in_ref->value.var.slot;
+}
+
+
 /* destroys the variant, without deallocating the memory it consumes;
  allowing the same pointer to be reused for a different variant */
 static void _xte_variant_zap(XTEVariant *in_variant, int in_only_external)
@@ -248,6 +318,8 @@ static void _xte_variant_zap(XTEVariant *in_variant, int in_only_external)
         case XTE_TYPE_LOCAL:
             if (!in_only_external)
             {
+                /* the name of a variable reference with a slot belongs to the handler */
+                if ((in_variant->type == XTE_TYPE_GLOBAL) && (in_variant->value.var.scope)) break;
                 if (in_variant->value.utf8_string) free(in_variant->value.utf8_string);
             }
             break;
@@ -286,7 +358,7 @@ void xte_variant_free(XTEVariant *in_variant)
     
     
     _xte_variant_zap(in_variant, XTE_FALSE);
-    free(in_variant);
+    _xte_slab_free(in_variant);
 }
 
 
@@ -342,52 +414,102 @@ XTEVariant* xte_variant_copy(XTE *in_engine, XTEVariant *in_variant)
     XTEVariant *result = xte_variant_create(in_engine);
     if (!result) return NULL;
     *result = *in_variant;
-    if (in_variant->type == XTE_TYPE_STRING)
+    if ((in_variant->type == XTE_TYPE_STRING) || (in_variant->type == XTE_TYPE_GLOBAL))
         result->value.utf8_string = _xte_clone_cstr(in_engine, in_variant->value.utf8_string);
+    if (in_variant->type == XTE_TYPE_GLOBAL)
+    {
+        /* the copy may outlive the handler, so it owns the name and is looked up by name */
+        result->value.var.slot = -1;
+        result->value.var.scope = NULL;
+    }
     result->ref_count = 1;
     return result;
 }
 
 
-int _xte_global_exists(XTE *in_engine, const char *in_var_name)
+/* returns the global table slot for the specified name; either the slot of the global,
+ or the empty slot where the global should be inserted */
+static int _xte_global_table_slot(XTE *in_engine, char const *in_var_name, unsigned long in_hash)
 {
-    /* lookup the global variable by name */
-    int var_index;
-    for (var_index = 0; var_index < in_engine->global_count; var_index++)
+    int mask = in_engine->global_table_size - 1;
+    int slot = (int)(in_hash & mask);
+    for (;;)
     {
-        if (_xte_compare_cstr(in_engine->globals[var_index]->name, in_var_name) == 0)
-            return XTE_TRUE;
+        int var_index = in_engine->global_table[slot];
+        if (var_index < 0) return slot;
+        struct XTEVariable *var = in_engine->globals[var_index];
+        if ((var->hash == in_hash) && (_xte_compare_cstr(var->name, in_var_name) == 0))
+            return slot;
+        slot = (slot + 1) & mask;
     }
-    return XTE_FALSE;
 }
 
 
-static struct XTEVariable* _xte_global_lookup(XTE *in_engine, char const *in_var_name)
+/* resizes the global table to accomodate more globals */
+static int _xte_global_table_grow(XTE *in_engine)
 {
-    int var_index;
-    for (var_index = 0; var_index < in_engine->global_count; var_index++)
+    int new_size = (in_engine->global_table_size ? in_engine->global_table_size * 2 : 64);
+    int *new_table = malloc(sizeof(int) * new_size);
+    if (!new_table) return XTE_FALSE;
+    for (int i = 0; i < new_size; i++)
+        new_table[i] = -1;
+    
+    if (in_engine->global_table) free(in_engine->global_table);
+    in_engine->global_table = new_table;
+    in_engine->global_table_size = new_size;
+    
+    for (int var_index = 0; var_index < in_engine->global_count; var_index++)
     {
-        if (_xte_compare_cstr(in_engine->globals[var_index]->name, in_var_name) == 0)
-            return in_engine->globals[var_index];
+        struct XTEVariable *var = in_engine->globals[var_index];
+        in_engine->global_table[_xte_global_table_slot(in_engine, var->name, var->hash)] = var_index;
     }
-    return NULL;
+    return XTE_TRUE;
+}
+
+
+static struct XTEVariable* _xte_global_lookup(XTE *in_engine, char const *in_var_name)
+{
+    if (in_engine->global_count == 0) return NULL;
+    int var_index = in_engine->global_table[_xte_global_table_slot(in_engine, in_var_name, _xte_cstr_case_hash(in_var_name))];
+    if (var_index < 0) return NULL;
+    return in_engine->globals[var_index];
+}
+
+
+int _xte_global_exists(XTE *in_engine, const char *in_var_name)
+{
+    return (_xte_global_lookup(in_engine, in_var_name) != NULL);
 }
 
 
 struct XTEVariable* _xte_define_global(XTE *in_engine, char const *in_var_name)
 {
-    struct XTEVariable **new_globals = realloc(in_engine->globals, sizeof(struct XTEVariable*) * (in_engine->global_count + 1));
+    /* make room */
+    if (in_engine->global_count == in_engine->global_alloc)
+    {
+        int new_alloc = (in_engine->global_alloc ? in_engine->global_alloc * 2 : 32);
+        struct XTEVariable **new_globals = realloc(in_engine->globals, sizeof(struct XTEVariable*) * new_alloc);
     if (!new_globals) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
     in_engine->globals = new_globals;
+        in_engine->global_alloc = new_alloc;
+    }
+    if ((in_engine->global_count + 1) * 2 > in_engine->global_table_size)
+    {
+        if (!_xte_global_table_grow(in_engine)) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    }
     
     struct XTEVariable *var = malloc(sizeof(struct XTEVariable));
-    if (!var) return NULL;
-    int var_index = in_engine->global_count++;
-    new_globals[var_index] = var;
-    
+    if (!var) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
     var->name = _xte_clone_cstr(in_engine, in_var_name);
     var->value = xte_string_create_with_cstring(in_engine, "");
     var->is_global = XTE_TRUE;
+    var->hash = _xte_cstr_case_hash(in_var_name);
+    var->buffer_size = 0;
+    var->chunk_index = NULL;
+    
+    int var_index = in_engine->global_count++;
+    in_engine->globals[var_index] = var;
+    in_engine->global_table[_xte_global_table_slot(in_engine, var->name, var->hash)] = var_index;
     
     if (in_engine->callback.debug_variable)
         in_engine->callback.debug_variable(in_engine, in_engine->context, var->name, XTE_TRUE, "");
@@ -396,30 +518,64 @@ struct XTEVariable* _xte_define_global(XTE *in_engine, char const *in_var_name)
 }
 
 
-static struct XTEVariable* _xte_define_local(XTE *in_engine, char const *in_var_name)
+/* returns the slot assigned to a variable name by the frame's handler, or -1 if it has none;
+ only used when a variable is defined by name, so that references with a slot needn't search */
+static int _xte_frame_slot_named(struct XTEHandlerFrame *in_frame, char const *in_var_name)
+{
+    for (int slot = 0; slot < in_frame->slot_count; slot++)
+    {
+        if (_xte_compare_cstr(in_frame->handler->value.handler.slot_names[slot], in_var_name) == 0)
+            return slot;
+    }
+    return -1;
+}
+
+
+/* defines a local variable within the current handler frame, taking ownership of the value;
+ the slot is that of the variable name, or -1 to look it up by name.
+ the locals are grown geometrically, and as they may move, the frame's slots are found again */
+struct XTEVariable* _xte_define_local(XTE *in_engine, char const *in_var_name, int in_slot, XTEVariant *in_value)
 {
     struct XTEHandlerFrame *frame = in_engine->handler_stack + in_engine->handler_stack_ptr;
     
-    struct XTEVariable *new_locals = realloc(frame->locals, sizeof(struct XTEVariable) * (frame->local_count + 1));
+    if (frame->local_count == frame->local_alloc)
+    {
+        int new_alloc = frame->local_alloc * 2;
+        if (new_alloc == 0) new_alloc = (frame->slot_count > 4 ? frame->slot_count : 4);
+        struct XTEVariable *new_locals = realloc(frame->locals, sizeof(struct XTEVariable) * new_alloc);
     if (!new_locals) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
+        if (new_locals != frame->locals)
+        {
+            for (int var_index = 0; var_index < frame->local_count; var_index++)
+            {
+                int slot = _xte_frame_slot_named(frame, new_locals[var_index].name);
+                if (slot >= 0) frame->slots[slot] = &(new_locals[var_index]);
+            }
+        }
     frame->locals = new_locals;
+        frame->local_alloc = new_alloc;
+    }
     int var_index = frame->local_count++;
     
-    struct XTEVariable *var = &(new_locals[var_index]);
+    struct XTEVariable *var = &(frame->locals[var_index]);
     var->name = _xte_clone_cstr(in_engine, in_var_name);
-    var->value = xte_string_create_with_cstring(in_engine, "");
+    var->value = in_value;
     var->is_global = XTE_FALSE;
+    var->buffer_size = 0;
+    var->chunk_index = NULL;
     
-    if (in_engine->callback.debug_variable)
-        in_engine->callback.debug_variable(in_engine, in_engine->context, var->name, XTE_FALSE, "");
+    /* locals take precedence over imported globals of the same name */
+    if ((in_slot < 0) || (in_slot >= frame->slot_count)) in_slot = _xte_frame_slot_named(frame, in_var_name);
+    if (in_slot >= 0) frame->slots[in_slot] = var;
     
     return var;
 }
 
 
 /* attempts to access the variable record with the given name,
- and if it doesn't exist, creates it with an appropriate scope */
-static struct XTEVariable* _xte_variable_access(XTE *in_engine, char const *in_var_name, int in_create)
+ and if it doesn't exist, creates it with an appropriate scope;
+ if the reference has a slot, the variable is found directly in the handler frame */
+static struct XTEVariable* _xte_variable_access(XTE *in_engine, char const *in_var_name, int in_slot, int in_create)
 {
     /* if there's a handler executing; lookup the variable
      within the handler's scope,
@@ -427,31 +583,46 @@ static struct XTEVariable* _xte_variable_access(XTE *in_engine, char const *in_v
     if (in_engine->handler_stack_ptr >= 0)
     {
         struct XTEHandlerFrame *frame = in_engine->handler_stack + in_engine->handler_stack_ptr;
+        struct XTEVariable *var = NULL;
         
+        /* have slot; every variable with a slot is kept there, so if it's empty,
+         the variable doesn't exist */
+        if ((in_slot >= 0) && (in_slot < frame->slot_count))
+            var = frame->slots[in_slot];
+        else
+        {
         /* have handler; read local and imported global scope */
+            in_slot = -1;
         for (int var_index = 0; var_index < frame->local_count; var_index++)
         {
             if (_xte_compare_cstr(frame->locals[var_index].name, in_var_name) == 0)
-                return &(frame->locals[var_index]);
+            {
+                var = &(frame->locals[var_index]);
+                break;
         }
-        for (int var_index = 0; var_index < frame->imported_global_count; var_index++)
+        }
+        for (int var_index = 0; (!var) && (var_index < frame->imported_global_count); var_index++)
         {
             if (_xte_compare_cstr(frame->imported_globals[var_index]->name, in_var_name) == 0)
-                return frame->imported_globals[var_index];
+                var = frame->imported_globals[var_index];
+        }
         }
         
         /* variable doesn't exist; create local */
-        if (in_create)
-            return _xte_define_local(in_engine, in_var_name);
+        if ((!var) && in_create)
+        {
+            var = _xte_define_local(in_engine, in_var_name, in_slot, xte_string_create_with_cstring(in_engine, ""));
+            if (!var) return NULL;
+            if (in_engine->callback.debug_variable)
+                in_engine->callback.debug_variable(in_engine, in_engine->context, var->name, XTE_FALSE, "");
+        }
+        return var;
     }
     else
     {
         /* no handler; read globle scope only */
-        for (int var_index = 0; var_index < in_engine->global_count; var_index++)
-        {
-            if (_xte_compare_cstr(in_engine->globals[var_index]->name, in_var_name) == 0)
-                return in_engine->globals[var_index];
-        }
+        struct XTEVariable *var = _xte_global_lookup(in_engine, in_var_name);
+        if (var) return var;
         
         /* variable doesn't exist; create global */
         if (in_create)
@@ -470,6 +641,9 @@ static void _xte_report_variable_mutation(XTE *in_engine, struct XTEVariable *in
     
     
     
+    /* nothing to do unless a debugger is watching */
+    if (!in_engine->callback.debug_variable) return;
+    
     /* grab the value of the variable as a string for reporting */
     /// ***TODO**** should be able to reuse/combine parts of the variant conversion mechanism hopefully in future
     if (in_engine->temp_debug_var_value) free(in_engine->temp_debug_var_value);
@@ -500,25 +674,16 @@ static void _xte_report_variable_mutation(XTE *in_engine, struct XTEVariable *in
         in_engine->temp_debug_var_value = _xte_clone_cstr(in_engine, "");
     
     /* report the mutation */
-    if (in_engine->callback.debug_variable)
-        in_engine->callback.debug_variable(in_engine, in_engine->context, in_var->name, in_var->is_global, in_engine->temp_debug_var_value);
+    in_engine->callback.debug_variable(in_engine, in_engine->context, in_var->name, in_var->is_global, in_engine->temp_debug_var_value);
 }
 
 
 
 void _xte_global_import(XTE *in_engine, char const *in_var_name)
 {
-    struct XTEVariable *var = NULL;
-    
-    for (int var_index = 0; var_index < in_engine->global_count; var_index++)
-    {
-        if (_xte_compare_cstr(in_engine->globals[var_index]->name, in_var_name) == 0)
-        {
-            var = in_engine->globals[var_index];
-            break;
-        }
-    }
+    struct XTEVariable *var = _xte_global_lookup(in_engine, in_var_name);
     if (!var) var = _xte_define_global(in_engine, in_var_name);
+    if (!var) return;
     
     struct XTEHandlerFrame *frame = in_engine->handler_stack + in_engine->handler_stack_ptr;
     
@@ -528,14 +693,18 @@ void _xte_global_import(XTE *in_engine, char const *in_var_name)
     frame->imported_globals = new_imported_globals;
     new_imported_globals[frame->imported_global_count++] = var;
     
+    /* locals take precedence over imported globals of the same name */
+    int slot = _xte_frame_slot_named(frame, in_var_name);
+    if ((slot >= 0) && (!frame->slots[slot])) frame->slots[slot] = var;
+    
     _xte_report_variable_mutation(in_engine, var);
 }
 
 
-static XTEVariant* _xte_variable_read(XTE *in_engine, char const *in_var_name)
+static XTEVariant* _xte_variable_read(XTE *in_engine, char const *in_var_name, int in_slot)
 {
     /* lookup variable */
-    struct XTEVariable *the_var = _xte_variable_access(in_engine, in_var_name, XTE_FALSE);
+    struct XTEVariable *the_var = _xte_variable_access(in_engine, in_var_name, in_slot, XTE_FALSE);
     
     /* if it doesn't exist, return the variable name itself */
     if (the_var == NULL)
@@ -546,25 +715,63 @@ static XTEVariant* _xte_variable_read(XTE *in_engine, char const *in_var_name)
 }
 
 
+/* returns the value of the variable without copying it, or NULL if the variable doesn't exist;
+ the value belongs to the variable */
+XTEVariant* _xte_variable_peek(XTE *in_engine, char const *in_var_name, int in_slot)
+{
+    struct XTEVariable *the_var = _xte_variable_access(in_engine, in_var_name, in_slot, XTE_FALSE);
+    if (the_var == NULL) return NULL;
+    return the_var->value;
+}
+
+
+/* returns the variable record of a variable reference, or NULL if the variable doesn't exist;
+ used by chunk expressions to read the string of a variable directly, see xtalk_chunk.c */
+struct XTEVariable* _xte_variable_lookup(XTE *in_engine, XTEVariant *in_ref)
+{
+    return _xte_variable_access(in_engine, in_ref->value.var.name, _xte_variable_ref_slot(in_engine, in_ref), XTE_FALSE);
+}
+
+
+/* discards the index of chunks within the value of a variable, whenever the value changes */
+static void _xte_variable_unindex(struct XTEVariable *in_var)
+{
+    if (!in_var->chunk_index) return;
+    _xte_chunk_index_dispose(in_var->chunk_index);
+    in_var->chunk_index = NULL;
+}
+
+
 
 
 
 long _xte_utf8_count_bytes_in_range(char const *in_string, long in_start, long in_end);
-char const* _xte_utf8_index_char(char const *in_string, long const in_char_offset);
+long _xte_utf8_count_chars_between(char const *in_begin, char const *const in_end);
 
-void _xte_variable_write(XTE *in_engine, char const *in_var_name, XTEVariant *in_value, XTETextRange in_range, XTEPutMode in_mode)
+void _xte_variable_write(XTE *in_engine, char const *in_var_name, int in_slot, XTEVariant *in_value, XTETextRange in_range, XTEPutMode in_mode)
 {
     /* lookup the variable;
      create it if necessary */
-    struct XTEVariable *var = _xte_variable_access(in_engine, in_var_name, XTE_TRUE);
+    struct XTEVariable *var = _xte_variable_access(in_engine, in_var_name, in_slot, XTE_TRUE);
     
     /* mutate the variable */
     if (in_value == var->value) return; /* don't try to mutate to itself */
+    _xte_variable_unindex(var);
     if ((in_range.offset < 0) && (in_mode == XTE_PUT_INTO))
     {
-        /* simple mutation; replace entire variable with new value */
-        xte_variant_release(var->value);
-        var->value = xte_variant_copy(in_engine, in_value);
+        /* simple mutation; replace entire variable with new value;
+         numbers and booleans overwrite one another in place, unless the value is shared */
+        if (_xte_is_immediate(in_value) && _xte_is_immediate(var->value) && (var->value->ref_count == 1))
+        {
+            var->value->type = in_value->type;
+            var->value->value = in_value->value;
+        }
+        else
+        {
+            xte_variant_release(var->value);
+            var->value = xte_variant_copy(in_engine, in_value);
+        }
+        var->buffer_size = 0;
     }
     else
     {
@@ -579,59 +786,100 @@ void _xte_variable_write(XTE *in_engine, char const *in_var_name, XTEVariant *in
          first we must convert the variable to a string
          (because strings are the only type of variable we support using ranges & modes on
          as variables, at this time - in future this could change!) */
+        if ((var->value->type != XTE_TYPE_STRING) || (var->value->ref_count > 1))
+        {
+            var->buffer_size = 0;
+            if (var->value->ref_count > 1)
+            {
+                XTEVariant *copy = xte_variant_copy(in_engine, var->value);
+                if (!copy) return _xte_panic_void(in_engine, XTE_ERROR_MEMORY, NULL);
+                xte_variant_release(var->value);
+                var->value = copy;
+            }
+        }
         if (!xte_variant_convert(in_engine, var->value, XTE_TYPE_STRING))
         {
             /* if we can't convert it, just overwrite it completely */
             xte_variant_release(var->value);
             var->value = xte_string_create_with_cstring(in_engine, "");
         }
-        char const *existing_string = xte_variant_as_cstring(var->value);
         
-        /* if the range is unspecified, compute the length now */
-        if (in_range.offset < 0)
+        /* the string is edited in place from now on; thus appending to the variable
+         doesn't copy it, and replacing a range doesn't copy the part before the range */
+        if (var->buffer_size == 0)
         {
-            in_range.offset = 0;
-            in_range.length = _xte_utf8_strlen(existing_string);
+            var->byte_length = strlen(var->value->value.utf8_string);
+            var->buffer_size = var->byte_length + 1;
+            var->char_count = -1;
         }
         
-        /* transform replace range based on mode */
-        if (in_mode == XTE_PUT_BEFORE)
-            in_range.length = 0;
-        else if (in_mode == XTE_PUT_AFTER)
+        /* find the bytes to be replaced; appending or prepending needs no character count */
+        long first_part_size, substring_bytes;
+        if (in_range.offset < 0)
         {
-            in_range.offset += in_range.length;
-            in_range.length = 0;
+            first_part_size = (in_mode == XTE_PUT_AFTER ? var->byte_length : 0);
+            substring_bytes = 0;
+        }
+        else
+        {
+            /* transform replace range based on mode */
+            if (in_mode == XTE_PUT_BEFORE)
+                in_range.length = 0;
+            else if (in_mode == XTE_PUT_AFTER)
+            {
+                in_range.offset += in_range.length;
+                in_range.length = 0;
+            }
+            
+            if (var->char_count < 0)
+                var->char_count = _xte_utf8_strlen(var->value->value.utf8_string);
+            if (var->char_count == var->byte_length)
+            {
+                /* characters are bytes if the string is entirely ASCII */
+                first_part_size = (in_range.offset < var->byte_length ? in_range.offset : var->byte_length);
+                substring_bytes = (in_range.offset + in_range.length < var->byte_length ?
+                                   in_range.offset + in_range.length : var->byte_length) - first_part_size;
+            }
+            else
+            {
+                first_part_size = _xte_utf8_count_bytes_in_range(var->value->value.utf8_string, 0, in_range.offset);
+                substring_bytes = 0;
+                if (in_range.length > 0)
+                    substring_bytes = _xte_utf8_count_bytes_in_range(var->value->value.utf8_string + first_part_size, 0, in_range.length);
+            }
         }
-        
-        /* if there's a range, grab the length of the substring in bytes */
-        long substring_bytes = 0;
-        if (in_range.length > 0)
-            substring_bytes = _xte_utf8_count_bytes_in_range(existing_string, in_range.offset, in_range.length);
-        
-        /* grab the part before and after the range being replaced */
-        char const *first_part = existing_string;
-        long first_part_size = _xte_utf8_count_bytes_in_range(existing_string, 0, in_range.offset);
-        char const *last_part = _xte_utf8_index_char(existing_string, in_range.offset + in_range.length);
-        long last_part_size = strlen(last_part);
         
         /* grab the new string value */
         char const *new_part = xte_variant_as_cstring(in_value);
         long new_part_size = strlen(new_part);
         
-        /* build the new string */
-        long new_string_len = first_part_size + new_part_size + last_part_size + 1;
-        char *new_string = malloc(new_string_len);
-        if (!new_string) return _xte_panic_void(in_engine, XTE_ERROR_MEMORY, NULL);
-        memcpy(new_string, first_part, first_part_size);
-        memcpy(new_string + first_part_size, new_part, new_part_size);
-        memcpy(new_string + first_part_size + new_part_size, last_part, last_part_size + 1);
+        /* keep the character count */
+        if (var->char_count >= 0)
+        {
+            var->char_count += _xte_utf8_strlen(new_part);
+            if (substring_bytes > 0)
+                var->char_count -= _xte_utf8_count_chars_between(var->value->value.utf8_string + first_part_size,
+                                                                 var->value->value.utf8_string + first_part_size + substring_bytes);
+        }
+        
+        /* grow the buffer geometrically */
+        long new_string_len = var->byte_length - substring_bytes + new_part_size;
+        if (new_string_len + 1 > var->buffer_size)
+        {
+            long new_size = var->buffer_size * 2;
+            if (new_size < new_string_len + 1) new_size = new_string_len + 1;
+            char *new_string = realloc(var->value->value.utf8_string, new_size);
+            if (!new_string) return _xte_panic_void(in_engine, XTE_ERROR_MEMORY, NULL);
+            var->value->value.utf8_string = new_string;
+            var->buffer_size = new_size;
+        }
         
-        /* replace the variable value with the new string */
-        xte_variant_release(var->value);
-        var->value = xte_variant_create(in_engine);
-        if (!var->value) return _xte_panic_void(in_engine, XTE_ERROR_MEMORY, NULL);
-        var->value->type = XTE_TYPE_STRING;
-        var->value->value.utf8_string = new_string;
+        /* move the part after the range, then copy in the new value */
+        char *string = var->value->value.utf8_string;
+        memmove(string + first_part_size + new_part_size, string + first_part_size + substring_bytes,
+                var->byte_length - first_part_size - substring_bytes + 1);
+        memcpy(string + first_part_size, new_part, new_part_size);
+        var->byte_length = new_string_len;
     }
     
     /* report the variable mutation to the debugger as required */
@@ -662,7 +910,7 @@ XTEVariant* xte_variant_value(XTE *in_engine, XTEVariant *in_variant)
                                                               in_variant->value.prop.rep);
             return NULL;
         case XTE_TYPE_GLOBAL:
-            return _xte_variable_read(in_engine, in_variant->value.utf8_string);
+            return _xte_variable_read(in_engine, in_variant->value.var.name, _xte_variable_ref_slot(in_engine, in_variant));
         case XTE_TYPE_OBJECT:
             if (in_variant->value.ref.type->container_read)
                 return in_variant->value.ref.type->container_read(in_engine, in_engine->context, 0, in_variant, XTE_PROPREP_NORMAL);
@@ -713,11 +961,13 @@ int xte_container_write(XTE *in_engine, XTEVariant *in_container, XTEVariant *in
     switch (in_container->type)
     {
         case XTE_TYPE_GLOBAL:
-            _xte_variable_write(in_engine, in_container->value.utf8_string, in_value, in_range, in_mode);
+            _xte_variable_write(in_engine, in_container->value.var.name, _xte_variable_ref_slot(in_engine, in_container),
+                                in_value, in_range, in_mode);
             return XTE_TRUE;
         case XTE_TYPE_OBJECT:
             if (!in_container->value.ref.type->container_write) return XTE_FALSE;
             in_container->value.ref.type->container_write(in_engine, in_engine->context, in_container, in_value, in_range, in_mode);
+            _xte_shadowed_invalidate(in_engine);
             return XTE_TRUE;
         default: break;
     }
@@ -730,6 +980,9 @@ int xte_property_write(XTE *in_engine, XTEVariant *in_property, XTEVariant *in_v
     if (!in_property->value.prop.ptrs->func_write)
         return XTE_FALSE;
     in_property->value.prop.ptrs->func_write(in_engine, in_engine->context, in_property->value.prop.ptrs->env_id, in_property->value.prop.owner, in_value);
+    
+    /* eg. the script of an object */
+    _xte_shadowed_invalidate(in_engine);
     return XTE_TRUE;
 }
 
@@ -762,7 +1015,7 @@ XTEVariant* _xte_resolve_value(XTE *in_engine, XTEVariant *in_variant)
             
             /* return the property value */
             *in_variant = *prop_value;
-            free(prop_value);
+            _xte_slab_free(prop_value);
             break;
         }
         case XTE_TYPE_GLOBAL:
@@ -771,7 +1024,7 @@ XTEVariant* _xte_resolve_value(XTE *in_engine, XTEVariant *in_variant)
             XTEVariant *global_value = xte_variant_value(in_engine, in_variant);//_xte_global_read(in_engine, in_variant->value.utf8_string);
             
             /* replace the input variant with the value */
-            if (in_variant->value.utf8_string) free(in_variant->value.utf8_string);
+            if ((in_variant->value.utf8_string) && (!in_variant->value.var.scope)) free(in_variant->value.utf8_string);
             *in_variant = *global_value;
             
             /* cleanup */
@@ -975,7 +1228,7 @@ int xte_variant_convert(XTE *in_engine, XTEVariant *in_variant, XTEVariantType i
                 {
                     if (!_xte_cstr_is_numeric(in_variant->value.utf8_string))
                         return XTE_FALSE;
-                    int real = atof(in_variant->value.utf8_string);
+                    double real = atof(in_variant->value.utf8_string);
                     if (in_variant->value.utf8_string) free(in_variant->value.utf8_string);
                     in_variant->value.real = real;
                     in_variant->type = XTE_TYPE_REAL;
@@ -1076,7 +1329,7 @@ int _xte_compare_variants(XTE *in_engine, XTEVariant *in_variant1, XTEVariant *i
         case XTE_TYPE_REAL:
         {
             double diff = in_variant1->value.real - in_variant2->value.real;
-            if (abs(diff) < REAL_THRESHOLD) return 0;
+            if (fabs(diff) < REAL_THRESHOLD) return 0;
             else if (diff > 0) return 1;
             else return -1;
         }
@@ -1168,12 +1421,14 @@ void xte_debug_mutate_variable(XTE *in_engine, char const *in_name, int in_conte
     assert(in_name != NULL);
     assert(in_value != NULL);
     
-    struct XTEVariable *var = _xte_variable_access(in_engine, in_name, XTE_FALSE);
+    struct XTEVariable *var = _xte_variable_access(in_engine, in_name, -1, XTE_FALSE);
     
     if (!var) return;
     
     xte_variant_release(var->value);
     var->value = xte_string_create_with_cstring(in_engine, in_value);
+    var->buffer_size = 0;
+    _xte_variable_unindex(var);
     
     _xte_report_variable_mutation(in_engine, var);
 }
@@ -1227,6 +1482,8 @@ void xte_set_global(XTE *in_engine, char const *in_name, XTEVariant *in_value)
     
     xte_variant_release(global->value);
     global->value = xte_variant_copy(in_engine, in_value);
+    global->buffer_size = 0;
+    _xte_variable_unindex(global);
     
     _xte_report_variable_mutation(in_engine, global);
 }
@@ -0,0 +1,1246 @@
+/*
+ 
+ xTalk Engine Bytecode Unit
+ xtalk_vm.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Compiles the abstract syntax tree of a handler to a compact stack-based bytecode and runs it.
+ 
+ The statements and control structures of the handler are flattened into a list of instructions
+ with explicit jumps, so that loops, conditions, "next repeat" and "exit repeat" don't recurse
+ through the tree or check loop abort codes at every node.  Literals are decoded once, into a
+ constant pool, and the counters of "repeat" loops are kept as native integers.
+ 
+ Nodes the compiler doesn't handle itself (properties, references, constants, etc.) are
+ evaluated by the tree interpreter in xtalk_interp.c, which is also used for ad-hoc commands and
+ expressions, and for any handler when bytecode is disabled (see use_bytecode.)
+ 
+ *************************************************************************************************
+ */
+
+#include "xtalk_internal.h"
+
+
+/*********
+ Constants
+ */
+
+/* flags for XTE_OP_ADD_CONST */
+#define _ADD_CONST_SUBTRACT 0x1 /* subtract the constant rather than add it */
+#define _ADD_CONST_LEFT     0x2 /* the constant is the left operand */
+
+/* how an operator converts it's operands; see _xte_operator_operands() */
+#define _OPERANDS_BOXED      0
+#define _OPERANDS_NUMBERS    1
+#define _OPERANDS_COMPARABLE 2
+#define _OPERANDS_BOOLEANS   3
+
+
+/*********
+ Utilities
+ */
+
+#ifdef ERROR_RUNTIME
+#undef ERROR_RUNTIME
+#endif
+#define ERROR_RUNTIME(in_template, in_param1, in_param2) \
+{ _xte_error_runtime(in_engine, in_engine->run_error_line, in_template, in_param1, in_param2, NULL);  }
+
+
+/*
+ *  _xte_operator_operands
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns how the operator converts it's operands.  Only operators that convert their operands
+ *  to numbers or booleans, or compare them, can be applied to unboxed operands; any other
+ *  operator requires it's operands to be boxed.
+ */
+static int _xte_operator_operands(XTEASTOperator in_op)
+{
+    switch (in_op)
+    {
+        case XTE_AST_OP_NEGATE:
+        case XTE_AST_OP_EXPONENT:
+        case XTE_AST_OP_MULTIPLY:
+        case XTE_AST_OP_DIVIDE_FP:
+        case XTE_AST_OP_ADD:
+        case XTE_AST_OP_SUBTRACT:
+        case XTE_AST_OP_DIVIDE_INT:
+        case XTE_AST_OP_MODULUS:
+            return _OPERANDS_NUMBERS;
+        
+        case XTE_AST_OP_EQUAL:
+        case XTE_AST_OP_NOT_EQUAL:
+        case XTE_AST_OP_GREATER:
+        case XTE_AST_OP_LESSER:
+        case XTE_AST_OP_LESS_EQ:
+        case XTE_AST_OP_GREATER_EQ:
+            return _OPERANDS_COMPARABLE;
+        
+        case XTE_AST_OP_NOT:
+        case XTE_AST_OP_AND:
+        case XTE_AST_OP_OR:
+            return _OPERANDS_BOOLEANS;
+        
+        default: break;
+    }
+    return _OPERANDS_BOXED;
+}
+
+
+/*********
+ Compiler
+ */
+
+/*
+ *  Compilation State
+ *  ---------------------------------------------------------------------------------------------
+ *  The jumps for "next repeat" and "exit repeat" are emitted before their targets are known;
+ *  they are chained together through their target operand and patched once the enclosing loop
+ *  has been compiled.
+ */
+struct XTELoopLabels
+{
+    struct XTELoopLabels *outer;
+    int next_chain;
+    int exit_chain;
+};
+
+struct XTECompiler
+{
+    XTE *engine;
+    struct XTEBytecode *code;
+    struct XTELoopLabels *loop;
+    
+    /* current depth of the operand stack */
+    int depth;
+    int failed;
+};
+
+
+static void _xte_compile_statement(struct XTECompiler *in_compiler, XTEAST *in_ast);
+static void _xte_compile_block(struct XTECompiler *in_compiler, XTEAST *in_ast);
+
+
+/*
+ *  _xte_emit
+ *  ---------------------------------------------------------------------------------------------
+ *  Appends an instruction to the bytecode, returning it's address.  <in_stack_effect> is the
+ *  net number of values the instruction pushes on to the operand stack.
+ */
+static int _xte_emit(struct XTECompiler *in_compiler, enum XTEOpcode in_op, int in_a, int in_b, int in_c,
+                     XTEAST *in_ast, int in_stack_effect)
+{
+    struct XTEBytecode *code = in_compiler->code;
+    if (in_compiler->failed) return 0;
+    
+    /* grow the instruction list */
+    if (code->instruction_count == code->instruction_alloc)
+    {
+        int new_alloc = (code->instruction_alloc ? code->instruction_alloc * 2 : 32);
+        struct XTEInstruction *new_instructions = realloc(code->instructions, sizeof(struct XTEInstruction) * new_alloc);
+        if (!new_instructions)
+        {
+            in_compiler->failed = XTE_TRUE;
+            return _xte_panic_int(in_compiler->engine, XTE_ERROR_MEMORY, NULL);
+        }
+        code->instructions = new_instructions;
+        code->instruction_alloc = new_alloc;
+    }
+    
+    struct XTEInstruction *instruction = code->instructions + code->instruction_count;
+    instruction->op = in_op;
+    instruction->a = in_a;
+    instruction->b = in_b;
+    instruction->c = in_c;
+    instruction->ast = in_ast;
+    
+    /* track the maximum depth of the operand stack */
+    in_compiler->depth += in_stack_effect;
+    if (in_compiler->depth > code->stack_size) code->stack_size = in_compiler->depth;
+    
+    return code->instruction_count++;
+}
+
+
+/*
+ *  _xte_patch_chain
+ *  ---------------------------------------------------------------------------------------------
+ *  Sets the target of each jump in a chain of "next repeat" or "exit repeat" jumps.
+ */
+static void _xte_patch_chain(struct XTECompiler *in_compiler, int in_chain, int in_target)
+{
+    if (in_compiler->failed) return;
+    while (in_chain >= 0)
+    {
+        int next = in_compiler->code->instructions[in_chain].a;
+        in_compiler->code->instructions[in_chain].a = in_target;
+        in_chain = next;
+    }
+}
+
+
+/*
+ *  _xte_compile_constant
+ *  ---------------------------------------------------------------------------------------------
+ *  Adds a literal value to the constant pool, returning it's index.
+ *
+ *  !  Assumes ownership of the supplied value.
+ */
+static int _xte_compile_constant(struct XTECompiler *in_compiler, XTEVariant *in_value)
+{
+    struct XTEBytecode *code = in_compiler->code;
+    if (!in_value) in_compiler->failed = XTE_TRUE;
+    if (in_compiler->failed)
+    {
+        xte_variant_release(in_value);
+        return 0;
+    }
+    
+    if (code->constant_count == code->constant_alloc)
+    {
+        int new_alloc = (code->constant_alloc ? code->constant_alloc * 2 : 8);
+        XTEVariant **new_constants = realloc(code->constants, sizeof(XTEVariant*) * new_alloc);
+        if (!new_constants)
+        {
+            xte_variant_release(in_value);
+            in_compiler->failed = XTE_TRUE;
+            return _xte_panic_int(in_compiler->engine, XTE_ERROR_MEMORY, NULL);
+        }
+        code->constants = new_constants;
+        code->constant_alloc = new_alloc;
+    }
+    
+    code->constants[code->constant_count] = in_value;
+    return code->constant_count++;
+}
+
+
+/*
+ *  _xte_is_number_literal
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns XTE_TRUE if the node is an integer or real literal.
+ */
+static int _xte_is_number_literal(XTEAST *in_ast)
+{
+    return (in_ast && ((in_ast->type == XTE_AST_LITERAL_INTEGER) || (in_ast->type == XTE_AST_LITERAL_REAL)));
+}
+
+
+/*
+ *  _xte_compile_add_const
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles the common idiom of adding a number to, or subtracting a number from a variable,
+ *  eg. "put x + 1 into x", as a single instruction.  Returns XTE_FALSE if the operator isn't
+ *  of this form.
+ */
+static int _xte_compile_add_const(struct XTECompiler *in_compiler, XTEAST *in_ast)
+{
+    XTE *in_engine = in_compiler->engine;
+    if ((in_ast->value.op != XTE_AST_OP_ADD) && (in_ast->value.op != XTE_AST_OP_SUBTRACT)) return XTE_FALSE;
+    
+    XTEAST *left = in_ast->children[0];
+    XTEAST *right = in_ast->children[1];
+    XTEAST *variable, *number;
+    int flags = (in_ast->value.op == XTE_AST_OP_SUBTRACT ? _ADD_CONST_SUBTRACT : 0);
+    
+    if (left && (left->type == XTE_AST_WORD) && _xte_is_number_literal(right))
+    {
+        variable = left;
+        number = right;
+    }
+    else if ((in_ast->value.op == XTE_AST_OP_ADD) && _xte_is_number_literal(left) && right && (right->type == XTE_AST_WORD))
+    {
+        variable = right;
+        number = left;
+        flags |= _ADD_CONST_LEFT;
+    }
+    else return XTE_FALSE;
+    
+    int constant;
+    if (number->type == XTE_AST_LITERAL_INTEGER)
+        constant = _xte_compile_constant(in_compiler, xte_integer_create(in_engine, number->value.integer));
+    else
+        constant = _xte_compile_constant(in_compiler, xte_real_create(in_engine, number->value.real));
+    
+    _xte_emit(in_compiler, XTE_OP_ADD_CONST, variable->var_slot, constant, flags, variable, 1);
+    return XTE_TRUE;
+}
+
+
+static void _xte_compile_expression(struct XTECompiler *in_compiler, XTEAST *in_ast);
+
+
+/*
+ *  _xte_is_pure
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns XTE_TRUE if evaluating the expression can't change the value of a variable.
+ */
+static int _xte_is_pure(XTEAST *in_ast)
+{
+    if (!in_ast) return XTE_TRUE;
+    switch (in_ast->type)
+    {
+        case XTE_AST_LITERAL_STRING:
+        case XTE_AST_LITERAL_BOOLEAN:
+        case XTE_AST_LITERAL_REAL:
+        case XTE_AST_LITERAL_INTEGER:
+        case XTE_AST_WORD:
+            return XTE_TRUE;
+        case XTE_AST_EXPRESSION:
+        case XTE_AST_OPERATOR:
+            for (int i = 0; i < in_ast->children_count; i++)
+            {
+                if (!_xte_is_pure(in_ast->children[i])) return XTE_FALSE;
+            }
+            return XTE_TRUE;
+        default: break;
+    }
+    return XTE_FALSE;
+}
+
+
+/*
+ *  _xte_compile_operand
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles an operand of an operator.  Where the operator can be applied to unboxed operands,
+ *  a variable is loaded by value, rather than by reference.
+ *
+ *  A variable is only loaded before the operands which follow it are evaluated if they can't
+ *  change it's value; otherwise, as with the tree interpreter, the reference is resolved by the
+ *  operator.
+ */
+static void _xte_compile_operand(struct XTECompiler *in_compiler, XTEAST *in_operator, int in_operand)
+{
+    XTEAST *operand = in_operator->children[in_operand];
+    while (operand && (operand->type == XTE_AST_EXPRESSION) && (operand->children_count == 1))
+        operand = operand->children[0];
+    
+    int conversion = _xte_operator_operands(in_operator->value.op);
+    if (operand && (operand->type == XTE_AST_WORD) && (conversion != _OPERANDS_BOXED))
+    {
+        int followers_are_pure = XTE_TRUE;
+        for (int i = in_operand + 1; i < in_operator->children_count; i++)
+        {
+            if (!_xte_is_pure(in_operator->children[i])) followers_are_pure = XTE_FALSE;
+        }
+        if (followers_are_pure)
+        {
+            _xte_emit(in_compiler, XTE_OP_LOAD, operand->var_slot, (conversion == _OPERANDS_NUMBERS), 0, operand, 1);
+            return;
+        }
+    }
+    _xte_compile_expression(in_compiler, in_operator->children[in_operand]);
+}
+
+
+/*
+ *  _xte_compile_expression
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles an expression; the instructions push the value of the expression (which may be
+ *  NULL) on to the operand stack.
+ */
+static void _xte_compile_expression(struct XTECompiler *in_compiler, XTEAST *in_ast)
+{
+    XTE *in_engine = in_compiler->engine;
+    
+    /* missing parameters, etc. */
+    if (!in_ast)
+    {
+        _xte_emit(in_compiler, XTE_OP_NULL, 0, 0, 0, NULL, 1);
+        return;
+    }
+    
+    switch (in_ast->type)
+    {
+        case XTE_AST_EXPRESSION:
+            if (in_ast->children_count == 1)
+                _xte_compile_expression(in_compiler, in_ast->children[0]);
+            else
+                _xte_emit(in_compiler, XTE_OP_NULL, 0, 0, 0, NULL, 1);
+            break;
+        
+        case XTE_AST_LITERAL_STRING:
+            _xte_emit(in_compiler, XTE_OP_CONST, _xte_compile_constant(in_compiler,
+                      xte_string_create_with_cstring(in_engine, in_ast->value.string)), 0, 0, in_ast, 1);
+            break;
+        case XTE_AST_LITERAL_BOOLEAN:
+            _xte_emit(in_compiler, XTE_OP_CONST, _xte_compile_constant(in_compiler,
+                      xte_boolean_create(in_engine, in_ast->value.boolean)), 0, 0, in_ast, 1);
+            break;
+        case XTE_AST_LITERAL_REAL:
+            _xte_emit(in_compiler, XTE_OP_CONST, _xte_compile_constant(in_compiler,
+                      xte_real_create(in_engine, in_ast->value.real)), 0, 0, in_ast, 1);
+            break;
+        case XTE_AST_LITERAL_INTEGER:
+            _xte_emit(in_compiler, XTE_OP_CONST, _xte_compile_constant(in_compiler,
+                      xte_integer_create(in_engine, in_ast->value.integer)), 0, 0, in_ast, 1);
+            break;
+        
+        case XTE_AST_WORD:
+            _xte_emit(in_compiler, XTE_OP_VARIABLE, in_ast->var_slot, 0, 0, in_ast, 1);
+            break;
+        
+        case XTE_AST_OPERATOR:
+        {
+            if (_xte_compile_add_const(in_compiler, in_ast)) break;
+            
+            int operand_count = _xte_operator_operand_count(in_ast->value.op);
+            assert(in_ast->children_count == operand_count);
+            for (int i = 0; i < operand_count; i++)
+                _xte_compile_operand(in_compiler, in_ast, i);
+            _xte_emit(in_compiler, XTE_OP_OPERATOR, in_ast->value.op, 0, 0, in_ast, 1 - operand_count);
+            break;
+        }
+        
+        case XTE_AST_FUNCTION:
+            for (int i = 0; i < in_ast->children_count; i++)
+                _xte_compile_expression(in_compiler, in_ast->children[i]);
+            _xte_emit(in_compiler, XTE_OP_FUNCTION, in_ast->children_count, 0, 0, in_ast, 1 - in_ast->children_count);
+            break;
+        
+        default:
+            /* properties, references, constants, etc. are left to the tree interpreter */
+            _xte_emit(in_compiler, XTE_OP_EVAL, 0, 0, 0, in_ast, 1);
+            break;
+    }
+}
+
+
+/*
+ *  _xte_compile_command
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles a command call.  As with the tree interpreter, "the result" is cleared before the
+ *  parameters are evaluated.
+ */
+static void _xte_compile_command(struct XTECompiler *in_compiler, XTEAST *in_ast)
+{
+    _xte_emit(in_compiler, XTE_OP_CLEAR_RESULT, 0, 0, 0, NULL, 0);
+    for (int i = 0; i < in_ast->children_count; i++)
+    {
+        if (in_ast->children[i] && (in_ast->children[i]->flags & XTE_AST_FLAG_DELAYED_EVAL))
+            _xte_emit(in_compiler, XTE_OP_WRAP, 0, 0, 0, in_ast->children[i], 1);
+        else
+            _xte_compile_expression(in_compiler, in_ast->children[i]);
+    }
+    _xte_emit(in_compiler, XTE_OP_COMMAND, in_ast->children_count, 0, 0, in_ast, -in_ast->children_count);
+}
+
+
+/*
+ *  _xte_compile_condition
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles an if..then..else clause.  The children are pairs of condition and block, with an
+ *  optional trailing else block.
+ */
+static void _xte_compile_condition(struct XTECompiler *in_compiler, XTEAST *in_ast)
+{
+    int end_chain = -1;
+    int error_chain = -1;
+    
+    for (int i = 0; i < in_ast->children_count; i += 2)
+    {
+        if (i + 1 == in_ast->children_count)
+        {
+            /* else */
+            _xte_compile_statement(in_compiler, in_ast->children[i]);
+        }
+        else
+        {
+            /* if */
+            _xte_compile_expression(in_compiler, in_ast->children[i]);
+            int test = _xte_emit(in_compiler, XTE_OP_IF, 0, in_ast->source_line, error_chain, in_ast, -1);
+            error_chain = test;
+            
+            _xte_compile_statement(in_compiler, in_ast->children[i+1]);
+            end_chain = _xte_emit(in_compiler, XTE_OP_JUMP, end_chain, 0, 0, NULL, 0);
+            if (!in_compiler->failed) in_compiler->code->instructions[test].a = in_compiler->code->instruction_count;
+        }
+    }
+    
+    /* all branches, and conditions that are not true or false, continue after the clause */
+    _xte_patch_chain(in_compiler, end_chain, in_compiler->code->instruction_count);
+    while ((!in_compiler->failed) && (error_chain >= 0))
+    {
+        int next = in_compiler->code->instructions[error_chain].c;
+        in_compiler->code->instructions[error_chain].c = in_compiler->code->instruction_count;
+        error_chain = next;
+    }
+    
+    _xte_emit(in_compiler, XTE_OP_STEP, in_ast->source_line, 0, 0, in_ast, 0);
+}
+
+
+/*
+ *  _xte_compile_loop
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles a loop.  Loop counters are allocated two at a time; the count and the limit.
+ *  "repeat for each" requires a third, the cursor within the container, which is kept on the
+ *  operand stack until the loop exits.
+ */
+static void _xte_compile_loop(struct XTECompiler *in_compiler, XTEAST *in_ast)
+{
+    struct XTELoopLabels labels = { in_compiler->loop, -1, -1 };
+    struct XTEBytecode *code = in_compiler->code;
+    int counters = 0;
+    int init = -1, limit = -1, test = -1, begin_loop_stmts = 0;
+    
+    /* setup; prepare counters, variables, etc. */
+    switch (in_ast->value.loop)
+    {
+        case XTE_AST_LOOP_NUMBER:
+            counters = code->counter_count;
+            code->counter_count += 2;
+            _xte_compile_expression(in_compiler, in_ast->children[0]);
+            init = _xte_emit(in_compiler, XTE_OP_COUNT_INIT, counters, 0, 0, in_ast, -1);
+            begin_loop_stmts = 1;
+            break;
+        case XTE_AST_LOOP_COUNT_UP:
+        case XTE_AST_LOOP_COUNT_DOWN:
+            counters = code->counter_count;
+            code->counter_count += 2;
+            _xte_compile_expression(in_compiler, in_ast->children[1]);
+            init = _xte_emit(in_compiler, XTE_OP_FOR_INIT, counters, in_ast->children[0]->var_slot, 0, in_ast->children[0], -1);
+        
+            /* the end value is only evaluated once */
+            _xte_compile_expression(in_compiler, in_ast->children[2]);
+            limit = _xte_emit(in_compiler, XTE_OP_FOR_LIMIT, counters, 0, 0, in_ast, -1);
+            begin_loop_stmts = 3;
+            break;
+        case XTE_AST_LOOP_UNTIL:
+        case XTE_AST_LOOP_WHILE:
+            begin_loop_stmts = 1;
+            break;
+        case XTE_AST_LOOP_EACH_CHAR:
+        case XTE_AST_LOOP_EACH_WORD:
+        case XTE_AST_LOOP_EACH_LINE:
+        case XTE_AST_LOOP_EACH_ITEM:
+            counters = code->counter_count;
+            code->counter_count += 3;
+            _xte_compile_expression(in_compiler, in_ast->children[1]);
+            init = _xte_emit(in_compiler, XTE_OP_EACH_INIT, counters, 0, 0, in_ast, 1);
+            begin_loop_stmts = 2;
+            break;
+    }
+    
+    /* check loop counter or condition */
+    int top = code->instruction_count;
+    switch (in_ast->value.loop)
+    {
+        case XTE_AST_LOOP_NUMBER:
+        case XTE_AST_LOOP_COUNT_UP:
+        case XTE_AST_LOOP_COUNT_DOWN:
+            test = _xte_emit(in_compiler, XTE_OP_COUNT_TEST, counters, 0, 0, in_ast, 0);
+            break;
+        case XTE_AST_LOOP_UNTIL:
+        case XTE_AST_LOOP_WHILE:
+            _xte_compile_expression(in_compiler, in_ast->children[0]);
+            test = _xte_emit(in_compiler, XTE_OP_WHILE, 0, (in_ast->value.loop == XTE_AST_LOOP_UNTIL), 0, in_ast, -1);
+            break;
+        case XTE_AST_LOOP_EACH_CHAR:
+        case XTE_AST_LOOP_EACH_WORD:
+        case XTE_AST_LOOP_EACH_LINE:
+        case XTE_AST_LOOP_EACH_ITEM:
+            test = _xte_emit(in_compiler, XTE_OP_COUNT_TEST, counters, 0, 0, in_ast, 0);
+            _xte_emit(in_compiler, XTE_OP_EACH_NEXT, counters, 0, 0, in_ast, 0);
+            break;
+    }
+    
+    /* loop iteration */
+    in_compiler->loop = &labels;
+    for (int i = begin_loop_stmts; i < in_ast->children_count; i++)
+    {
+        XTEAST *stmt = in_ast->children[i];
+        _xte_emit(in_compiler, XTE_OP_LINE, (stmt ? stmt->source_line : in_ast->source_line), 0, 0, stmt, 0);
+        if (stmt) _xte_compile_statement(in_compiler, stmt);
+        if ((i + 1 < in_ast->children_count) && in_ast->children[i+1])
+            _xte_emit(in_compiler, XTE_OP_STEP, in_ast->children[i+1]->source_line, 0, 0, stmt, 0);
+        else
+            _xte_emit(in_compiler, XTE_OP_STEP, in_ast->source_line, 0, 0, stmt, 0);
+    }
+    in_compiler->loop = labels.outer;
+    
+    /* increment / decrement loop counter, and begin the next iteration */
+    _xte_patch_chain(in_compiler, labels.next_chain, code->instruction_count);
+    if ((in_ast->value.loop == XTE_AST_LOOP_NUMBER) || XTE_AST_LOOP_IS_EACH(in_ast->value.loop))
+        _xte_emit(in_compiler, XTE_OP_COUNT_NEXT, counters, 0, 0, in_ast, 0);
+    else if (in_ast->value.loop == XTE_AST_LOOP_COUNT_UP)
+        _xte_emit(in_compiler, XTE_OP_FOR_NEXT, counters, in_ast->children[0]->var_slot, 1, in_ast->children[0], 0);
+    else if (in_ast->value.loop == XTE_AST_LOOP_COUNT_DOWN)
+        _xte_emit(in_compiler, XTE_OP_FOR_NEXT, counters, in_ast->children[0]->var_slot, -1, in_ast->children[0], 0);
+    _xte_emit(in_compiler, XTE_OP_REPEAT, top, in_ast->source_line, 0, in_ast, 0);
+    
+    /* exit the loop */
+    int loop_exit = code->instruction_count;
+    _xte_patch_chain(in_compiler, labels.exit_chain, loop_exit);
+    if ((test >= 0) && (!in_compiler->failed))
+    {
+        if (code->instructions[test].op == XTE_OP_WHILE) code->instructions[test].a = loop_exit;
+        else code->instructions[test].b = loop_exit;
+    }
+    if (XTE_AST_LOOP_IS_EACH(in_ast->value.loop))
+    {
+        _xte_emit(in_compiler, XTE_OP_POP, 0, 0, 0, in_ast, -1);
+        _xte_emit(in_compiler, XTE_OP_POP, 0, 0, 0, in_ast, -1);
+    }
+    _xte_emit(in_compiler, XTE_OP_STEP, in_ast->source_line, 0, 0, in_ast, 0);
+    
+    /* invalid counts, limits and conditions abandon the loop */
+    if (!in_compiler->failed)
+    {
+        if (init >= 0) code->instructions[init].c = code->instruction_count;
+        if (limit >= 0) code->instructions[limit].c = code->instruction_count;
+        if ((test >= 0) && (code->instructions[test].op == XTE_OP_WHILE))
+            code->instructions[test].c = code->instruction_count;
+    }
+}
+
+
+/*
+ *  _xte_compile_exit
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles a return, exit, pass or next statement.
+ */
+static void _xte_compile_exit(struct XTECompiler *in_compiler, XTEAST *in_ast)
+{
+    switch (in_ast->value.exit)
+    {
+        case XTE_AST_EXIT_EVENT:
+            _xte_emit(in_compiler, XTE_OP_EXIT_EVENT, 0, 0, 0, in_ast, 0);
+            break;
+        
+        case XTE_AST_EXIT_PASSING:
+        case XTE_AST_EXIT_HANDLER:
+            if (in_ast->children_count == 1)
+                _xte_compile_expression(in_compiler, in_ast->children[0]);
+            _xte_emit(in_compiler, XTE_OP_RETURN, (in_ast->children_count == 1), (in_ast->value.exit == XTE_AST_EXIT_PASSING),
+                      0, in_ast, -(in_ast->children_count == 1));
+            break;
+        
+        case XTE_AST_EXIT_ITERATION:
+            /* outside a loop, the tree interpreter reports the error */
+            if (!in_compiler->loop) _xte_emit(in_compiler, XTE_OP_EXEC, 0, 0, 0, in_ast, 0);
+            else in_compiler->loop->next_chain = _xte_emit(in_compiler, XTE_OP_JUMP, in_compiler->loop->next_chain, 0, 0, in_ast, 0);
+            break;
+        
+        case XTE_AST_EXIT_LOOP:
+            if (!in_compiler->loop) _xte_emit(in_compiler, XTE_OP_EXEC, 0, 0, 0, in_ast, 0);
+            else in_compiler->loop->exit_chain = _xte_emit(in_compiler, XTE_OP_JUMP, in_compiler->loop->exit_chain, 0, 0, in_ast, 0);
+            break;
+    }
+}
+
+
+/*
+ *  _xte_compile_statement
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles a single statement or control structure.
+ */
+static void _xte_compile_statement(struct XTECompiler *in_compiler, XTEAST *in_ast)
+{
+    if (!in_ast) return;
+    switch (in_ast->type)
+    {
+        case XTE_AST_LIST:
+            _xte_compile_block(in_compiler, in_ast);
+            break;
+        case XTE_AST_LOOP:
+            _xte_compile_loop(in_compiler, in_ast);
+            break;
+        case XTE_AST_CONDITION:
+            _xte_compile_condition(in_compiler, in_ast);
+            break;
+        case XTE_AST_EXIT:
+            _xte_compile_exit(in_compiler, in_ast);
+            break;
+        case XTE_AST_COMMAND:
+            _xte_compile_command(in_compiler, in_ast);
+            break;
+        default:
+            /* parameter names, global declarations, etc. */
+            _xte_emit(in_compiler, XTE_OP_EXEC, 0, 0, 0, in_ast, 0);
+            break;
+    }
+}
+
+
+/*
+ *  _xte_compile_block
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles a list of statements in a handler or condition.
+ */
+static void _xte_compile_block(struct XTECompiler *in_compiler, XTEAST *in_ast)
+{
+    assert((in_ast->type == XTE_AST_LIST) || (in_ast->type == XTE_AST_HANDLER));
+    
+    for (int i = 0; i < in_ast->children_count; i++)
+    {
+        XTEAST *stmt = in_ast->children[i];
+        int line = (stmt ? stmt->source_line : in_ast->source_line) + 1;
+        _xte_emit(in_compiler, XTE_OP_LINE, line, 0, 0, stmt, 0);
+        _xte_compile_statement(in_compiler, stmt);
+        _xte_emit(in_compiler, XTE_OP_STEP, line, 0, 0, stmt, 0);
+    }
+}
+
+
+/*
+ *  _xte_compile_bytecode
+ *  ---------------------------------------------------------------------------------------------
+ *  Compiles a handler.  Returns NULL if the handler couldn't be compiled.
+ *
+ *  The result is the caller's responsibility; see _xte_bytecode_destroy().
+ */
+struct XTEBytecode* _xte_compile_bytecode(XTE *in_engine, XTEAST *in_handler)
+{
+    assert(IS_XTE(in_engine));
+    assert(in_handler != NULL);
+    assert(in_handler->type == XTE_AST_HANDLER);
+    
+    struct XTEBytecode *code = calloc(1, sizeof(struct XTEBytecode));
+    if (!code) return _xte_panic_null(in_engine, XTE_ERROR_MEMORY, NULL);
+    
+    struct XTECompiler compiler;
+    compiler.engine = in_engine;
+    compiler.code = code;
+    compiler.loop = NULL;
+    compiler.depth = 0;
+    compiler.failed = XTE_FALSE;
+    
+    _xte_compile_block(&compiler, in_handler);
+    assert(compiler.failed || (compiler.depth == 0));
+    
+    if (compiler.failed)
+    {
+        _xte_bytecode_destroy(code);
+        return NULL;
+    }
+    return code;
+}
+
+
+/*
+ *  _xte_bytecode_destroy
+ *  ---------------------------------------------------------------------------------------------
+ *  Disposes of a compiled handler.
+ */
+void _xte_bytecode_destroy(struct XTEBytecode *in_code)
+{
+    if (!in_code) return;
+    for (int i = 0; i < in_code->constant_count; i++)
+        xte_variant_release(in_code->constants[i]);
+    if (in_code->constants) free(in_code->constants);
+    if (in_code->instructions) free(in_code->instructions);
+    free(in_code);
+}
+
+
+
+/*********
+ Virtual Machine
+ */
+
+/*
+ *  _xte_vm_should_halt
+ *  ---------------------------------------------------------------------------------------------
+ *  Checks the run state of the engine while it's not simply running; should it abort or pause?
+ */
+static int _xte_vm_should_halt(XTE *in_engine)
+{
+    if ((in_engine->run_state == XTE_RUNSTATE_DEBUG_OUT) && (in_engine->handler_stack_ptr < in_engine->debug_handler_ref_point))
+        in_engine->run_state = XTE_RUNSTATE_PAUSE;
+    return _xte_should_abort(in_engine, INVALID_LINE_NUMBER);
+}
+
+
+/*
+ *  _xte_vm_prepare_frame
+ *  ---------------------------------------------------------------------------------------------
+ *  Sizes the operand stack and loop counters of the current handler frame for the bytecode.
+ *  The operand stack is always NULL above it's top, so a list of parameters popped from the
+ *  stack is NULL terminated.
+ */
+static int _xte_vm_prepare_frame(XTE *in_engine, struct XTEHandlerFrame *in_frame, struct XTEBytecode *in_code)
+{
+    if (in_code->stack_size + 1 > in_frame->vm_stack_alloc)
+    {
+        XTEVariant **new_stack = realloc(in_frame->vm_stack, sizeof(XTEVariant*) * (in_code->stack_size + 1));
+        if (!new_stack) return _xte_panic_int(in_engine, XTE_ERROR_MEMORY, NULL);
+        in_frame->vm_stack = new_stack;
+        memset(new_stack, 0, sizeof(XTEVariant*) * (in_code->stack_size + 1));
+        
+        struct XTEVariant *new_cells = realloc(in_frame->vm_cells, sizeof(struct XTEVariant) * (in_code->stack_size + 1));
+        if (!new_cells) return _xte_panic_int(in_engine, XTE_ERROR_MEMORY, NULL);
+        in_frame->vm_cells = new_cells;
+        in_frame->vm_stack_alloc = in_code->stack_size + 1;
+    }
+    if (in_code->counter_count > in_frame->vm_counter_alloc)
+    {
+        int *new_counters = realloc(in_frame->vm_counters, sizeof(int) * in_code->counter_count);
+        if (!new_counters) return _xte_panic_int(in_engine, XTE_ERROR_MEMORY, NULL);
+        in_frame->vm_counters = new_counters;
+        in_frame->vm_counter_alloc = in_code->counter_count;
+    }
+    return XTE_TRUE;
+}
+
+
+/*
+ *  _xte_vm_box
+ *  ---------------------------------------------------------------------------------------------
+ *  Ensures the operand at the specified index of the stack is a variant in it's own right, that
+ *  can be passed to a command or function, or retained; returns the operand.
+ *
+ *  An operand is unboxed if it points to the corresponding cell.
+ */
+static XTEVariant* _xte_vm_box(XTE *in_engine, XTEVariant **in_stack, struct XTEVariant *in_cells, int in_index)
+{
+    if (in_stack[in_index] == in_cells + in_index)
+        in_stack[in_index] = xte_variant_copy(in_engine, in_cells + in_index);
+    return in_stack[in_index];
+}
+
+
+/*
+ *  _xte_vm_release
+ *  ---------------------------------------------------------------------------------------------
+ *  Disposes of the operand at the specified index of the stack.
+ */
+static void _xte_vm_release(XTEVariant **in_stack, struct XTEVariant *in_cells, int in_index)
+{
+    if (in_stack[in_index] != in_cells + in_index)
+        xte_variant_release(in_stack[in_index]);
+    in_stack[in_index] = NULL;
+}
+
+
+/*
+ *  _xte_vm_operator
+ *  ---------------------------------------------------------------------------------------------
+ *  Applies an operator to unboxed operands, using the same implementation functions as
+ *  _xte_operator_apply(), but without allocating.  The result replaces the left operand, or is
+ *  NULL if the operands aren't valid for the operator.
+ */
+static XTEVariant* _xte_vm_operator(XTE *in_engine, XTEASTOperator in_op, XTEVariant *in_left, XTEVariant *in_right)
+{
+    switch (in_op)
+    {
+            /* unary */
+        case XTE_AST_OP_NEGATE:
+            return _xte_op_math_negate(in_engine, in_left);
+        case XTE_AST_OP_NOT:
+            return _xte_op_logic_not(in_engine, in_left);
+        
+            /* binary */
+        case XTE_AST_OP_EQUAL:
+            return _xte_immediate_boolean(in_left, (_xte_compare_variants(in_engine, in_left, in_right) == 0));
+        case XTE_AST_OP_NOT_EQUAL:
+            return _xte_immediate_boolean(in_left, (_xte_compare_variants(in_engine, in_left, in_right) != 0));
+        case XTE_AST_OP_GREATER:
+            return _xte_immediate_boolean(in_left, (_xte_compare_variants(in_engine, in_left, in_right) > 0));
+        case XTE_AST_OP_LESSER:
+            return _xte_immediate_boolean(in_left, (_xte_compare_variants(in_engine, in_left, in_right) < 0));
+        case XTE_AST_OP_LESS_EQ:
+            return _xte_immediate_boolean(in_left, (_xte_compare_variants(in_engine, in_left, in_right) <= 0));
+        case XTE_AST_OP_GREATER_EQ:
+            return _xte_immediate_boolean(in_left, (_xte_compare_variants(in_engine, in_left, in_right) >= 0));
+        
+        case XTE_AST_OP_EXPONENT:
+            return _xte_op_math_exponent(in_engine, in_left, in_right);
+        case XTE_AST_OP_MULTIPLY:
+            return _xte_op_math_multiply(in_engine, in_left, in_right);
+        case XTE_AST_OP_DIVIDE_FP:
+            return _xte_op_math_divide_fp(in_engine, in_left, in_right);
+        case XTE_AST_OP_ADD:
+            return _xte_op_math_add(in_engine, in_left, in_right);
+        case XTE_AST_OP_SUBTRACT:
+            return _xte_op_math_subtract(in_engine, in_left, in_right);
+        case XTE_AST_OP_DIVIDE_INT:
+            return _xte_op_math_divide_int(in_engine, in_left, in_right);
+        case XTE_AST_OP_MODULUS:
+            return _xte_op_math_modulus(in_engine, in_left, in_right);
+        
+        case XTE_AST_OP_AND:
+            return _xte_op_logic_and(in_engine, in_left, in_right);
+        case XTE_AST_OP_OR:
+            return _xte_op_logic_or(in_engine, in_left, in_right);
+        
+        default: break;
+    }
+    return NULL;
+}
+
+
+/*
+ *  _xte_vm_run
+ *  ---------------------------------------------------------------------------------------------
+ *  Runs a compiled handler within the current handler frame; the equivalent of interpreting the
+ *  handler's AST with _xte_interpret_subtree().
+ */
+void _xte_vm_run(XTE *in_engine, XTEAST *in_handler, struct XTEBytecode *in_code)
+{
+    assert(IS_XTE(in_engine));
+    assert(in_handler != NULL);
+    assert(in_code != NULL);
+    assert(in_engine->handler_stack_ptr >= 0);
+    
+    struct XTEHandlerFrame *frame = in_engine->handler_stack + in_engine->handler_stack_ptr;
+    if (!_xte_vm_prepare_frame(in_engine, frame, in_code)) return;
+    
+    /* check debugging state */
+    if (_xte_should_abort_node(in_engine, in_handler)) return;
+    if ((in_engine->run_state == XTE_RUNSTATE_DEBUG_INTO) && (in_engine->handler_stack_ptr > in_engine->debug_handler_ref_point))
+    {
+        in_engine->run_state = XTE_RUNSTATE_PAUSE;
+        if (_xte_should_abort(in_engine, in_handler->source_line)) return;
+    }
+    
+    /* reset exit flag */
+    in_engine->exit_handler = XTE_FALSE;
+    
+    XTEVariant **stack = frame->vm_stack;
+    struct XTEVariant *cells = frame->vm_cells;
+    int *counters = frame->vm_counters;
+    int sp = 0;
+    
+    struct XTEInstruction *instructions = in_code->instructions;
+    int pc = 0;
+    while (pc < in_code->instruction_count)
+    {
+        struct XTEInstruction *instruction = instructions + pc++;
+        
+        /* has the script been aborted or paused? */
+        if ((in_engine->run_state != XTE_RUNSTATE_RUN) && _xte_vm_should_halt(in_engine)) goto halt;
+        
+        switch (instruction->op)
+        {
+                /* statements */
+            case XTE_OP_LINE:
+                in_engine->run_error_line = instruction->a;
+                if (instruction->ast && _xte_should_abort_node(in_engine, instruction->ast)) goto halt;
+                break;
+            
+            case XTE_OP_STEP:
+                if (in_engine->run_state == XTE_RUNSTATE_DEBUG_OVER)
+                    in_engine->run_state = XTE_RUNSTATE_PAUSE;
+                if (_xte_should_abort(in_engine, instruction->a)) goto halt;
+                break;
+            
+            case XTE_OP_EXEC:
+                xte_variant_release(_xte_interpret_subtree(in_engine, instruction->ast));
+                break;
+            
+            case XTE_OP_CLEAR_RESULT:
+                _xte_set_result(in_engine, xte_string_create_with_cstring(in_engine, ""));
+                break;
+            
+            case XTE_OP_COMMAND:
+            {
+                sp -= instruction->a;
+                for (int i = sp; i < sp + instruction->a; i++)
+                    _xte_vm_box(in_engine, stack, cells, i);
+                _xte_command_send(in_engine, instruction->ast, stack + sp);
+                for (int i = sp; i < sp + instruction->a; i++)
+                    _xte_vm_release(stack, cells, i);
+                break;
+            }
+            
+                /* control */
+            case XTE_OP_JUMP:
+                pc = instruction->a;
+                break;
+            
+            case XTE_OP_IF:
+            {
+                XTEVariant *value = stack[--sp];
+                int is_valid = xte_variant_convert(in_engine, value, XTE_TYPE_BOOLEAN);
+                int condition = (is_valid ? value->value.boolean : XTE_FALSE);
+                _xte_vm_release(stack, cells, sp);
+                if (!is_valid)
+                {
+                    ERROR_RUNTIME("Expected true or false here.", NULL, NULL);
+                    pc = instruction->c;
+                    break;
+                }
+                
+                /* check debugging state */
+                if (in_engine->run_state == XTE_RUNSTATE_DEBUG_OVER)
+                    in_engine->run_state = XTE_RUNSTATE_PAUSE;
+                if (_xte_should_abort(in_engine, instruction->b)) goto halt;
+                
+                if (!condition) pc = instruction->a;
+                break;
+            }
+            
+            case XTE_OP_WHILE:
+            {
+                XTEVariant *value = stack[--sp];
+                int is_valid = xte_variant_convert(in_engine, value, XTE_TYPE_BOOLEAN);
+                int condition = (is_valid ? value->value.boolean : XTE_FALSE);
+                _xte_vm_release(stack, cells, sp);
+                if (!is_valid)
+                {
+                    ERROR_RUNTIME("Expected true or false for loop condition.", NULL, NULL);
+                    pc = instruction->c;
+                    break;
+                }
+                if ((!condition) == (!instruction->b)) pc = instruction->a;
+                break;
+            }
+            
+            case XTE_OP_REPEAT:
+                if (_xte_should_abort(in_engine, instruction->b)) goto halt;
+                pc = instruction->a;
+                break;
+            
+            case XTE_OP_COUNT_INIT:
+            {
+                XTEVariant *count = stack[--sp];
+                int is_valid = xte_variant_convert(in_engine, count, XTE_TYPE_INTEGER);
+                counters[instruction->a] = 0;
+                counters[instruction->a + 1] = (is_valid ? xte_variant_as_int(count) : 0);
+                _xte_vm_release(stack, cells, sp);
+                if (!is_valid)
+                {
+                    ERROR_RUNTIME("Expected integer count for loop.", NULL, NULL);
+                    pc = instruction->c;
+                }
+                break;
+            }
+            
+            case XTE_OP_COUNT_TEST:
+                if (counters[instruction->a] == counters[instruction->a + 1]) pc = instruction->b;
+                break;
+            
+            case XTE_OP_COUNT_NEXT:
+                counters[instruction->a]++;
+                break;
+            
+            case XTE_OP_FOR_INIT:
+            {
+                XTEVariant *start = stack[--sp];
+                int is_valid = xte_variant_convert(in_engine, start, XTE_TYPE_INTEGER);
+                counters[instruction->a] = (is_valid ? xte_variant_as_int(start) : 0);
+                _xte_vm_release(stack, cells, sp);
+                if (!is_valid)
+                {
+                    ERROR_RUNTIME("Expected integer start value for loop.", NULL, NULL);
+                    pc = instruction->c;
+                    break;
+                }
+                
+                struct XTEVariant count;
+                _xte_variable_write(in_engine, instruction->ast->value.string, instruction->b,
+                                    _xte_immediate_integer(&count, counters[instruction->a]),
+                                    _xte_text_make_range(-1, -1), XTE_PUT_INTO);
+                break;
+            }
+            
+            case XTE_OP_FOR_LIMIT:
+            {
+                XTEVariant *limit = stack[--sp];
+                int is_valid = xte_variant_convert(in_engine, limit, XTE_TYPE_INTEGER);
+                counters[instruction->a + 1] = (is_valid ? xte_variant_as_int(limit) : 0);
+                _xte_vm_release(stack, cells, sp);
+                if (!is_valid)
+                {
+                    ERROR_RUNTIME("Expected integer end value for loop.", NULL, NULL);
+                    pc = instruction->c;
+                }
+                break;
+            }
+            
+            case XTE_OP_FOR_NEXT:
+            {
+                /* the loop variable is overwritten in place */
+                struct XTEVariant count;
+                counters[instruction->a] += instruction->c;
+                _xte_variable_write(in_engine, instruction->ast->value.string, instruction->b,
+                                    _xte_immediate_integer(&count, counters[instruction->a]),
+                                    _xte_text_make_range(-1, -1), XTE_PUT_INTO);
+                break;
+            }
+            
+            case XTE_OP_EACH_INIT:
+            {
+                /* the container is kept on the stack as a string until the loop exits,
+                 with the itemDelimiter when the loop began above it */
+                XTEVariant *container = _xte_vm_box(in_engine, stack, cells, sp - 1);
+                if (!xte_variant_convert(in_engine, container, XTE_TYPE_STRING))
+                {
+                    _xte_vm_release(stack, cells, --sp);
+                    ERROR_RUNTIME("Expected string here.", NULL, NULL);
+                    pc = instruction->c;
+                    break;
+                }
+                long offset;
+                counters[instruction->a] = 0;
+                counters[instruction->a + 1] = (int)_xte_chunk_each_begin(xte_variant_as_cstring(container), instruction->ast->value.loop,
+                                                                          in_engine->item_delimiter, &offset);
+                counters[instruction->a + 2] = (int)offset;
+                stack[sp++] = xte_string_create_with_cstring(in_engine, in_engine->item_delimiter);
+                break;
+            }
+            
+            case XTE_OP_EACH_NEXT:
+            {
+                long offset = counters[instruction->a + 2];
+                XTEVariant *element = _xte_chunk_each_next(in_engine, xte_variant_as_cstring(stack[sp - 2]), instruction->ast->value.loop,
+                                                           xte_variant_as_cstring(stack[sp - 1]), &offset);
+                counters[instruction->a + 2] = (int)offset;
+                if (!element) goto halt;
+                XTEAST *variable = instruction->ast->children[0];
+                _xte_variable_write(in_engine, variable->value.string, variable->var_slot,
+                                    element, _xte_text_make_range(-1, -1), XTE_PUT_INTO);
+                xte_variant_release(element);
+                break;
+            }
+            
+            case XTE_OP_RETURN:
+                if (instruction->b) in_engine->exited_passing = XTE_TRUE;
+                in_engine->exit_handler = XTE_TRUE;
+                if (instruction->a)
+                {
+                    frame->return_value = _xte_vm_box(in_engine, stack, cells, --sp);
+                    stack[sp] = NULL;
+                }
+                goto halt;
+            
+            case XTE_OP_EXIT_EVENT:
+                /* abort the current script */
+                in_engine->run_state = XTE_RUNSTATE_ABORT;
+                goto halt;
+            
+                /* expressions */
+            case XTE_OP_NULL:
+                stack[sp++] = NULL;
+                break;
+            
+            case XTE_OP_POP:
+                _xte_vm_release(stack, cells, --sp);
+                break;
+            
+            case XTE_OP_CONST:
+            {
+                /* numbers and booleans are copied to the cell; operators mutate their operands */
+                XTEVariant *constant = in_code->constants[instruction->a];
+                if (_xte_is_immediate(constant))
+                {
+                    cells[sp] = *constant;
+                    cells[sp].ref_count = 1;
+                    stack[sp] = cells + sp;
+                    sp++;
+                }
+                else
+                    stack[sp++] = xte_variant_copy(in_engine, constant);
+                break;
+            }
+            
+            case XTE_OP_VARIABLE:
+                stack[sp++] = _xte_variable_ref(in_engine, instruction->ast->value.string, instruction->a);
+                break;
+            
+            case XTE_OP_LOAD:
+            {
+                /* a number converted by the operator would become real */
+                XTEVariant *value = _xte_variable_peek(in_engine, instruction->ast->value.string, instruction->a);
+                if (_xte_is_immediate(value))
+                {
+                    cells[sp] = *value;
+                    cells[sp].ref_count = 1;
+                    if (instruction->b && (value->type == XTE_TYPE_INTEGER))
+                        _xte_immediate_real(cells + sp, value->value.integer);
+                    stack[sp] = cells + sp;
+                    sp++;
+                }
+                else
+                    stack[sp++] = _xte_variable_ref(in_engine, instruction->ast->value.string, instruction->a);
+                break;
+            }
+            
+            case XTE_OP_EVAL:
+                stack[sp++] = _xte_interpret_subtree(in_engine, instruction->ast);
+                break;
+            
+            case XTE_OP_WRAP:
+                stack[sp++] = _xte_ast_wrap(in_engine, instruction->ast);
+                break;
+            
+            case XTE_OP_ADD_CONST:
+            {
+                /* numeric variables are added to directly; like the operator, the result is real */
+                XTEVariant *constant = in_code->constants[instruction->b];
+                XTEVariant *value = _xte_variable_peek(in_engine, instruction->ast->value.string, instruction->a);
+                if (value && ((value->type == XTE_TYPE_INTEGER) || (value->type == XTE_TYPE_REAL)))
+                {
+                    if (instruction->c & _ADD_CONST_SUBTRACT)
+                        stack[sp] = _xte_immediate_real(cells + sp, xte_variant_as_double(value) - xte_variant_as_double(constant));
+                    else
+                        stack[sp] = _xte_immediate_real(cells + sp, xte_variant_as_double(value) + xte_variant_as_double(constant));
+                    sp++;
+                    break;
+                }
+                
+                /* anything else is converted by the operator */
+                XTEVariant *variable = _xte_variable_ref(in_engine, instruction->ast->value.string, instruction->a);
+                XTEVariant *number = xte_variant_copy(in_engine, constant);
+                XTEVariant *operands[2];
+                operands[0] = (instruction->c & _ADD_CONST_LEFT ? number : variable);
+                operands[1] = (instruction->c & _ADD_CONST_LEFT ? variable : number);
+                stack[sp++] = _xte_operator_apply(in_engine, (instruction->c & _ADD_CONST_SUBTRACT ?
+                                                              XTE_AST_OP_SUBTRACT : XTE_AST_OP_ADD), operands);
+                break;
+            }
+            
+            case XTE_OP_OPERATOR:
+            {
+                int operand_count = _xte_operator_operand_count(instruction->a);
+                sp -= operand_count;
+                
+                /* numbers and booleans are operated upon in place */
+                if ((stack[sp] == cells + sp) && ((operand_count == 1) || (stack[sp + 1] == cells + sp + 1)) &&
+                    (_xte_operator_operands(instruction->a) != _OPERANDS_BOXED))
+                {
+                    stack[sp] = _xte_vm_operator(in_engine, instruction->a, cells + sp, cells + sp + 1);
+                    assert((stack[sp] == NULL) || (stack[sp] == cells + sp));
+                    if (operand_count == 2) stack[sp + 1] = NULL;
+                    sp++;
+                    break;
+                }
+                
+                XTEVariant *operands[2] = {NULL, NULL};
+                for (int i = 0; i < operand_count; i++)
+                {
+                    operands[i] = _xte_vm_box(in_engine, stack, cells, sp + i);
+                    stack[sp + i] = NULL;
+                }
+                stack[sp++] = _xte_operator_apply(in_engine, instruction->a, operands);
+                break;
+            }
+            
+            case XTE_OP_FUNCTION:
+            {
+                sp -= instruction->a;
+                for (int i = sp; i < sp + instruction->a; i++)
+                    _xte_vm_box(in_engine, stack, cells, i);
+                XTEVariant *result = _xte_function_send(in_engine, instruction->ast, stack + sp);
+                for (int i = sp; i < sp + instruction->a; i++)
+                    _xte_vm_release(stack, cells, i);
+                stack[sp++] = result;
+                break;
+            }
+        }
+    }
+    
+halt:
+    /* release anything left on the operand stack */
+    while (sp > 0)
+        _xte_vm_release(stack, cells, --sp);
+    
+    /* reset exit flag */
+    in_engine->exit_handler = XTE_FALSE;
+}
+
+
@@ -0,0 +1,334 @@
+/*
+ 
+ xTalk Engine Built-in Vocabulary Unit
+ xtalk_vocab.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Responsible for the built-in language terminology, which is built once per process and shared
+ by every engine.  An engine begins with the terminology tables of the base vocabulary; when the
+ environment adds terminology, the engine takes it's own copy of the tables (but not of the
+ built-in terms within them) and the new terms are added to the copy.
+ 
+ *************************************************************************************************
+ */
+
+#include "xtalk_internal.h"
+
+#include <pthread.h>
+
+
+/*********
+ Base Vocabulary
+ */
+
+void _xte_synonyms_add_builtins(XTE *in_engine);
+void _xte_classes_add_builtins(XTE *in_engine);
+void _xte_constants_add_builtins(XTE *in_engine);
+void _xte_properties_add_builtins(XTE *in_engine);
+void _xte_elements_add_builtins(XTE *in_engine);
+void _xte_functions_add_builtins(XTE *in_engine);
+void _xte_commands_add_builtins(XTE *in_engine);
+struct XTEDictionary* _xte_dict_build(XTE *in_engine);
+
+
+/* the base vocabulary is held by an engine which is never used for anything else,
+ so that the usual dictionary functions can build it */
+static XTE *_g_xte_base_vocab = NULL;
+static pthread_once_t _g_xte_base_vocab_once = PTHREAD_ONCE_INIT;
+
+
+static void _xte_vocab_build_base(void)
+{
+    XTE *base = calloc(1, sizeof(struct XTE));
+    if (!base) return;
+    strcpy(base->struct_id, _XTE_STRUCT_ID);
+    
+    _xte_synonyms_add_builtins(base);
+    _xte_classes_add_builtins(base);
+    _xte_properties_add_builtins(base);
+    _xte_constants_add_builtins(base);
+    _xte_elements_add_builtins(base);
+    _xte_functions_add_builtins(base);
+    _xte_commands_add_builtins(base);
+    
+    /* the hashed dictionary is built now, as it can't be built on first use by multiple threads */
+    if (!_xte_dict_build(base)) return;
+    
+    if (base->f_result_cstr) free(base->f_result_cstr);
+    base->f_result_cstr = NULL;
+    
+    _g_xte_base_vocab = base;
+}
+
+
+/*
+ *  _xte_vocab_shared
+ *  ---------------------------------------------------------------------------------------------
+ *  Returns the base vocabulary, the tables of which might be shared with the engine.  Returns
+ *  NULL while the base vocabulary itself is being built.
+ */
+
+XTE const* _xte_vocab_shared(XTE *in_engine)
+{
+    if (in_engine == _g_xte_base_vocab) return NULL;
+    return _g_xte_base_vocab;
+}
+
+
+
+/*********
+ Sharing
+ */
+
+/*
+ *  _xte_vocab_share
+ *  ---------------------------------------------------------------------------------------------
+ *  Configures a new engine with the built-in terminology, building it if this is the first
+ *  engine.  Returns XTE_FALSE if the base vocabulary couldn't be built.
+ */
+
+int _xte_vocab_share(XTE *in_engine)
+{
+    pthread_once(&_g_xte_base_vocab_once, &_xte_vocab_build_base);
+    XTE const *base = _g_xte_base_vocab;
+    if (!base) return XTE_FALSE;
+    
+    in_engine->func_count = base->func_count;
+    in_engine->funcs = base->funcs;
+    in_engine->syns_count = base->syns_count;
+    in_engine->syns = base->syns;
+    in_engine->cons_count = base->cons_count;
+    in_engine->cons = base->cons;
+    in_engine->ref_count = base->ref_count;
+    in_engine->refs = base->refs;
+    in_engine->class_prop_count = base->class_prop_count;
+    in_engine->class_props = base->class_props;
+    in_engine->global_prop_count = base->global_prop_count;
+    in_engine->global_props = base->global_props;
+    in_engine->prop_ptr_count = base->prop_ptr_count;
+    in_engine->prop_ptr_table = base->prop_ptr_table;
+    in_engine->cmd_prefix_count = base->cmd_prefix_count;
+    in_engine->cmd_prefix_table = base->cmd_prefix_table;
+    in_engine->class_count = base->class_count;
+    in_engine->classes = base->classes;
+    in_engine->dict = base->dict;
+    
+    return XTE_TRUE;
+}
+
+
+/* returns a copy of a table of the base vocabulary; or the table, if it's not shared */
+static void* _xte_vocab_copy(void *in_table, void const *in_base_table, int in_count, size_t in_item_size, int *io_ok)
+{
+    if ((!in_table) || (in_table != in_base_table)) return in_table;
+    
+    void *table = malloc(in_item_size * in_count);
+    if (!table)
+    {
+        *io_ok = XTE_FALSE;
+        return in_table;
+    }
+    memcpy(table, in_table, in_item_size * in_count);
+    return table;
+}
+
+
+/*
+ *  _xte_vocab_detach
+ *  ---------------------------------------------------------------------------------------------
+ *  Gives the engine it's own copy of any terminology tables still shared with the base
+ *  vocabulary, so that they can be extended.  The built-in terms within the tables remain
+ *  shared.  Returns XTE_FALSE if there isn't enough memory.
+ */
+
+int _xte_vocab_detach(XTE *in_engine)
+{
+    XTE const *base = _xte_vocab_shared(in_engine);
+    if (!base) return XTE_TRUE;
+    
+    int ok = XTE_TRUE;
+    in_engine->funcs = _xte_vocab_copy(in_engine->funcs, base->funcs, in_engine->func_count,
+                                       sizeof(struct XTEFunctionInt*), &ok);
+    in_engine->syns = _xte_vocab_copy(in_engine->syns, base->syns, in_engine->syns_count,
+                                      sizeof(struct XTESynonymInt), &ok);
+    in_engine->cons = _xte_vocab_copy(in_engine->cons, base->cons, in_engine->cons_count,
+                                      sizeof(struct XTEConstantInt), &ok);
+    in_engine->refs = _xte_vocab_copy(in_engine->refs, base->refs, in_engine->ref_count,
+                                      sizeof(struct XTERefInt), &ok);
+    in_engine->class_props = _xte_vocab_copy(in_engine->class_props, base->class_props, in_engine->class_prop_count,
+                                             sizeof(struct XTEPropertyInt*), &ok);
+    in_engine->global_props = _xte_vocab_copy(in_engine->global_props, base->global_props, in_engine->global_prop_count,
+                                              sizeof(struct XTEPropertyInt*), &ok);
+    in_engine->prop_ptr_table = _xte_vocab_copy(in_engine->prop_ptr_table, base->prop_ptr_table, in_engine->prop_ptr_count,
+                                                sizeof(struct XTEPropertyPtrs), &ok);
+    in_engine->cmd_prefix_table = _xte_vocab_copy(in_engine->cmd_prefix_table, base->cmd_prefix_table,
+                                                  in_engine->cmd_prefix_count, sizeof(struct XTECmdPrefix), &ok);
+    in_engine->classes = _xte_vocab_copy(in_engine->classes, base->classes, in_engine->class_count,
+                                         sizeof(struct XTEClassInt*), &ok);
+    return ok;
+}
+
+
+
+/*********
+ Disposal
+ */
+
+static void _xte_vocab_dispose_syntax(struct XTECmdInt *in_syntax)
+{
+    if (in_syntax->pattern) _xte_bnf_destroy(in_syntax->pattern);
+    for (int p = 0; p < in_syntax->param_count; p++)
+    {
+        if (in_syntax->params[p]) free(in_syntax->params[p]);
+    }
+    if (in_syntax->params) free(in_syntax->params);
+    if (in_syntax->param_is_delayed) free(in_syntax->param_is_delayed);
+}
+
+
+static void _xte_vocab_dispose_prop(struct XTEPropertyInt *in_prop)
+{
+    if (in_prop->name) free(in_prop->name);
+    if (in_prop->usual_type) free(in_prop->usual_type);
+    for (int w = 0; w < in_prop->word_count; w++)
+    {
+        if (in_prop->words[w]) free(in_prop->words[w]);
+    }
+    if (in_prop->words) free(in_prop->words);
+    free(in_prop);
+}
+
+
+/*
+ *  _xte_vocab_dispose
+ *  ---------------------------------------------------------------------------------------------
+ *  Disposes of the terminology added to the engine by the environment, and the engine's copies
+ *  of the terminology tables.  The built-in terms, which are at the start of each table (except
+ *  the references, which are sorted) are left alone.
+ */
+
+void _xte_vocab_dispose(XTE *in_engine)
+{
+    XTE const *base = _xte_vocab_shared(in_engine);
+    if (!base) return;
+    
+    _xte_dict_dispose(in_engine);
+    
+    for (int i = base->func_count; i < in_engine->func_count; i++)
+    {
+        struct XTEFunctionInt *func = in_engine->funcs[i];
+        if (func->name) free(func->name);
+        free(func);
+    }
+    if (in_engine->funcs != base->funcs) free(in_engine->funcs);
+    
+    for (int i = base->syns_count; i < in_engine->syns_count; i++)
+    {
+        struct XTESynonymInt *syn = in_engine->syns + i;
+        if (syn->name) free(syn->name);
+        for (int w = 0; w < syn->word_count; w++)
+        {
+            if (syn->words[w]) free(syn->words[w]);
+        }
+        if (syn->words) free(syn->words);
+        for (int w = 0; w < syn->rep_word_count; w++)
+        {
+            if (syn->rep_words[w]) free(syn->rep_words[w]);
+        }
+        if (syn->rep_words) free(syn->rep_words);
+    }
+    if (in_engine->syns != base->syns) free(in_engine->syns);
+    
+    for (int i = base->cons_count; i < in_engine->cons_count; i++)
+    {
+        struct XTEConstantInt *cons = in_engine->cons + i;
+        if (cons->name) free(cons->name);
+        for (int w = 0; w < cons->word_count; w++)
+        {
+            if (cons->words[w]) free(cons->words[w]);
+        }
+        if (cons->words) free(cons->words);
+    }
+    if (in_engine->cons != base->cons) free(in_engine->cons);
+    
+    /* references are inserted amongst the built-ins, which retain their relative order */
+    for (int i = 0, b = 0; i < in_engine->ref_count; i++)
+    {
+        struct XTERefInt *ref = in_engine->refs + i;
+        if ((b < base->ref_count) && (ref->words == base->refs[b].words))
+        {
+            b++;
+            continue;
+        }
+        if (ref->name) free(ref->name);
+        if (ref->type) free(ref->type);
+        for (int w = 0; w < ref->word_count; w++)
+        {
+            if (ref->words[w]) free(ref->words[w]);
+        }
+        if (ref->words) free(ref->words);
+        for (int u = 0; u < ref->uid_alt_count; u++)
+        {
+            if (ref->uid_alt[u].uid_name) free(ref->uid_alt[u].uid_name);
+            if (ref->uid_alt[u].uid_type) free(ref->uid_alt[u].uid_type);
+        }
+        if (ref->uid_alt) free(ref->uid_alt);
+    }
+    if (in_engine->refs != base->refs) free(in_engine->refs);
+    
+    for (int i = base->class_prop_count; i < in_engine->class_prop_count; i++)
+        _xte_vocab_dispose_prop(in_engine->class_props[i]);
+    if (in_engine->class_props != base->class_props) free(in_engine->class_props);
+    
+    for (int i = base->global_prop_count; i < in_engine->global_prop_count; i++)
+        _xte_vocab_dispose_prop(in_engine->global_props[i]);
+    if (in_engine->global_props != base->global_props) free(in_engine->global_props);
+    
+    /* the pointers of a built-in property are copied when the environment adds another
+     property of the same name */
+    for (int i = 0; i < in_engine->prop_ptr_count; i++)
+    {
+        struct XTEPropertyPtrs *entry = in_engine->prop_ptr_table + i;
+        if (i < base->prop_ptr_count)
+        {
+            if (entry->ptrs != base->prop_ptr_table[i].ptrs) free(entry->ptrs);
+            continue;
+        }
+        if (entry->name) free(entry->name);
+        if (entry->ptrs) free(entry->ptrs);
+    }
+    if (in_engine->prop_ptr_table != base->prop_ptr_table) free(in_engine->prop_ptr_table);
+    
+    for (int i = base->class_count; i < in_engine->class_count; i++)
+    {
+        struct XTEClassInt *a_class = in_engine->classes[i];
+        if (a_class->name) free(a_class->name);
+        /* this table is full of pointers to records free'd earlier */
+        if (a_class->properties) free(a_class->properties);
+        free(a_class);
+    }
+    if (in_engine->classes != base->classes) free(in_engine->classes);
+    
+    /* likewise the syntaxes of a built-in command prefix are copied when the environment adds
+     another command with the same prefix */
+    for (int i = 0; i < in_engine->cmd_prefix_count; i++)
+    {
+        struct XTECmdPrefix *prefix = in_engine->cmd_prefix_table + i;
+        int first_syntax = 0;
+        if (i < base->cmd_prefix_count)
+        {
+            if (prefix->commands == base->cmd_prefix_table[i].commands) continue;
+            first_syntax = base->cmd_prefix_table[i].command_count;
+        }
+        else if (prefix->prefix_word) free(prefix->prefix_word);
+        for (int s = first_syntax; s < prefix->command_count; s++)
+            _xte_vocab_dispose_syntax(prefix->commands + s);
+        if (prefix->commands) free(prefix->commands);
+    }
+    if (in_engine->cmd_prefix_table != base->cmd_prefix_table) free(in_engine->cmd_prefix_table);
+}
+
+
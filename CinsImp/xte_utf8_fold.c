@@ -0,0 +1,852 @@
+/*
+ 
+ xTalk Engine UTF-8 Case Folding Tables
+ xte_utf8_fold.c
+ 
+ CinsImp
+ Copyright (c) 2010-2013 Joshua Hawcroft
+ <www.joshhawcroft.com/CinsImp/>
+ 
+ Generated by Tools/xte_mkfold.c from the Unicode case folding data in xte_utf8_tables.c;
+ do not edit.
+ 
+ The folded form of a code point is looked up by its high bits in _XTE_UTF8_FOLD_BLOCK_INDEX
+ and then by its low 8-bits in _XTE_UTF8_FOLD_BLOCKS.  Zero means the code point folds to
+ itself.  Values with the high bit set index a multiple code point form in
+ _XTE_UTF8_FOLD_EXPANSIONS.
+ 
+ *************************************************************************************************
+ */
+
+
+unsigned int const _XTE_UTF8_FOLD_EXPANSIONS[][3] = {
+    { 0x0053, 0x0053, 0x0000 }, /* 00DF */
+    { 0x0049, 0x0307, 0x0000 }, /* 0130 */
+    { 0x02BC, 0x004E, 0x0000 }, /* 0149 */
+    { 0x004A, 0x030C, 0x0000 }, /* 01F0 */
+    { 0x03B9, 0x0308, 0x0301 }, /* 0390 */
+    { 0x03C5, 0x0308, 0x0301 }, /* 03B0 */
+    { 0x0565, 0x0582, 0x0000 }, /* 0587 */
+    { 0x0048, 0x0331, 0x0000 }, /* 1E96 */
+    { 0x0054, 0x0308, 0x0000 }, /* 1E97 */
+    { 0x0057, 0x030A, 0x0000 }, /* 1E98 */
+    { 0x0059, 0x030A, 0x0000 }, /* 1E99 */
+    { 0x0041, 0x02BE, 0x0000 }, /* 1E9A */
+    { 0x0053, 0x0053, 0x0000 }, /* 1E9E */
+    { 0x03C5, 0x0313, 0x0000 }, /* 1F50 */
+    { 0x03C5, 0x0313, 0x0300 }, /* 1F52 */
+    { 0x03C5, 0x0313, 0x0301 }, /* 1F54 */
+    { 0x03C5, 0x0313, 0x0342 }, /* 1F56 */
+    { 0x1F00, 0x03B9, 0x0000 }, /* 1F80 */
+    { 0x1F01, 0x03B9, 0x0000 }, /* 1F81 */
+    { 0x1F02, 0x03B9, 0x0000 }, /* 1F82 */
+    { 0x1F03, 0x03B9, 0x0000 }, /* 1F83 */
+    { 0x1F04, 0x03B9, 0x0000 }, /* 1F84 */
+    { 0x1F05, 0x03B9, 0x0000 }, /* 1F85 */
+    { 0x1F06, 0x03B9, 0x0000 }, /* 1F86 */
+    { 0x1F07, 0x03B9, 0x0000 }, /* 1F87 */
+    { 0x1F00, 0x03B9, 0x0000 }, /* 1F88 */
+    { 0x1F01, 0x03B9, 0x0000 }, /* 1F89 */
+    { 0x1F02, 0x03B9, 0x0000 }, /* 1F8A */
+    { 0x1F03, 0x03B9, 0x0000 }, /* 1F8B */
+    { 0x1F04, 0x03B9, 0x0000 }, /* 1F8C */
+    { 0x1F05, 0x03B9, 0x0000 }, /* 1F8D */
+    { 0x1F06, 0x03B9, 0x0000 }, /* 1F8E */
+    { 0x1F07, 0x03B9, 0x0000 }, /* 1F8F */
+    { 0x1F20, 0x03B9, 0x0000 }, /* 1F90 */
+    { 0x1F21, 0x03B9, 0x0000 }, /* 1F91 */
+    { 0x1F22, 0x03B9, 0x0000 }, /* 1F92 */
+    { 0x1F23, 0x03B9, 0x0000 }, /* 1F93 */
+    { 0x1F24, 0x03B9, 0x0000 }, /* 1F94 */
+    { 0x1F25, 0x03B9, 0x0000 }, /* 1F95 */
+    { 0x1F26, 0x03B9, 0x0000 }, /* 1F96 */
+    { 0x1F27, 0x03B9, 0x0000 }, /* 1F97 */
+    { 0x1F20, 0x03B9, 0x0000 }, /* 1F98 */
+    { 0x1F21, 0x03B9, 0x0000 }, /* 1F99 */
+    { 0x1F22, 0x03B9, 0x0000 }, /* 1F9A */
+    { 0x1F23, 0x03B9, 0x0000 }, /* 1F9B */
+    { 0x1F24, 0x03B9, 0x0000 }, /* 1F9C */
+    { 0x1F25, 0x03B9, 0x0000 }, /* 1F9D */
+    { 0x1F26, 0x03B9, 0x0000 }, /* 1F9E */
+    { 0x1F27, 0x03B9, 0x0000 }, /* 1F9F */
+    { 0x1F60, 0x03B9, 0x0000 }, /* 1FA0 */
+    { 0x1F61, 0x03B9, 0x0000 }, /* 1FA1 */
+    { 0x1F62, 0x03B9, 0x0000 }, /* 1FA2 */
+    { 0x1F63, 0x03B9, 0x0000 }, /* 1FA3 */
+    { 0x1F64, 0x03B9, 0x0000 }, /* 1FA4 */
+    { 0x1F65, 0x03B9, 0x0000 }, /* 1FA5 */
+    { 0x1F66, 0x03B9, 0x0000 }, /* 1FA6 */
+    { 0x1F67, 0x03B9, 0x0000 }, /* 1FA7 */
+    { 0x1F60, 0x03B9, 0x0000 }, /* 1FA8 */
+    { 0x1F61, 0x03B9, 0x0000 }, /* 1FA9 */
+    { 0x1F62, 0x03B9, 0x0000 }, /* 1FAA */
+    { 0x1F63, 0x03B9, 0x0000 }, /* 1FAB */
+    { 0x1F64, 0x03B9, 0x0000 }, /* 1FAC */
+    { 0x1F65, 0x03B9, 0x0000 }, /* 1FAD */
+    { 0x1F66, 0x03B9, 0x0000 }, /* 1FAE */
+    { 0x1F67, 0x03B9, 0x0000 }, /* 1FAF */
+    { 0x1F70, 0x03B9, 0x0000 }, /* 1FB2 */
+    { 0x03B1, 0x03B9, 0x0000 }, /* 1FB3 */
+    { 0x03AC, 0x03B9, 0x0000 }, /* 1FB4 */
+    { 0x03B1, 0x0342, 0x0000 }, /* 1FB6 */
+    { 0x03B1, 0x0342, 0x03B9 }, /* 1FB7 */
+    { 0x03B1, 0x03B9, 0x0000 }, /* 1FBC */
+    { 0x1F74, 0x03B9, 0x0000 }, /* 1FC2 */
+    { 0x03B7, 0x03B9, 0x0000 }, /* 1FC3 */
+    { 0x03AE, 0x03B9, 0x0000 }, /* 1FC4 */
+    { 0x03B7, 0x0342, 0x0000 }, /* 1FC6 */
+    { 0x03B7, 0x0342, 0x03B9 }, /* 1FC7 */
+    { 0x03B7, 0x03B9, 0x0000 }, /* 1FCC */
+    { 0x03B9, 0x0308, 0x0300 }, /* 1FD2 */
+    { 0x03B9, 0x0308, 0x0301 }, /* 1FD3 */
+    { 0x03B9, 0x0342, 0x0000 }, /* 1FD6 */
+    { 0x03B9, 0x0308, 0x0342 }, /* 1FD7 */
+    { 0x03C5, 0x0308, 0x0300 }, /* 1FE2 */
+    { 0x03C5, 0x0308, 0x0301 }, /* 1FE3 */
+    { 0x03C1, 0x0313, 0x0000 }, /* 1FE4 */
+    { 0x03C5, 0x0342, 0x0000 }, /* 1FE6 */
+    { 0x03C5, 0x0308, 0x0342 }, /* 1FE7 */
+    { 0x1F7C, 0x03B9, 0x0000 }, /* 1FF2 */
+    { 0x03C9, 0x03B9, 0x0000 }, /* 1FF3 */
+    { 0x03CE, 0x03B9, 0x0000 }, /* 1FF4 */
+    { 0x03C9, 0x0342, 0x0000 }, /* 1FF6 */
+    { 0x03C9, 0x0342, 0x03B9 }, /* 1FF7 */
+    { 0x03C9, 0x03B9, 0x0000 }, /* 1FFC */
+    { 0x0046, 0x0046, 0x0000 }, /* FB00 */
+    { 0x0046, 0x0049, 0x0000 }, /* FB01 */
+    { 0x0046, 0x004C, 0x0000 }, /* FB02 */
+    { 0x0046, 0x0046, 0x0049 }, /* FB03 */
+    { 0x0046, 0x0046, 0x004C }, /* FB04 */
+    { 0x0053, 0x0054, 0x0000 }, /* FB05 */
+    { 0x0053, 0x0054, 0x0000 }, /* FB06 */
+    { 0x0574, 0x0576, 0x0000 }, /* FB13 */
+    { 0x0574, 0x0565, 0x0000 }, /* FB14 */
+    { 0x0574, 0x056B, 0x0000 }, /* FB15 */
+    { 0x057E, 0x0576, 0x0000 }, /* FB16 */
+    { 0x0574, 0x056D, 0x0000 }, /* FB17 */
+};
+
+
+unsigned int const _XTE_UTF8_FOLD_BLOCKS[][256] = {
+    { 0 },
+    { /* 0000 */
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0, 0x00000041, 0x00000042, 0x00000043, 0x00000044, 0x00000045, 0x00000046, 0x00000047,
+        0x00000048, 0x00000049, 0x0000004A, 0x0000004B, 0x0000004C, 0x0000004D, 0x0000004E, 0x0000004F,
+        0x00000050, 0x00000051, 0x00000052, 0x00000053, 0x00000054, 0x00000055, 0x00000056, 0x00000057,
+        0x00000058, 0x00000059, 0x0000005A,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0, 0x000003BC,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x000000E0, 0x000000E1, 0x000000E2, 0x000000E3, 0x000000E4, 0x000000E5, 0x000000E6, 0x000000E7,
+        0x000000E8, 0x000000E9, 0x000000EA, 0x000000EB, 0x000000EC, 0x000000ED, 0x000000EE, 0x000000EF,
+        0x000000F0, 0x000000F1, 0x000000F2, 0x000000F3, 0x000000F4, 0x000000F5, 0x000000F6,          0,
+        0x000000F8, 0x000000F9, 0x000000FA, 0x000000FB, 0x000000FC, 0x000000FD, 0x000000FE, 0x80000000,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* 0100 */
+        0x00000101,          0, 0x00000103,          0, 0x00000105,          0, 0x00000107,          0,
+        0x00000109,          0, 0x0000010B,          0, 0x0000010D,          0, 0x0000010F,          0,
+        0x00000111,          0, 0x00000113,          0, 0x00000115,          0, 0x00000117,          0,
+        0x00000119,          0, 0x0000011B,          0, 0x0000011D,          0, 0x0000011F,          0,
+        0x00000121,          0, 0x00000123,          0, 0x00000125,          0, 0x00000127,          0,
+        0x00000129,          0, 0x0000012B,          0, 0x0000012D,          0, 0x0000012F,          0,
+        0x80000001,          0, 0x00000133,          0, 0x00000135,          0, 0x00000137,          0,
+                 0, 0x0000013A,          0, 0x0000013C,          0, 0x0000013E,          0, 0x00000140,
+                 0, 0x00000142,          0, 0x00000144,          0, 0x00000146,          0, 0x00000148,
+                 0, 0x80000002, 0x0000014B,          0, 0x0000014D,          0, 0x0000014F,          0,
+        0x00000151,          0, 0x00000153,          0, 0x00000155,          0, 0x00000157,          0,
+        0x00000159,          0, 0x0000015B,          0, 0x0000015D,          0, 0x0000015F,          0,
+        0x00000161,          0, 0x00000163,          0, 0x00000165,          0, 0x00000167,          0,
+        0x00000169,          0, 0x0000016B,          0, 0x0000016D,          0, 0x0000016F,          0,
+        0x00000171,          0, 0x00000173,          0, 0x00000175,          0, 0x00000177,          0,
+        0x000000FF, 0x0000017A,          0, 0x0000017C,          0, 0x0000017E,          0, 0x00000053,
+                 0, 0x00000253, 0x00000183,          0, 0x00000185,          0, 0x00000254, 0x00000188,
+                 0, 0x00000256, 0x00000257, 0x0000018C,          0,          0, 0x000001DD, 0x00000259,
+        0x0000025B, 0x00000192,          0, 0x00000260, 0x00000263,          0, 0x00000269, 0x00000268,
+        0x00000199,          0,          0,          0, 0x0000026F, 0x00000272,          0, 0x00000275,
+        0x000001A1,          0, 0x000001A3,          0, 0x000001A5,          0, 0x00000280, 0x000001A8,
+                 0, 0x00000283,          0,          0, 0x000001AD,          0, 0x00000288, 0x000001B0,
+                 0, 0x0000028A, 0x0000028B, 0x000001B4,          0, 0x000001B6,          0, 0x00000292,
+        0x000001B9,          0,          0,          0, 0x000001BD,          0,          0,          0,
+                 0,          0,          0,          0, 0x000001C6, 0x000001C6,          0, 0x000001C9,
+        0x000001C9,          0, 0x000001CC, 0x000001CC,          0, 0x000001CE,          0, 0x000001D0,
+                 0, 0x000001D2,          0, 0x000001D4,          0, 0x000001D6,          0, 0x000001D8,
+                 0, 0x000001DA,          0, 0x000001DC,          0,          0, 0x000001DF,          0,
+        0x000001E1,          0, 0x000001E3,          0, 0x000001E5,          0, 0x000001E7,          0,
+        0x000001E9,          0, 0x000001EB,          0, 0x000001ED,          0, 0x000001EF,          0,
+        0x80000003, 0x000001F3, 0x000001F3,          0, 0x000001F5,          0, 0x00000195, 0x000001BF,
+        0x000001F9,          0, 0x000001FB,          0, 0x000001FD,          0, 0x000001FF,          0,
+    },
+    { /* 0200 */
+        0x00000201,          0, 0x00000203,          0, 0x00000205,          0, 0x00000207,          0,
+        0x00000209,          0, 0x0000020B,          0, 0x0000020D,          0, 0x0000020F,          0,
+        0x00000211,          0, 0x00000213,          0, 0x00000215,          0, 0x00000217,          0,
+        0x00000219,          0, 0x0000021B,          0, 0x0000021D,          0, 0x0000021F,          0,
+        0x0000019E,          0, 0x00000223,          0, 0x00000225,          0, 0x00000227,          0,
+        0x00000229,          0, 0x0000022B,          0, 0x0000022D,          0, 0x0000022F,          0,
+        0x00000231,          0, 0x00000233,          0,          0,          0,          0,          0,
+                 0,          0, 0x00002C65, 0x0000023C,          0, 0x0000019A, 0x00002C66,          0,
+                 0, 0x00000242,          0, 0x00000180, 0x00000289, 0x0000028C, 0x00000247,          0,
+        0x00000249,          0, 0x0000024B,          0, 0x0000024D,          0, 0x0000024F,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* 0300 */
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0, 0x000003B9,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00000371,          0, 0x00000373,          0,          0,          0, 0x00000377,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0, 0x000003AC,          0,
+        0x000003AD, 0x000003AE, 0x000003AF,          0, 0x000003CC,          0, 0x000003CD, 0x000003CE,
+        0x80000004, 0x000003B1, 0x000003B2, 0x000003B3, 0x000003B4, 0x000003B5, 0x000003B6, 0x000003B7,
+        0x000003B8, 0x000003B9, 0x000003BA, 0x000003BB, 0x000003BC, 0x000003BD, 0x000003BE, 0x000003BF,
+        0x000003C0, 0x000003C1,          0, 0x000003C3, 0x000003C4, 0x000003C5, 0x000003C6, 0x000003C7,
+        0x000003C8, 0x000003C9, 0x000003CA, 0x000003CB,          0,          0,          0,          0,
+        0x80000005,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0, 0x000003C3,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0, 0x000003D7,
+        0x000003B2, 0x000003B8,          0,          0,          0, 0x000003C6, 0x000003C0,          0,
+        0x000003D9,          0, 0x000003DB,          0, 0x000003DD,          0, 0x000003DF,          0,
+        0x000003E1,          0, 0x000003E3,          0, 0x000003E5,          0, 0x000003E7,          0,
+        0x000003E9,          0, 0x000003EB,          0, 0x000003ED,          0, 0x000003EF,          0,
+        0x000003BA, 0x000003C1,          0,          0, 0x000003B8, 0x000003B5,          0, 0x000003F8,
+                 0, 0x000003F2, 0x000003FB,          0,          0, 0x0000037B, 0x0000037C, 0x0000037D,
+    },
+    { /* 0400 */
+        0x00000450, 0x00000451, 0x00000452, 0x00000453, 0x00000454, 0x00000455, 0x00000456, 0x00000457,
+        0x00000458, 0x00000459, 0x0000045A, 0x0000045B, 0x0000045C, 0x0000045D, 0x0000045E, 0x0000045F,
+        0x00000430, 0x00000431, 0x00000432, 0x00000433, 0x00000434, 0x00000435, 0x00000436, 0x00000437,
+        0x00000438, 0x00000439, 0x0000043A, 0x0000043B, 0x0000043C, 0x0000043D, 0x0000043E, 0x0000043F,
+        0x00000440, 0x00000441, 0x00000442, 0x00000443, 0x00000444, 0x00000445, 0x00000446, 0x00000447,
+        0x00000448, 0x00000449, 0x0000044A, 0x0000044B, 0x0000044C, 0x0000044D, 0x0000044E, 0x0000044F,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00000461,          0, 0x00000463,          0, 0x00000465,          0, 0x00000467,          0,
+        0x00000469,          0, 0x0000046B,          0, 0x0000046D,          0, 0x0000046F,          0,
+        0x00000471,          0, 0x00000473,          0, 0x00000475,          0, 0x00000477,          0,
+        0x00000479,          0, 0x0000047B,          0, 0x0000047D,          0, 0x0000047F,          0,
+        0x00000481,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0, 0x0000048B,          0, 0x0000048D,          0, 0x0000048F,          0,
+        0x00000491,          0, 0x00000493,          0, 0x00000495,          0, 0x00000497,          0,
+        0x00000499,          0, 0x0000049B,          0, 0x0000049D,          0, 0x0000049F,          0,
+        0x000004A1,          0, 0x000004A3,          0, 0x000004A5,          0, 0x000004A7,          0,
+        0x000004A9,          0, 0x000004AB,          0, 0x000004AD,          0, 0x000004AF,          0,
+        0x000004B1,          0, 0x000004B3,          0, 0x000004B5,          0, 0x000004B7,          0,
+        0x000004B9,          0, 0x000004BB,          0, 0x000004BD,          0, 0x000004BF,          0,
+        0x000004CF, 0x000004C2,          0, 0x000004C4,          0, 0x000004C6,          0, 0x000004C8,
+                 0, 0x000004CA,          0, 0x000004CC,          0, 0x000004CE,          0,          0,
+        0x000004D1,          0, 0x000004D3,          0, 0x000004D5,          0, 0x000004D7,          0,
+        0x000004D9,          0, 0x000004DB,          0, 0x000004DD,          0, 0x000004DF,          0,
+        0x000004E1,          0, 0x000004E3,          0, 0x000004E5,          0, 0x000004E7,          0,
+        0x000004E9,          0, 0x000004EB,          0, 0x000004ED,          0, 0x000004EF,          0,
+        0x000004F1,          0, 0x000004F3,          0, 0x000004F5,          0, 0x000004F7,          0,
+        0x000004F9,          0, 0x000004FB,          0, 0x000004FD,          0, 0x000004FF,          0,
+    },
+    { /* 0500 */
+        0x00000501,          0, 0x00000503,          0, 0x00000505,          0, 0x00000507,          0,
+        0x00000509,          0, 0x0000050B,          0, 0x0000050D,          0, 0x0000050F,          0,
+        0x00000511,          0, 0x00000513,          0, 0x00000515,          0, 0x00000517,          0,
+        0x00000519,          0, 0x0000051B,          0, 0x0000051D,          0, 0x0000051F,          0,
+        0x00000521,          0, 0x00000523,          0, 0x00000525,          0, 0x00000527,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0, 0x00000561, 0x00000562, 0x00000563, 0x00000564, 0x00000565, 0x00000566, 0x00000567,
+        0x00000568, 0x00000569, 0x0000056A, 0x0000056B, 0x0000056C, 0x0000056D, 0x0000056E, 0x0000056F,
+        0x00000570, 0x00000571, 0x00000572, 0x00000573, 0x00000574, 0x00000575, 0x00000576, 0x00000577,
+        0x00000578, 0x00000579, 0x0000057A, 0x0000057B, 0x0000057C, 0x0000057D, 0x0000057E, 0x0000057F,
+        0x00000580, 0x00000581, 0x00000582, 0x00000583, 0x00000584, 0x00000585, 0x00000586,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0, 0x80000006,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* 1000 */
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00002D00, 0x00002D01, 0x00002D02, 0x00002D03, 0x00002D04, 0x00002D05, 0x00002D06, 0x00002D07,
+        0x00002D08, 0x00002D09, 0x00002D0A, 0x00002D0B, 0x00002D0C, 0x00002D0D, 0x00002D0E, 0x00002D0F,
+        0x00002D10, 0x00002D11, 0x00002D12, 0x00002D13, 0x00002D14, 0x00002D15, 0x00002D16, 0x00002D17,
+        0x00002D18, 0x00002D19, 0x00002D1A, 0x00002D1B, 0x00002D1C, 0x00002D1D, 0x00002D1E, 0x00002D1F,
+        0x00002D20, 0x00002D21, 0x00002D22, 0x00002D23, 0x00002D24, 0x00002D25,          0, 0x00002D27,
+                 0,          0,          0,          0,          0, 0x00002D2D,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* 1E00 */
+        0x00001E01,          0, 0x00001E03,          0, 0x00001E05,          0, 0x00001E07,          0,
+        0x00001E09,          0, 0x00001E0B,          0, 0x00001E0D,          0, 0x00001E0F,          0,
+        0x00001E11,          0, 0x00001E13,          0, 0x00001E15,          0, 0x00001E17,          0,
+        0x00001E19,          0, 0x00001E1B,          0, 0x00001E1D,          0, 0x00001E1F,          0,
+        0x00001E21,          0, 0x00001E23,          0, 0x00001E25,          0, 0x00001E27,          0,
+        0x00001E29,          0, 0x00001E2B,          0, 0x00001E2D,          0, 0x00001E2F,          0,
+        0x00001E31,          0, 0x00001E33,          0, 0x00001E35,          0, 0x00001E37,          0,
+        0x00001E39,          0, 0x00001E3B,          0, 0x00001E3D,          0, 0x00001E3F,          0,
+        0x00001E41,          0, 0x00001E43,          0, 0x00001E45,          0, 0x00001E47,          0,
+        0x00001E49,          0, 0x00001E4B,          0, 0x00001E4D,          0, 0x00001E4F,          0,
+        0x00001E51,          0, 0x00001E53,          0, 0x00001E55,          0, 0x00001E57,          0,
+        0x00001E59,          0, 0x00001E5B,          0, 0x00001E5D,          0, 0x00001E5F,          0,
+        0x00001E61,          0, 0x00001E63,          0, 0x00001E65,          0, 0x00001E67,          0,
+        0x00001E69,          0, 0x00001E6B,          0, 0x00001E6D,          0, 0x00001E6F,          0,
+        0x00001E71,          0, 0x00001E73,          0, 0x00001E75,          0, 0x00001E77,          0,
+        0x00001E79,          0, 0x00001E7B,          0, 0x00001E7D,          0, 0x00001E7F,          0,
+        0x00001E81,          0, 0x00001E83,          0, 0x00001E85,          0, 0x00001E87,          0,
+        0x00001E89,          0, 0x00001E8B,          0, 0x00001E8D,          0, 0x00001E8F,          0,
+        0x00001E91,          0, 0x00001E93,          0, 0x00001E95,          0, 0x80000007, 0x80000008,
+        0x80000009, 0x8000000A, 0x8000000B, 0x00001E61,          0,          0, 0x8000000C,          0,
+        0x00001EA1,          0, 0x00001EA3,          0, 0x00001EA5,          0, 0x00001EA7,          0,
+        0x00001EA9,          0, 0x00001EAB,          0, 0x00001EAD,          0, 0x00001EAF,          0,
+        0x00001EB1,          0, 0x00001EB3,          0, 0x00001EB5,          0, 0x00001EB7,          0,
+        0x00001EB9,          0, 0x00001EBB,          0, 0x00001EBD,          0, 0x00001EBF,          0,
+        0x00001EC1,          0, 0x00001EC3,          0, 0x00001EC5,          0, 0x00001EC7,          0,
+        0x00001EC9,          0, 0x00001ECB,          0, 0x00001ECD,          0, 0x00001ECF,          0,
+        0x00001ED1,          0, 0x00001ED3,          0, 0x00001ED5,          0, 0x00001ED7,          0,
+        0x00001ED9,          0, 0x00001EDB,          0, 0x00001EDD,          0, 0x00001EDF,          0,
+        0x00001EE1,          0, 0x00001EE3,          0, 0x00001EE5,          0, 0x00001EE7,          0,
+        0x00001EE9,          0, 0x00001EEB,          0, 0x00001EED,          0, 0x00001EEF,          0,
+        0x00001EF1,          0, 0x00001EF3,          0, 0x00001EF5,          0, 0x00001EF7,          0,
+        0x00001EF9,          0, 0x00001EFB,          0, 0x00001EFD,          0, 0x00001EFF,          0,
+    },
+    { /* 1F00 */
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00001F00, 0x00001F01, 0x00001F02, 0x00001F03, 0x00001F04, 0x00001F05, 0x00001F06, 0x00001F07,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00001F10, 0x00001F11, 0x00001F12, 0x00001F13, 0x00001F14, 0x00001F15,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00001F20, 0x00001F21, 0x00001F22, 0x00001F23, 0x00001F24, 0x00001F25, 0x00001F26, 0x00001F27,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00001F30, 0x00001F31, 0x00001F32, 0x00001F33, 0x00001F34, 0x00001F35, 0x00001F36, 0x00001F37,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00001F40, 0x00001F41, 0x00001F42, 0x00001F43, 0x00001F44, 0x00001F45,          0,          0,
+        0x8000000D,          0, 0x8000000E,          0, 0x8000000F,          0, 0x80000010,          0,
+                 0, 0x00001F51,          0, 0x00001F53,          0, 0x00001F55,          0, 0x00001F57,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00001F60, 0x00001F61, 0x00001F62, 0x00001F63, 0x00001F64, 0x00001F65, 0x00001F66, 0x00001F67,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x80000011, 0x80000012, 0x80000013, 0x80000014, 0x80000015, 0x80000016, 0x80000017, 0x80000018,
+        0x80000019, 0x8000001A, 0x8000001B, 0x8000001C, 0x8000001D, 0x8000001E, 0x8000001F, 0x80000020,
+        0x80000021, 0x80000022, 0x80000023, 0x80000024, 0x80000025, 0x80000026, 0x80000027, 0x80000028,
+        0x80000029, 0x8000002A, 0x8000002B, 0x8000002C, 0x8000002D, 0x8000002E, 0x8000002F, 0x80000030,
+        0x80000031, 0x80000032, 0x80000033, 0x80000034, 0x80000035, 0x80000036, 0x80000037, 0x80000038,
+        0x80000039, 0x8000003A, 0x8000003B, 0x8000003C, 0x8000003D, 0x8000003E, 0x8000003F, 0x80000040,
+                 0,          0, 0x80000041, 0x80000042, 0x80000043,          0, 0x80000044, 0x80000045,
+        0x00001FB0, 0x00001FB1, 0x00001F70, 0x00001F71, 0x80000046,          0, 0x000003B9,          0,
+                 0,          0, 0x80000047, 0x80000048, 0x80000049,          0, 0x8000004A, 0x8000004B,
+        0x00001F72, 0x00001F73, 0x00001F74, 0x00001F75, 0x8000004C,          0,          0,          0,
+                 0,          0, 0x8000004D, 0x8000004E,          0,          0, 0x8000004F, 0x80000050,
+        0x00001FD0, 0x00001FD1, 0x00001F76, 0x00001F77,          0,          0,          0,          0,
+                 0,          0, 0x80000051, 0x80000052, 0x80000053,          0, 0x80000054, 0x80000055,
+        0x00001FE0, 0x00001FE1, 0x00001F7A, 0x00001F7B, 0x00001FE5,          0,          0,          0,
+                 0,          0, 0x80000056, 0x80000057, 0x80000058,          0, 0x80000059, 0x8000005A,
+        0x00001F78, 0x00001F79, 0x00001F7C, 0x00001F7D, 0x8000005B,          0,          0,          0,
+    },
+    { /* 2100 */
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0, 0x000003C9,          0,
+                 0,          0, 0x0000004B, 0x000000E5,          0,          0,          0,          0,
+                 0,          0, 0x0000214E,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00002170, 0x00002171, 0x00002172, 0x00002173, 0x00002174, 0x00002175, 0x00002176, 0x00002177,
+        0x00002178, 0x00002179, 0x0000217A, 0x0000217B, 0x0000217C, 0x0000217D, 0x0000217E, 0x0000217F,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0, 0x00002184,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* 2400 */
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0, 0x000024D0, 0x000024D1,
+        0x000024D2, 0x000024D3, 0x000024D4, 0x000024D5, 0x000024D6, 0x000024D7, 0x000024D8, 0x000024D9,
+        0x000024DA, 0x000024DB, 0x000024DC, 0x000024DD, 0x000024DE, 0x000024DF, 0x000024E0, 0x000024E1,
+        0x000024E2, 0x000024E3, 0x000024E4, 0x000024E5, 0x000024E6, 0x000024E7, 0x000024E8, 0x000024E9,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* 2C00 */
+        0x00002C30, 0x00002C31, 0x00002C32, 0x00002C33, 0x00002C34, 0x00002C35, 0x00002C36, 0x00002C37,
+        0x00002C38, 0x00002C39, 0x00002C3A, 0x00002C3B, 0x00002C3C, 0x00002C3D, 0x00002C3E, 0x00002C3F,
+        0x00002C40, 0x00002C41, 0x00002C42, 0x00002C43, 0x00002C44, 0x00002C45, 0x00002C46, 0x00002C47,
+        0x00002C48, 0x00002C49, 0x00002C4A, 0x00002C4B, 0x00002C4C, 0x00002C4D, 0x00002C4E, 0x00002C4F,
+        0x00002C50, 0x00002C51, 0x00002C52, 0x00002C53, 0x00002C54, 0x00002C55, 0x00002C56, 0x00002C57,
+        0x00002C58, 0x00002C59, 0x00002C5A, 0x00002C5B, 0x00002C5C, 0x00002C5D, 0x00002C5E,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x00002C61,          0, 0x0000026B, 0x00001D7D, 0x0000027D,          0,          0, 0x00002C68,
+                 0, 0x00002C6A,          0, 0x00002C6C,          0, 0x00000251, 0x00000271, 0x00000250,
+        0x00000252,          0, 0x00002C73,          0,          0, 0x00002C76,          0,          0,
+                 0,          0,          0,          0,          0,          0, 0x0000023F, 0x00000240,
+        0x00002C81,          0, 0x00002C83,          0, 0x00002C85,          0, 0x00002C87,          0,
+        0x00002C89,          0, 0x00002C8B,          0, 0x00002C8D,          0, 0x00002C8F,          0,
+        0x00002C91,          0, 0x00002C93,          0, 0x00002C95,          0, 0x00002C97,          0,
+        0x00002C99,          0, 0x00002C9B,          0, 0x00002C9D,          0, 0x00002C9F,          0,
+        0x00002CA1,          0, 0x00002CA3,          0, 0x00002CA5,          0, 0x00002CA7,          0,
+        0x00002CA9,          0, 0x00002CAB,          0, 0x00002CAD,          0, 0x00002CAF,          0,
+        0x00002CB1,          0, 0x00002CB3,          0, 0x00002CB5,          0, 0x00002CB7,          0,
+        0x00002CB9,          0, 0x00002CBB,          0, 0x00002CBD,          0, 0x00002CBF,          0,
+        0x00002CC1,          0, 0x00002CC3,          0, 0x00002CC5,          0, 0x00002CC7,          0,
+        0x00002CC9,          0, 0x00002CCB,          0, 0x00002CCD,          0, 0x00002CCF,          0,
+        0x00002CD1,          0, 0x00002CD3,          0, 0x00002CD5,          0, 0x00002CD7,          0,
+        0x00002CD9,          0, 0x00002CDB,          0, 0x00002CDD,          0, 0x00002CDF,          0,
+        0x00002CE1,          0, 0x00002CE3,          0,          0,          0,          0,          0,
+                 0,          0,          0, 0x00002CEC,          0, 0x00002CEE,          0,          0,
+                 0,          0, 0x00002CF3,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* A600 */
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x0000A641,          0, 0x0000A643,          0, 0x0000A645,          0, 0x0000A647,          0,
+        0x0000A649,          0, 0x0000A64B,          0, 0x0000A64D,          0, 0x0000A64F,          0,
+        0x0000A651,          0, 0x0000A653,          0, 0x0000A655,          0, 0x0000A657,          0,
+        0x0000A659,          0, 0x0000A65B,          0, 0x0000A65D,          0, 0x0000A65F,          0,
+        0x0000A661,          0, 0x0000A663,          0, 0x0000A665,          0, 0x0000A667,          0,
+        0x0000A669,          0, 0x0000A66B,          0, 0x0000A66D,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x0000A681,          0, 0x0000A683,          0, 0x0000A685,          0, 0x0000A687,          0,
+        0x0000A689,          0, 0x0000A68B,          0, 0x0000A68D,          0, 0x0000A68F,          0,
+        0x0000A691,          0, 0x0000A693,          0, 0x0000A695,          0, 0x0000A697,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* A700 */
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0, 0x0000A723,          0, 0x0000A725,          0, 0x0000A727,          0,
+        0x0000A729,          0, 0x0000A72B,          0, 0x0000A72D,          0, 0x0000A72F,          0,
+                 0,          0, 0x0000A733,          0, 0x0000A735,          0, 0x0000A737,          0,
+        0x0000A739,          0, 0x0000A73B,          0, 0x0000A73D,          0, 0x0000A73F,          0,
+        0x0000A741,          0, 0x0000A743,          0, 0x0000A745,          0, 0x0000A747,          0,
+        0x0000A749,          0, 0x0000A74B,          0, 0x0000A74D,          0, 0x0000A74F,          0,
+        0x0000A751,          0, 0x0000A753,          0, 0x0000A755,          0, 0x0000A757,          0,
+        0x0000A759,          0, 0x0000A75B,          0, 0x0000A75D,          0, 0x0000A75F,          0,
+        0x0000A761,          0, 0x0000A763,          0, 0x0000A765,          0, 0x0000A767,          0,
+        0x0000A769,          0, 0x0000A76B,          0, 0x0000A76D,          0, 0x0000A76F,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0, 0x0000A77A,          0, 0x0000A77C,          0, 0x00001D79, 0x0000A77F,          0,
+        0x0000A781,          0, 0x0000A783,          0, 0x0000A785,          0, 0x0000A787,          0,
+                 0,          0,          0, 0x0000A78C,          0, 0x00000265,          0,          0,
+        0x0000A791,          0, 0x0000A793,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+        0x0000A7A1,          0, 0x0000A7A3,          0, 0x0000A7A5,          0, 0x0000A7A7,          0,
+        0x0000A7A9,          0, 0x00000266,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* FB00 */
+        0x8000005C, 0x8000005D, 0x8000005E, 0x8000005F, 0x80000060, 0x80000061, 0x80000062,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0, 0x80000063, 0x80000064, 0x80000065, 0x80000066, 0x80000067,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* FF00 */
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0, 0x0000FF41, 0x0000FF42, 0x0000FF43, 0x0000FF44, 0x0000FF45, 0x0000FF46, 0x0000FF47,
+        0x0000FF48, 0x0000FF49, 0x0000FF4A, 0x0000FF4B, 0x0000FF4C, 0x0000FF4D, 0x0000FF4E, 0x0000FF4F,
+        0x0000FF50, 0x0000FF51, 0x0000FF52, 0x0000FF53, 0x0000FF54, 0x0000FF55, 0x0000FF56, 0x0000FF57,
+        0x0000FF58, 0x0000FF59, 0x0000FF5A,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+    { /* 10400 */
+        0x00010428, 0x00010429, 0x0001042A, 0x0001042B, 0x0001042C, 0x0001042D, 0x0001042E, 0x0001042F,
+        0x00010430, 0x00010431, 0x00010432, 0x00010433, 0x00010434, 0x00010435, 0x00010436, 0x00010437,
+        0x00010438, 0x00010439, 0x0001043A, 0x0001043B, 0x0001043C, 0x0001043D, 0x0001043E, 0x0001043F,
+        0x00010440, 0x00010441, 0x00010442, 0x00010443, 0x00010444, 0x00010445, 0x00010446, 0x00010447,
+        0x00010448, 0x00010449, 0x0001044A, 0x0001044B, 0x0001044C, 0x0001044D, 0x0001044E, 0x0001044F,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+                 0,          0,          0,          0,          0,          0,          0,          0,
+    },
+};
+
+
+unsigned char const _XTE_UTF8_FOLD_BLOCK_INDEX[0X1100] = {
+    1, 2, 3, 4, 5, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 9,
+    0, 10, 0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 13, 14, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 15, 0, 0, 0, 16,
+    0, 0, 0, 0, 17, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+
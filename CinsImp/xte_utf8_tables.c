@@ -1,3 +1,6 @@
+#include "xtalk_test.h"
+
+
 
 unsigned long const _XTE_UTF8_CP_OFFSETS_FOR_TAIL_SIZE[6] = {
     0x00000000UL, 0x00003080UL, 0x000E2080UL,
@@ -15,6 +18,11 @@ char const _XTE_UTF8_CHAR_TAIL_SIZES[256] = {
     2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2, 3,3,3,3,3,3,3,3,4,4,4,4,5,5,5,5
 };
 
+/* only the tests need the case folding data at runtime; it's compiled into the tables of
+ xte_utf8_fold.c by Tools/xte_mkfold.c */
+
+#if XTALK_TESTS
+
 /* from Unicode Character Database, 2012-08-14, 17:54:49 GMT
  <http://www.unicode.org/ucd/> */
 
@@ -1181,3 +1189,6 @@ char const *const _XTE_UTF8_CASE_DATA =
 "10426; C; 1044E; # DESERET CAPITAL LETTER OI\n"
 "10427; C; 1044F; # DESERET CAPITAL LETTER EW\n"
 ;
+
+#endif
+